@@ -0,0 +1,138 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2014-2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ *********************************************************************************/
+
+#include "utils/structs.glsl"
+#include "utils/pickingutils.glsl"
+
+// Instanced tensor glyphs, see TensorGlyphInstance for the layout of the instance attributes.
+// The base mesh is a unit sphere which is deformed per instance depending on the glyph type.
+#define REYNOLDS 0
+#define HYW 1
+#define SUPERQUADRIC 3
+#define SUPERQUADRIC_EXTENDED 4
+#define QUADRIC 5
+
+uniform GeometryParameters geometry;
+uniform CameraParameters camera;
+
+uniform int glyphType = QUADRIC;
+uniform int pickingOffset = 0;
+uniform int selectedInstance = -1;
+
+layout(location = 8) in vec3 in_Frame0;
+layout(location = 9) in vec3 in_Frame1;
+layout(location = 10) in vec3 in_Frame2;
+layout(location = 11) in vec3 in_Position;
+layout(location = 12) in vec4 in_Shape;
+layout(location = 13) in vec4 in_InstanceColor;
+// Index of the glyph in the uploaded data, instances are reordered by culling and level of detail
+layout(location = 14) in uint in_InstanceId;
+
+out vec4 worldPosition_;
+out vec3 normal_;
+out vec3 viewNormal_;
+out vec3 texCoord_;
+out vec4 color_;
+flat out vec3 pickingColor_;
+flat out int highlight_;
+
+float signedPow(float x, float a) { return sign(x) * pow(abs(x), a); }
+
+vec3 superquadric(vec3 u) {
+    float phi = acos(clamp(u.z / length(u), -1.0, 1.0));
+    float theta = atan(u.y, u.x);
+
+    float alpha = in_Shape.x;
+    float beta = in_Shape.y;
+
+    if (glyphType == SUPERQUADRIC) {
+        vec3 v = vec3(signedPow(cos(phi), beta),
+                      -signedPow(sin(theta), alpha) * signedPow(sin(phi), beta),
+                      signedPow(cos(theta), alpha) * signedPow(sin(phi), beta));
+        // Planar glyphs
+        return in_Shape.w > 0.0 ? vec3(v.z, -v.y, v.x) : v;
+    }
+
+    float sinphiBeta = signedPow(sin(phi), beta);
+    vec3 v = vec3(signedPow(cos(theta), alpha) * sinphiBeta,
+                  signedPow(sin(theta), alpha) * sinphiBeta, signedPow(cos(phi), beta));
+    float betaPrim = in_Shape.z;
+    if (betaPrim > 0.0) {
+        v.y *= signedPow(acos(pow(v.z, 1.0 / betaPrim)), betaPrim) / sinphiBeta;
+    }
+    return v * in_Shape.w;
+}
+
+vec3 deform(vec3 u, mat3 frame, out float scale) {
+    scale = 1.0;
+    if (glyphType == REYNOLDS) {
+        scale = dot(frame * u, u);
+        return u * abs(scale) * in_Shape.x;
+    } else if (glyphType == HYW) {
+        vec3 displacement = frame * u;
+        return u * length(displacement - u * dot(displacement, u)) * in_Shape.y;
+    } else if (glyphType == SUPERQUADRIC || glyphType == SUPERQUADRIC_EXTENDED) {
+        return frame * superquadric(u);
+    } else {
+        return frame * u;
+    }
+}
+
+void main() {
+    mat3 frame = mat3(in_Frame0, in_Frame1, in_Frame2);
+    vec3 u = normalize(in_Vertex.xyz);
+
+    float scale;
+    vec3 p = deform(u, frame, scale);
+
+    // The deformations are not linear, approximate the normal by finite differences on the sphere
+    const float eps = 1.0e-3;
+    vec3 t0 = normalize(cross(u, abs(u.z) < 0.9 ? vec3(0.0, 0.0, 1.0) : vec3(1.0, 0.0, 0.0)));
+    vec3 t1 = cross(u, t0);
+    float dummy;
+    vec3 n = cross(deform(normalize(u + eps * t0), frame, dummy) - p,
+                   deform(normalize(u + eps * t1), frame, dummy) - p);
+    n = length(n) > 0.0 ? normalize(n) : u;
+    n = dot(n, p) < 0.0 ? -n : n;
+
+    color_ = in_InstanceColor;
+    if (glyphType == REYNOLDS) {
+        color_ = scale < 0.0 ? vec4(1.0, 0.0, 0.0, 1.0) : vec4(0.0, 1.0, 0.0, 1.0);
+    }
+
+    texCoord_ = in_TexCoord;
+    worldPosition_ = geometry.dataToWorld * vec4(in_Position + p, 1.0);
+    normal_ = geometry.dataToWorldNormalMatrix * n;
+    viewNormal_ = (camera.worldToView * vec4(normal_, 0.0)).xyz;
+
+    pickingColor_ = pickingIndexToColor(uint(pickingOffset) + in_InstanceId);
+    highlight_ = int(in_InstanceId) == selectedInstance ? 1 : 0;
+
+    gl_Position = camera.worldToClip * worldPosition_;
+}
@@ -30,9 +30,8 @@
 #include "utils/shading.glsl"
 #include "colortools.glsl"
 
-// Same as geometryrendering.frag with the exception of picking
-uniform vec3 pickingColor;
-uniform bool highlight;
+// Same as geometryrendering.frag with the exception of picking, the picking color and the
+// highlight are set per glyph instance by tensorglyphinstanced.vert
 
 uniform LightParameters light;
 uniform CameraParameters camera;
@@ -42,6 +41,8 @@ in vec3 normal_;
 in vec3 viewNormal_;
 in vec3 texCoord_;
 in vec4 color_;
+flat in vec3 pickingColor_;
+flat in int highlight_;
 
 void main() {
     vec4 fragColor = vec4(1.0);
@@ -52,12 +53,12 @@ void main() {
     hl_color = hcl2rgb(hl_color);
 
     vec4 color;
-    color = highlight ? vec4(hl_color, 1.0) : color_;
+    color = highlight_ != 0 ? vec4(hl_color, 1.0) : color_;
     
     fragColor.rgb = APPLY_LIGHTING(light, color.rgb, color.rgb, vec3(1.0f), worldPosition_.xyz,
                                    normalize(normal_), normalize(toCameraDir_));
     
     FragData0 = fragColor;
 
-    PickingData = vec4(pickingColor, 1.0);
+    PickingData = vec4(pickingColor_, 1.0);
 }
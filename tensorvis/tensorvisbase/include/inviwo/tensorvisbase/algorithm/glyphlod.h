@@ -0,0 +1,108 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/tensorvisbase/tensorvisbasemoduledefine.h>
+#include <inviwo/tensorvisbase/datastructures/tensorglyphinstances.h>
+#include <inviwo/core/common/inviwo.h>
+
+#include <vector>
+
+namespace inviwo {
+
+/*
+ * Parameters of the glyph level of detail selection. Level 0 is the finest level, every further
+ * level halves the sphere resolution down to minResolution.
+ */
+struct IVW_MODULE_TENSORVISBASE_API GlyphLodSettings {
+    // Discard glyphs outside the view frustum or with a projected radius below minPixelRadius
+    bool cull = true;
+    float minPixelRadius = 0.5f;
+    // Pick the resolution of each glyph from its projected size
+    bool lod = true;
+    float pixelsPerSegment = 4.0f;
+    size_t levels = 4;
+    size2_t minResolution{6, 4};
+};
+
+struct IVW_MODULE_TENSORVISBASE_API GlyphLodSelection {
+    // Sphere resolution (theta, phi) of each level, finest first
+    std::vector<size2_t> resolutions;
+    // Indices of the visible glyphs of each level
+    std::vector<std::vector<size_t>> instances;
+    size_t culled = 0;
+
+    size_t getNumberOfVisibleGlyphs() const;
+};
+
+namespace util {
+
+/*
+ * Radius of a sphere around the glyph position that contains the whole glyph.
+ */
+IVW_MODULE_TENSORVISBASE_API float glyphBoundingRadius(TensorGlyphType type,
+                                                       const TensorGlyphInstance &instance);
+
+IVW_MODULE_TENSORVISBASE_API std::vector<size2_t> glyphLodResolutions(
+    const size2_t &maxResolution, const GlyphLodSettings &settings);
+
+/*
+ * Radius in pixels of a sphere in world space, for perspective as well as orthographic
+ * projections given by worldToClip.
+ */
+IVW_MODULE_TENSORVISBASE_API float projectedRadius(const vec3 &center, float radius,
+                                                   const mat4 &worldToClip,
+                                                   const size2_t &viewport);
+
+IVW_MODULE_TENSORVISBASE_API bool isInFrustum(const vec3 &center, float radius,
+                                              const mat4 &worldToClip);
+
+/*
+ * Returns the level of a glyph with the given bounding sphere, or -1 if it is culled.
+ */
+IVW_MODULE_TENSORVISBASE_API int selectGlyphLod(const vec3 &center, float radius,
+                                                const mat4 &worldToClip, const size2_t &viewport,
+                                                const std::vector<size2_t> &resolutions,
+                                                const GlyphLodSettings &settings);
+
+/*
+ * Sorts the glyphs into levels of detail, where the finest level has the resolution of the base
+ * mesh of the glyphs. jobs limits the number of chunks the glyphs are split into, 0 uses the
+ * thread pool and 1 runs serially. Small sets of glyphs are always sorted serially.
+ */
+IVW_MODULE_TENSORVISBASE_API GlyphLodSelection selectGlyphLods(const TensorGlyphInstances &glyphs,
+                                                               const mat4 &worldToClip,
+                                                               const size2_t &viewport,
+                                                               const GlyphLodSettings &settings,
+                                                               size_t jobs = 0);
+
+}  // namespace util
+
+}  // namespace inviwo
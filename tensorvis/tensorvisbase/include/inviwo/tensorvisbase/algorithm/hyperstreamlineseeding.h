@@ -0,0 +1,79 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/tensorvisbase/tensorvisbasemoduledefine.h>
+#include <inviwo/tensorvisbase/datastructures/tensorfield3d.h>
+#include <inviwo/tensorvisbase/datastructures/hyperstreamlineoccupancygrid.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace inviwo {
+namespace tensorutil {
+
+/*
+ * Seed points for hyperstreamlines. All functions return positions in the data space [0,1]^3 of
+ * the tensor field, see HyperStreamLineTracer::traceFromDataSpace.
+ */
+
+/*
+ * Per voxel weights from the metadata of a scalar tensor feature, e.g. an anisotropy measure.
+ * Negative values get weight zero, as do voxels outside the mask of the field. Throws if the
+ * field has no such metadata or it has more than one component.
+ */
+IVW_MODULE_TENSORVISBASE_API std::vector<double> featureWeights(const TensorField3D &tensorField,
+                                                                TensorFeature feature);
+
+/*
+ * Draws count seeds from the voxels with a probability proportional to their weight, each seed
+ * at a random position inside its voxel. The same random seed gives the same seed points. Throws
+ * if the number of weights does not match the dimensions or all weights are zero.
+ */
+IVW_MODULE_TENSORVISBASE_API std::vector<dvec3> weightedSeeds(const std::vector<double> &weights,
+                                                              const size3_t &dimensions,
+                                                              size_t count,
+                                                              std::uint32_t randomSeed = 0);
+
+/*
+ * Seeds at the centers of the empty cells of the occupancy grid on a sub-lattice with the given
+ * spacing in cells. Each round uses another offset of the sub-lattice, so after
+ * numberOfSeedingRounds(spacing) rounds every cell has been considered once. Tracing the seeds
+ * of a round before creating the next one fills the grid with evenly spaced lines. A round can
+ * be traced in parallel against a frozen grid, see HyperStreamLineTracer::setOccupancyFrozen.
+ */
+IVW_MODULE_TENSORVISBASE_API std::vector<dvec3> evenlySpacedSeeds(
+    const HyperStreamLineOccupancyGrid &grid, size_t spacing, size_t round);
+
+IVW_MODULE_TENSORVISBASE_API size_t numberOfSeedingRounds(size_t spacing);
+
+}  // namespace tensorutil
+}  // namespace inviwo
@@ -0,0 +1,78 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019-2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/tensorvisbase/tensorvisbasemoduledefine.h>
+#include <inviwo/tensorvisbase/datastructures/tensorfield3d.h>
+#include <inviwo/core/common/inviwo.h>
+
+#include <array>
+#include <memory>
+#include <vector>
+
+namespace inviwo {
+namespace tensorutil {
+
+/*
+ * Returns true for the features that can be computed per tensor by computeTensorFeatures, i.e.
+ * the invariants and all scalar measures derived from the eigenvalues.
+ */
+IVW_MODULE_TENSORVISBASE_API bool isScalarTensorFeature(TensorFeature feature);
+
+/*
+ * Returns true if the feature is computed from the eigenvalues rather than from the tensor.
+ */
+IVW_MODULE_TENSORVISBASE_API bool requiresEigenValues(TensorFeature feature);
+
+/*
+ * Creates the metadata container matching the feature, taking ownership of the data.
+ */
+IVW_MODULE_TENSORVISBASE_API std::unique_ptr<MetaDataBase> createMetaData(
+    TensorFeature feature, std::vector<double> data);
+
+/*
+ * Fused kernel computing any subset of the scalar tensor features in a single parallel pass over
+ * the tensors and the eigenvalues. columns[i] has to point to tensors.size() preallocated values
+ * for features[i]. The eigenvalues (major, intermediate, minor) are only accessed, and may be
+ * nullptr, if none of the features requires them.
+ */
+IVW_MODULE_TENSORVISBASE_API void computeTensorFeatures(
+    const TensorStorage3D &tensors, const std::array<const double *, 3> &eigenValues,
+    const std::vector<TensorFeature> &features, const std::vector<double *> &columns);
+
+/*
+ * Computes the given scalar features of the tensor field in one pass and returns them as
+ * metadata ready to be added to a field. Features that are not scalar features are skipped.
+ */
+IVW_MODULE_TENSORVISBASE_API std::vector<std::unique_ptr<MetaDataBase>> computeTensorFeatures(
+    const TensorField3D &tensorField, const std::vector<TensorFeature> &features);
+
+}  // namespace tensorutil
+}  // namespace inviwo
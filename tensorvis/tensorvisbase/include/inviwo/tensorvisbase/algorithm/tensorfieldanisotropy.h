@@ -0,0 +1,71 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/tensorvisbase/tensorvisbasemoduledefine.h>
+#include <inviwo/tensorvisbase/datastructures/tensorfield3d.h>
+#include <inviwo/tensorvisbase/util/tensorutil.h>
+#include <inviwo/core/datastructures/volume/volume.h>
+
+#include <array>
+#include <memory>
+#include <vector>
+
+namespace inviwo {
+namespace tensorutil {
+
+/*
+ * Number of volume channels the measure occupies, 3 for barycentric coordinates and 1 otherwise.
+ */
+IVW_MODULE_TENSORVISBASE_API size_t numberOfChannels(Anisotropy measure);
+
+/*
+ * Evaluates the measure for the eigenvalues (major, intermediate, minor) and writes
+ * numberOfChannels(measure) values to out. Returns the number of values written.
+ */
+IVW_MODULE_TENSORVISBASE_API size_t evaluateAnisotropy(Anisotropy measure,
+                                                       const std::array<double, 3> &eigenValues,
+                                                       double *out);
+
+/*
+ * Computes the given anisotropy measures for all tensors in a single sweep and writes them as
+ * consecutive channels of a float volume, e.g. barycentric coordinates followed by
+ * |lambda1 - lambda2| gives a 4 channel volume. At most 4 channels are supported. The data range
+ * of the volume spans the values of all channels.
+ * Each job works on a contiguous range of tensors and keeps its own value range, the ranges are
+ * combined after all jobs finished, so the result does not depend on the number of jobs. jobs = 0
+ * uses the size of the thread pool and 1 runs serially.
+ */
+IVW_MODULE_TENSORVISBASE_API std::shared_ptr<Volume> computeAnisotropy(
+    const TensorField3D &tensorField, const std::vector<Anisotropy> &measures, size_t jobs = 0);
+
+}  // namespace tensorutil
+}  // namespace inviwo
@@ -0,0 +1,85 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/tensorvisbase/tensorvisbasemoduledefine.h>
+#include <inviwo/tensorvisbase/algorithm/tensorfieldsampling.h>
+#include <inviwo/tensorvisbase/datastructures/tensorfield2d.h>
+#include <inviwo/tensorvisbase/datastructures/tensorfield3d.h>
+#include <inviwo/core/common/inviwo.h>
+
+#include <functional>
+
+namespace inviwo {
+namespace tensorutil {
+
+/*
+ * Filter applied along the axes that are downsampled. Box averages all voxels covered by an output
+ * voxel, Gaussian weighs them with a Gaussian of standard deviation of half an output voxel.
+ */
+enum class ResamplingFilter { None, Box, Gaussian };
+
+/*
+ * Space in which the tensors are averaged. The log-Euclidean mean exp(sum w_i log(T_i)) avoids the
+ * swelling of the Euclidean mean but requires symmetric positive definite tensors.
+ */
+enum class ResamplingSpace { Euclidean, LogEuclidean };
+
+struct IVW_MODULE_TENSORVISBASE_API ResamplingSettings {
+    // Used along axes that are upsampled, or all axes if filter is None
+    InterpolationMethod method = InterpolationMethod::Linear;
+    ResamplingFilter filter = ResamplingFilter::Box;
+    ResamplingSpace space = ResamplingSpace::Euclidean;
+    // Edge length in voxels of the bricks of the output that are processed as one job
+    size_t brickSize = 32;
+    // Number of threads, 0 uses the size of the thread pool and 1 runs serially
+    size_t jobs = 0;
+    // Called with the fraction of finished bricks, from the worker threads
+    std::function<void(float)> progress;
+};
+
+/*
+ * Resamples the tensor field to the given dimensions, keeping its extents. Output voxels are
+ * processed in memory order in bricks on the thread pool. Voxels outside the mask of a 3D field do
+ * not contribute, the mask of the output marks the voxels with at least one contributing voxel.
+ * Barycentric interpolation is only used for 2D fields that are neither filtered nor averaged in
+ * log-Euclidean space, otherwise it is replaced by linear interpolation.
+ * Throws an Exception for ResamplingSpace::LogEuclidean if a tensor is not positive definite.
+ */
+IVW_MODULE_TENSORVISBASE_API std::shared_ptr<TensorField3D> resample(
+    const std::shared_ptr<const TensorField3D> &tensorField, const size3_t &newDimensions,
+    const ResamplingSettings &settings = {});
+
+IVW_MODULE_TENSORVISBASE_API std::shared_ptr<TensorField2D> resample(
+    const std::shared_ptr<const TensorField2D> &tensorField, const size2_t &newDimensions,
+    const ResamplingSettings &settings = {});
+
+}  // namespace tensorutil
+}  // namespace inviwo
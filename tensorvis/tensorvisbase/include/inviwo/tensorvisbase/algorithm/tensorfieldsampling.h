@@ -34,13 +34,15 @@
 #include <inviwo/core/common/inviwo.h>
 #include <inviwo/tensorvisbase/tensorvisbasemoduledefine.h>
 
+#include <array>
+
 namespace inviwo {
 namespace tensorutil {
 enum class InterpolationMethod { Linear, Nearest, Barycentric };
 }
 
 template <tensorutil::InterpolationMethod method>
-dmat2 sample(std::shared_ptr<const TensorField2D> tensorField, const dvec2& position) {
+dmat2 sample(const std::shared_ptr<const TensorField2D>& tensorField, const dvec2& position) {
     const auto fBounds = tensorField->getBounds<double>();
 
     if constexpr (method == tensorutil::InterpolationMethod::Nearest) {
@@ -123,69 +125,101 @@ dmat2 sample(std::shared_ptr<const TensorField2D> tensorField, const dvec2& posi
     return dmat2();
 }
 
-IVW_MODULE_TENSORVISBASE_API dmat2 sample(std::shared_ptr<const TensorField2D> tensorField,
+IVW_MODULE_TENSORVISBASE_API dmat2 sample(const std::shared_ptr<const TensorField2D>& tensorField,
                                           const dvec2& position,
                                           const tensorutil::InterpolationMethod method);
 
 /**
- * Returns a pair of a glm::uint8 and dmat3.
- * The dmat3 is the tensor. Since the field stores tensors at every position
- * it has a mask defining where it is actually defined and where not. It is 1
- * if there is data at this position and 0 if not. If the mask value is zero,
- * the tensor will be a 0 tensor. If the mask is not set for the tensor field,
- * the mask value return will always be 0.
+ * \class TensorField3DSampler
+ * \brief Samples a 3D tensor field at positions in texture space [0,1].
+ * The sampler is bound to a field once, precomputing the index strides and the texture to index
+ * scaling, so sampling does not touch any reference counts. Positions outside [0,1] are clamped
+ * to the border of the field. Voxels outside the binary mask of the field do not contribute to
+ * the interpolation. If none of the contributing voxels is inside the mask, the sample is the
+ * zero tensor with mask value 0. Fields without a mask are defined everywhere.
+ * Barycentric interpolation is only defined for 2D fields, the 3D sampler uses trilinear
+ * interpolation instead.
  */
-template <tensorutil::InterpolationMethod method>
-std::pair<glm::uint8, dmat3> sample(std::shared_ptr<const TensorField3D> tensorField,
-                                    const dvec3& position) {
-    // Position is in texture space [0,1], translate to index space
-    const auto bounds = tensorField->getBounds<double>();
-    const auto indexPosition = position * bounds;
+class IVW_MODULE_TENSORVISBASE_API TensorField3DSampler {
+public:
+    using Sample = std::pair<glm::uint8, dmat3>;
 
-    dmat3 val{0.0};
+    explicit TensorField3DSampler(std::shared_ptr<const TensorField3D> tensorField);
 
-    if constexpr (method == tensorutil::InterpolationMethod::Linear) {
-        const auto xm = glm::floor(indexPosition.x);
-        const auto ym = glm::floor(indexPosition.y);
-        const auto zm = glm::floor(indexPosition.z);
+    template <tensorutil::InterpolationMethod method>
+    Sample sample(const dvec3& position) const;
 
-        const auto xp = glm::ceil(indexPosition.x);
-        const auto yp = glm::ceil(indexPosition.y);
-        const auto zp = glm::ceil(indexPosition.z);
+    Sample sample(const dvec3& position, tensorutil::InterpolationMethod method) const;
 
-        const auto xFrac = glm::fract(position.x * bounds.x);
-        const auto yFrac = glm::fract(position.y * bounds.y);
-        const auto zFrac = glm::fract(position.z * bounds.z);
+    /*
+     * Samples count positions into tensors and, unless it is nullptr, mask. The interpolation
+     * method is dispatched once for all positions.
+     */
+    void sample(const dvec3* positions, size_t count, dmat3* tensors, glm::uint8* mask,
+                tensorutil::InterpolationMethod method) const;
 
-        // Upper layer
-        const auto& tensor010 = tensorField->at(size3_t(xm, yp, zm)).second;
-        const auto& tensor011 = tensorField->at(size3_t(xm, yp, zp)).second;
-        const auto tensorUpperLeft = glm::mix(tensor010, tensor011, zFrac);
+    std::vector<dmat3> sample(const std::vector<dvec3>& positions,
+                              tensorutil::InterpolationMethod method) const;
 
-        const auto& tensor111 = tensorField->at(size3_t(xp, yp, zp)).second;
-        const auto& tensor110 = tensorField->at(size3_t(xp, yp, zm)).second;
-        const auto tensorUpperRight = glm::mix(tensor110, tensor111, zFrac);
+    const TensorField3D& getTensorField() const { return *tensorField_; }
 
-        const auto tensorUpper = glm::mix(tensorUpperLeft, tensorUpperRight, xFrac);
+private:
+    template <tensorutil::InterpolationMethod method>
+    void sampleAll(const dvec3* positions, size_t count, dmat3* tensors, glm::uint8* mask) const;
 
-        // Lower layer
-        const auto& tensor000 = tensorField->at(size3_t(xm, ym, zm)).second;
-        const auto& tensor001 = tensorField->at(size3_t(xm, ym, zp)).second;
-        const auto tensorLowerLeft = glm::mix(tensor000, tensor001, zFrac);
+    dmat3 tensor(size_t index) const { return data_ ? data_[index] : (*tensors_)[index]; }
+    bool isDefined(size_t index) const { return !mask_ || mask_[index] != 0; }
 
-        const auto& tensor100 = tensorField->at(size3_t(xp, ym, zm)).second;
-        const auto& tensor101 = tensorField->at(size3_t(xp, ym, zp)).second;
-        const auto tensorLowerRight = glm::mix(tensor100, tensor101, zFrac);
+    std::shared_ptr<const TensorField3D> tensorField_;
+    const TensorStorage3D* tensors_;
+    // Direct access for TensorStorageMode::Full, nullptr for the packed modes
+    const dmat3* data_;
+    // nullptr if the field has no mask
+    const glm::uint8* mask_;
+    size3_t maxIndex_;
+    size_t strideY_;
+    size_t strideZ_;
+    dvec3 indexScale_;
+};
 
-        const auto tensorLower = glm::mix(tensorLowerLeft, tensorLowerRight, xFrac);
+template <tensorutil::InterpolationMethod method>
+TensorField3DSampler::Sample TensorField3DSampler::sample(const dvec3& position) const {
+    // Position is in texture space [0,1], translate to index space
+    const auto indexPosition = glm::clamp(position * indexScale_, dvec3(0.0), dvec3(maxIndex_));
 
-        val = glm::mix(tensorLower, tensorUpper, yFrac);
+    if constexpr (method == tensorutil::InterpolationMethod::Nearest) {
+        const auto voxel = size3_t(glm::round(indexPosition));
+        const auto index = voxel.x + voxel.y * strideY_ + voxel.z * strideZ_;
+        if (!isDefined(index)) return {glm::uint8{0}, dmat3(0.0)};
+        return {glm::uint8{1}, tensor(index)};
     } else {
-        if constexpr (method == tensorutil::InterpolationMethod::Nearest) {
-            val = tensorField->at(size3_t(glm::round(indexPosition))).second;
+        const auto lower = size3_t(indexPosition);
+        const auto upper = glm::min(lower + size3_t(1), maxIndex_);
+        const auto frac = indexPosition - dvec3(lower);
+
+        const std::array<size_t, 2> xs{lower.x, upper.x};
+        const std::array<size_t, 2> ys{lower.y * strideY_, upper.y * strideY_};
+        const std::array<size_t, 2> zs{lower.z * strideZ_, upper.z * strideZ_};
+        const std::array<dvec3, 2> weights{dvec3(1.0) - frac, frac};
+
+        dmat3 sum(0.0);
+        double weightSum = 0.0;
+        for (size_t z = 0; z < 2; ++z) {
+            for (size_t y = 0; y < 2; ++y) {
+                for (size_t x = 0; x < 2; ++x) {
+                    const auto weight = weights[x].x * weights[y].y * weights[z].z;
+                    const auto index = xs[x] + ys[y] + zs[z];
+                    if (weight == 0.0 || !isDefined(index)) continue;
+                    sum += weight * tensor(index);
+                    weightSum += weight;
+                }
+            }
         }
+
+        if (weightSum == 0.0) return {glm::uint8{0}, dmat3(0.0)};
+        // Renormalize the weights if some of the voxels are outside the mask
+        return {glm::uint8{1}, mask_ ? sum / weightSum : sum};
     }
-    return std::pair<glm::uint8, dmat3>(glm::uint8{1}, val);
 }
 
 /**
@@ -194,9 +228,25 @@ std::pair<glm::uint8, dmat3> sample(std::shared_ptr<const TensorField3D> tensorF
  * it has a mask defining where it is actually defined and where not. It is 1
  * if there is data at this position and 0 if not. If the mask value is zero,
  * the tensor will be a 0 tensor. If the mask is not set for the tensor field,
- * the mask value return will always be 0.
+ * the mask value returned will always be 1. Use a TensorField3DSampler when sampling
+ * many positions.
+ */
+template <tensorutil::InterpolationMethod method>
+std::pair<glm::uint8, dmat3> sample(const std::shared_ptr<const TensorField3D>& tensorField,
+                                    const dvec3& position) {
+    return TensorField3DSampler(tensorField).sample<method>(position);
+}
+
+/**
+ * Returns a pair of a glm::uint8 and dmat3.
+ * The dmat3 is the tensor. Since the field stores tensors at every position
+ * it has a mask defining where it is actually defined and where not. It is 1
+ * if there is data at this position and 0 if not. If the mask value is zero,
+ * the tensor will be a 0 tensor. If the mask is not set for the tensor field,
+ * the mask value returned will always be 1. Use a TensorField3DSampler when sampling
+ * many positions.
  */
 IVW_MODULE_TENSORVISBASE_API std::pair<glm::uint8, dmat3> sample(
-    std::shared_ptr<const TensorField3D> tensorField, const dvec3& position,
+    const std::shared_ptr<const TensorField3D>& tensorField, const dvec3& position,
     const tensorutil::InterpolationMethod method);
 }  // namespace inviwo
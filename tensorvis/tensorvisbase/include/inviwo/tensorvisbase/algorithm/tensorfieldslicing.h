@@ -46,6 +46,10 @@ IVW_MODULE_TENSORVISBASE_API std::shared_ptr<TensorField3D> getSlice3D(
     const size_t sliceNumber);
 }  // namespace detail
 
+/*
+ * Copies a slice of the tensor field into a new 2D or 3D tensor field. Use a TensorFieldSliceView
+ * to access a slice without copying it.
+ */
 template <unsigned int N>
 auto slice(std::shared_ptr<const TensorField3D> inTensorField, const CartesianCoordinateAxis axis,
            const size_t sliceNumber) {
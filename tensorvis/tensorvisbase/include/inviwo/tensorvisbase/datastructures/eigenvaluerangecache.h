@@ -0,0 +1,69 @@
+#pragma once
+
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/tensorvisbase/tensorvisbasemoduledefine.h>
+#include <inviwo/tensorvisbase/datastructures/tensorfield2d.h>
+#include <inviwo/core/datastructures/image/image.h>
+
+#include <memory>
+
+namespace inviwo {
+
+/*
+ * Value ranges of the eigenvalues of a 2D tensor field and of the anisotropy |major - minor|.
+ * Zero values are ignored for the minimum if there are non-zero values, so that e.g. an empty
+ * background does not flatten the color mapping.
+ */
+struct IVW_MODULE_TENSORVISBASE_API EigenValueRanges {
+    dvec2 major{0.0};
+    dvec2 minor{0.0};
+    dvec2 anisotropy{0.0};
+
+    /*
+     * Computes the ranges of the field resampled to the given resolution, which catches values
+     * between the tensors of the field that show up when it is interpolated for rendering. The
+     * resampling runs on jobs threads, 0 uses the size of the thread pool.
+     */
+    static EigenValueRanges compute(const std::shared_ptr<const TensorField2D> &tensorField,
+                                    const size2_t &resolution, size_t jobs = 0);
+};
+
+/**
+ * \class EigenValueRangeCache
+ * \brief Keeps the eigenvalue ranges and the tensor image of the last 2D tensor field.
+ * Rendering processors only need these to change when the field does, so they are recomputed if
+ * a different field or resolution is requested and are a plain lookup otherwise. The cache does
+ * not keep the field alive.
+ */
+class IVW_MODULE_TENSORVISBASE_API EigenValueRangeCache {
+public:
+    explicit EigenValueRangeCache(size_t jobs = 0) : jobs_(jobs) {}
+
+    const EigenValueRanges &getRanges(const std::shared_ptr<const TensorField2D> &tensorField,
+                                      const size2_t &resolution);
+
+    /*
+     * The tensors of the field as an RGBA image, see TensorField2D::getImageRepresentation.
+     */
+    std::shared_ptr<const Image> getImage(const std::shared_ptr<const TensorField2D> &tensorField);
+
+    void clear();
+
+    /*
+     * Number of times the ranges have been computed so far.
+     */
+    size_t getNumberOfComputations() const { return computations_; }
+
+private:
+    size_t jobs_;
+    size_t computations_{0};
+
+    std::weak_ptr<const TensorField2D> rangesField_;
+    size2_t resolution_{0};
+    EigenValueRanges ranges_;
+
+    std::weak_ptr<const TensorField2D> imageField_;
+    std::shared_ptr<const Image> image_;
+};
+
+}  // namespace inviwo
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/tensorvisbase/tensorvisbasemoduledefine.h>
+#include <inviwo/tensorvisbase/datastructures/tensorglyphinstances.h>
+#include <inviwo/core/datastructures/geometry/basicmesh.h>
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace inviwo {
+
+/**
+ * \class GlyphMeshCache
+ * \brief Least recently used cache of glyph geometry keyed on the glyph shape.
+ * Glyphs are fully described by their type, a few shape parameters (e.g. alpha and beta of a
+ * superquadric or the normalized eigenvalues of a Reynolds glyph), their color and the sphere
+ * resolution. The shape parameters are quantized, so similar tensors share the same geometry.
+ * Orientation, position and size are not part of the geometry but of the basis and world matrix
+ * of the meshes handed out by instantiate(). The cache is bounded by the memory of the cached
+ * meshes, evicting the least recently used geometry first.
+ */
+class IVW_MODULE_TENSORVISBASE_API GlyphMeshCache {
+public:
+    struct Key {
+        TensorGlyphType type;
+        size2_t resolution;
+        std::array<std::int32_t, 4> shape;
+        std::uint32_t color;
+
+        bool operator==(const Key &rhs) const {
+            return type == rhs.type && resolution == rhs.resolution && shape == rhs.shape &&
+                   color == rhs.color;
+        }
+    };
+
+    static constexpr size_t defaultMaxSizeInBytes = 256 * 1024 * 1024;
+    static constexpr double defaultQuantization = 1.0 / 256.0;
+
+    explicit GlyphMeshCache(size_t maxSizeInBytes = defaultMaxSizeInBytes,
+                            double quantization = defaultQuantization);
+
+    /*
+     * Quantizes the shape parameters and the color. Use dequantize to get the shape the geometry
+     * of the key has to be built from, so that the cached geometry does not depend on which
+     * tensor created it first.
+     */
+    Key makeKey(TensorGlyphType type, const size2_t &resolution, const dvec4 &shape,
+                const vec4 &color = vec4(0.0f)) const;
+    dvec4 dequantize(const Key &key) const;
+
+    /*
+     * Returns the cached geometry of the key, calling create on a cache miss. The returned mesh
+     * is shared and must not be modified.
+     */
+    std::shared_ptr<const BasicMesh> get(const Key &key,
+                                         const std::function<std::shared_ptr<BasicMesh>()> &create);
+
+    /*
+     * Creates a mesh sharing the buffers of the cached geometry, with its own basis and world
+     * matrix.
+     */
+    static std::shared_ptr<BasicMesh> instantiate(const BasicMesh &geometry);
+
+    static size_t getSizeInBytes(const BasicMesh &mesh);
+
+    size_t size() const;
+    size_t getSizeInBytes() const;
+    size_t getMaxSizeInBytes() const;
+    void setMaxSizeInBytes(size_t maxSizeInBytes);
+    double getQuantization() const { return quantization_; }
+
+    size_t getHits() const;
+    size_t getMisses() const;
+
+    void clear();
+
+private:
+    struct KeyHash {
+        size_t operator()(const Key &key) const;
+    };
+
+    struct Entry {
+        Key key;
+        std::shared_ptr<const BasicMesh> mesh;
+        size_t sizeInBytes;
+    };
+
+    // Evicts least recently used entries until the cache fits into maxSizeInBytes_
+    void evict();
+
+    mutable std::mutex mutex_;
+    size_t maxSizeInBytes_;
+    double quantization_;
+    size_t sizeInBytes_ = 0;
+    size_t hits_ = 0;
+    size_t misses_ = 0;
+
+    // Most recently used entries first
+    std::list<Entry> entries_;
+    std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> lookup_;
+};
+
+}  // namespace inviwo
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/tensorvisbase/tensorvisbasemoduledefine.h>
+#include <inviwo/tensorvisbase/datastructures/hyperstreamlinetracer.h>
+#include <inviwo/tensorvisbase/datastructures/tensorfield3d.h>
+#include <inviwo/tensorvisbase/algorithm/tensorfieldsampling.h>
+
+#include <array>
+#include <atomic>
+#include <memory>
+
+namespace inviwo {
+
+/**
+ * \class EigenSystemSampler
+ * \brief Samples the eigen decomposition of a 3D tensor field at positions in data space [0,1].
+ * The tensor is interpolated trilinearly and decomposed on every call, which gives the
+ * eigenvectors of all three families at once.
+ */
+class IVW_MODULE_TENSORVISBASE_API EigenSystemSampler {
+public:
+    using EigenSystem = std::array<std::pair<double, dvec3>, 3>;
+
+    explicit EigenSystemSampler(std::shared_ptr<const TensorField3D> tensorField);
+
+    /*
+     * Eigenvalues and eigenvectors sorted by descending eigenvalue, zero outside of the mask of
+     * the field.
+     */
+    EigenSystem sample(const dvec3 &pos) const;
+    bool withinBounds(const dvec3 &pos) const;
+
+    /*
+     * Number of tensors decomposed so far, over all threads.
+     */
+    size_t getNumberOfDecompositions() const { return decompositions_.load(); }
+
+private:
+    TensorField3DSampler sampler_;
+    mutable std::atomic<size_t> decompositions_{0};
+};
+
+/**
+ * \class EigenVectorSampler
+ * \brief Eigenvectors of one family of an EigenSystemSampler, with the sampler interface of
+ * HyperStreamLineTracer::traceWith. Family 0 is the major, 1 the intermediate and 2 the minor
+ * eigenvector.
+ */
+class IVW_MODULE_TENSORVISBASE_API EigenVectorSampler {
+public:
+    EigenVectorSampler(const EigenSystemSampler &sampler, size_t family,
+                       const dvec3 *pinnedPos = nullptr,
+                       const EigenSystemSampler::EigenSystem *pinned = nullptr)
+        : sampler_(&sampler), family_(family), pinnedPos_(pinnedPos), pinned_(pinned) {}
+
+    /*
+     * Samples at the pinned position, if any, use the pinned eigen system instead of the sampler.
+     */
+    dvec3 sample(const dvec3 &pos) const {
+        if (pinned_ && pos == *pinnedPos_) return (*pinned_)[family_].second;
+        return sampler_->sample(pos)[family_].second;
+    }
+    bool withinBounds(const dvec3 &pos) const { return sampler_->withinBounds(pos); }
+
+private:
+    const EigenSystemSampler *sampler_;
+    size_t family_;
+    const dvec3 *pinnedPos_;
+    const EigenSystemSampler::EigenSystem *pinned_;
+};
+
+/**
+ * \class HyperStreamLineFamilyTracer
+ * \brief Traces the major, intermediate and minor hyperstreamlines of a 3D tensor field from
+ * shared seeds in one pass.
+ * All families sample the same EigenSystemSampler, so no eigenvector volumes have to be created
+ * for the individual families. The families are traced one after another and only the
+ * decomposition of the seed is shared, which saves two decompositions per seed. Past the seed
+ * the lines of the families are at different positions and every sample costs one
+ * decomposition, as it would when tracing the families separately.
+ * The step settings of getTracer() apply to all families. Occupancy grids should not be used
+ * since the families would occupy the cells of each other.
+ */
+class IVW_MODULE_TENSORVISBASE_API HyperStreamLineFamilyTracer {
+public:
+    enum class Family { Major = 0, Intermediate = 1, Minor = 2 };
+    using Results = std::array<HyperStreamLineTracer::Result, 3>;
+
+    HyperStreamLineFamilyTracer(std::shared_ptr<const TensorField3D> tensorField,
+                                const IntegralLineProperties &properties);
+
+    /*
+     * Traces the families that are set in families from a seed in the seed space of the
+     * properties. The results are indexed by family, families not traced get empty lines.
+     */
+    Results traceFrom(const dvec3 &pIn, const std::array<bool, 3> &families);
+    Results traceFromDataSpace(const dvec3 &p, const std::array<bool, 3> &families);
+
+    HyperStreamLineTracer &getTracer() { return tracer_; }
+    const EigenSystemSampler &getSampler() const { return sampler_; }
+
+private:
+    std::shared_ptr<const TensorField3D> tensorField_;
+    EigenSystemSampler sampler_;
+    HyperStreamLineTracer tracer_;
+};
+
+}  // namespace inviwo
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/tensorvisbase/tensorvisbasemoduledefine.h>
+
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <memory>
+
+namespace inviwo {
+
+/**
+ * \class HyperStreamLineOccupancyGrid
+ * \brief Regular grid over the data space [0,1]^3 of a sampler that counts the lines passing
+ * through each cell.
+ * A cell is saturated once as many lines as its capacity have entered it. Tracers occupy the
+ * cells along their lines and stop when they would enter a saturated cell, which keeps the lines
+ * evenly spaced. Cells are counted with atomics, so any number of tracers can share a grid
+ * without locking. Which of two competing lines gets a cell then depends on the scheduling of the
+ * threads.
+ */
+class IVW_MODULE_TENSORVISBASE_API HyperStreamLineOccupancyGrid {
+public:
+    static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+    /*
+     * Throws if any dimension or the capacity is zero.
+     */
+    HyperStreamLineOccupancyGrid(const size3_t &dimensions, size_t capacity = 1);
+
+    const size3_t &getDimensions() const { return dimensions_; }
+    size_t getSize() const { return dimensions_.x * dimensions_.y * dimensions_.z; }
+    size_t getCapacity() const { return capacity_; }
+
+    /*
+     * Index of the cell containing the data space position, npos if it is outside of [0,1]^3.
+     */
+    size_t cellIndex(const dvec3 &pos) const;
+    dvec3 cellCenter(size_t cell) const;
+
+    size_t getCount(size_t cell) const { return counts_[cell].load(std::memory_order_relaxed); }
+    bool isSaturated(size_t cell) const { return getCount(cell) >= capacity_; }
+
+    /*
+     * Counts one more line in the cell unless it is saturated. Returns false if the cell was
+     * already saturated. Thread safe.
+     */
+    bool tryOccupy(size_t cell);
+
+    /*
+     * Marks all cells as empty, not thread safe.
+     */
+    void clear();
+
+private:
+    size3_t dimensions_;
+    size_t capacity_;
+    std::unique_ptr<std::atomic<std::uint32_t>[]> counts_;
+};
+
+}  // namespace inviwo
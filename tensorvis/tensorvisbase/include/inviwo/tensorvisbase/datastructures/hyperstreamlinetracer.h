@@ -5,6 +5,10 @@
 #include <modules/vectorfieldvisualization/datastructures/integralline.h>
 #include <modules/vectorfieldvisualization/properties/integrallineproperties.h>
 #include <inviwo/core/util/spatialsampler.h>
+#include <inviwo/tensorvisbase/datastructures/hyperstreamlineoccupancygrid.h>
+
+#include <array>
+#include <limits>
 
 namespace inviwo {
 
@@ -70,13 +74,101 @@ std::tuple<SpatialVector, DataVector, bool> hyperstep(const SpatialVector &oldPo
 
     return {move(oldPos, K, stepSize), k1, flipped};
 }
+
+/*
+ * One Dormand-Prince (RK45) step along an eigenvector field. Eigenvectors have no sign, so every
+ * stage sample is flipped to point the same way as dir, the direction at oldPos. Returns the
+ * fifth-order position, the aligned direction at that position and the distance between the
+ * fifth- and fourth-order positions, which is the error estimate used to adapt the step size.
+ * The direction at the new position is the first stage of the next step.
+ */
+template <typename SpatialVector, typename DataVector, typename Sampler, typename DataMatrix>
+std::tuple<SpatialVector, DataVector, double> adaptiveHyperstep(const SpatialVector &oldPos,
+                                                                const DataVector &dir,
+                                                                double stepSize,
+                                                                const DataMatrix &invBasis,
+                                                                bool normalizeSamples,
+                                                                const Sampler &sampler) {
+    static constexpr double a[6][6] = {
+        {1.0 / 5.0},
+        {3.0 / 40.0, 9.0 / 40.0},
+        {44.0 / 45.0, -56.0 / 15.0, 32.0 / 9.0},
+        {19372.0 / 6561.0, -25360.0 / 2187.0, 64448.0 / 6561.0, -212.0 / 729.0},
+        {9017.0 / 3168.0, -355.0 / 33.0, 46732.0 / 5247.0, 49.0 / 176.0, -5103.0 / 18656.0},
+        {35.0 / 384.0, 0.0, 500.0 / 1113.0, 125.0 / 192.0, -2187.0 / 6784.0, 11.0 / 84.0}};
+    // Difference between the fifth- and fourth-order weights
+    static constexpr double e[7] = {
+        71.0 / 57600.0, 0.0,          -71.0 / 16695.0, 71.0 / 1920.0, -17253.0 / 339200.0,
+        22.0 / 525.0,   -1.0 / 40.0};
+
+    auto sample = [&](const SpatialVector &pos) {
+        DataVector v = sampler.sample(pos);
+        if (glm::dot(v, dir) < 0.0) v = -v;
+        if (normalizeSamples) {
+            const auto l = glm::length(v);
+            if (l != 0.0) v /= l;
+        }
+        return v;
+    };
+
+    std::array<DataVector, 7> k;
+    k[0] = dir;
+    SpatialVector pos = oldPos;
+    for (size_t i = 0; i < 6; ++i) {
+        DataVector v(0.0);
+        for (size_t j = 0; j <= i; ++j) {
+            v += a[i][j] * k[j];
+        }
+        pos = oldPos + SpatialVector(invBasis * (v * stepSize));
+        k[i + 1] = sample(pos);
+    }
+
+    DataVector err(0.0);
+    for (size_t i = 0; i < 7; ++i) {
+        err += e[i] * k[i];
+    }
+
+    return {pos, k[6], glm::length(invBasis * (err * stepSize))};
+}
 }  // namespace detail
 
 class IVW_MODULE_TENSORVISBASE_API HyperStreamLineTracer {
 public:
+    /*
+     * Integration steps taken for one line, in both directions. Samples counts the calls to the
+     * sampler, rejected steps are only taken with an adaptive step size.
+     */
+    struct StepStatistics {
+        size_t acceptedSteps{0};
+        size_t rejectedSteps{0};
+        size_t samples{0};
+        double minStepSize{std::numeric_limits<double>::max()};
+        double maxStepSize{0.0};
+    };
+
+    /*
+     * A cell of the occupancy grid entered by a line, point is the index of the first point of
+     * the line in that cell at the time it was traced.
+     */
+    struct CellEntry {
+        size_t cell;
+        size_t point;
+    };
+    /*
+     * Cells entered while tracing against a frozen occupancy grid, in the order they were
+     * entered. Backward points are indexed before the backward part of the line is reversed.
+     */
+    struct EnteredCells {
+        size_t seed{HyperStreamLineOccupancyGrid::npos};
+        std::vector<CellEntry> backward;
+        std::vector<CellEntry> forward;
+    };
+
     struct Result {
         IntegralLine line;
         size_t seedIndex{0};
+        StepStatistics steps;
+        EnteredCells cells;
         operator IntegralLine() const { return line; }
     };
 
@@ -93,9 +185,32 @@ public:
 
     HyperStreamLineTracer(std::shared_ptr<const SpatialSampler<3, 3, double>> sampler,
                           const IntegralLineProperties &properties);
+    /*
+     * Tracer without a sampler of its own, the entity only provides the transformations. Such a
+     * tracer can only trace with traceWith().
+     */
+    HyperStreamLineTracer(const SpatialEntity<3> &entity, const IntegralLineProperties &properties);
 
+    /*
+     * Traces from a seed given in the seed space of the properties.
+     */
     Result traceFrom(const SpatialVector &pIn);
+    /*
+     * Traces from a seed in the data space of the sampler, e.g. from tensorutil::weightedSeeds.
+     */
+    Result traceFromDataSpace(const SpatialVector &p);
+    /*
+     * Traces from a seed in data space with another sampler. Sampler needs sample(pos), returning
+     * the direction at pos, and withinBounds(pos). Implemented for SpatialSampler<3, 3, double>
+     * and EigenVectorSampler.
+     */
+    template <typename Sampler>
+    Result traceWith(const SpatialVector &p, const Sampler &sampler);
 
+    /*
+     * Samples the given sampler at every point of the traced lines and stores the values as line
+     * metadata with the given name. Adding a sampler with the same name replaces it.
+     */
     void addMetaDataSampler(const std::string &name,
                             std::shared_ptr<const SpatialSampler<3, 3, double>> sampler);
 
@@ -104,12 +219,78 @@ public:
     void setTransformOutputToWorldSpace(bool transform);
     bool isTransformingOutputToWorldSpace() const;
 
+    /*
+     * Use an embedded RK45 (Dormand-Prince) integrator that adapts the step size so that the
+     * estimated error of each step stays below the tolerance, instead of fixed RK4 steps. The
+     * step size of the properties is the initial one, steps are kept within
+     * [stepSize / maxStepFactor, stepSize * maxStepFactor]. The number of steps of the properties
+     * still limits the number of accepted steps.
+     */
+    void setAdaptiveStepSize(bool adaptive);
+    bool isUsingAdaptiveStepSize() const;
+    void setTolerance(double tolerance);
+    double getTolerance() const;
+    void setMaxStepFactor(double factor);
+    double getMaxStepFactor() const;
+
+    /*
+     * Lines occupy the cells of the grid they pass through and end when they would enter a
+     * saturated cell. Seeds in saturated cells give empty lines. The grid may be shared by
+     * tracers on several threads, nullptr disables the occupancy test.
+     */
+    void setOccupancyGrid(std::shared_ptr<HyperStreamLineOccupancyGrid> grid);
+    const std::shared_ptr<HyperStreamLineOccupancyGrid> &getOccupancyGrid() const;
+
+    /*
+     * With a frozen occupancy grid lines only end in cells that are already saturated and do not
+     * occupy any cells themselves, the entered cells are recorded in the result instead. Lines
+     * can then be traced in parallel and handed to commitOccupancy() in seed order, which gives
+     * the same lines as tracing them one after another against the live grid.
+     */
+    void setOccupancyFrozen(bool frozen);
+    bool isOccupancyFrozen() const;
+    /*
+     * Occupies the cells entered by a line traced against the frozen grid and cuts the line
+     * where it enters a cell that has been saturated since, as if it had been traced against the
+     * live grid. Not thread safe, results have to be committed one at a time in seed order.
+     */
+    void commitOccupancy(Result &result) const;
+
 private:
-    bool addPoint(IntegralLine &line, const SpatialVector &pos);
-    bool addPoint(IntegralLine &line, const SpatialVector &pos, const DataVector &worldVelocity);
+    using MetaDataValue = typename SpatialSampler<3, 3, double>::ReturnType;
 
-    IntegralLine::TerminationReason integrate(size_t steps, SpatialVector pos, IntegralLine &line,
-                                              bool fwd);
+    /*
+     * Points of a line while it is traced. Metadata columns are indexed like metaSamplers_, the
+     * columns are moved into the IntegralLine by name once the line is done.
+     */
+    struct LineBuffer {
+        std::vector<dvec3> positions;
+        std::vector<dvec3> velocities;
+        std::vector<std::vector<MetaDataValue>> metaData;
+        size_t cell{HyperStreamLineOccupancyGrid::npos};
+        std::vector<CellEntry> entered;
+
+        void reverse();
+    };
+
+    template <typename Sampler>
+    bool addPoint(LineBuffer &line, const SpatialVector &pos, const Sampler &sampler);
+    /*
+     * Occupies the cell at pos if the line enters a new one, false if that cell is saturated.
+     * With a frozen grid the cell is recorded instead of occupied.
+     */
+    bool enterCell(LineBuffer &line, const SpatialVector &pos);
+    bool addPoint(LineBuffer &line, const SpatialVector &pos, const DataVector &worldVelocity);
+
+    template <typename Sampler>
+    IntegralLine::TerminationReason integrate(size_t steps, SpatialVector pos, LineBuffer &line,
+                                              bool fwd, const Sampler &sampler,
+                                              StepStatistics &stats);
+    template <typename Sampler>
+    IntegralLine::TerminationReason integrateAdaptive(size_t steps, SpatialVector pos,
+                                                      LineBuffer &line, bool fwd,
+                                                      const Sampler &sampler,
+                                                      StepStatistics &stats);
 
     IntegralLineProperties::IntegrationScheme integrationScheme_;
 
@@ -119,13 +300,20 @@ private:
     bool normalizeSamples_;
 
     std::shared_ptr<const SpatialSampler<3, 3, double>> sampler_;
-    std::unordered_map<std::string, std::shared_ptr<const SpatialSampler<3, 3, double>>>
+    std::vector<std::pair<std::string, std::shared_ptr<const SpatialSampler<3, 3, double>>>>
         metaSamplers_;
 
     DataMatrix invBasis_;
     DataHomogenouSpatialMatrixrix seedTransformation_;
     DataHomogenouSpatialMatrixrix toWorld_;
     bool transformOutputToWorldSpace_;
+
+    bool adaptive_;
+    double tolerance_;
+    double maxStepFactor_;
+
+    std::shared_ptr<HyperStreamLineOccupancyGrid> occupancy_;
+    bool occupancyFrozen_;
 };
 
 }  // namespace inviwo
@@ -6,147 +6,141 @@
 #include <inviwo/tensorvisbase/datastructures/tensorfieldmetadata.h>
 #include <inviwo/tensorvisbase/tensorvisbasemoduledefine.h>
 
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <vector>
+
 namespace inviwo {
-using InvariantSpaceAxis = std::vector<glm::f64>;
+/**
+ * \class InvariantSpace
+ * \brief Points in a space spanned by tensor invariants or other tensor features.
+ * All values live in one contiguous block with one column per axis. Axes are therefore
+ * contiguous views and points are strided views into the block, neither copies anything. Adding
+ * points appends to the columns, growing the block geometrically, use reserve() if the number
+ * of points is known up front.
+ */
 struct IVW_MODULE_TENSORVISBASE_API InvariantSpace {
-    InvariantSpace() = default;
-    InvariantSpace(size_t numberOfDimensions, const std::vector<std::string>& identifiers,
-                   const std::vector<TensorFeature>& metaDataTypes);
-    ~InvariantSpace() = default;
-
-    glm::u8 getNumberOfDimensions() const { return static_cast<glm::u8>(data_.size()); }
-
-    size_t getNumElements() const {
-        if (!data_.size())
-            return 0;
-        else
-            return data_[0]->size();
-    }
-    void addAxis(const std::string& identifier, std::vector<double>* data, TensorFeature type) {
-        identifiers_.push_back(identifier);
-        metaDataTypes_.push_back(type);
-
-        auto minmax = std::minmax_element(data->begin(), data->end());
-
-        minmax_.push_back({*minmax.first, *minmax.second});
-
-        data_.push_back(data);
-    }
-
-    template <typename T>
-    void addAxis(const MetaDataType<T>* metaData, const std::string& name = "") {
-        identifiers_.push_back(name.empty() ? metaData->getDisplayName() : name);
-        metaDataTypes_.push_back(metaData->type_);
-        minmax_.push_back({{metaData->getMinMax().first, metaData->getMinMax().second}});
-
-        data_.push_back(new std::vector<T>(metaData->getData()));
-    }
-
-    void addAxes(const InvariantSpace& invariantSpace) {
-        for (int i = 0; i < invariantSpace.getNumberOfDimensions(); ++i) {
-            identifiers_.push_back(invariantSpace.identifiers_[i]);
-            metaDataTypes_.push_back(invariantSpace.metaDataTypes_[i]);
-            minmax_.push_back(invariantSpace.minmax_[i]);
-
-            data_.push_back(new std::vector<double>(invariantSpace.data_[i]->begin(),
-                                                    invariantSpace.data_[i]->end()));
-        }
-    }
-
-    void addAxes(std::shared_ptr<const InvariantSpace> invariantSpace) {
-        for (int i = 0; i < invariantSpace->getNumberOfDimensions(); ++i) {
-            identifiers_.push_back(invariantSpace->identifiers_[i]);
-            metaDataTypes_.push_back(invariantSpace->metaDataTypes_[i]);
-            minmax_.push_back(invariantSpace->minmax_[i]);
-
-            data_.push_back(new std::vector<double>(invariantSpace->data_[i]->begin(),
-                                                    invariantSpace->data_[i]->end()));
-        }
-    }
-
-    void addPoint(const std::vector<double>& v) {
-        if (v.size() != data_.size()) {
-            LogError("Tried to add feature of wrong dimensionality ("
-                     << std::to_string(v.size()) << " instead of " << std::to_string(data_.size())
-                     << ")");
-            return;
-        }
-        size_t i = 0;
-        for (const auto val : v) {
-            data_[i]->push_back(val);
-
-            // update minmax
-            minmax_[i][0] = std::min(minmax_[i][0], val);
-            minmax_[i][1] = std::max(minmax_[i][1], val);
-
-            i++;
-        }
-    }
+    /**
+     * Non-owning view of values that are stride elements apart, i.e. an axis (stride 1) or a
+     * point (stride = capacity) of an invariant space. Invalidated when the space reallocates.
+     */
+    class View {
+    public:
+        class Iterator {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = double;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const double*;
+            using reference = double;
+
+            Iterator(const double* ptr, size_t stride) : ptr_(ptr), stride_(stride) {}
+            double operator*() const { return *ptr_; }
+            Iterator& operator++() {
+                ptr_ += stride_;
+                return *this;
+            }
+            bool operator==(const Iterator& rhs) const { return ptr_ == rhs.ptr_; }
+            bool operator!=(const Iterator& rhs) const { return ptr_ != rhs.ptr_; }
 
-    std::vector<double> getPoint(size_t idx) const {
-        std::vector<double> feature;
+        private:
+            const double* ptr_;
+            size_t stride_;
+        };
 
-        if (!data_.size()) return feature;
-        if (!getNumElements()) return feature;
+        View(const double* data, size_t size, size_t stride)
+            : data_(data), size_(size), stride_(stride) {}
 
-        for (size_t j = 0; j < getNumberOfDimensions(); j++) {
-            feature.push_back((*(data_[j]))[idx]);
-        }
+        size_t size() const { return size_; }
+        bool empty() const { return size_ == 0; }
+        size_t getStride() const { return stride_; }
+        bool isContiguous() const { return stride_ == 1; }
 
-        return feature;
-    }
+        // Points to the first value, the values are getStride() elements apart
+        const double* data() const { return data_; }
+        double operator[](size_t i) const { return data_[i * stride_]; }
 
-    std::vector<double> flatten() const {
-        std::vector<double> flattened;
+        Iterator begin() const { return Iterator(data_, stride_); }
+        Iterator end() const { return Iterator(data_ + size_ * stride_, stride_); }
 
-        if (!data_.size()) return flattened;
-        if (!getNumElements()) return flattened;
+        std::vector<double> toVector() const { return std::vector<double>(begin(), end()); }
 
-        for (size_t i = 0; i < getNumElements(); i++) {
-            for (size_t j = 0; j < getNumberOfDimensions(); j++) {
-                flattened.push_back((*(data_[j]))[i]);
-            }
-        }
+    private:
+        const double* data_;
+        size_t size_;
+        size_t stride_;
+    };
 
-        return flattened;
-    }
+    InvariantSpace() = default;
+    InvariantSpace(size_t numberOfDimensions, const std::vector<std::string>& identifiers,
+                   const std::vector<TensorFeature>& metaDataTypes);
 
-    void clear() { data_.clear(); }
+    glm::u8 getNumberOfDimensions() const { return static_cast<glm::u8>(dimensions_); }
+    size_t getNumElements() const { return size_; }
+    size_t getCapacity() const { return capacity_; }
 
-    void setNumberOfDimensions(size_t n) {
-        if (data_.size() > n) {
-            LogError("Reduction of dimensionality would mean loss of data. Aborting");
-        }
+    /*
+     * Adds an axis with one value per point. The first axis sets the number of points of an
+     * empty space, any other axis needs to have a value for each point.
+     */
+    void addAxis(const std::string& identifier, const std::vector<double>& data,
+                 TensorFeature type);
 
-        data_.resize(n);
-        for (auto& entry : data_) {
-            entry = new InvariantSpaceAxis();
-        }
-    }
+    template <typename T>
+    void addAxis(const MetaDataType<T>* metaData, const std::string& name = "") {
+        const auto& data = metaData->getData();
+        if (!appendColumn(data.begin(), data.end())) return;
 
-    void setNumberOfElements(size_t n) {
-        for (auto axis : data_) {
-            axis->resize(n);
-        }
+        identifiers_.push_back(name.empty() ? metaData->getDisplayName() : name);
+        metaDataTypes_.push_back(metaData->type_);
+        minmax_.push_back({{metaData->getMinMax().first, metaData->getMinMax().second}});
     }
 
-    const std::vector<double>& operator[](size_t idx) const { return *data_[idx]; }
-
-    const std::vector<double>& operator[](int idx) const { return *data_[idx]; }
-
-    /// \returns the begin iterator
-    std::vector<std::vector<double>*>::iterator begin() { return data_.begin(); }
-
-    /// \returns the begin const iterator
-    std::vector<std::vector<double>*>::const_iterator begin() const { return data_.cbegin(); }
-
-    /// \returns the end iterator
-    std::vector<std::vector<double>*>::iterator end() { return data_.end(); }
-
-    /// \returns the end const iterator
-    std::vector<std::vector<double>*>::const_iterator end() const { return data_.cend(); }
-
-    const std::vector<InvariantSpaceAxis*>& data() const { return data_; }
+    void addAxes(const InvariantSpace& invariantSpace);
+    void addAxes(std::shared_ptr<const InvariantSpace> invariantSpace) { addAxes(*invariantSpace); }
+
+    /*
+     * Appends a point, which needs one value per axis. The values must not be a view of this
+     * space since adding may reallocate.
+     */
+    void addPoint(const std::vector<double>& v) { addPoint(View(v.data(), v.size(), 1)); }
+    void addPoint(const View& v);
+
+    /*
+     * Strided view of the values of the point at idx, one per axis.
+     */
+    View getPoint(size_t idx) const { return View(data_.data() + idx, dimensions_, capacity_); }
+    View getAxis(size_t idx) const { return View(column(idx), size_, 1); }
+
+    /*
+     * All points one after the other (row-major), e.g. for clustering.
+     */
+    std::vector<double> flatten() const;
+
+    /*
+     * Makes room for n points without reallocating.
+     */
+    void reserve(size_t n);
+
+    /*
+     * Removes all points and resets the ranges, the axes are kept.
+     */
+    void clear();
+
+    /*
+     * Adds empty axes up to n dimensions, reducing the dimensionality is not supported.
+     */
+    void setNumberOfDimensions(size_t n);
+    /*
+     * Resizes all axes to n points, new values are zero.
+     */
+    void setNumberOfElements(size_t n);
+
+    View operator[](size_t idx) const { return getAxis(idx); }
+    View operator[](int idx) const { return getAxis(static_cast<size_t>(idx)); }
 
     const auto& getIdentifier(size_t index) const { return identifiers_[index]; }
     const auto& getIdentifiers() const { return identifiers_; }
@@ -160,12 +154,43 @@ struct IVW_MODULE_TENSORVISBASE_API InvariantSpace {
     std::string getDataInfo() const;
 
 private:
-    std::vector<InvariantSpaceAxis*> data_;
+    const double* column(size_t idx) const { return data_.data() + idx * capacity_; }
+    double* column(size_t idx) { return data_.data() + idx * capacity_; }
+
+    // Moves the columns into a block with room for capacity points per axis
+    void reallocate(size_t capacity);
+
+    template <typename It>
+    bool appendColumn(It begin, It end);
+
+    // Column-major, axis i occupies [i * capacity_, i * capacity_ + size_)
+    std::vector<double> data_;
+    size_t dimensions_{0};
+    size_t size_{0};
+    size_t capacity_{0};
+
     std::vector<std::string> identifiers_;
     std::vector<TensorFeature> metaDataTypes_;
     std::vector<std::array<glm::f64, 2>> minmax_;
 };
 
+template <typename It>
+bool InvariantSpace::appendColumn(It begin, It end) {
+    const auto size = static_cast<size_t>(std::distance(begin, end));
+    if (dimensions_ == 0) {
+        size_ = size;
+        capacity_ = size;
+    } else if (size != size_) {
+        LogError("Tried to add axis with " << size << " instead of " << size_ << " values");
+        return false;
+    }
+
+    data_.resize((dimensions_ + 1) * capacity_);
+    std::copy(begin, end, column(dimensions_));
+    ++dimensions_;
+    return true;
+}
+
 /**
  * \ingroup ports
  */
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/tensorvisbase/tensorvisbasemoduledefine.h>
+#include <inviwo/tensorvisbase/datastructures/tensorfieldmetadata.h>
+#include <inviwo/core/datastructures/buffer/buffer.h>
+#include <inviwo/core/datastructures/volume/volumeram.h>
+#include <inviwo/core/util/exception.h>
+
+#include <type_traits>
+
+namespace inviwo {
+
+/*
+ * Scalar precision of a MetaDataColumnView. Float32 halves the memory footprint and matches what
+ * the GPU side (volumes, buffers and data frames) consumes anyway.
+ */
+enum class MetaDataPrecision { Float32, Float64 };
+
+template <class Elem, class Traits>
+std::basic_ostream<Elem, Traits> &operator<<(std::basic_ostream<Elem, Traits> &os,
+                                             MetaDataPrecision precision) {
+    switch (precision) {
+        case MetaDataPrecision::Float32:
+            os << "Float32";
+            break;
+        case MetaDataPrecision::Float64:
+            os << "Float64";
+            break;
+    }
+
+    return os;
+}
+
+/**
+ * \class MetaDataColumnView
+ * \brief Non-owning view of a contiguous column of tensor feature values.
+ * A column holds size() elements with getNumberOfComponents() interleaved float or double
+ * scalars each, i.e. the same layout as a std::vector<dvec3> or a float volume. Views can be
+ * created from the metadata of a TensorField3D or from any raw pointer without copying anything.
+ */
+class IVW_MODULE_TENSORVISBASE_API MetaDataColumnView {
+public:
+    MetaDataColumnView(const void *data, size_t size, size_t numberOfComponents,
+                       MetaDataPrecision precision);
+
+    /*
+     * Views the data of a metadata container, throws if the container does not hold floating
+     * point data.
+     */
+    static MetaDataColumnView fromMetaData(const MetaDataBase &metaData);
+
+    const void *getDataPtr() const { return data_; }
+
+    template <typename T>
+    const T *data() const;
+
+    size_t size() const { return size_; }
+    size_t getNumberOfComponents() const { return numberOfComponents_; }
+    size_t getNumberOfScalars() const { return size_ * numberOfComponents_; }
+    MetaDataPrecision getPrecision() const { return precision_; }
+    size_t getSizeInBytes() const;
+
+    const DataFormatBase *getDataFormat() const;
+
+    /*
+     * Converts the column into dst, which has to hold getNumberOfScalars() values of the given
+     * precision. Falls back to a plain memory copy if the precision matches.
+     */
+    void copyTo(void *dst, MetaDataPrecision precision) const;
+
+private:
+    const void *data_;
+    size_t size_;
+    size_t numberOfComponents_;
+    MetaDataPrecision precision_;
+};
+
+template <typename T>
+const T *MetaDataColumnView::data() const {
+    static_assert(std::is_same<T, float>::value || std::is_same<T, double>::value,
+                  "MetaDataColumnView only holds float or double scalars");
+    if ((precision_ == MetaDataPrecision::Float32) != std::is_same<T, float>::value) {
+        throw Exception("Requested scalar type does not match the column precision.",
+                        IVW_CONTEXT_CUSTOM("MetaDataColumnView"));
+    }
+    return static_cast<const T *>(data_);
+}
+
+namespace util {
+
+/*
+ * Creates representations holding the data of the column with the requested precision. Inviwo
+ * representations own their memory, so this amounts to a single bulk copy (or conversion)
+ * instead of per element access through the representation.
+ */
+IVW_MODULE_TENSORVISBASE_API std::shared_ptr<BufferRAM> createBufferRAM(
+    const MetaDataColumnView &column, MetaDataPrecision precision);
+
+IVW_MODULE_TENSORVISBASE_API std::shared_ptr<BufferBase> createBuffer(
+    const MetaDataColumnView &column, MetaDataPrecision precision);
+
+IVW_MODULE_TENSORVISBASE_API std::shared_ptr<VolumeRAM> createVolumeRAM(
+    const MetaDataColumnView &column, const size3_t &dimensions, MetaDataPrecision precision);
+
+}  // namespace util
+
+}  // namespace inviwo
@@ -41,6 +41,9 @@
 #include <inviwo/tensorvisbase/util/tensorutil.h>
 #include <inviwo/core/util/indexmapper.h>
 
+#include <atomic>
+#include <mutex>
+
 namespace inviwo {
 /**
  * \class TensorField2D
@@ -85,6 +88,9 @@ public:
     // Destructors
     virtual ~TensorField2D() = default;
 
+    TensorField2D(const TensorField2D &tf);
+    TensorField2D &operator=(const TensorField2D &) = delete;
+
     std::string getDataInfo() const;
     std::shared_ptr<Image> getImageRepresentation() const;
 
@@ -114,11 +120,11 @@ public:
 
     template <typename T = double>
     T getMinorEigenValue(const size_t index) const {
-        return T(minorEigenValues_[index]);
+        return T(minorEigenValues()[index]);
     }
     template <typename T = double>
     T getMajorEigenValue(const size_t index) const {
-        return T(majorEigenValues_[index]);
+        return T(majorEigenValues()[index]);
     }
 
     dmat2 getBasis() const;
@@ -149,13 +155,18 @@ public:
     std::array<dvec2, 2> getSortedEigenVectorsForTensor(const size2_t &pos) const;
 
 private:
-    void computeEigenValuesAndEigenVectors();
+    /*
+     * The eigen decomposition is computed on first access to any of the eigenvalues or
+     * eigenvectors, unless it was handed to the constructor.
+     */
+    void ensureEigenDecomposition() const;
+    void computeEigenValuesAndEigenVectors() const;
     void computeNormalizedScreenCoordinates();
 
-    std::vector<dvec2> majorEigenVectors_;
-    std::vector<dvec2> minorEigenVectors_;
-    std::vector<double> majorEigenValues_;
-    std::vector<double> minorEigenValues_;
+    mutable std::vector<dvec2> majorEigenVectors_;
+    mutable std::vector<dvec2> minorEigenVectors_;
+    mutable std::vector<double> majorEigenValues_;
+    mutable std::vector<double> minorEigenValues_;
     std::vector<dvec2> normalizedImagePositions_;
     std::vector<dvec2> coordinates_;
     size2_t dimensions_;
@@ -166,6 +177,9 @@ private:
     glm::u8 dimensionality_;
     util::IndexMapper2D indexMapper_;
     std::vector<dmat2> tensors_;
+
+    mutable std::mutex eigenDecompositionMutex_;
+    mutable std::atomic<bool> hasEigenDecomposition_{false};
 };
 
 }  // namespace inviwo
@@ -6,10 +6,13 @@
 #include <inviwo/core/datastructures/image/image.h>
 #include <inviwo/core/util/indexmapper.h>
 #include <inviwo/tensorvisbase/datastructures/tensorfieldmetadata.h>
+#include <inviwo/tensorvisbase/datastructures/tensorstorage.h>
 #include <inviwo/tensorvisbase/tensorvisbasemoduledefine.h>
 #include <inviwo/tensorvisbase/util/tensorutil.h>
 #include <Eigen/Dense>
 #include <unordered_map>
+#include <mutex>
+#include <atomic>
 #include <inviwo/core/datastructures/spatialdata.h>
 
 namespace inviwo {
@@ -27,6 +30,8 @@ public:
 
     TensorField3D(size_t x, size_t y, size_t z, std::vector<dmat3> data,
                   const vec3 &extent = vec3(1.0f), float sliceCoord = 0.0f);
+    TensorField3D(size3_t dimensions, TensorStorage3D data, const vec3 &extent = vec3(1.0f),
+                  float sliceCoord = 0.0f);
     TensorField3D(size3_t dimensions, std::vector<dmat3> data,
                   const std::vector<double> &majorEigenvalues,
                   const std::vector<double> &middleEigenvalues,
@@ -50,7 +55,8 @@ public:
     TensorField3D(size_t x, size_t y, size_t z, const std::vector<double> &data,
                   const vec3 &extent = vec3(1.0f), float sliceCoord = 0.0f);
 
-    // The pointer that is handed in should point to the data that will be copied.
+    // The pointer that is handed in should point to the data that will be copied, 9 values per
+    // tensor in column-major order. To avoid the copy, adopt the memory with a TensorStorage3D.
     TensorField3D(size3_t dimensions, const double *data, const vec3 &extent = vec3(1.0f),
                   float sliceCoord = 0.0f);
     TensorField3D(size3_t dimensions, const float *data, const vec3 &extent = vec3(1.0f),
@@ -76,13 +82,21 @@ public:
     TensorField3D(size3_t dimensions, std::vector<dmat3> data,
                   const std::unordered_map<uint64_t, std::unique_ptr<MetaDataBase>> &metaData,
                   const vec3 &extent = vec3(1.0f), float sliceCoord = 0.0f);
+    TensorField3D(size3_t dimensions, TensorStorage3D data,
+                  const std::unordered_map<uint64_t, std::unique_ptr<MetaDataBase>> &metaData,
+                  const vec3 &extent = vec3(1.0f), float sliceCoord = 0.0f);
+    // Takes over the metadata instead of cloning it
+    TensorField3D(size3_t dimensions, TensorStorage3D data,
+                  std::unordered_map<uint64_t, std::unique_ptr<MetaDataBase>> &&metaData,
+                  const vec3 &extent = vec3(1.0f), float sliceCoord = 0.0f);
 
     TensorField3D &operator=(const TensorField3D &) = delete;
 
     // Destructors
     virtual ~TensorField3D() = default;
 
-    // Copying and Cloning
+    // Copying and Cloning. Copies share the tensors and the metadata with the original, see
+    // TensorStorage3D, so they are cheap to make even for large fields.
     TensorField3D(const TensorField3D &tf);
     virtual TensorField3D *clone() const final;
 
@@ -96,8 +110,10 @@ public:
      * if there is data at this position and 0 if not. If the mask value is zero,
      * the tensor will be a 0 tensor. If the mask is not set for the tensor field,
      * the mask value return will always be 0.
+     * The tensor is returned by value, so reading works for all storage modes and neither
+     * copies nor converts the tensor storage. Use tensors() for bulk access.
      */
-    std::pair<glm::uint8, dmat3 &> at(size3_t position);
+    std::pair<glm::uint8, dmat3> at(size3_t position) const;
     /*
      * Returns a pair of a glm::uint8 and dmat3.
      * The dmat3 is the tensor. Since the field stores tensors at every position
@@ -106,7 +122,7 @@ public:
      * the tensor will be a 0 tensor. If the mask is not set for the tensor field,
      * the mask value return will always be 0.
      */
-    std::pair<glm::uint8, dmat3 &> at(size_t x, const size_t y, const size_t z);
+    std::pair<glm::uint8, dmat3> at(size_t x, size_t y, size_t z) const;
     /*
      * Returns a pair of a glm::uint8 and dmat3.
      * The dmat3 is the tensor. Since the field stores tensors at every position
@@ -115,35 +131,7 @@ public:
      * the tensor will be a 0 tensor. If the mask is not set for the tensor field,
      * the mask value return will always be 0.
      */
-    std::pair<glm::uint8, dmat3 &> at(size_t index);
-
-    /*
-     * Returns a pair of a glm::uint8 and dmat3.
-     * The dmat3 is the tensor. Since the field stores tensors at every position
-     * it has a mask defining where it is actually defined and where not. It is 1
-     * if there is data at this position and 0 if not. If the mask value is zero,
-     * the tensor will be a 0 tensor. If the mask is not set for the tensor field,
-     * the mask value return will always be 0.
-     */
-    std::pair<glm::uint8, const dmat3 &> at(size3_t position) const;
-    /*
-     * Returns a pair of a glm::uint8 and dmat3.
-     * The dmat3 is the tensor. Since the field stores tensors at every position
-     * it has a mask defining where it is actually defined and where not. It is 1
-     * if there is data at this position and 0 if not. If the mask value is zero,
-     * the tensor will be a 0 tensor. If the mask is not set for the tensor field,
-     * the mask value return will always be 0.
-     */
-    std::pair<glm::uint8, const dmat3 &> at(size_t x, size_t y, size_t z) const;
-    /*
-     * Returns a pair of a glm::uint8 and dmat3.
-     * The dmat3 is the tensor. Since the field stores tensors at every position
-     * it has a mask defining where it is actually defined and where not. It is 1
-     * if there is data at this position and 0 if not. If the mask value is zero,
-     * the tensor will be a 0 tensor. If the mask is not set for the tensor field,
-     * the mask value return will always be 0.
-     */
-    std::pair<glm::uint8, const dmat3 &> at(size_t index) const;
+    std::pair<glm::uint8, dmat3> at(size_t index) const;
 
     size3_t getDimensions() const final { return dimensions_; }
 
@@ -177,15 +165,15 @@ public:
 
     template <typename T = double>
     T getMajorEigenValue(const size_t index) const {
-        return T(getMetaData<MajorEigenValues>()[index]);
+        return T(majorEigenValues()[index]);
     }
     template <typename T = double>
     T getMiddleEigenValue(const size_t index) const {
-        return T(getMetaData<IntermediateEigenValues>()[index]);
+        return T(middleEigenValues()[index]);
     }
     template <typename T = double>
     T getMinorEigenValue(const size_t index) const {
-        return T(getMetaData<MinorEigenValues>()[index]);
+        return T(minorEigenValues()[index]);
     }
 
     mat4 getBasisAndOffset() const;
@@ -207,7 +195,14 @@ public:
     const std::vector<double> &middleEigenValues() const;
     const std::vector<double> &minorEigenValues() const;
 
-    const std::vector<dmat3> &tensors() const;
+    const TensorStorage3D &tensors() const;
+
+    TensorStorageMode getStorageMode() const { return tensors_.getMode(); }
+    /*
+     * Converts the tensors to the given storage mode. Converting to one of the symmetric modes
+     * drops the anti-symmetric part of the tensors.
+     */
+    void setStorageMode(TensorStorageMode mode);
 
     void setMask(const std::vector<glm::uint8> &mask) { binaryMask_ = mask; }
     const std::vector<glm::uint8> &getMask() const { return binaryMask_; }
@@ -219,101 +214,130 @@ public:
     int getNumDefinedEntries() const;
 
     /*
-     * 0 = major, 1 = middle, 2 = minor
-     */
-    std::array<DataMapper, 3> dataMapEigenValues_;
-    /*
-     * 0 = major, 1 = middle, 2 = minor
+     * Data maps for the eigenvalues and eigenvectors, 0 = major, 1 = middle, 2 = minor.
+     * Computed from the eigen decomposition on first access unless set explicitly.
      */
-    std::array<DataMapper, 3> dataMapEigenVectors_;
+    const std::array<DataMapper, 3> &dataMapEigenValues() const;
+    const std::array<DataMapper, 3> &dataMapEigenVectors() const;
+    void setDataMapEigenValues(const std::array<DataMapper, 3> &dataMaps);
+    void setDataMapEigenVectors(const std::array<DataMapper, 3> &dataMaps);
 
     bool hasMask() const { return binaryMask_.size() == size_; }
 
     const util::IndexMapper3D &indexMapper() const { return indexMapper_; }
 
+    /*
+     * Returns true if the metadata is either stored in the field or can be computed on demand.
+     * The eigen decomposition (eigenvalues and eigenvectors) as well as the invariants I1, I2, I3,
+     * J1, J2, J3 and the Lode angle are computed from the tensors on first access.
+     */
     template <typename T>
     bool hasMetaData() const {
-        return metaData_.find(T::id()) != std::end(metaData_);
+        return hasMetaData(T::id());
     }
     bool hasMetaData(TensorFeature feature) const;
     bool hasMetaData(const uint64_t id) const;
 
+    /*
+     * Returns true if the metadata has already been computed or added, i.e. accessing it will
+     * not trigger any computation.
+     */
+    bool isMetaDataComputed(const uint64_t id) const;
+
     // Returns a reference to the actual data
     template <typename T>
     const typename T::DataType &getMetaData() const {
-        const auto it = metaData_.find(T::id());
-        if (it == metaData_.end()) {
-            throw Exception("Could not locate metadata for ID " + std::to_string(T::id()));
-        }
-        const auto ptr = static_cast<const T *>(it->second.get());
-        return ptr->data_;
+        return getMetaDataContainer<T>()->data_;
     }
 
     // returns a pointer to the MetaDataType object
     template <typename T>
     auto getMetaDataContainer() const {
-        const auto it = metaData_.find(T::id());
-        if (it == metaData_.end()) {
-            throw Exception("Could not locate metadata for ID " + std::to_string(T::id()));
-        }
-        return static_cast<const T *>(it->second.get());
+        return static_cast<const T *>(getMetaDataContainer(T::id()));
     }
 
     // Returns a pointer to the actual data
     template <typename T>
     auto getMetaDataPtr() const {
-        const auto it = metaData_.find(T::id());
-        if (it == metaData_.end()) {
-            throw Exception("Could not locate metadata for ID " + std::to_string(T::id()));
-        }
-        const auto ptr = static_cast<const T *>(it->second.get());
-        return &(ptr->data_);
+        return &(getMetaDataContainer<T>()->data_);
     }
 
-    auto getMetaDataContainer(const uint64_t id) const {
-        const auto it = metaData_.find(id);
-        if (it == metaData_.end()) {
-            throw Exception("Could not locate metadata for ID " + std::to_string(id));
-        }
-        return it->second.get();
-    }
+    const MetaDataBase *getMetaDataContainer(const uint64_t id) const;
 
     template <typename T, typename S>
     void addMetaData(const S &data, TensorFeature type) {
-        auto metaData = std::make_unique<T>(data, type);
-        metaData_.insert(std::make_pair(T::id(), std::move(metaData)));
+        addMetaData(T::id(), std::make_unique<T>(data, type));
     }
 
     template <typename T, typename S>
     void addMetaData(const uint64_t id, const S &data, TensorFeature type) {
-        auto metaData = std::make_unique<T>(data, type);
-        metaData_.insert(std::make_pair(id, std::move(metaData)));
+        addMetaData(id, std::make_unique<T>(data, type));
     }
 
+    /*
+     * Removes the metadata. The eigenvalues and eigenvectors cannot be removed once available,
+     * since references to them are handed out by the eigen accessors, and throw an Exception.
+     */
     template <typename T>
     void removeMetaData() {
-        if (hasMetaData<T>()) {
-            metaData_.erase(T::id());
-        }
+        removeMetaData(T::id());
     }
+    void removeMetaData(uint64_t id);
 
-    const std::unordered_map<uint64_t, std::unique_ptr<MetaDataBase>> &metaData() const {
-        return metaData_;
-    }
+    /*
+     * Adds the metadata using its own id, replacing existing metadata with the same id. The
+     * eigenvalues and eigenvectors can only be added while not yet available, replacing them
+     * throws an Exception.
+     */
+    void addMetaData(std::unique_ptr<MetaDataBase> metaData);
+
+    /*
+     * Returns a snapshot of the metadata that has been computed or added so far. Lazily computed
+     * metadata that has not been accessed yet is not part of the map. The snapshot is taken under
+     * the metadata lock and shares the entries with the field, so it is safe to iterate while
+     * other threads access the field.
+     */
+    std::unordered_map<uint64_t, std::shared_ptr<const MetaDataBase>> metaData() const;
 
 protected:
-    void computeEigenValuesAndEigenVectors();
+    struct EigenDecomposition {
+        std::array<const std::vector<double> *, 3> eigenValues;
+        std::array<const std::vector<dvec3> *, 3> eigenVectors;
+    };
+    /*
+     * Returns the eigen decomposition, computing it if necessary. Once available this only costs
+     * an atomic load, which makes it suitable for per-tensor accessors called in parallel loops.
+     * The eigen metadata is never replaced or removed afterwards, so the pointers stay valid for
+     * the lifetime of the field.
+     */
+    const EigenDecomposition &eigenDecomposition() const;
+
+    void addMetaData(uint64_t id, std::unique_ptr<MetaDataBase> metaData);
+
+    // The following need to be called with metaDataMutex_ locked
+    void computeEigenValuesAndEigenVectors() const;
+    void computeInvariant(uint64_t id) const;
+    void computeDataMaps() const;
+
     void computeNormalizedScreenCoordinates(double sliceCoord);
-    void computeDataMaps();
 
     size3_t dimensions_;
     util::IndexMapper3D indexMapper_;
-    std::vector<dmat3> tensors_;
+    TensorStorage3D tensors_;
     size_t size_;
     glm::u8 rank_;
     glm::u8 dimensionality_;
     std::vector<vec3> normalizedVolumePositions_;
-    std::unordered_map<uint64_t, std::unique_ptr<MetaDataBase>> metaData_;
+    // Metadata is immutable once added, so copies of the field share it
+    mutable std::unordered_map<uint64_t, std::shared_ptr<const MetaDataBase>> metaData_;
+    mutable std::recursive_mutex metaDataMutex_;
+    mutable EigenDecomposition eigenDecomposition_;
+    mutable std::atomic<bool> hasEigenDecomposition_{false};
+
+    mutable std::array<DataMapper, 3> dataMapEigenValues_;
+    mutable std::array<DataMapper, 3> dataMapEigenVectors_;
+    mutable bool hasDataMapEigenValues_ = false;
+    mutable bool hasDataMapEigenVectors_ = false;
 
     std::vector<glm::uint8> binaryMask_;
 };
@@ -4,9 +4,11 @@
 #include <inviwo/core/util/formats.h>
 #include <inviwo/core/util/enumtraits.h>
 #include <inviwo/tensorvisbase/util/tensorutil.h>
-#include <modules/base/algorithm/dataminmax.h>
+#include <inviwo/tensorvisbase/util/datareductions.h>
 
 #include <algorithm>
+#include <atomic>
+#include <memory>
 #include <utility>
 #include <sstream>
 
@@ -149,10 +151,36 @@ struct MetaDataBase {
 
     virtual size_t getNumberOfComponents() const = 0;
 
+    virtual size_t getNumberOfElements() const = 0;
+
+    virtual const DataFormatBase *getDataFormat() const = 0;
+
     virtual std::string getDisplayName() const = 0;
 
+    virtual TensorFeature getTensorFeature() const = 0;
+
     virtual const void *getDataPtr() const = 0;
 
+    /*
+     * Returns the min, max and mean of the data. The statistics are computed in parallel on first
+     * use and cached until the data is changed through allocate() or deserialize(). Call
+     * invalidateStatistics() after modifying the data directly.
+     */
+    virtual std::shared_ptr<const tensorutil::DataStatistics> getStatistics() const = 0;
+    virtual void invalidateStatistics() = 0;
+
+    /*
+     * Resizes the container to numElements elements and returns a pointer to the data, which can
+     * then be filled in directly, e.g. when reading the metadata from file.
+     */
+    virtual void *allocate(size_t numElements, TensorFeature type) = 0;
+
+    /*
+     * Returns new metadata of the same type holding rowLength consecutive elements starting at
+     * each of the row starts, e.g. the elements of a slice or a sub-box of the tensor field.
+     */
+    virtual MetaDataBase *gather(const std::vector<size_t> &rowStarts, size_t rowLength) const = 0;
+
     // Serialization
     virtual void serialize(std::ofstream &outFile) const = 0;
 
@@ -171,8 +199,11 @@ struct MetaDataType : MetaDataBase {
     ~MetaDataType() override = default;
 
     virtual MetaDataType<T> *clone() const override = 0;
+    // Creates metadata of the same type and feature holding the given data
+    virtual MetaDataType<T> *create(DataType data) const = 0;
 
     // Getters
+    // Uses the cached statistics, see getStatistics()
     std::pair<TType, TType> getMinMax() const;
 
     std::string getDisplayName() const override {
@@ -183,12 +214,26 @@ struct MetaDataType : MetaDataBase {
 
     size_t getNumberOfComponents() const override;
 
+    size_t getNumberOfElements() const override { return data_.size(); }
+
+    const DataFormatBase *getDataFormat() const override { return DataFormat<T>::get(); }
+
     const std::vector<T> &getData() const;
 
     uint64_t getId() const override = 0;
 
+    TensorFeature getTensorFeature() const override { return type_; }
+
     const void *getDataPtr() const override;
 
+    std::shared_ptr<const tensorutil::DataStatistics> getStatistics() const override;
+    void invalidateStatistics() override;
+
+    void *allocate(size_t numElements, TensorFeature type) override;
+
+    MetaDataType<T> *gather(const std::vector<size_t> &rowStarts,
+                            size_t rowLength) const override;
+
     // Serialization
     void serialize(std::ofstream &outFile) const override;
 
@@ -196,6 +241,10 @@ struct MetaDataType : MetaDataBase {
 
     DataType data_;
     TensorFeature type_ = TensorFeature::NumberOfTensorFeatures;
+
+private:
+    // Only accessed through std::atomic_load and std::atomic_store
+    mutable std::shared_ptr<const tensorutil::DataStatistics> statistics_;
 };
 
 template <typename T>
@@ -210,6 +259,7 @@ void MetaDataType<T>::serialize(std::ofstream &outFile) const {
 
 template <typename T>
 void MetaDataType<T>::deserialize(std::ifstream &inFile, const size_t numElements) {
+    invalidateStatistics();
     data_.resize(numElements);
     auto data = data_.data();
 
@@ -220,9 +270,26 @@ void MetaDataType<T>::deserialize(std::ifstream &inFile, const size_t numElement
 template <typename T>
 std::pair<typename MetaDataType<T>::TType, typename MetaDataType<T>::TType>
 MetaDataType<T>::getMinMax() const {
-    auto minmax = util::dataMinMax(data_.data(), data_.size());
-    return std::make_pair(util::glm_convert<MetaDataType<T>::TType>(minmax.first),
-                          util::glm_convert<MetaDataType<T>::TType>(minmax.second));
+    const auto statistics = getStatistics();
+    return std::make_pair(util::glm_convert<MetaDataType<T>::TType>(statistics->min),
+                          util::glm_convert<MetaDataType<T>::TType>(statistics->max));
+}
+
+template <typename T>
+std::shared_ptr<const tensorutil::DataStatistics> MetaDataType<T>::getStatistics() const {
+    auto statistics = std::atomic_load(&statistics_);
+    if (!statistics) {
+        // Concurrent callers might both compute the statistics, which is harmless
+        statistics = std::make_shared<const tensorutil::DataStatistics>(
+            tensorutil::computeStatistics(data_.data(), data_.size()));
+        std::atomic_store(&statistics_, statistics);
+    }
+    return statistics;
+}
+
+template <typename T>
+void MetaDataType<T>::invalidateStatistics() {
+    std::atomic_store(&statistics_, std::shared_ptr<const tensorutil::DataStatistics>{});
 }
 
 template <typename T>
@@ -239,6 +306,25 @@ const void *MetaDataType<T>::getDataPtr() const {
     return data_.data();
 }
 
+template <typename T>
+void *MetaDataType<T>::allocate(const size_t numElements, const TensorFeature type) {
+    invalidateStatistics();
+    type_ = type;
+    data_.resize(numElements);
+    return data_.data();
+}
+
+template <typename T>
+MetaDataType<T> *MetaDataType<T>::gather(const std::vector<size_t> &rowStarts,
+                                         const size_t rowLength) const {
+    DataType data(rowStarts.size() * rowLength);
+    auto dst = data.begin();
+    for (const auto start : rowStarts) {
+        dst = std::copy_n(data_.begin() + start, rowLength, dst);
+    }
+    return create(std::move(data));
+}
+
 template <typename T>
 size_t MetaDataType<T>::getNumberOfComponents() const {
     return util::extent<MetaDataType<T>::TType>::value;
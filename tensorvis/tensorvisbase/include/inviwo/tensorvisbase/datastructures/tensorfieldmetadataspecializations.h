@@ -5,9 +5,11 @@
 struct I1 : public MetaDataType<glm::f64> {
     I1() = default;
 
-    explicit I1(const std::vector<double>& data, TensorFeature type) : MetaDataType(data, type){};
+    explicit I1(std::vector<double> data, TensorFeature type)
+        : MetaDataType(std::move(data), type){};
 
     I1* clone() const final { return new I1(data_, type_); }
+    I1* create(DataType data) const final { return new I1(std::move(data), type_); }
 
     uint64_t getId() const final { return id(); }
 
@@ -17,9 +19,11 @@ struct I1 : public MetaDataType<glm::f64> {
 struct I2 : MetaDataType<glm::f64> {
     I2() = default;
 
-    explicit I2(const std::vector<double>& data, TensorFeature type) : MetaDataType(data, type){};
+    explicit I2(std::vector<double> data, TensorFeature type)
+        : MetaDataType(std::move(data), type){};
 
     I2* clone() const final { return new I2(data_, type_); }
+    I2* create(DataType data) const final { return new I2(std::move(data), type_); }
 
     uint64_t getId() const final { return id(); }
 
@@ -29,9 +33,11 @@ struct I2 : MetaDataType<glm::f64> {
 struct I3 : MetaDataType<glm::f64> {
     I3() = default;
 
-    explicit I3(const std::vector<double>& data, TensorFeature type) : MetaDataType(data, type){};
+    explicit I3(std::vector<double> data, TensorFeature type)
+        : MetaDataType(std::move(data), type){};
 
     I3* clone() const final { return new I3(data_, type_); }
+    I3* create(DataType data) const final { return new I3(std::move(data), type_); }
 
     uint64_t getId() const final { return id(); }
 
@@ -41,9 +47,11 @@ struct I3 : MetaDataType<glm::f64> {
 struct J1 : MetaDataType<glm::f64> {
     J1() = default;
 
-    explicit J1(const std::vector<double>& data, TensorFeature type) : MetaDataType(data, type){};
+    explicit J1(std::vector<double> data, TensorFeature type)
+        : MetaDataType(std::move(data), type){};
 
     J1* clone() const final { return new J1(data_, type_); }
+    J1* create(DataType data) const final { return new J1(std::move(data), type_); }
 
     uint64_t getId() const final { return id(); }
 
@@ -53,9 +61,11 @@ struct J1 : MetaDataType<glm::f64> {
 struct J2 : MetaDataType<glm::f64> {
     J2() = default;
 
-    explicit J2(const std::vector<double>& data, TensorFeature type) : MetaDataType(data, type){};
+    explicit J2(std::vector<double> data, TensorFeature type)
+        : MetaDataType(std::move(data), type){};
 
     J2* clone() const final { return new J2(data_, type_); }
+    J2* create(DataType data) const final { return new J2(std::move(data), type_); }
 
     uint64_t getId() const final { return id(); }
 
@@ -65,9 +75,11 @@ struct J2 : MetaDataType<glm::f64> {
 struct J3 : MetaDataType<glm::f64> {
     J3() = default;
 
-    explicit J3(const std::vector<double>& data, TensorFeature type) : MetaDataType(data, type){};
+    explicit J3(std::vector<double> data, TensorFeature type)
+        : MetaDataType(std::move(data), type){};
 
     J3* clone() const final { return new J3(data_, type_); }
+    J3* create(DataType data) const final { return new J3(std::move(data), type_); }
 
     uint64_t getId() const final { return id(); }
 
@@ -77,10 +89,13 @@ struct J3 : MetaDataType<glm::f64> {
 struct MajorEigenVectors : MetaDataType<dvec3> {
     MajorEigenVectors() = default;
 
-    explicit MajorEigenVectors(const std::vector<dvec3>& data, TensorFeature type)
-        : MetaDataType(data, type){};
+    explicit MajorEigenVectors(std::vector<dvec3> data, TensorFeature type)
+        : MetaDataType(std::move(data), type){};
 
     MajorEigenVectors* clone() const final { return new MajorEigenVectors(data_, type_); }
+    MajorEigenVectors* create(DataType data) const final {
+        return new MajorEigenVectors(std::move(data), type_);
+    }
 
     uint64_t getId() const final { return id(); }
 
@@ -90,12 +105,15 @@ struct MajorEigenVectors : MetaDataType<dvec3> {
 struct IntermediateEigenVectors : MetaDataType<dvec3> {
     IntermediateEigenVectors() = default;
 
-    explicit IntermediateEigenVectors(const std::vector<dvec3>& data, TensorFeature type)
-        : MetaDataType(data, type){};
+    explicit IntermediateEigenVectors(std::vector<dvec3> data, TensorFeature type)
+        : MetaDataType(std::move(data), type){};
 
     IntermediateEigenVectors* clone() const final {
         return new IntermediateEigenVectors(data_, type_);
     }
+    IntermediateEigenVectors* create(DataType data) const final {
+        return new IntermediateEigenVectors(std::move(data), type_);
+    }
 
     uint64_t getId() const final { return id(); }
 
@@ -105,10 +123,13 @@ struct IntermediateEigenVectors : MetaDataType<dvec3> {
 struct MinorEigenVectors : MetaDataType<dvec3> {
     MinorEigenVectors() = default;
 
-    explicit MinorEigenVectors(const std::vector<dvec3>& data, TensorFeature type)
-        : MetaDataType(data, type){};
+    explicit MinorEigenVectors(std::vector<dvec3> data, TensorFeature type)
+        : MetaDataType(std::move(data), type){};
 
     MinorEigenVectors* clone() const final { return new MinorEigenVectors(data_, type_); }
+    MinorEigenVectors* create(DataType data) const final {
+        return new MinorEigenVectors(std::move(data), type_);
+    }
 
     uint64_t getId() const final { return id(); }
 
@@ -118,10 +139,13 @@ struct MinorEigenVectors : MetaDataType<dvec3> {
 struct MajorEigenValues : MetaDataType<glm::f64> {
     MajorEigenValues() = default;
 
-    explicit MajorEigenValues(const std::vector<double>& data, TensorFeature type)
-        : MetaDataType(data, type){};
+    explicit MajorEigenValues(std::vector<double> data, TensorFeature type)
+        : MetaDataType(std::move(data), type){};
 
     MajorEigenValues* clone() const final { return new MajorEigenValues(data_, type_); }
+    MajorEigenValues* create(DataType data) const final {
+        return new MajorEigenValues(std::move(data), type_);
+    }
 
     uint64_t getId() const final { return id(); }
 
@@ -131,12 +155,15 @@ struct MajorEigenValues : MetaDataType<glm::f64> {
 struct IntermediateEigenValues : MetaDataType<glm::f64> {
     IntermediateEigenValues() = default;
 
-    explicit IntermediateEigenValues(const std::vector<double>& data, TensorFeature type)
-        : MetaDataType(data, type){};
+    explicit IntermediateEigenValues(std::vector<double> data, TensorFeature type)
+        : MetaDataType(std::move(data), type){};
 
     IntermediateEigenValues* clone() const final {
         return new IntermediateEigenValues(data_, type_);
     }
+    IntermediateEigenValues* create(DataType data) const final {
+        return new IntermediateEigenValues(std::move(data), type_);
+    }
 
     uint64_t getId() const final { return id(); }
 
@@ -146,10 +173,13 @@ struct IntermediateEigenValues : MetaDataType<glm::f64> {
 struct MinorEigenValues : MetaDataType<glm::f64> {
     MinorEigenValues() = default;
 
-    explicit MinorEigenValues(const std::vector<double>& data, TensorFeature type)
-        : MetaDataType(data, type){};
+    explicit MinorEigenValues(std::vector<double> data, TensorFeature type)
+        : MetaDataType(std::move(data), type){};
 
     MinorEigenValues* clone() const final { return new MinorEigenValues(data_, type_); }
+    MinorEigenValues* create(DataType data) const final {
+        return new MinorEigenValues(std::move(data), type_);
+    }
 
     uint64_t getId() const final { return id(); }
 
@@ -159,10 +189,11 @@ struct MinorEigenValues : MetaDataType<glm::f64> {
 struct LodeAngle : MetaDataType<glm::f64> {
     LodeAngle() = default;
 
-    explicit LodeAngle(const std::vector<double>& data, TensorFeature type)
-        : MetaDataType(data, type){};
+    explicit LodeAngle(std::vector<double> data, TensorFeature type)
+        : MetaDataType(std::move(data), type){};
 
     LodeAngle* clone() const final { return new LodeAngle(data_, type_); }
+    LodeAngle* create(DataType data) const final { return new LodeAngle(std::move(data), type_); }
 
     uint64_t getId() const final { return id(); }
 
@@ -172,10 +203,11 @@ struct LodeAngle : MetaDataType<glm::f64> {
 struct Anisotropy : MetaDataType<glm::f64> {
     Anisotropy() = default;
 
-    explicit Anisotropy(const std::vector<double>& data, TensorFeature type)
-        : MetaDataType(data, type){};
+    explicit Anisotropy(std::vector<double> data, TensorFeature type)
+        : MetaDataType(std::move(data), type){};
 
     Anisotropy* clone() const final { return new Anisotropy(data_, type_); }
+    Anisotropy* create(DataType data) const final { return new Anisotropy(std::move(data), type_); }
 
     uint64_t getId() const final { return id(); }
 
@@ -185,10 +217,13 @@ struct Anisotropy : MetaDataType<glm::f64> {
 struct LinearAnisotropy : MetaDataType<glm::f64> {
     LinearAnisotropy() = default;
 
-    explicit LinearAnisotropy(const std::vector<double>& data, TensorFeature type)
-        : MetaDataType(data, type){};
+    explicit LinearAnisotropy(std::vector<double> data, TensorFeature type)
+        : MetaDataType(std::move(data), type){};
 
     LinearAnisotropy* clone() const final { return new LinearAnisotropy(data_, type_); }
+    LinearAnisotropy* create(DataType data) const final {
+        return new LinearAnisotropy(std::move(data), type_);
+    }
 
     uint64_t getId() const final { return id(); }
 
@@ -198,10 +233,13 @@ struct LinearAnisotropy : MetaDataType<glm::f64> {
 struct PlanarAnisotropy : MetaDataType<glm::f64> {
     PlanarAnisotropy() = default;
 
-    explicit PlanarAnisotropy(const std::vector<double>& data, TensorFeature type)
-        : MetaDataType(data, type){};
+    explicit PlanarAnisotropy(std::vector<double> data, TensorFeature type)
+        : MetaDataType(std::move(data), type){};
 
     PlanarAnisotropy* clone() const final { return new PlanarAnisotropy(data_, type_); }
+    PlanarAnisotropy* create(DataType data) const final {
+        return new PlanarAnisotropy(std::move(data), type_);
+    }
 
     uint64_t getId() const final { return id(); }
 
@@ -211,10 +249,13 @@ struct PlanarAnisotropy : MetaDataType<glm::f64> {
 struct SphericalAnisotropy : MetaDataType<glm::f64> {
     SphericalAnisotropy() = default;
 
-    explicit SphericalAnisotropy(const std::vector<double>& data, TensorFeature type)
-        : MetaDataType(data, type){};
+    explicit SphericalAnisotropy(std::vector<double> data, TensorFeature type)
+        : MetaDataType(std::move(data), type){};
 
     SphericalAnisotropy* clone() const final { return new SphericalAnisotropy(data_, type_); }
+    SphericalAnisotropy* create(DataType data) const final {
+        return new SphericalAnisotropy(std::move(data), type_);
+    }
 
     uint64_t getId() const final { return id(); }
 
@@ -224,10 +265,13 @@ struct SphericalAnisotropy : MetaDataType<glm::f64> {
 struct Diffusivity : MetaDataType<glm::f64> {
     Diffusivity() = default;
 
-    explicit Diffusivity(const std::vector<double>& data, TensorFeature type)
-        : MetaDataType(data, type){};
+    explicit Diffusivity(std::vector<double> data, TensorFeature type)
+        : MetaDataType(std::move(data), type){};
 
     Diffusivity* clone() const final { return new Diffusivity(data_, type_); }
+    Diffusivity* create(DataType data) const final {
+        return new Diffusivity(std::move(data), type_);
+    }
 
     uint64_t getId() const final { return id(); }
 
@@ -237,10 +281,13 @@ struct Diffusivity : MetaDataType<glm::f64> {
 struct ShearStress : MetaDataType<glm::f64> {
     ShearStress() = default;
 
-    explicit ShearStress(const std::vector<double>& data, TensorFeature type)
-        : MetaDataType(data, type){};
+    explicit ShearStress(std::vector<double> data, TensorFeature type)
+        : MetaDataType(std::move(data), type){};
 
     ShearStress* clone() const final { return new ShearStress(data_, type_); }
+    ShearStress* create(DataType data) const final {
+        return new ShearStress(std::move(data), type_);
+    }
 
     uint64_t getId() const final { return id(); }
 
@@ -250,10 +297,11 @@ struct ShearStress : MetaDataType<glm::f64> {
 struct PureShear : MetaDataType<glm::f64> {
     PureShear() = default;
 
-    explicit PureShear(const std::vector<double>& data, TensorFeature type)
-        : MetaDataType(data, type){};
+    explicit PureShear(std::vector<double> data, TensorFeature type)
+        : MetaDataType(std::move(data), type){};
 
     PureShear* clone() const final { return new PureShear(data_, type_); }
+    PureShear* create(DataType data) const final { return new PureShear(std::move(data), type_); }
 
     uint64_t getId() const final { return id(); }
 
@@ -263,10 +311,13 @@ struct PureShear : MetaDataType<glm::f64> {
 struct ShapeFactor : MetaDataType<glm::f64> {
     ShapeFactor() = default;
 
-    explicit ShapeFactor(const std::vector<double>& data, TensorFeature type)
-        : MetaDataType(data, type){};
+    explicit ShapeFactor(std::vector<double> data, TensorFeature type)
+        : MetaDataType(std::move(data), type){};
 
     ShapeFactor* clone() const final { return new ShapeFactor(data_, type_); }
+    ShapeFactor* create(DataType data) const final {
+        return new ShapeFactor(std::move(data), type_);
+    }
 
     uint64_t getId() const final { return id(); }
 
@@ -276,10 +327,13 @@ struct ShapeFactor : MetaDataType<glm::f64> {
 struct IsotropicScaling : MetaDataType<glm::f64> {
     IsotropicScaling() = default;
 
-    explicit IsotropicScaling(const std::vector<double>& data, TensorFeature type)
-        : MetaDataType(data, type){};
+    explicit IsotropicScaling(std::vector<double> data, TensorFeature type)
+        : MetaDataType(std::move(data), type){};
 
     IsotropicScaling* clone() const final { return new IsotropicScaling(data_, type_); }
+    IsotropicScaling* create(DataType data) const final {
+        return new IsotropicScaling(std::move(data), type_);
+    }
 
     uint64_t getId() const final { return id(); }
 
@@ -289,10 +343,11 @@ struct IsotropicScaling : MetaDataType<glm::f64> {
 struct Rotation : MetaDataType<glm::f64> {
     Rotation() = default;
 
-    explicit Rotation(const std::vector<double>& data, TensorFeature type)
-        : MetaDataType(data, type){};
+    explicit Rotation(std::vector<double> data, TensorFeature type)
+        : MetaDataType(std::move(data), type){};
 
     Rotation* clone() const final { return new Rotation(data_, type_); }
+    Rotation* create(DataType data) const final { return new Rotation(std::move(data), type_); }
 
     uint64_t getId() const final { return id(); }
 
@@ -302,10 +357,13 @@ struct Rotation : MetaDataType<glm::f64> {
 struct FrobeniusNorm : MetaDataType<glm::f64> {
     FrobeniusNorm() = default;
 
-    explicit FrobeniusNorm(const std::vector<double>& data, TensorFeature type)
-        : MetaDataType(data, type){};
+    explicit FrobeniusNorm(std::vector<double> data, TensorFeature type)
+        : MetaDataType(std::move(data), type){};
 
     FrobeniusNorm* clone() const final { return new FrobeniusNorm(data_, type_); }
+    FrobeniusNorm* create(DataType data) const final {
+        return new FrobeniusNorm(std::move(data), type_);
+    }
 
     uint64_t getId() const final { return id(); }
 
@@ -315,10 +373,13 @@ struct FrobeniusNorm : MetaDataType<glm::f64> {
 struct HillYieldCriterion : MetaDataType<glm::f64> {
     HillYieldCriterion() = default;
 
-    explicit HillYieldCriterion(const std::vector<double>& data, TensorFeature type)
-        : MetaDataType(data, type){};
+    explicit HillYieldCriterion(std::vector<double> data, TensorFeature type)
+        : MetaDataType(std::move(data), type){};
 
     HillYieldCriterion* clone() const final { return new HillYieldCriterion(data_, type_); }
+    HillYieldCriterion* create(DataType data) const final {
+        return new HillYieldCriterion(std::move(data), type_);
+    }
 
     uint64_t getId() const final { return id(); }
 
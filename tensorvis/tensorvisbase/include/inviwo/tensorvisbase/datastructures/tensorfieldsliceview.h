@@ -0,0 +1,102 @@
+#pragma once
+
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/tensorvisbase/tensorvisbasemoduledefine.h>
+#include <inviwo/tensorvisbase/datastructures/tensorfield2d.h>
+#include <inviwo/tensorvisbase/datastructures/tensorfield3d.h>
+#include <inviwo/core/datastructures/geometry/geometrytype.h>
+
+#include <memory>
+#include <vector>
+
+namespace inviwo {
+
+/**
+ * \class TensorFieldSliceView
+ * \brief Axis aligned slice of a TensorField3D that references the data of its parent field.
+ * A view only stores the parent field, the slice axis and the slice number. Tensors, mask and
+ * metadata are read from the parent through the offset and strides of the slice, so creating a
+ * view neither allocates nor copies tensors, and the eigen decomposition and metadata already
+ * computed for the parent are reused. The 2D slice position (u, v) maps to (y, z) for slices
+ * along X, to (x, z) along Y and to (x, y) along Z.
+ *
+ * Use materialize2D() or materialize3D() to get a stand-alone tensor field for algorithms that
+ * need one. Slices along Z are contiguous in memory and materialize3D() shares the tensors of
+ * the parent for them.
+ */
+class IVW_MODULE_TENSORVISBASE_API TensorFieldSliceView {
+public:
+    /*
+     * Throws if the slice number is out of bounds for the given axis.
+     */
+    TensorFieldSliceView(std::shared_ptr<const TensorField3D> tensorField,
+                         CartesianCoordinateAxis axis, size_t sliceNumber);
+
+    const std::shared_ptr<const TensorField3D> &getTensorField() const { return tensorField_; }
+    CartesianCoordinateAxis getAxis() const { return axis_; }
+    size_t getSliceNumber() const { return sliceNumber_; }
+
+    const size2_t &getDimensions() const { return dimensions_; }
+    size_t getSize() const { return dimensions_.x * dimensions_.y; }
+
+    /*
+     * Index of the slice position in the parent field.
+     */
+    size_t parentIndex(const size2_t &pos) const {
+        return offset_ + pos.x * strides_.x + pos.y * strides_.y;
+    }
+    size_t parentIndex(size_t index) const {
+        return parentIndex(size2_t(index % dimensions_.x, index / dimensions_.x));
+    }
+
+    std::pair<glm::uint8, dmat3> at(const size2_t &pos) const {
+        return tensorField_->at(parentIndex(pos));
+    }
+
+    /*
+     * The tensor at pos projected onto the slice plane, see tensorutil::getProjectedTensor.
+     */
+    dmat2 projectedAt(const size2_t &pos) const;
+
+    /*
+     * Returns the metadata value of the parent at the slice position. Computes the metadata of
+     * the parent if it is not available yet.
+     */
+    template <typename T>
+    const typename T::DataType::value_type &getMetaData(const size2_t &pos) const {
+        return tensorField_->getMetaData<T>()[parentIndex(pos)];
+    }
+
+    /*
+     * Parent indices of the first element of each run of slice elements that are consecutive in
+     * the parent. Runs hold getRowLength() elements: a single element for slices along X, one
+     * row for slices along Y and the whole slice for slices along Z.
+     */
+    std::vector<size_t> getRowStarts() const;
+    size_t getRowLength() const;
+
+    /*
+     * Copies the slice into a 2D tensor field of projected tensors.
+     */
+    std::shared_ptr<TensorField2D> materialize2D() const;
+
+    /*
+     * Copies the slice into a 3D tensor field that is one voxel thick along the slice axis. The
+     * storage mode, mask and all metadata already computed for the parent are kept, nothing is
+     * recomputed for the slice.
+     */
+    std::shared_ptr<TensorField3D> materialize3D() const;
+
+    std::string getDataInfo() const;
+
+private:
+    std::shared_ptr<const TensorField3D> tensorField_;
+    CartesianCoordinateAxis axis_;
+    size_t sliceNumber_;
+
+    size2_t dimensions_;
+    size_t offset_;
+    size2_t strides_;
+};
+
+}  // namespace inviwo
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/tensorvisbase/tensorvisbasemoduledefine.h>
+#include <inviwo/tensorvisbase/datastructures/tensorfield3d.h>
+
+#include <memory>
+#include <vector>
+
+namespace inviwo {
+
+/**
+ * \class TensorFieldSubsetView
+ * \brief Axis aligned sub-box of a TensorField3D that references the data of its parent field.
+ * The view stores the parent field, the origin of the box and its dimensions. Tensors, mask and
+ * metadata are read from the parent, so creating a view of a region of interest neither
+ * allocates nor copies, and nothing computed for the parent is computed again.
+ *
+ * Use materialize() to get a stand-alone tensor field. The region is copied as runs of elements
+ * that are consecutive in the parent, on the thread pool.
+ */
+class IVW_MODULE_TENSORVISBASE_API TensorFieldSubsetView {
+public:
+    /*
+     * Throws if the box is empty or not inside the tensor field.
+     */
+    TensorFieldSubsetView(std::shared_ptr<const TensorField3D> tensorField, const size3_t &origin,
+                          const size3_t &dimensions);
+
+    const std::shared_ptr<const TensorField3D> &getTensorField() const { return tensorField_; }
+    const size3_t &getOrigin() const { return origin_; }
+    const size3_t &getDimensions() const { return dimensions_; }
+    size_t getSize() const { return dimensions_.x * dimensions_.y * dimensions_.z; }
+
+    /*
+     * Index in the parent field of a position in the view.
+     */
+    size_t parentIndex(const size3_t &pos) const {
+        return offset_ + pos.x + pos.y * strides_.x + pos.z * strides_.y;
+    }
+    size_t parentIndex(size_t index) const {
+        const auto x = index % dimensions_.x;
+        const auto y = (index / dimensions_.x) % dimensions_.y;
+        const auto z = index / (dimensions_.x * dimensions_.y);
+        return parentIndex(size3_t(x, y, z));
+    }
+
+    std::pair<glm::uint8, dmat3> at(const size3_t &pos) const {
+        return tensorField_->at(parentIndex(pos));
+    }
+
+    /*
+     * Returns the metadata value of the parent at the view position. Computes the metadata of
+     * the parent if it is not available yet.
+     */
+    template <typename T>
+    const typename T::DataType::value_type &getMetaData(const size3_t &pos) const {
+        return tensorField_->getMetaData<T>()[parentIndex(pos)];
+    }
+
+    /*
+     * Parent indices of the first element of each run of view elements that are consecutive in
+     * the parent. Runs are rows along x, whole xy-planes if the box spans the parent along x, or
+     * the whole box if it spans the parent along x and y.
+     */
+    std::vector<size_t> getRowStarts() const;
+    size_t getRowLength() const;
+
+    /*
+     * Copies the region into a new tensor field, keeping the storage mode, the mask and all
+     * metadata already computed for the parent. A box that is contiguous in the parent shares its
+     * tensors. Rows are copied on the thread pool, jobs = 0 uses the size of the pool and 1 runs
+     * serially.
+     */
+    std::shared_ptr<TensorField3D> materialize(size_t jobs = 0) const;
+
+    std::string getDataInfo() const;
+
+private:
+    std::shared_ptr<const TensorField3D> tensorField_;
+    size3_t origin_;
+    size3_t dimensions_;
+
+    size_t offset_;
+    size2_t strides_;
+};
+
+}  // namespace inviwo
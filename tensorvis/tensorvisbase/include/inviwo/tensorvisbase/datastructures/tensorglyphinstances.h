@@ -0,0 +1,86 @@
+#pragma once
+
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/tensorvisbase/tensorvisbasemoduledefine.h>
+#include <inviwo/core/datastructures/geometry/basicmesh.h>
+
+#include <memory>
+#include <vector>
+
+namespace inviwo {
+
+enum class TensorGlyphType {
+    Reynolds,
+    HYW,
+    CombinedReynoldsHYW,
+    Superquadric,
+    SuperquadricExtended,
+    Quadric,
+    Cube,
+    Cylinder
+};
+
+/*
+ * Per glyph parameters for instanced rendering. Every glyph is a deformation of a unit sphere
+ * vertex u, translated to position:
+ *
+ *   Reynolds               u * |dot(u, frame * u)| * shape.x
+ *   HYW                    u * |frame * u - dot(u, frame * u) * u| * shape.y
+ *   Superquadric           frame * superquadric(u, alpha = shape.x, beta = shape.y),
+ *                          x and z swapped if shape.w > 0 (planar glyphs)
+ *   SuperquadricExtended   frame * superquadricExtended(u, alpha, beta, beta') * shape.w
+ *   Quadric                frame * u
+ *
+ * For Reynolds and HYW glyphs the frame is the tensor scaled by the glyph size and shape holds
+ * the normalization of both glyphs, for the other types the frame holds the glyph axes scaled by
+ * the glyph size. The layout matches the instance attributes of tensorglyphinstanced.vert.
+ */
+struct TensorGlyphInstance {
+    mat3 frame;
+    vec3 position;
+    vec4 shape;
+    vec4 color;
+};
+
+static_assert(sizeof(TensorGlyphInstance) == 80, "Unexpected padding in TensorGlyphInstance");
+
+/**
+ * \class TensorGlyphInstances
+ * \brief Glyphs of one type sharing a single base mesh, drawn with instanced rendering.
+ * Memory is linear in the number of glyphs instead of in the number of vertices, the base mesh
+ * only depends on the glyph type and resolution.
+ */
+class IVW_MODULE_TENSORVISBASE_API TensorGlyphInstances {
+public:
+    TensorGlyphInstances(TensorGlyphType type, std::shared_ptr<const BasicMesh> baseMesh,
+                         const size2_t &resolution, std::vector<TensorGlyphInstance> instances,
+                         std::vector<size_t> fieldIndices);
+
+    TensorGlyphType getType() const { return type_; }
+    std::shared_ptr<const BasicMesh> getBaseMesh() const { return baseMesh_; }
+    /*
+     * Sphere resolution (theta, phi) of the base mesh.
+     */
+    const size2_t &getResolution() const { return resolution_; }
+
+    const std::vector<TensorGlyphInstance> &getInstances() const { return instances_; }
+    /*
+     * Index of the tensor in the tensor field each glyph was generated from.
+     */
+    const std::vector<size_t> &getFieldIndices() const { return fieldIndices_; }
+
+    size_t size() const { return instances_.size(); }
+    bool empty() const { return instances_.empty(); }
+    size_t getSizeInBytes() const { return instances_.size() * sizeof(TensorGlyphInstance); }
+
+    std::string getDataInfo() const;
+
+private:
+    TensorGlyphType type_;
+    std::shared_ptr<const BasicMesh> baseMesh_;
+    size2_t resolution_;
+    std::vector<TensorGlyphInstance> instances_;
+    std::vector<size_t> fieldIndices_;
+};
+
+}  // namespace inviwo
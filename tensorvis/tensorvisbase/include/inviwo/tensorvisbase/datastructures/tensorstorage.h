@@ -0,0 +1,292 @@
+#pragma once
+
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/tensorvisbase/tensorvisbasemoduledefine.h>
+
+#include <array>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+namespace inviwo {
+
+/*
+ * Describes how the tensors of a TensorField3D are kept in memory. Full stores every tensor as a
+ * dmat3 (9 doubles), Symmetric and SymmetricFloat only store the 6 unique components of a
+ * symmetric tensor as doubles or floats respectively.
+ */
+enum class TensorStorageMode { Full, Symmetric, SymmetricFloat };
+
+template <class Elem, class Traits>
+std::basic_ostream<Elem, Traits> &operator<<(std::basic_ostream<Elem, Traits> &os,
+                                             TensorStorageMode mode) {
+    switch (mode) {
+        case TensorStorageMode::Full:
+            os << "Full (9 x double)";
+            break;
+        case TensorStorageMode::Symmetric:
+            os << "Symmetric (6 x double)";
+            break;
+        case TensorStorageMode::SymmetricFloat:
+            os << "Symmetric (6 x float)";
+            break;
+    }
+
+    return os;
+}
+
+/*
+ * The 6 unique components of a symmetric 3x3 tensor in the order
+ *
+ *   xx, yy, zz, xy, yz, xz
+ *
+ * which is the same order as used by TensorField3D::getVolumeRepresentation.
+ */
+template <typename T>
+struct SymmetricTensor3 {
+    std::array<T, 6> components;
+
+    /*
+     * Packs the symmetric part of the tensor, i.e. the off-diagonal entries are averaged.
+     */
+    static SymmetricTensor3 fromMatrix(const dmat3 &tensor) {
+        return {{{static_cast<T>(tensor[0][0]), static_cast<T>(tensor[1][1]),
+                  static_cast<T>(tensor[2][2]), static_cast<T>(0.5 * (tensor[1][0] + tensor[0][1])),
+                  static_cast<T>(0.5 * (tensor[2][1] + tensor[1][2])),
+                  static_cast<T>(0.5 * (tensor[2][0] + tensor[0][2]))}}};
+    }
+
+    dmat3 toMatrix() const {
+        const auto xx = static_cast<double>(components[0]);
+        const auto yy = static_cast<double>(components[1]);
+        const auto zz = static_cast<double>(components[2]);
+        const auto xy = static_cast<double>(components[3]);
+        const auto yz = static_cast<double>(components[4]);
+        const auto xz = static_cast<double>(components[5]);
+        return dmat3(xx, xy, xz, xy, yy, yz, xz, yz, zz);
+    }
+};
+
+/**
+ * \class TensorStorage3D
+ * \brief Tensor container used by TensorField3D.
+ * Stores the tensors either as full matrices or as packed symmetric tensors, see
+ * TensorStorageMode. Element access always yields a dmat3, so code that only reads tensors does
+ * not need to know about the storage mode.
+ * Copies share the tensor data, which is only duplicated once a copy is modified (copy-on-write).
+ * This makes copying a tensor field cheap regardless of its size.
+ */
+class IVW_MODULE_TENSORVISBASE_API TensorStorage3D {
+public:
+    class ConstIterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = dmat3;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const dmat3 *;
+        using reference = dmat3;
+
+        ConstIterator(const TensorStorage3D *storage, size_t index)
+            : storage_(storage), index_(index) {}
+
+        dmat3 operator*() const { return (*storage_)[index_]; }
+        ConstIterator &operator++() {
+            ++index_;
+            return *this;
+        }
+        ConstIterator operator++(int) {
+            auto it = *this;
+            ++index_;
+            return it;
+        }
+        bool operator==(const ConstIterator &rhs) const { return index_ == rhs.index_; }
+        bool operator!=(const ConstIterator &rhs) const { return index_ != rhs.index_; }
+
+    private:
+        const TensorStorage3D *storage_;
+        size_t index_;
+    };
+
+    TensorStorage3D() = default;
+    explicit TensorStorage3D(std::vector<dmat3> tensors,
+                             TensorStorageMode mode = TensorStorageMode::Full);
+    explicit TensorStorage3D(std::vector<SymmetricTensor3<double>> tensors);
+    explicit TensorStorage3D(std::vector<SymmetricTensor3<float>> tensors);
+
+    /*
+     * Adopts caller-owned memory holding size tensors without copying it. The shared_ptr keeps
+     * the memory alive for as long as any copy of the storage uses it, pass a custom deleter to
+     * hand over memory owned by something else, e.g. a vtkDataArray. The memory is never
+     * written to, modifying the storage copies the tensors first.
+     */
+    TensorStorage3D(std::shared_ptr<const dmat3> tensors, size_t size);
+    TensorStorage3D(std::shared_ptr<const SymmetricTensor3<double>> tensors, size_t size);
+    TensorStorage3D(std::shared_ptr<const SymmetricTensor3<float>> tensors, size_t size);
+
+    /*
+     * Builds the storage from size tensors of 9 scalars each, in column-major order, where
+     * consecutive tensors are stride scalars apart (stride >= 9). The data is converted
+     * directly into the requested storage mode without intermediate copies.
+     */
+    template <typename T>
+    static TensorStorage3D fromStrided(const T *data, size_t size, size_t stride = 9,
+                                       TensorStorageMode mode = TensorStorageMode::Full);
+
+    TensorStorageMode getMode() const { return mode_; }
+    bool isSymmetric() const { return mode_ != TensorStorageMode::Full; }
+
+    size_t size() const {
+        switch (mode_) {
+            case TensorStorageMode::Symmetric:
+                return symmetric_.size;
+            case TensorStorageMode::SymmetricFloat:
+                return symmetricFloat_.size;
+            case TensorStorageMode::Full:
+            default:
+                return full_.size;
+        }
+    }
+    bool empty() const { return size() == 0; }
+
+    /*
+     * Returns the number of bytes occupied by the tensors.
+     */
+    size_t getSizeInBytes() const;
+
+    dmat3 operator[](size_t index) const {
+        switch (mode_) {
+            case TensorStorageMode::Symmetric:
+                return symmetric_.get()[index].toMatrix();
+            case TensorStorageMode::SymmetricFloat:
+                return symmetricFloat_.get()[index].toMatrix();
+            case TensorStorageMode::Full:
+            default:
+                return full_.get()[index];
+        }
+    }
+
+    /*
+     * Sets the tensor at the given index. For the symmetric modes only the symmetric part of the
+     * tensor is stored.
+     */
+    void set(size_t index, const dmat3 &tensor);
+
+    /*
+     * Returns a pointer to the contiguous dmat3 data for TensorStorageMode::Full and nullptr
+     * for the packed symmetric modes. The non-const version detaches shared data first.
+     */
+    dmat3 *data() { return mode_ == TensorStorageMode::Full ? detach(full_) : nullptr; }
+    const dmat3 *data() const { return mode_ == TensorStorageMode::Full ? full_.get() : nullptr; }
+
+    /*
+     * Returns the packed tensors for TensorStorageMode::Symmetric and
+     * TensorStorageMode::SymmetricFloat respectively, nullptr otherwise.
+     */
+    const SymmetricTensor3<double> *symmetricTensors() const {
+        return mode_ == TensorStorageMode::Symmetric ? symmetric_.get() : nullptr;
+    }
+    const SymmetricTensor3<float> *symmetricFloatTensors() const {
+        return mode_ == TensorStorageMode::SymmetricFloat ? symmetricFloat_.get() : nullptr;
+    }
+
+    /*
+     * Returns true if the tensor data is shared with other copies of this storage or with
+     * adopted caller-owned memory.
+     */
+    bool isShared() const;
+
+    /*
+     * Returns a copy of the tensors using the given storage mode.
+     */
+    TensorStorage3D convert(TensorStorageMode mode) const;
+
+    std::vector<dmat3> toMatrices() const;
+
+    /*
+     * Returns storage of the same mode holding rowLength consecutive tensors starting at each of
+     * the row starts. A single row shares the memory of this storage instead of copying it.
+     */
+    TensorStorage3D gather(const std::vector<size_t> &rowStarts, size_t rowLength) const;
+
+    ConstIterator begin() const { return ConstIterator(this, 0); }
+    ConstIterator end() const { return ConstIterator(this, size()); }
+
+private:
+    /*
+     * Shared, read-only tensor memory. Owned memory lives in a std::vector held by the shared_ptr
+     * control block, adopted memory is only referenced.
+     */
+    template <typename T>
+    struct SharedArray {
+        SharedArray() = default;
+        explicit SharedArray(std::vector<T> tensors) {
+            auto owned = std::make_shared<std::vector<T>>(std::move(tensors));
+            size = owned->size();
+            data = std::shared_ptr<const T>(owned, owned->data());
+            isOwned = true;
+        }
+        SharedArray(std::shared_ptr<const T> tensors, size_t count)
+            : data(std::move(tensors)), size(count), isOwned(false) {}
+
+        const T *get() const { return data.get(); }
+
+        std::shared_ptr<const T> data;
+        size_t size = 0;
+        bool isOwned = true;
+    };
+
+    template <typename T>
+    static T *detach(SharedArray<T> &tensors) {
+        if (!tensors.isOwned || tensors.data.use_count() > 1) {
+            tensors = SharedArray<T>(std::vector<T>(tensors.get(), tensors.get() + tensors.size));
+        }
+        return const_cast<T *>(tensors.get());
+    }
+
+    TensorStorageMode mode_ = TensorStorageMode::Full;
+    SharedArray<dmat3> full_;
+    SharedArray<SymmetricTensor3<double>> symmetric_;
+    SharedArray<SymmetricTensor3<float>> symmetricFloat_;
+};
+
+template <typename T>
+TensorStorage3D TensorStorage3D::fromStrided(const T *data, const size_t size, const size_t stride,
+                                             const TensorStorageMode mode) {
+    const auto tensorAt = [data, stride](size_t i) {
+        dmat3 tensor;
+        const auto src = data + i * stride;
+        for (glm::length_t col = 0; col < 3; ++col) {
+            for (glm::length_t row = 0; row < 3; ++row) {
+                tensor[col][row] = static_cast<double>(src[3 * col + row]);
+            }
+        }
+        return tensor;
+    };
+
+    switch (mode) {
+        case TensorStorageMode::Symmetric: {
+            std::vector<SymmetricTensor3<double>> tensors(size);
+            for (size_t i = 0; i < size; ++i) {
+                tensors[i] = SymmetricTensor3<double>::fromMatrix(tensorAt(i));
+            }
+            return TensorStorage3D(std::move(tensors));
+        }
+        case TensorStorageMode::SymmetricFloat: {
+            std::vector<SymmetricTensor3<float>> tensors(size);
+            for (size_t i = 0; i < size; ++i) {
+                tensors[i] = SymmetricTensor3<float>::fromMatrix(tensorAt(i));
+            }
+            return TensorStorage3D(std::move(tensors));
+        }
+        case TensorStorageMode::Full:
+        default: {
+            std::vector<dmat3> tensors(size);
+            for (size_t i = 0; i < size; ++i) {
+                tensors[i] = tensorAt(i);
+            }
+            return TensorStorage3D(std::move(tensors));
+        }
+    }
+}
+
+}  // namespace inviwo
@@ -36,6 +36,8 @@
 #include <inviwo/core/datastructures/datatraits.h>
 #include <inviwo/tensorvisbase/datastructures/tensorfield2d.h>
 #include <inviwo/tensorvisbase/datastructures/tensorfield3d.h>
+#include <inviwo/tensorvisbase/datastructures/tensorfieldsliceview.h>
+#include <inviwo/tensorvisbase/datastructures/tensorfieldsubsetview.h>
 
 namespace inviwo {
 
@@ -87,6 +89,54 @@ struct DataTraits<TensorField3D> {
     }
 };
 
+/**
+ * \ingroup ports
+ */
+using TensorFieldSliceViewInport = DataInport<TensorFieldSliceView>;
+
+/**
+ * \ingroup ports
+ */
+using TensorFieldSliceViewOutport = DataOutport<TensorFieldSliceView>;
+
+template <>
+struct DataTraits<TensorFieldSliceView> {
+    static std::string classIdentifier() { return "org.inviwo.TensorFieldSliceView"; }
+    static std::string dataName() { return "TensorFieldSliceView"; }
+    static uvec3 colorCode() { return uvec3(10, 150, 135); }
+    static Document info(const TensorFieldSliceView& data) {
+        std::ostringstream oss;
+        oss << data.getDataInfo();
+        Document doc;
+        doc.append("p", oss.str());
+        return doc;
+    }
+};
+
+/**
+ * \ingroup ports
+ */
+using TensorFieldSubsetViewInport = DataInport<TensorFieldSubsetView>;
+
+/**
+ * \ingroup ports
+ */
+using TensorFieldSubsetViewOutport = DataOutport<TensorFieldSubsetView>;
+
+template <>
+struct DataTraits<TensorFieldSubsetView> {
+    static std::string classIdentifier() { return "org.inviwo.TensorFieldSubsetView"; }
+    static std::string dataName() { return "TensorFieldSubsetView"; }
+    static uvec3 colorCode() { return uvec3(10, 150, 135); }
+    static Document info(const TensorFieldSubsetView& data) {
+        std::ostringstream oss;
+        oss << data.getDataInfo();
+        Document doc;
+        doc.append("p", oss.str());
+        return doc;
+    }
+};
+
 }  // namespace inviwo
 
 #endif  // IVW_TENSORFIELD3DPORT_H
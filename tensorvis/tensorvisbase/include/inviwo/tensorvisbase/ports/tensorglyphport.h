@@ -0,0 +1,65 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#ifndef IVW_TENSORGLYPHPORT_H
+#define IVW_TENSORGLYPHPORT_H
+
+#include <inviwo/core/common/inviwocoredefine.h>
+#include <inviwo/core/ports/datainport.h>
+#include <inviwo/core/ports/dataoutport.h>
+#include <inviwo/core/datastructures/datatraits.h>
+#include <inviwo/tensorvisbase/datastructures/tensorglyphinstances.h>
+
+namespace inviwo {
+
+/**
+ * \ingroup ports
+ */
+using TensorGlyphInport = DataInport<TensorGlyphInstances>;
+
+/**
+ * \ingroup ports
+ */
+using TensorGlyphOutport = DataOutport<TensorGlyphInstances>;
+
+template <>
+struct DataTraits<TensorGlyphInstances> {
+    static std::string classIdentifier() { return "org.inviwo.TensorGlyphInstances"; }
+    static std::string dataName() { return "TensorGlyphInstances"; }
+    static uvec3 colorCode() { return uvec3(188, 101, 101); }
+    static Document info(const TensorGlyphInstances& data) {
+        Document doc;
+        doc.append("p", data.getDataInfo());
+        return doc;
+    }
+};
+
+}  // namespace inviwo
+
+#endif  // IVW_TENSORGLYPHPORT_H
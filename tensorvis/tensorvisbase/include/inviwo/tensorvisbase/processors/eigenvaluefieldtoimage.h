@@ -35,6 +35,7 @@
 #include <inviwo/core/processors/processor.h>
 #include <inviwo/core/ports/imageport.h>
 #include <inviwo/tensorvisbase/ports/tensorfieldport.h>
+#include <inviwo/tensorvisbase/datastructures/eigenvaluerangecache.h>
 #include <inviwo/core/properties/transferfunctionproperty.h>
 #include <modules/opengl/shader/shader.h>
 #include <inviwo/core/datastructures/image/image.h>
@@ -88,6 +89,7 @@ private:
     Shader shader_;
     Image tf_texture_;
     BoolProperty majorMinor_;
+    EigenValueRangeCache cache_;
 
     float minVal_;
     float maxVal_;
@@ -99,6 +101,7 @@ private:
 
     void updateEigenValues();
     void updateAnisotropy();
+    const EigenValueRanges &getRanges();
 };
 
 }  // namespace inviwo
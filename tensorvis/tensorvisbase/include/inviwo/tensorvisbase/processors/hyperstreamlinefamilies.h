@@ -0,0 +1,48 @@
+#pragma once
+
+#include <inviwo/tensorvisbase/tensorvisbasemoduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/processors/processor.h>
+#include <inviwo/core/util/foreach.h>
+#include <inviwo/core/properties/boolproperty.h>
+#include <inviwo/core/properties/ordinalproperty.h>
+#include <modules/vectorfieldvisualization/datastructures/integrallineset.h>
+#include <modules/vectorfieldvisualization/ports/seedpointsport.h>
+#include <inviwo/tensorvisbase/datastructures/hyperstreamlinefamilytracer.h>
+#include <inviwo/tensorvisbase/ports/tensorfieldport.h>
+
+#include <array>
+
+namespace inviwo {
+
+/*
+ * Traces the major, intermediate and minor hyperstreamlines of a tensor field from the same seed
+ * points in one pass and writes each family to its own line set. Only the families whose outports
+ * are connected are traced.
+ */
+class IVW_MODULE_TENSORVISBASE_API HyperStreamlineFamilies : public Processor {
+public:
+    HyperStreamlineFamilies();
+    virtual ~HyperStreamlineFamilies() = default;
+
+    virtual void process() override;
+
+    virtual const ProcessorInfo getProcessorInfo() const override;
+    static const ProcessorInfo processorInfo_;
+
+private:
+    TensorField3DInport tensorField_;
+    SeedPointsInport<3> seeds_;
+
+    IntegralLineSetOutport majorLines_;
+    IntegralLineSetOutport intermediateLines_;
+    IntegralLineSetOutport minorLines_;
+
+    IntegralLineProperties properties_;
+
+    BoolProperty adaptiveStepSize_;
+    DoubleProperty tolerance_;
+    DoubleProperty maxStepFactor_;
+};
+
+}  // namespace inviwo
@@ -6,14 +6,30 @@
 #include <inviwo/core/ports/datainport.h>
 #include <inviwo/core/util/utilities.h>
 #include <inviwo/core/util/foreach.h>
+#include <inviwo/core/properties/boolproperty.h>
+#include <inviwo/core/properties/ordinalproperty.h>
+#include <inviwo/core/properties/optionproperty.h>
+#include <inviwo/core/properties/compositeproperty.h>
 #include <modules/vectorfieldvisualization/datastructures/integrallineset.h>
 #include <modules/vectorfieldvisualization/ports/seedpointsport.h>
 #include <inviwo/tensorvisbase/datastructures/hyperstreamlinetracer.h>
+#include <inviwo/tensorvisbase/ports/tensorfieldport.h>
 
 namespace inviwo {
 
+/*
+ * Traces hyperstreamlines from the seed points of the inport and, depending on the seeding mode,
+ * from seeds generated for the tensor field:
+ *  - Evenly spaced: rounds of seeds in the empty cells of an occupancy grid, lines end in cells
+ *    that already hold enough lines.
+ *  - Feature weighted: seeds drawn with a probability proportional to a scalar tensor feature of
+ *    the optional tensor field, e.g. an anisotropy measure.
+ * Generated seeds are in the data space of the sampler.
+ */
 class IVW_MODULE_TENSORVISBASE_API HyperStreamlines : public Processor {
 public:
+    enum class SeedingMode { SeedPoints, EvenlySpaced, FeatureWeighted };
+
     HyperStreamlines();
     virtual ~HyperStreamlines();
 
@@ -25,9 +41,24 @@ public:
 private:
     DataInport<SpatialSampler<3, 3, double>> sampler_;
     SeedPointsInport<SpatialSampler<3, 3, double>::SpatialDimensions> seeds_;
+    TensorField3DInport tensorField_;
 
     IntegralLineSetOutport lines_;
 
     IntegralLineProperties properties_;
+
+    BoolProperty adaptiveStepSize_;
+    DoubleProperty tolerance_;
+    DoubleProperty maxStepFactor_;
+
+    CompositeProperty seeding_;
+    TemplateOptionProperty<SeedingMode> seedingMode_;
+    BoolProperty useOccupancy_;
+    IntSize3Property occupancyResolution_;
+    IntSizeTProperty cellCapacity_;
+    IntSizeTProperty seedSpacing_;
+    TemplateOptionProperty<TensorFeature> feature_;
+    IntSizeTProperty numberOfSeeds_;
+    IntSizeTProperty randomSeed_;
 };
 }  // namespace inviwo
\ No newline at end of file
@@ -35,6 +35,7 @@
 #include <inviwo/tensorvisbase/tensorvisbasemoduledefine.h>
 #include <inviwo/tensorvisbase/datastructures/tensorfield2d.h>
 #include <inviwo/tensorvisbase/util/tensorfieldutil.h>
+#include <inviwo/tensorvisbase/algorithm/tensorfieldresampling.h>
 
 namespace inviwo {
 
@@ -75,6 +76,8 @@ private:
 
     FloatProperty resolutionMultiplier_;
     TemplateOptionProperty<tensorutil::InterpolationMethod> interpolationMethod_;
+    TemplateOptionProperty<tensorutil::ResamplingFilter> filter_;
+    TemplateOptionProperty<tensorutil::ResamplingSpace> space_;
 };
 
 }  // namespace inviwo
@@ -34,6 +34,8 @@
 #include <inviwo/core/common/inviwo.h>
 #include <inviwo/core/processors/processor.h>
 #include <inviwo/core/properties/optionproperty.h>
+#include <inviwo/core/properties/boolproperty.h>
+#include <inviwo/core/properties/compositeproperty.h>
 #include <inviwo/tensorvisbase/util/tensorutil.h>
 #include <inviwo/tensorvisbase/ports/tensorfieldport.h>
 #include <inviwo/core/ports/volumeport.h>
@@ -76,6 +78,14 @@ private:
 
     TemplateOptionProperty<tensorutil::Anisotropy> anisotropy_;
 
+    // Writes all checked measures into the channels of one volume instead of only anisotropy_
+    BoolProperty combineMeasures_;
+    CompositeProperty measures_;
+    BoolProperty absLamda1MinusLamda2_;
+    BoolProperty absLamda1MinusLamda3_;
+    BoolProperty barycentric_;
+    BoolProperty absLamda1MinusAbsLamda2_;
+
     TemplateOptionProperty<GLint> interpolationScheme_;
 };
 
@@ -105,6 +105,9 @@ private:
 
     std::shared_ptr<TensorField3D> tensorFieldOut_;
 
+    // The optional scalar features and the properties selecting them
+    std::vector<std::pair<const BoolProperty*, TensorFeature>> scalarFeatures() const;
+
     void addMetaData();
     void removeMetaData();
 
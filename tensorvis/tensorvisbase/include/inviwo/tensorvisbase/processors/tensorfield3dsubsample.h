@@ -35,6 +35,7 @@
 #include <inviwo/tensorvisbase/tensorvisbasemoduledefine.h>
 #include <inviwo/tensorvisbase/ports/tensorfieldport.h>
 #include <inviwo/tensorvisbase/util/tensorfieldutil.h>
+#include <inviwo/tensorvisbase/algorithm/tensorfieldresampling.h>
 #include <inviwo/core/processors/progressbarowner.h>
 
 namespace inviwo {
@@ -77,6 +78,8 @@ private:
 
     FloatProperty resolutionMultiplier_;
     TemplateOptionProperty<tensorutil::InterpolationMethod> interpolationMethod_;
+    TemplateOptionProperty<tensorutil::ResamplingFilter> filter_;
+    TemplateOptionProperty<tensorutil::ResamplingSpace> space_;
 
     std::shared_ptr<TensorField3D> tf_;
 
@@ -71,6 +71,7 @@ public:
 private:
     TensorField3DInport inport_;
     TensorField3DOutport outport_;
+    TensorFieldSubsetViewOutport viewOutport_;
 
     OrdinalProperty<size3_t> origin_;
     OrdinalProperty<size3_t> offset_;
@@ -35,6 +35,7 @@
 #include <inviwo/core/processors/processor.h>
 #include <inviwo/tensorvisbase/tensorvisbasemoduledefine.h>
 #include <inviwo/tensorvisbase/datastructures/tensorfield2d.h>
+#include <inviwo/tensorvisbase/datastructures/eigenvaluerangecache.h>
 #include <modules/opengl/shader/shaderutils.h>
 #include <inviwo/tensorvisbase/util/tensorfieldutil.h>
 #include <inviwo/core/properties/boolproperty.h>
@@ -89,6 +90,7 @@ private:
 
     Shader shader_;
     Image tf_texture_;
+    EigenValueRangeCache cache_;
 
     float minVal_;
     float maxVal_;
@@ -77,6 +77,7 @@ private:
     TensorField3DInport inport_;
     TensorField2DOutport outport2D_;
     TensorField3DOutport outport3D_;
+    TensorFieldSliceViewOutport viewOutport_;
 
     MeshOutport sliceOutport_;
     MeshOutport planeOutport_;
@@ -38,6 +38,7 @@
 #include <inviwo/core/properties/boolproperty.h>
 #include <inviwo/core/properties/optionproperty.h>
 #include <inviwo/tensorvisbase/datastructures/tensorfieldmetadata.h>
+#include <inviwo/tensorvisbase/datastructures/metadatacolumnview.h>
 
 namespace inviwo {
 
@@ -76,6 +77,7 @@ private:
     VolumeOutport outport_;
 
     TemplateOptionProperty<TensorFeature> feature_;
+    TemplateOptionProperty<MetaDataPrecision> precision_;
 
     BoolProperty normalizeVectors_;
 };
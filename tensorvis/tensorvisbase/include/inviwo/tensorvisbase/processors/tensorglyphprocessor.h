@@ -37,6 +37,7 @@
 #include <inviwo/core/ports/dataoutport.h>
 #include <inviwo/core/properties/compositeproperty.h>
 #include <inviwo/tensorvisbase/ports/tensorfieldport.h>
+#include <inviwo/tensorvisbase/ports/tensorglyphport.h>
 #include <inviwo/tensorvisbase/properties/tensorglyphproperty.h>
 
 namespace inviwo {
@@ -49,7 +50,8 @@ namespace inviwo {
  *   * __<Inport1>__ <description>.
  *
  * ### Outports
- *   * __<Outport1>__ <description>.
+ *   * __outport__ One mesh per glyph, only generated if connected.
+ *   * __glyphOutport__ Glyph instances for the Tensor Glyph Renderer, sharing one base mesh.
  *
  * ### Properties
  *   * __<Prop1>__ <description>.
@@ -74,6 +76,7 @@ public:
 private:
     TensorField3DInport inport_;
     DataOutport<std::vector<std::shared_ptr<Mesh>>> outport_;
+    TensorGlyphOutport glyphOutport_;
 
     TensorGlyphProperty glyphParameters_;
 };
@@ -36,10 +36,11 @@
 #include <inviwo/core/processors/processor.h>
 #include <inviwo/core/ports/imageport.h>
 #include <inviwo/core/properties/ordinalproperty.h>
+#include <inviwo/core/properties/compositeproperty.h>
+#include <inviwo/core/properties/boolproperty.h>
 #include <inviwo/core/ports/datainport.h>
 #include <inviwo/core/ports/meshport.h>
 #include <inviwo/core/datastructures/geometry/basicmesh.h>
-#include <inviwo/core/rendering/meshdrawer.h>
 #include <inviwo/core/interaction/pickingmapper.h>
 #include <inviwo/core/properties/cameraproperty.h>
 #include <inviwo/core/interaction/cameratrackball.h>
@@ -50,9 +51,12 @@
 #include <modules/opengl/inviwoopengl.h>
 #include <modules/opengl/image/imagecompositor.h>
 #include <modules/opengl/shader/shader.h>
+#include <modules/opengl/buffer/bufferobject.h>
 
 #include <inviwo/tensorvisbase/ports/tensorfieldport.h>
+#include <inviwo/tensorvisbase/ports/tensorglyphport.h>
 #include <inviwo/tensorvisbase/properties/tensorglyphproperty.h>
+#include <inviwo/tensorvisbase/algorithm/glyphlod.h>
 
 namespace inviwo {
 
@@ -73,8 +77,9 @@ namespace inviwo {
 
 /**
  * \class TensorGlyphRenderer
- * \brief <brief description>
- * <Detailed description from a developer prespective>
+ * \brief Renders tensor glyph instances with a single instanced draw call per glyph type.
+ * The base mesh is deformed into the individual glyphs in tensorglyphinstanced.vert, the
+ * instance parameters are uploaded to the GPU once whenever the glyphs change.
  */
 class IVW_MODULE_TENSORVISBASE_API TensorGlyphRenderer : public Processor {
 public:
@@ -90,7 +95,7 @@ public:
     void handlePickingEvent(PickingEvent*);
 
 private:
-    DataInport<std::vector<std::shared_ptr<Mesh>>> meshInport_;
+    TensorGlyphInport glyphInport_;
     TensorField3DInport tensorFieldInport_;
     DataInport<size_t> offsetInport_;
     ImageInport imageInport_;
@@ -99,7 +104,17 @@ private:
 
     ImageOutport outport_;
 
-    std::vector<std::unique_ptr<MeshDrawer>> meshDrawers_;
+    // Visible glyphs sorted by level of detail and their index in the glyph inport data
+    std::unique_ptr<BufferObject> instanceBuffer_;
+    std::unique_ptr<BufferObject> instanceIdBuffer_;
+    bool uploadInstances_ = false;
+
+    struct LodRange {
+        std::shared_ptr<const BasicMesh> mesh;
+        size_t first;
+        size_t count;
+    };
+    std::vector<LodRange> lodRanges_;
 
     CameraProperty camera_;
     CameraTrackball trackball_;
@@ -121,9 +136,19 @@ private:
     bool triggerSelect_ = false;
 
     void addCommonShaderDefines(Shader& shader);
+    GlyphLodSettings getLodSettings() const;
+    void updateInstances(const TensorGlyphInstances& glyphs);
+    void drawInstances(const LodRange& range, TensorGlyphType type);
 
     BoolProperty selectMode_;
     TensorGlyphProperty glyphType_;
+
+    CompositeProperty lod_;
+    BoolProperty cullGlyphs_;
+    FloatProperty minPixelRadius_;
+    BoolProperty useLod_;
+    FloatProperty pixelsPerSegment_;
+    OrdinalProperty<size_t> lodLevels_;
 };
 
 }  // namespace inviwo
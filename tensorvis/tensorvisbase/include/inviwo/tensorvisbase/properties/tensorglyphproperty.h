@@ -33,10 +33,13 @@
 #include <inviwo/core/common/inviwo.h>
 #include <inviwo/tensorvisbase/tensorvisbasemoduledefine.h>
 #include <inviwo/tensorvisbase/datastructures/tensorfield3d.h>
+#include <inviwo/tensorvisbase/datastructures/tensorglyphinstances.h>
 #include <inviwo/core/properties/compositeproperty.h>
 #include <inviwo/core/properties/optionproperty.h>
 #include <inviwo/core/properties/ordinalproperty.h>
 
+#include <functional>
+
 namespace inviwo {
 
 /**
@@ -49,16 +52,7 @@ public:
     virtual std::string getClassIdentifier() const override;
     static const std::string classIdentifier;
 
-    enum class GlyphType {
-        Reynolds,
-        HYW,
-        CombinedReynoldsHYW,
-        Superquadric,
-        SuperquadricExtended,
-        Quadric,
-        Cube,
-        Cylinder
-    };
+    using GlyphType = TensorGlyphType;
 
     TensorGlyphProperty(std::string identifier = std::string("tensorGlyphProperty"),
                         std::string displayName = std::string("Glyph properties"));
@@ -96,6 +90,28 @@ public:
                                                      const float size,
                                                      const dvec4& color = dvec4(1.)) const;
 
+    /*
+     * Returns false for the glyph types that can only be generated from single tensors, i.e.
+     * Cube and Cylinder.
+     */
+    bool supportsInstancing() const;
+
+    /*
+     * Unit sphere at the current resolution, deformed into the individual glyphs on the GPU.
+     */
+    std::shared_ptr<const BasicMesh> createBaseMesh() const;
+    std::shared_ptr<const BasicMesh> createBaseMesh(const size2_t& resolution) const;
+
+    /*
+     * Computes the instance parameters of the glyph of a tensor, see TensorGlyphInstance.
+     * eigenSystem holds the eigenvalues and eigenvectors sorted by eigenvalue in descending
+     * order, the Frobenius norm is only used by superquadric extended glyphs. Does not modify
+     * the property and can be called concurrently.
+     */
+    TensorGlyphInstance generateInstance(const dmat3& tensor,
+                                         const std::array<std::pair<double, dvec3>, 3>& eigenSystem,
+                                         double frobeniusNorm, const vec3& pos) const;
+
 protected:
     // Properties go here
     TemplateOptionProperty<GlyphType> glyphType_;
@@ -121,11 +137,21 @@ private:
                         useEigenBasis_);
     }
 
+    // Normalized eigenvalues and the (scaled) glyph axes of the superquadric glyphs
+    struct GlyphAxes {
+        std::array<double, 3> eigenValues;
+        dmat3 basis;
+    };
+
     void evalColorReadOnly();
-    double signedExponentiation(double x, double a);
-    dvec3 cartesianToSpherical(const dvec3& pos) const;
     std::pair<bool, dvec3> intersectTriangle(const dvec2& coord,
-                                             const std::array<dvec2, 3>& tri_verts);
+                                             const std::array<dvec2, 3>& tri_verts) const;
+
+    GlyphAxes glyphAxes(std::array<std::pair<double, dvec3>, 3> eigenValuesAndEigenVectors) const;
+    // alpha, beta and whether the glyph is planar
+    dvec3 superquadricShape(const std::array<double, 3>& eigenValues) const;
+    // alpha, beta and beta'
+    dvec3 superquadricExtendedShape(std::array<double, 3> lamda, double frobeniusNorm) const;
 
     const std::shared_ptr<BasicMesh> generateSuperquadric(
         std::shared_ptr<const TensorField3D> tensorField, size_t index, const dvec3 pos,
@@ -167,9 +193,22 @@ private:
         std::shared_ptr<const TensorField3D> tensorField, size_t index, const dvec3 pos,
         const float size);
 
-    std::shared_ptr<BasicMesh> createSuperquadric(const std::array<double, 3>& eigenValues,
-                                                  const dvec3& pos, const float size,
-                                                  const dvec4& color) const;
+    /*
+     * Glyph geometry in the local frame of the glyph, i.e. without orientation, position and
+     * size, which only depends on the given shape parameters.
+     */
+    std::shared_ptr<BasicMesh> createSuperquadric(const dvec3& shape, const dvec4& color) const;
+    std::shared_ptr<BasicMesh> createReynolds(const dvec3& eigenValues) const;
+    std::shared_ptr<BasicMesh> createHWY(const dvec3& eigenValues, const dvec4& color) const;
+
+    /*
+     * Looks up the geometry of the shape in the glyph mesh cache of the module, creating it if
+     * necessary, and places it at pos with the given basis and size.
+     */
+    std::shared_ptr<BasicMesh> cachedGlyph(
+        GlyphType type, const dvec4& shape, const dvec4& color, const dmat3& basis,
+        const dvec3& pos, float size,
+        const std::function<std::shared_ptr<BasicMesh>(const dvec4&)>& create) const;
 
     //    static constexpr std::array<std::array<dvec2, 3>, 10> tri_uv{
     //        {{dvec2(0.00, 0.00), dvec2(0.50, 0.00), dvec2(0.25, 0.25)},
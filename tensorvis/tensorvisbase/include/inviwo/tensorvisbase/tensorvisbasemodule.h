@@ -32,6 +32,7 @@
 
 #include <inviwo/tensorvisbase/tensorvisbasemoduledefine.h>
 #include <inviwo/core/common/inviwomodule.h>
+#include <inviwo/tensorvisbase/datastructures/glyphmeshcache.h>
 
 namespace inviwo {
 
@@ -39,6 +40,14 @@ class IVW_MODULE_TENSORVISBASE_API TensorVisBaseModule : public InviwoModule {
 public:
     TensorVisBaseModule(InviwoApplication* app);
     virtual ~TensorVisBaseModule() = default;
+
+    /*
+     * Glyph geometry shared by all processors generating tensor glyphs.
+     */
+    GlyphMeshCache& getGlyphMeshCache() { return glyphMeshCache_; }
+
+private:
+    GlyphMeshCache glyphMeshCache_;
 };
 
 }  // namespace inviwo
@@ -1,4 +1,4 @@
-#define TFB_CURRENT_VERSION 5
+#define TFB_CURRENT_VERSION 6
 
 #ifndef _IVW_MODULE_TENSORVISBASE_DEFINE_H_
 #define _IVW_MODULE_TENSORVISBASE_DEFINE_H_
@@ -0,0 +1,169 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/tensorvisbase/tensorvisbasemoduledefine.h>
+#include <inviwo/core/util/glm.h>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <vector>
+
+namespace inviwo {
+namespace tensorutil {
+
+/*
+ * Component-wise min, max and mean of a column of scalars or glm vectors. Components beyond
+ * numberOfComponents are zero.
+ */
+struct IVW_MODULE_TENSORVISBASE_API DataStatistics {
+    dvec4 min{0.0};
+    dvec4 max{0.0};
+    dvec4 mean{0.0};
+    size_t numberOfComponents = 0;
+    size_t size = 0;
+
+    /*
+     * Smallest minimum and largest maximum over all components.
+     */
+    dvec2 range() const;
+};
+
+namespace detail {
+/*
+ * Number of chunks a reduction over size elements is split into. jobs = 0 uses the size of the
+ * thread pool, but columns too small to be worth it are always reduced in a single chunk.
+ */
+IVW_MODULE_TENSORVISBASE_API size_t numberOfChunks(size_t size, size_t jobs);
+
+/*
+ * Calls callback(chunk, begin, end) for each of the chunks of [0, size). The calling thread
+ * processes chunks as well and only waits for chunks that are already being processed, so this
+ * can be used from within pool tasks without starving the pool. Rethrows the first exception
+ * thrown by the callback once all chunks are done.
+ */
+IVW_MODULE_TENSORVISBASE_API void forEachChunk(
+    size_t size, size_t chunks, const std::function<void(size_t, size_t, size_t)> &callback);
+
+template <typename T>
+dvec4 toDVec4(const T &value) {
+    dvec4 res{0.0};
+    for (size_t i = 0; i < util::extent<T>::value; ++i) {
+        res[static_cast<glm::length_t>(i)] = static_cast<double>(util::glmcomp(value, i));
+    }
+    return res;
+}
+}  // namespace detail
+
+/*
+ * Computes the statistics of size values. The column is split into one contiguous chunk per job
+ * and the partial results of the chunks are combined, the inner loops only use element-wise
+ * glm::min, glm::max and additions and can be vectorized by the compiler.
+ */
+template <typename T>
+DataStatistics computeStatistics(const T *data, const size_t size, const size_t jobs = 0) {
+    using Sum = typename util::same_extent<T, double>::type;
+
+    DataStatistics res;
+    res.numberOfComponents = util::extent<T>::value;
+    res.size = size;
+    if (size == 0) return res;
+
+    struct Partial {
+        T min;
+        T max;
+        Sum sum;
+    };
+
+    const auto chunks = detail::numberOfChunks(size, jobs);
+    std::vector<Partial> partials(chunks);
+    detail::forEachChunk(size, chunks, [&](size_t chunk, size_t begin, size_t end) {
+        auto min = data[begin];
+        auto max = data[begin];
+        Sum sum{0};
+        for (size_t i = begin; i < end; ++i) {
+            min = glm::min(min, data[i]);
+            max = glm::max(max, data[i]);
+            sum += static_cast<Sum>(data[i]);
+        }
+        partials[chunk] = {min, max, sum};
+    });
+
+    auto min = partials.front().min;
+    auto max = partials.front().max;
+    Sum sum{0};
+    for (const auto &partial : partials) {
+        min = glm::min(min, partial.min);
+        max = glm::max(max, partial.max);
+        sum += partial.sum;
+    }
+
+    res.min = detail::toDVec4(min);
+    res.max = detail::toDVec4(max);
+    res.mean = detail::toDVec4(sum) / static_cast<double>(size);
+    return res;
+}
+
+/*
+ * Counts the values of the given component in bins equally sized bins over range. Values outside
+ * of the range are counted in the first and last bin respectively.
+ */
+template <typename T>
+std::vector<size_t> computeHistogram(const T *data, const size_t size, const size_t bins,
+                                     const dvec2 &range, const size_t component = 0,
+                                     const size_t jobs = 0) {
+    std::vector<size_t> histogram(bins, 0);
+    if (size == 0 || bins == 0) return histogram;
+
+    const auto chunks = detail::numberOfChunks(size, jobs);
+    std::vector<std::vector<size_t>> partials(chunks, std::vector<size_t>(bins, 0));
+
+    const auto scale = range.y > range.x ? static_cast<double>(bins) / (range.y - range.x) : 0.0;
+    const auto maxBin = static_cast<double>(bins - 1);
+    detail::forEachChunk(size, chunks, [&](size_t chunk, size_t begin, size_t end) {
+        auto &counts = partials[chunk];
+        for (size_t i = begin; i < end; ++i) {
+            const auto value = static_cast<double>(util::glmcomp(data[i], component));
+            const auto bin = std::clamp(std::floor((value - range.x) * scale), 0.0, maxBin);
+            ++counts[static_cast<size_t>(bin)];
+        }
+    });
+
+    for (const auto &counts : partials) {
+        std::transform(counts.begin(), counts.end(), histogram.begin(), histogram.begin(),
+                       std::plus<size_t>());
+    }
+    return histogram;
+}
+
+}  // namespace tensorutil
+}  // namespace inviwo
@@ -58,6 +58,10 @@ IVW_MODULE_TENSORVISBASE_API void bindTensorFieldAsColorTextures(
     std::shared_ptr<const TensorField3D> &tensorField, Shader *shader,
     TextureUnitContainer &textureUnits);
 
+/*
+ * Point sampled resizing of tensor fields, see resample() in tensorfieldresampling.h for filtered
+ * downsampling. The progress callback of subsample3D is called once per finished brick.
+ */
 std::shared_ptr<TensorField2D> IVW_MODULE_TENSORVISBASE_API
 subsample2D(std::shared_ptr<const TensorField2D> tensorField, size2_t newDimensions,
             const InterpolationMethod method = InterpolationMethod::Barycentric);
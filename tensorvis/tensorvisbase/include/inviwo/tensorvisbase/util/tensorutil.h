@@ -37,6 +37,7 @@
 #include <modules/eigenutils/eigenutils.h>
 #include <modules/opengl/shader/shaderutils.h>
 #include <inviwo/tensorvisbase/tensorvisbasemoduledefine.h>
+#include <inviwo/tensorvisbase/datastructures/tensorstorage.h>
 
 namespace inviwo {
 namespace tensorutil {
@@ -180,6 +181,49 @@ std::array<double, 3> IVW_MODULE_TENSORVISBASE_API calculateEigenValues(const dm
 
 dmat3 IVW_MODULE_TENSORVISBASE_API calculateEigenSystem(const dmat3 &tensor);
 
+/*
+ * Returns true if the tensor is symmetric, i.e. its off-diagonal entries differ by at most epsilon
+ * relative to their magnitude.
+ */
+bool IVW_MODULE_TENSORVISBASE_API isSymmetric(const dmat3 &tensor, double epsilon = 1e-12);
+
+/*
+ * Eigenvalues and eigenvectors of a symmetric tensor, only the symmetric part of the tensor is
+ * considered. The eigenvalues are computed in closed form and the eigenvectors from the null space
+ * of T - lambda * I. For (nearly) repeated eigenvalues the closed form eigenvectors are ill
+ * conditioned, in that case the Jacobi method is used instead.
+ * The result is sorted by descending eigenvalue and every eigenvector is a unit vector whose
+ * largest component is positive. A zero tensor yields zero eigenvalues and zero vectors.
+ */
+std::array<std::pair<double, dvec3>, 3> IVW_MODULE_TENSORVISBASE_API
+calculateSymmetricEigenValuesAndEigenVectors(const dmat3 &tensor);
+
+/*
+ * Same as calculateSymmetricEigenValuesAndEigenVectors but always uses cyclic Jacobi rotations.
+ */
+std::array<std::pair<double, dvec3>, 3> IVW_MODULE_TENSORVISBASE_API
+calculateSymmetricEigenValuesAndEigenVectorsJacobi(const dmat3 &tensor);
+
+/*
+ * Closed form eigenvalues of the symmetric part of the tensor, sorted in descending order.
+ */
+std::array<double, 3> IVW_MODULE_TENSORVISBASE_API
+calculateSymmetricEigenValues(const dmat3 &tensor);
+
+/*
+ * Batched version of calculateSymmetricEigenValuesAndEigenVectors for count packed tensors. The
+ * eigenvalues of the whole batch are computed in one loop without data dependent branches before
+ * the eigenvectors are determined. All output arrays need to hold count elements.
+ */
+void IVW_MODULE_TENSORVISBASE_API calculateSymmetricEigenValuesAndEigenVectors(
+    const SymmetricTensor3<double> *tensors, size_t count, double *majorEigenValues,
+    double *middleEigenValues, double *minorEigenValues, dvec3 *majorEigenVectors,
+    dvec3 *middleEigenVectors, dvec3 *minorEigenVectors);
+void IVW_MODULE_TENSORVISBASE_API calculateSymmetricEigenValuesAndEigenVectors(
+    const SymmetricTensor3<float> *tensors, size_t count, double *majorEigenValues,
+    double *middleEigenValues, double *minorEigenValues, dvec3 *majorEigenVectors,
+    dvec3 *middleEigenVectors, dvec3 *minorEigenVectors);
+
 static const std::string lamda_str{u8"λ"};
 
 static const std::string lamda1_str{u8"λ₁"};
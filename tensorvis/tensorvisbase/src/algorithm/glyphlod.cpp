@@ -0,0 +1,167 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/tensorvisbase/algorithm/glyphlod.h>
+#include <inviwo/tensorvisbase/util/datareductions.h>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace inviwo {
+
+size_t GlyphLodSelection::getNumberOfVisibleGlyphs() const {
+    return std::accumulate(instances.begin(), instances.end(), size_t{0},
+                           [](size_t sum, const std::vector<size_t> &level) {
+                               return sum + level.size();
+                           });
+}
+
+namespace util {
+
+namespace {
+vec4 row(const mat4 &m, glm::length_t i) { return vec4(m[0][i], m[1][i], m[2][i], m[3][i]); }
+
+float frobenius(const mat3 &m) {
+    return std::sqrt(glm::length2(m[0]) + glm::length2(m[1]) + glm::length2(m[2]));
+}
+}  // namespace
+
+float glyphBoundingRadius(const TensorGlyphType type, const TensorGlyphInstance &instance) {
+    const auto &frame = instance.frame;
+    // |frame * u| <= |frame|_F for unit vectors u, superquadrics lie within the unit cube
+    const auto columns = glm::length(frame[0]) + glm::length(frame[1]) + glm::length(frame[2]);
+
+    switch (type) {
+        case TensorGlyphType::Reynolds:
+            return frobenius(frame) * instance.shape.x;
+        case TensorGlyphType::HYW:
+            return frobenius(frame) * instance.shape.y;
+        case TensorGlyphType::CombinedReynoldsHYW:
+            return frobenius(frame) * std::max(instance.shape.x, instance.shape.y);
+        case TensorGlyphType::Superquadric:
+            return columns;
+        case TensorGlyphType::Quadric:
+        default:
+            return frobenius(frame);
+    }
+}
+
+std::vector<size2_t> glyphLodResolutions(const size2_t &maxResolution,
+                                         const GlyphLodSettings &settings) {
+    std::vector<size2_t> resolutions{maxResolution};
+    if (!settings.lod) return resolutions;
+
+    for (size_t level = 1; level < settings.levels; ++level) {
+        const auto res = glm::max(resolutions.back() / size_t{2},
+                                  glm::min(settings.minResolution, maxResolution));
+        if (res == resolutions.back()) break;
+        resolutions.push_back(res);
+    }
+    return resolutions;
+}
+
+float projectedRadius(const vec3 &center, const float radius, const mat4 &worldToClip,
+                      const size2_t &viewport) {
+    // Scale of the projection in x and y, the w row is constant for orthographic projections
+    const auto sx = glm::length(vec3(row(worldToClip, 0)));
+    const auto sy = glm::length(vec3(row(worldToClip, 1)));
+    const auto w = glm::dot(row(worldToClip, 3), vec4(center, 1.0f));
+
+    const auto ndcRadius = radius / std::max(std::abs(w), 1.0e-6f);
+    return 0.5f * ndcRadius *
+           std::max(sx * static_cast<float>(viewport.x), sy * static_cast<float>(viewport.y));
+}
+
+bool isInFrustum(const vec3 &center, const float radius, const mat4 &worldToClip) {
+    const auto w = row(worldToClip, 3);
+    for (glm::length_t i = 0; i < 3; ++i) {
+        const auto r = row(worldToClip, i);
+        for (const auto &plane : {w + r, w - r}) {
+            const auto length = glm::length(vec3(plane));
+            if (glm::dot(vec3(plane), center) + plane.w < -radius * length) return false;
+        }
+    }
+    return true;
+}
+
+int selectGlyphLod(const vec3 &center, const float radius, const mat4 &worldToClip,
+                   const size2_t &viewport, const std::vector<size2_t> &resolutions,
+                   const GlyphLodSettings &settings) {
+    if (settings.cull && !isInFrustum(center, radius, worldToClip)) return -1;
+    if (!settings.cull && !settings.lod) return 0;
+
+    const auto pixels = projectedRadius(center, radius, worldToClip, viewport);
+    if (settings.cull && pixels < settings.minPixelRadius) return -1;
+    if (!settings.lod) return 0;
+
+    // Coarsest level where the segments around the silhouette are at most pixelsPerSegment long
+    const auto segments = glm::two_pi<float>() * pixels / settings.pixelsPerSegment;
+    for (int level = static_cast<int>(resolutions.size()) - 1; level > 0; --level) {
+        if (static_cast<float>(resolutions[level].x) >= segments) return level;
+    }
+    return 0;
+}
+
+GlyphLodSelection selectGlyphLods(const TensorGlyphInstances &glyphs, const mat4 &worldToClip,
+                                  const size2_t &viewport, const GlyphLodSettings &settings,
+                                  const size_t jobs) {
+    GlyphLodSelection selection;
+    selection.resolutions = glyphLodResolutions(glyphs.getResolution(), settings);
+    selection.instances.resize(selection.resolutions.size());
+
+    const auto &instances = glyphs.getInstances();
+    std::vector<int> levels(instances.size());
+    const auto select = [&](size_t i) {
+        const auto &instance = instances[i];
+        levels[i] = selectGlyphLod(instance.position,
+                                   glyphBoundingRadius(glyphs.getType(), instance), worldToClip,
+                                   viewport, selection.resolutions, settings);
+    };
+
+    const auto chunks = tensorutil::detail::numberOfChunks(instances.size(), jobs);
+    tensorutil::detail::forEachChunk(instances.size(), chunks,
+                                     [&](size_t, size_t begin, size_t end) {
+                                         for (size_t i = begin; i < end; ++i) select(i);
+                                     });
+
+    for (size_t i = 0; i < levels.size(); ++i) {
+        if (levels[i] < 0) {
+            ++selection.culled;
+        } else {
+            selection.instances[levels[i]].push_back(i);
+        }
+    }
+
+    return selection;
+}
+
+}  // namespace util
+
+}  // namespace inviwo
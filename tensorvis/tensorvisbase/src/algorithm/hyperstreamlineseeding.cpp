@@ -0,0 +1,116 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/tensorvisbase/algorithm/hyperstreamlineseeding.h>
+#include <inviwo/tensorvisbase/datastructures/metadatacolumnview.h>
+#include <inviwo/core/util/exception.h>
+
+#include <algorithm>
+#include <random>
+
+namespace inviwo {
+namespace tensorutil {
+
+std::vector<double> featureWeights(const TensorField3D &tensorField, const TensorFeature feature) {
+    const auto id = static_cast<uint64_t>(feature);
+    if (!tensorField.hasMetaData(id)) {
+        throw Exception("Tensor field has no metadata for the seeding feature",
+                        IVW_CONTEXT_CUSTOM("tensorutil::featureWeights"));
+    }
+
+    const auto column = MetaDataColumnView::fromMetaData(*tensorField.getMetaDataContainer(id));
+    if (column.getNumberOfComponents() != 1) {
+        throw Exception("Seeding feature has to be scalar",
+                        IVW_CONTEXT_CUSTOM("tensorutil::featureWeights"));
+    }
+
+    std::vector<double> weights(column.size());
+    column.copyTo(weights.data(), MetaDataPrecision::Float64);
+
+    const auto hasMask = tensorField.hasMask();
+    for (size_t i = 0; i < weights.size(); ++i) {
+        if (weights[i] < 0.0 || (hasMask && !tensorField.getMask()[i])) weights[i] = 0.0;
+    }
+
+    return weights;
+}
+
+std::vector<dvec3> weightedSeeds(const std::vector<double> &weights, const size3_t &dimensions,
+                                 const size_t count, const std::uint32_t randomSeed) {
+    if (weights.size() != dimensions.x * dimensions.y * dimensions.z) {
+        throw Exception("Number of weights does not match the dimensions",
+                        IVW_CONTEXT_CUSTOM("tensorutil::weightedSeeds"));
+    }
+    if (std::none_of(weights.begin(), weights.end(), [](double w) { return w > 0.0; })) {
+        throw Exception("All seeding weights are zero",
+                        IVW_CONTEXT_CUSTOM("tensorutil::weightedSeeds"));
+    }
+
+    std::mt19937 gen(randomSeed);
+    std::discrete_distribution<size_t> voxelDist(weights.begin(), weights.end());
+    std::uniform_real_distribution<double> jitter(0.0, 1.0);
+
+    const util::IndexMapper3D indexMapper(dimensions);
+    std::vector<dvec3> seeds(count);
+    for (auto &seed : seeds) {
+        const auto voxel = indexMapper(voxelDist(gen));
+        const dvec3 offset(jitter(gen), jitter(gen), jitter(gen));
+        seed = (dvec3(voxel) + offset) / dvec3(dimensions);
+    }
+
+    return seeds;
+}
+
+std::vector<dvec3> evenlySpacedSeeds(const HyperStreamLineOccupancyGrid &grid, size_t spacing,
+                                     const size_t round) {
+    spacing = std::max(spacing, size_t{1});
+    const auto dims = grid.getDimensions();
+    const size3_t offset(round % spacing, (round / spacing) % spacing,
+                         (round / (spacing * spacing)) % spacing);
+
+    std::vector<dvec3> seeds;
+    for (auto z = offset.z; z < dims.z; z += spacing) {
+        for (auto y = offset.y; y < dims.y; y += spacing) {
+            for (auto x = offset.x; x < dims.x; x += spacing) {
+                const auto cell = x + dims.x * (y + dims.y * z);
+                if (grid.getCount(cell) == 0) seeds.push_back(grid.cellCenter(cell));
+            }
+        }
+    }
+
+    return seeds;
+}
+
+size_t numberOfSeedingRounds(size_t spacing) {
+    spacing = std::max(spacing, size_t{1});
+    return spacing * spacing * spacing;
+}
+
+}  // namespace tensorutil
+}  // namespace inviwo
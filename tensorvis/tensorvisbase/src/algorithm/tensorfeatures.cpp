@@ -0,0 +1,267 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019-2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/tensorvisbase/algorithm/tensorfeatures.h>
+#include <inviwo/tensorvisbase/util/tensorutil.h>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <iterator>
+#include <limits>
+
+namespace inviwo {
+namespace tensorutil {
+
+namespace {
+bool isInvariant(const TensorFeature feature) {
+    switch (feature) {
+        case TensorFeature::I1:
+        case TensorFeature::I2:
+        case TensorFeature::I3:
+        case TensorFeature::J1:
+        case TensorFeature::J2:
+        case TensorFeature::J3:
+        case TensorFeature::LodeAngle:
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool requiresSortedMagnitudes(const TensorFeature feature) {
+    return feature == TensorFeature::LinearAnisotropy ||
+           feature == TensorFeature::PlanarAnisotropy ||
+           feature == TensorFeature::SphericalAnisotropy;
+}
+
+struct Sample {
+    dmat3 tensor{0.0};
+    // major, intermediate, minor
+    std::array<double, 3> eigenValues{{0.0, 0.0, 0.0}};
+    // Absolute eigenvalues sorted in descending order
+    std::array<double, 3> magnitudes{{0.0, 0.0, 0.0}};
+};
+
+double anisotropyDenominator(const std::array<double, 3> &magnitudes) {
+    return std::max(magnitudes[0] + magnitudes[1] + magnitudes[2],
+                    std::numeric_limits<double>::epsilon());
+}
+
+double evaluate(const TensorFeature feature, const Sample &s) {
+    const auto &ev = s.eigenValues;
+    switch (feature) {
+        case TensorFeature::I1:
+            return calculateI1(s.tensor);
+        case TensorFeature::I2:
+            return calculateI2(s.tensor);
+        case TensorFeature::I3:
+            return calculateI3(s.tensor);
+        case TensorFeature::J1:
+            return calculateJ1(s.tensor);
+        case TensorFeature::J2:
+            return calculateJ2(s.tensor);
+        case TensorFeature::J3:
+            return calculateJ3(s.tensor);
+        case TensorFeature::LodeAngle:
+            return calculateLodeAngle(s.tensor);
+        case TensorFeature::Anisotropy:
+            return std::abs(ev[0] - ev[2]);
+        case TensorFeature::LinearAnisotropy:
+            return (s.magnitudes[0] - s.magnitudes[1]) / anisotropyDenominator(s.magnitudes);
+        case TensorFeature::PlanarAnisotropy:
+            return (2.0 * (s.magnitudes[1] - s.magnitudes[2])) /
+                   anisotropyDenominator(s.magnitudes);
+        case TensorFeature::SphericalAnisotropy:
+            return (3.0 * s.magnitudes[2]) / anisotropyDenominator(s.magnitudes);
+        case TensorFeature::Diffusivity:
+            return ev[0] * ev[0] + ev[1] * ev[1] + ev[2] * ev[2];
+        case TensorFeature::ShearStress:
+            return (ev[0] - ev[2]) / 2.0;
+        case TensorFeature::ShapeFactor:
+            return (ev[0] - ev[1]) / (ev[0] - ev[2]);
+        case TensorFeature::IsotropicScaling:
+            return (ev[0] + ev[1] + ev[2]) / 3.0;
+        case TensorFeature::FrobeniusNorm:
+            return std::sqrt(ev[0] * ev[0] + ev[1] * ev[1] + ev[2] * ev[2]);
+        case TensorFeature::HillYieldCriterion:
+            // Hill's criterion for an isotropic material (F = G = H = 1/2, L = M = N = 3/2) in
+            // the principal frame, where the shear terms vanish
+            return std::sqrt(0.5 * ((ev[0] - ev[1]) * (ev[0] - ev[1]) +
+                                    (ev[1] - ev[2]) * (ev[1] - ev[2]) +
+                                    (ev[2] - ev[0]) * (ev[2] - ev[0])));
+        case TensorFeature::PureShear:
+        case TensorFeature::Rotation:
+        default:
+            return 0.0;
+    }
+}
+}  // namespace
+
+bool isScalarTensorFeature(const TensorFeature feature) {
+    switch (feature) {
+        case TensorFeature::Anisotropy:
+        case TensorFeature::LinearAnisotropy:
+        case TensorFeature::PlanarAnisotropy:
+        case TensorFeature::SphericalAnisotropy:
+        case TensorFeature::Diffusivity:
+        case TensorFeature::ShearStress:
+        case TensorFeature::PureShear:
+        case TensorFeature::ShapeFactor:
+        case TensorFeature::IsotropicScaling:
+        case TensorFeature::Rotation:
+        case TensorFeature::FrobeniusNorm:
+        case TensorFeature::HillYieldCriterion:
+            return true;
+        default:
+            return isInvariant(feature);
+    }
+}
+
+bool requiresEigenValues(const TensorFeature feature) {
+    return isScalarTensorFeature(feature) && !isInvariant(feature) &&
+           feature != TensorFeature::PureShear && feature != TensorFeature::Rotation;
+}
+
+std::unique_ptr<MetaDataBase> createMetaData(const TensorFeature feature,
+                                             std::vector<double> data) {
+    switch (feature) {
+        case TensorFeature::I1:
+            return std::make_unique<I1>(std::move(data), feature);
+        case TensorFeature::I2:
+            return std::make_unique<I2>(std::move(data), feature);
+        case TensorFeature::I3:
+            return std::make_unique<I3>(std::move(data), feature);
+        case TensorFeature::J1:
+            return std::make_unique<J1>(std::move(data), feature);
+        case TensorFeature::J2:
+            return std::make_unique<J2>(std::move(data), feature);
+        case TensorFeature::J3:
+            return std::make_unique<J3>(std::move(data), feature);
+        case TensorFeature::Sigma1:
+            return std::make_unique<MajorEigenValues>(std::move(data), feature);
+        case TensorFeature::Sigma2:
+            return std::make_unique<IntermediateEigenValues>(std::move(data), feature);
+        case TensorFeature::Sigma3:
+            return std::make_unique<MinorEigenValues>(std::move(data), feature);
+        case TensorFeature::LodeAngle:
+            return std::make_unique<LodeAngle>(std::move(data), feature);
+        case TensorFeature::Anisotropy:
+            return std::make_unique<Anisotropy>(std::move(data), feature);
+        case TensorFeature::LinearAnisotropy:
+            return std::make_unique<LinearAnisotropy>(std::move(data), feature);
+        case TensorFeature::PlanarAnisotropy:
+            return std::make_unique<PlanarAnisotropy>(std::move(data), feature);
+        case TensorFeature::SphericalAnisotropy:
+            return std::make_unique<SphericalAnisotropy>(std::move(data), feature);
+        case TensorFeature::Diffusivity:
+            return std::make_unique<Diffusivity>(std::move(data), feature);
+        case TensorFeature::ShearStress:
+            return std::make_unique<ShearStress>(std::move(data), feature);
+        case TensorFeature::PureShear:
+            return std::make_unique<PureShear>(std::move(data), feature);
+        case TensorFeature::ShapeFactor:
+            return std::make_unique<ShapeFactor>(std::move(data), feature);
+        case TensorFeature::IsotropicScaling:
+            return std::make_unique<IsotropicScaling>(std::move(data), feature);
+        case TensorFeature::Rotation:
+            return std::make_unique<Rotation>(std::move(data), feature);
+        case TensorFeature::FrobeniusNorm:
+            return std::make_unique<FrobeniusNorm>(std::move(data), feature);
+        case TensorFeature::HillYieldCriterion:
+            return std::make_unique<HillYieldCriterion>(std::move(data), feature);
+        default:
+            return nullptr;
+    }
+}
+
+void computeTensorFeatures(const TensorStorage3D &tensors,
+                           const std::array<const double *, 3> &eigenValues,
+                           const std::vector<TensorFeature> &features,
+                           const std::vector<double *> &columns) {
+    const auto needsTensor = std::any_of(features.begin(), features.end(), isInvariant);
+    const auto needsEigenValues =
+        std::any_of(features.begin(), features.end(), requiresEigenValues);
+    const auto needsMagnitudes =
+        std::any_of(features.begin(), features.end(), requiresSortedMagnitudes);
+
+    const auto numFeatures = features.size();
+
+#pragma omp parallel for
+    for (int i = 0; i < static_cast<int>(tensors.size()); i++) {
+        Sample sample;
+        if (needsTensor) sample.tensor = tensors[i];
+        if (needsEigenValues) {
+            sample.eigenValues = {{eigenValues[0][i], eigenValues[1][i], eigenValues[2][i]}};
+        }
+        if (needsMagnitudes) {
+            std::transform(sample.eigenValues.begin(), sample.eigenValues.end(),
+                           sample.magnitudes.begin(), [](double v) { return std::abs(v); });
+            std::sort(sample.magnitudes.begin(), sample.magnitudes.end(), std::greater<double>());
+        }
+
+        for (size_t f = 0; f < numFeatures; f++) {
+            columns[f][i] = evaluate(features[f], sample);
+        }
+    }
+}
+
+std::vector<std::unique_ptr<MetaDataBase>> computeTensorFeatures(
+    const TensorField3D &tensorField, const std::vector<TensorFeature> &features) {
+    std::vector<TensorFeature> scalarFeatures;
+    std::copy_if(features.begin(), features.end(), std::back_inserter(scalarFeatures),
+                 isScalarTensorFeature);
+
+    std::array<const double *, 3> eigenValues{{nullptr, nullptr, nullptr}};
+    if (std::any_of(scalarFeatures.begin(), scalarFeatures.end(), requiresEigenValues)) {
+        eigenValues = {{tensorField.majorEigenValues().data(),
+                        tensorField.middleEigenValues().data(),
+                        tensorField.minorEigenValues().data()}};
+    }
+
+    const auto &tensors = tensorField.tensors();
+
+    std::vector<std::vector<double>> data(scalarFeatures.size());
+    std::vector<double *> columns;
+    for (auto &column : data) {
+        column.resize(tensors.size());
+        columns.push_back(column.data());
+    }
+
+    computeTensorFeatures(tensors, eigenValues, scalarFeatures, columns);
+
+    std::vector<std::unique_ptr<MetaDataBase>> metaData;
+    for (size_t i = 0; i < scalarFeatures.size(); i++) {
+        metaData.push_back(createMetaData(scalarFeatures[i], std::move(data[i])));
+    }
+    return metaData;
+}
+
+}  // namespace tensorutil
+}  // namespace inviwo
@@ -0,0 +1,139 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/tensorvisbase/algorithm/tensorfieldanisotropy.h>
+#include <inviwo/tensorvisbase/util/datareductions.h>
+#include <inviwo/core/datastructures/volume/volumeram.h>
+#include <inviwo/core/util/exception.h>
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+
+namespace inviwo {
+namespace tensorutil {
+
+size_t numberOfChannels(const Anisotropy measure) {
+    return measure == Anisotropy::barycentric ? 3 : 1;
+}
+
+size_t evaluateAnisotropy(const Anisotropy measure, const std::array<double, 3> &eigenValues,
+                          double *out) {
+    switch (measure) {
+        case Anisotropy::abs_lamda1_minus_lamda2:
+            out[0] = glm::abs(eigenValues[0] - eigenValues[1]);
+            return 1;
+        case Anisotropy::abs_lamda1_minus_lamda3:
+            out[0] = glm::abs(eigenValues[0] - eigenValues[2]);
+            return 1;
+        case Anisotropy::abs_lamda1_minus_abs_lamda2:
+            out[0] = glm::abs(eigenValues[0]) - glm::abs(eigenValues[2]);
+            return 1;
+        case Anisotropy::barycentric:
+        default: {
+            auto abs = std::array<double, 3>{glm::abs(eigenValues[0]), glm::abs(eigenValues[1]),
+                                             glm::abs(eigenValues[2])};
+            std::sort(abs.begin(), abs.end(), std::greater<double>());
+
+            const auto denominator =
+                std::max(abs[0] + abs[1] + abs[2], std::numeric_limits<double>::epsilon());
+            out[0] = (abs[0] - abs[1]) / denominator;
+            out[1] = (2.0 * (abs[1] - abs[2])) / denominator;
+            out[2] = (3.0 * abs[2]) / denominator;
+            return 3;
+        }
+    }
+}
+
+std::shared_ptr<Volume> computeAnisotropy(const TensorField3D &tensorField,
+                                          const std::vector<Anisotropy> &measures,
+                                          const size_t jobs) {
+    size_t channels = 0;
+    for (const auto measure : measures) channels += numberOfChannels(measure);
+    if (channels == 0 || channels > 4) {
+        throw Exception("The anisotropy measures need " + std::to_string(channels) +
+                            " channels, 1 to 4 are supported",
+                        IVW_CONTEXT_CUSTOM("tensorutil::computeAnisotropy"));
+    }
+
+    auto volume = std::make_shared<Volume>(tensorField.getDimensions(),
+                                           DataFormatBase::get(NumericType::Float, channels, 32));
+    auto data =
+        static_cast<glm::f32 *>(volume->getEditableRepresentation<VolumeRAM>()->getData());
+
+    const auto &majorEigenValues = tensorField.majorEigenValues();
+    const auto &intermediateEigenValues = tensorField.middleEigenValues();
+    const auto &minorEigenValues = tensorField.minorEigenValues();
+
+    const auto size = tensorField.getSize();
+    const auto chunks = detail::numberOfChunks(size, jobs);
+    const auto emptyRange =
+        dvec2(std::numeric_limits<double>::max(), std::numeric_limits<double>::lowest());
+    std::vector<dvec2> ranges(chunks, emptyRange);
+
+    detail::forEachChunk(size, chunks, [&](size_t chunk, size_t begin, size_t end) {
+        auto range = emptyRange;
+        std::array<double, 4> values;
+        for (size_t i = begin; i < end; ++i) {
+            const std::array<double, 3> eigenValues{
+                {majorEigenValues[i], intermediateEigenValues[i], minorEigenValues[i]}};
+
+            size_t channel = 0;
+            for (const auto measure : measures) {
+                channel += evaluateAnisotropy(measure, eigenValues, &values[channel]);
+            }
+
+            auto dst = data + i * channels;
+            for (size_t c = 0; c < channels; ++c) {
+                range.x = std::min(range.x, values[c]);
+                range.y = std::max(range.y, values[c]);
+                dst[c] = static_cast<glm::f32>(values[c]);
+            }
+        }
+        ranges[chunk] = range;
+    });
+
+    auto range = emptyRange;
+    for (const auto &r : ranges) {
+        range.x = std::min(range.x, r.x);
+        range.y = std::max(range.y, r.y);
+    }
+    volume->dataMap_.dataRange = range;
+    volume->dataMap_.valueRange = range;
+
+    const auto extents = tensorField.getExtents();
+    volume->setBasis(
+        mat3(vec3(extents.x, 0., 0.), vec3(0., extents.y, 0.), vec3(0., 0., extents.z)));
+    volume->setOffset(tensorField.getOffset());
+
+    return volume;
+}
+
+}  // namespace tensorutil
+}  // namespace inviwo
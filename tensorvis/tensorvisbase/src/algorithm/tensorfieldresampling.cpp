@@ -0,0 +1,345 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/tensorvisbase/algorithm/tensorfieldresampling.h>
+#include <inviwo/tensorvisbase/util/tensorfieldutil.h>
+#include <inviwo/tensorvisbase/util/datareductions.h>
+#include <inviwo/tensorvisbase/util/tensorutil.h>
+#include <inviwo/core/util/exception.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <mutex>
+
+namespace inviwo {
+namespace tensorutil {
+
+namespace {
+struct Tap {
+    size_t index;
+    double weight;
+};
+
+// Source voxels and their weights for every output voxel along one axis
+using AxisTaps = std::vector<std::vector<Tap>>;
+
+AxisTaps axisTaps(const size_t srcDim, const size_t dstDim, const ResamplingSettings &settings) {
+    const auto maxIndex = static_cast<double>(srcDim - 1);
+    // Distance between output voxels in source voxels
+    const auto spacing =
+        dstDim > 1 ? maxIndex / static_cast<double>(dstDim - 1) : static_cast<double>(srcDim);
+    const auto filter = settings.filter != ResamplingFilter::None && spacing > 1.0;
+
+    AxisTaps taps(dstDim);
+    for (size_t i = 0; i < dstDim; ++i) {
+        const auto x = dstDim > 1 ? static_cast<double>(i) * spacing : 0.5 * maxIndex;
+        auto &t = taps[i];
+
+        if (filter) {
+            // The box covers the output voxel, the Gaussian is cut off at two standard deviations
+            const auto radius = settings.filter == ResamplingFilter::Box ? 0.5 * spacing : spacing;
+            const auto sigma = 0.5 * spacing;
+            const auto first = std::max(0.0, std::ceil(x - radius - 0.5));
+            const auto last = std::min(maxIndex, std::floor(x + radius + 0.5));
+
+            double sum = 0.0;
+            for (auto j = first; j <= last; j += 1.0) {
+                const auto weight =
+                    settings.filter == ResamplingFilter::Box
+                        ? std::min(j + 0.5, x + radius) - std::max(j - 0.5, x - radius)
+                        : std::exp(-(j - x) * (j - x) / (2.0 * sigma * sigma));
+                if (weight <= 0.0) continue;
+                t.push_back({static_cast<size_t>(j), weight});
+                sum += weight;
+            }
+            for (auto &tap : t) tap.weight /= sum;
+        } else if (settings.method == InterpolationMethod::Nearest) {
+            t.push_back({static_cast<size_t>(std::round(x)), 1.0});
+        } else {
+            const auto lower = std::min(static_cast<size_t>(x), srcDim - 1);
+            const auto frac = x - static_cast<double>(lower);
+            t.push_back({lower, 1.0 - frac});
+            if (frac > 0.0 && lower + 1 < srcDim) t.push_back({lower + 1, frac});
+        }
+    }
+    return taps;
+}
+
+size_t numberOfJobs(const ResamplingSettings &settings, const size_t count) {
+    auto jobs = settings.jobs;
+    if (jobs == 0) {
+        const auto systemSettings =
+            InviwoApplication::getPtr()->getSettingsByType<SystemSettings>();
+        jobs = static_cast<size_t>(systemSettings->poolSize_.get());
+    }
+    return std::min(jobs, count);
+}
+
+/*
+ * Calls callback(i) for all i in [0, count). The resampling may itself run on the thread pool,
+ * so the calling thread takes part in the work and a single job runs serially.
+ */
+template <typename C>
+void forEachParallel(const size_t count, const ResamplingSettings &settings, C callback) {
+    const auto chunks = numberOfJobs(settings, count);
+    detail::forEachChunk(count, chunks, [&](size_t, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) callback(i);
+    });
+}
+
+/*
+ * Calls callback(begin, end) for every brick of the output, bricks are ordered like the voxels so
+ * that the bricks of one job are close in memory. 2D fields use a single layer of bricks.
+ */
+template <typename C>
+void forEachBrick(const size3_t &dims, const ResamplingSettings &settings, C callback) {
+    const auto brick = glm::min(size3_t(std::max<size_t>(settings.brickSize, 1)), dims);
+    const auto bricks = (dims + brick - size3_t(1)) / brick;
+    const auto count = glm::compMul(bricks);
+
+    std::mutex mutex;
+    size_t finished = 0;
+    forEachParallel(count, settings, [&](const size_t i) {
+        const auto begin =
+            size3_t(i % bricks.x, (i / bricks.x) % bricks.y, i / (bricks.x * bricks.y)) * brick;
+        callback(begin, glm::min(begin + brick, dims));
+
+        if (settings.progress) {
+            std::lock_guard<std::mutex> lock(mutex);
+            settings.progress(static_cast<float>(++finished) / static_cast<float>(count));
+        }
+    });
+}
+
+// Applies f to the eigenvalues of a symmetric tensor
+template <typename F>
+dmat3 applyToEigenValues(const dmat3 &tensor, F f) {
+    const auto eigenSystem = calculateSymmetricEigenValuesAndEigenVectors(tensor);
+    dmat3 res(0.0);
+    for (const auto &pair : eigenSystem) {
+        res += f(pair.first) * glm::outerProduct(pair.second, pair.second);
+    }
+    return res;
+}
+
+template <typename F>
+dmat2 applyToEigenValues(const dmat2 &tensor, F f) {
+    // Closed form for symmetric 2x2 tensors, T = m * I + (T - m * I) with eigenvalues m +- r
+    const auto mean = 0.5 * (tensor[0][0] + tensor[1][1]);
+    const auto offDiagonal = 0.5 * (tensor[0][1] + tensor[1][0]);
+    const auto halfDiff = 0.5 * (tensor[0][0] - tensor[1][1]);
+    const auto r = std::sqrt(halfDiff * halfDiff + offDiagonal * offDiagonal);
+    if (r == 0.0) return dmat2(f(mean));
+
+    const auto f1 = f(mean + r);
+    const auto f2 = f(mean - r);
+    const dmat2 deviator(halfDiff, offDiagonal, offDiagonal, -halfDiff);
+    return dmat2(0.5 * (f1 + f2)) + (0.5 * (f1 - f2) / r) * deviator;
+}
+
+template <typename Tensor>
+Tensor exponential(const Tensor &tensor) {
+    return applyToEigenValues(tensor, [](double v) { return std::exp(v); });
+}
+
+double minEigenValue(const dmat3 &tensor) { return calculateSymmetricEigenValues(tensor)[2]; }
+
+double minEigenValue(const dmat2 &tensor) {
+    const auto halfDiff = 0.5 * (tensor[0][0] - tensor[1][1]);
+    const auto offDiagonal = 0.5 * (tensor[0][1] + tensor[1][0]);
+    return 0.5 * (tensor[0][0] + tensor[1][1]) -
+           std::sqrt(halfDiff * halfDiff + offDiagonal * offDiagonal);
+}
+
+/*
+ * Matrix logarithms of the tensors, computed once per source voxel rather than once per tap.
+ * Voxels outside the mask are skipped.
+ */
+template <typename Tensor, typename Fetch>
+std::vector<Tensor> logarithms(const size_t size, Fetch fetch, const glm::uint8 *mask,
+                               const ResamplingSettings &settings) {
+    std::vector<Tensor> logs(size);
+    std::atomic<bool> positiveDefinite{true};
+
+    const auto blockSize = size_t{4096};
+    forEachParallel((size + blockSize - 1) / blockSize, settings, [&](const size_t block) {
+        for (size_t i = block * blockSize; i < std::min(size, (block + 1) * blockSize); ++i) {
+            if (mask && !mask[i]) continue;
+            const auto tensor = fetch(i);
+            if (minEigenValue(tensor) <= 0.0) {
+                positiveDefinite = false;
+                continue;
+            }
+            logs[i] = applyToEigenValues(tensor, [](double v) { return std::log(v); });
+        }
+    });
+
+    if (!positiveDefinite) {
+        throw Exception("Log-Euclidean resampling requires positive definite tensors",
+                        IVW_CONTEXT_CUSTOM("tensorutil::resample"));
+    }
+    return logs;
+}
+}  // namespace
+
+std::shared_ptr<TensorField3D> resample(const std::shared_ptr<const TensorField3D> &tensorField,
+                                        const size3_t &newDimensions,
+                                        const ResamplingSettings &settings) {
+    if (glm::any(glm::equal(newDimensions, size3_t(0)))) {
+        throw Exception("Cannot resample to empty dimensions",
+                        IVW_CONTEXT_CUSTOM("tensorutil::resample"));
+    }
+
+    const auto srcDims = tensorField->getDimensions();
+    const auto &storage = tensorField->tensors();
+    const dmat3 *data = storage.data();
+    const auto mask = tensorField->hasMask() ? tensorField->getMask().data() : nullptr;
+    const auto logEuclidean = settings.space == ResamplingSpace::LogEuclidean;
+
+    std::vector<dmat3> logs;
+    if (logEuclidean) {
+        logs = logarithms<dmat3>(
+            storage.size(), [&](size_t i) { return data ? data[i] : storage[i]; }, mask, settings);
+        data = logs.data();
+    }
+    const auto fetch = [&](size_t i) { return data ? data[i] : storage[i]; };
+
+    const std::array<AxisTaps, 3> taps{axisTaps(srcDims.x, newDimensions.x, settings),
+                                       axisTaps(srcDims.y, newDimensions.y, settings),
+                                       axisTaps(srcDims.z, newDimensions.z, settings)};
+    const auto strideY = srcDims.x;
+    const auto strideZ = srcDims.x * srcDims.y;
+
+    std::vector<dmat3> tensors(glm::compMul(newDimensions));
+    std::vector<glm::uint8> newMask(mask ? tensors.size() : 0);
+
+    const auto resampleBrick = [&](const size3_t &begin, const size3_t &end) {
+        for (auto z = begin.z; z < end.z; ++z) {
+            for (auto y = begin.y; y < end.y; ++y) {
+                auto index = begin.x + newDimensions.x * (y + newDimensions.y * z);
+                for (auto x = begin.x; x < end.x; ++x, ++index) {
+                    dmat3 sum(0.0);
+                    double weightSum = 0.0;
+                    for (const auto &tz : taps[2][z]) {
+                        for (const auto &ty : taps[1][y]) {
+                            const auto offset = tz.index * strideZ + ty.index * strideY;
+                            const auto weightZY = tz.weight * ty.weight;
+                            for (const auto &tx : taps[0][x]) {
+                                const auto i = offset + tx.index;
+                                if (mask && !mask[i]) continue;
+                                const auto weight = weightZY * tx.weight;
+                                sum += weight * fetch(i);
+                                weightSum += weight;
+                            }
+                        }
+                    }
+
+                    if (weightSum > 0.0) {
+                        sum /= weightSum;
+                        tensors[index] = logEuclidean ? exponential(sum) : sum;
+                    }
+                    if (mask) newMask[index] = weightSum > 0.0 ? 1 : 0;
+                }
+            }
+        }
+    };
+    forEachBrick(newDimensions, settings, resampleBrick);
+
+    auto res = std::make_shared<TensorField3D>(
+        newDimensions, TensorStorage3D(std::move(tensors), tensorField->getStorageMode()),
+        tensorField->getExtents());
+    res->setModelMatrix(tensorField->getModelMatrix());
+    res->setWorldMatrix(tensorField->getWorldMatrix());
+    if (mask) res->setMask(newMask);
+    return res;
+}
+
+std::shared_ptr<TensorField2D> resample(const std::shared_ptr<const TensorField2D> &tensorField,
+                                        const size2_t &newDimensions,
+                                        const ResamplingSettings &settings) {
+    if (glm::any(glm::equal(newDimensions, size2_t(0)))) {
+        throw Exception("Cannot resample to empty dimensions",
+                        IVW_CONTEXT_CUSTOM("tensorutil::resample"));
+    }
+
+    const auto srcDims = tensorField->getDimensions();
+    const auto logEuclidean = settings.space == ResamplingSpace::LogEuclidean;
+
+    std::vector<dmat2> logs;
+    if (logEuclidean) {
+        const auto &src = tensorField->tensors();
+        logs = logarithms<dmat2>(
+            src.size(), [&](size_t i) { return src[i]; }, nullptr, settings);
+    }
+    const auto &src = logEuclidean ? logs : tensorField->tensors();
+
+    // Barycentric interpolation is not separable, it is only used when nothing is filtered
+    const auto filtered = settings.filter != ResamplingFilter::None &&
+                          (newDimensions.x < srcDims.x || newDimensions.y < srcDims.y);
+    const auto barycentric =
+        settings.method == InterpolationMethod::Barycentric && !filtered && !logEuclidean;
+
+    const std::array<AxisTaps, 2> taps{axisTaps(srcDims.x, newDimensions.x, settings),
+                                       axisTaps(srcDims.y, newDimensions.y, settings)};
+    const auto bounds = glm::max(dvec2(newDimensions - size2_t(1)), dvec2(1.0));
+
+    std::vector<dmat2> tensors(newDimensions.x * newDimensions.y);
+
+    const auto resampleBrick = [&](const size3_t &begin, const size3_t &end) {
+        for (auto y = begin.y; y < end.y; ++y) {
+            auto index = begin.x + newDimensions.x * y;
+            for (auto x = begin.x; x < end.x; ++x, ++index) {
+                if (barycentric) {
+                    tensors[index] = sample(tensorField, dvec2(x, y) / bounds,
+                                            InterpolationMethod::Barycentric);
+                    continue;
+                }
+
+                dmat2 sum(0.0);
+                for (const auto &ty : taps[1][y]) {
+                    const auto offset = ty.index * srcDims.x;
+                    for (const auto &tx : taps[0][x]) {
+                        sum += (ty.weight * tx.weight) * src[offset + tx.index];
+                    }
+                }
+                tensors[index] = logEuclidean ? exponential(sum) : sum;
+            }
+        }
+    };
+    forEachBrick(size3_t(newDimensions, 1), settings, resampleBrick);
+
+    auto res = std::make_shared<TensorField2D>(newDimensions, tensors,
+                                               tensorField->getExtents<double>());
+    res->setOffset(tensorField->getOffset());
+    return res;
+}
+
+}  // namespace tensorutil
+}  // namespace inviwo
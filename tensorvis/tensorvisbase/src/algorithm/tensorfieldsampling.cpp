@@ -30,7 +30,7 @@
 #include <inviwo/tensorvisbase/algorithm/tensorfieldsampling.h>
 
 namespace inviwo {
-dmat2 sample(std::shared_ptr<const TensorField2D> tensorField, const dvec2& position,
+dmat2 sample(const std::shared_ptr<const TensorField2D>& tensorField, const dvec2& position,
              const tensorutil::InterpolationMethod method) {
     const auto fBounds = tensorField->getBounds<double>();
 
@@ -114,56 +114,54 @@ dmat2 sample(std::shared_ptr<const TensorField2D> tensorField, const dvec2& posi
     return dmat2();
 }
 
-std::pair<glm::uint8, dmat3> sample(std::shared_ptr<const TensorField3D> tensorField,
-                                    const dvec3& position,
-                                    const tensorutil::InterpolationMethod method) {
-    // Position is in texture space [0,1], translate to index space
-    const auto bounds = tensorField->getBounds<double>();
-    const auto indexPosition = position * bounds;
-
-    dmat3 val{0.0};
-
-    if (method == tensorutil::InterpolationMethod::Linear) {
-        const auto xm = glm::floor(indexPosition.x);
-        const auto ym = glm::floor(indexPosition.y);
-        const auto zm = glm::floor(indexPosition.z);
-
-        const auto xp = glm::ceil(indexPosition.x);
-        const auto yp = glm::ceil(indexPosition.y);
-        const auto zp = glm::ceil(indexPosition.z);
-
-        const auto xFrac = glm::fract(position.x * bounds.x);
-        const auto yFrac = glm::fract(position.y * bounds.y);
-        const auto zFrac = glm::fract(position.z * bounds.z);
-
-        // Upper layer
-        const auto& tensor010 = tensorField->at(size3_t(xm, yp, zm)).second;
-        const auto& tensor011 = tensorField->at(size3_t(xm, yp, zp)).second;
-        const auto tensorUpperLeft = glm::mix(tensor010, tensor011, zFrac);
-
-        const auto& tensor111 = tensorField->at(size3_t(xp, yp, zp)).second;
-        const auto& tensor110 = tensorField->at(size3_t(xp, yp, zm)).second;
-        const auto tensorUpperRight = glm::mix(tensor110, tensor111, zFrac);
-
-        const auto tensorUpper = glm::mix(tensorUpperLeft, tensorUpperRight, xFrac);
-
-        // Lower layer
-        const auto& tensor000 = tensorField->at(size3_t(xm, ym, zm)).second;
-        const auto& tensor001 = tensorField->at(size3_t(xm, ym, zp)).second;
-        const auto tensorLowerLeft = glm::mix(tensor000, tensor001, zFrac);
-
-        const auto& tensor100 = tensorField->at(size3_t(xp, ym, zm)).second;
-        const auto& tensor101 = tensorField->at(size3_t(xp, ym, zp)).second;
-        const auto tensorLowerRight = glm::mix(tensor100, tensor101, zFrac);
+TensorField3DSampler::TensorField3DSampler(std::shared_ptr<const TensorField3D> tensorField)
+    : tensorField_(std::move(tensorField))
+    , tensors_(&tensorField_->tensors())
+    , data_(tensors_->data())
+    , mask_(tensorField_->hasMask() ? tensorField_->getMask().data() : nullptr)
+    , maxIndex_(tensorField_->getDimensions() - size3_t(1))
+    , strideY_(tensorField_->getDimensions().x)
+    , strideZ_(tensorField_->getDimensions().x * tensorField_->getDimensions().y)
+    , indexScale_(tensorField_->getBounds<double>()) {}
+
+TensorField3DSampler::Sample TensorField3DSampler::sample(
+    const dvec3& position, const tensorutil::InterpolationMethod method) const {
+    if (method == tensorutil::InterpolationMethod::Nearest) {
+        return sample<tensorutil::InterpolationMethod::Nearest>(position);
+    }
+    return sample<tensorutil::InterpolationMethod::Linear>(position);
+}
 
-        const auto tensorLower = glm::mix(tensorLowerLeft, tensorLowerRight, xFrac);
+template <tensorutil::InterpolationMethod method>
+void TensorField3DSampler::sampleAll(const dvec3* positions, const size_t count, dmat3* tensors,
+                                     glm::uint8* mask) const {
+    for (size_t i = 0; i < count; ++i) {
+        const auto res = sample<method>(positions[i]);
+        tensors[i] = res.second;
+        if (mask) mask[i] = res.first;
+    }
+}
 
-        val = glm::mix(tensorLower, tensorUpper, yFrac);
+void TensorField3DSampler::sample(const dvec3* positions, const size_t count, dmat3* tensors,
+                                  glm::uint8* mask,
+                                  const tensorutil::InterpolationMethod method) const {
+    if (method == tensorutil::InterpolationMethod::Nearest) {
+        sampleAll<tensorutil::InterpolationMethod::Nearest>(positions, count, tensors, mask);
     } else {
-        if (method == tensorutil::InterpolationMethod::Nearest) {
-            val = tensorField->at(size3_t(glm::round(indexPosition))).second;
-        }
+        sampleAll<tensorutil::InterpolationMethod::Linear>(positions, count, tensors, mask);
     }
-    return std::pair<glm::uint8, dmat3>(glm::uint8{1}, dmat3());
 }
-}  // namespace inviwo
\ No newline at end of file
+
+std::vector<dmat3> TensorField3DSampler::sample(
+    const std::vector<dvec3>& positions, const tensorutil::InterpolationMethod method) const {
+    std::vector<dmat3> tensors(positions.size());
+    sample(positions.data(), positions.size(), tensors.data(), nullptr, method);
+    return tensors;
+}
+
+std::pair<glm::uint8, dmat3> sample(const std::shared_ptr<const TensorField3D>& tensorField,
+                                    const dvec3& position,
+                                    const tensorutil::InterpolationMethod method) {
+    return TensorField3DSampler(tensorField).sample(position, method);
+}
+}  // namespace inviwo
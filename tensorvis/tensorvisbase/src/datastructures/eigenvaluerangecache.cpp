@@ -0,0 +1,78 @@
+#include <inviwo/tensorvisbase/datastructures/eigenvaluerangecache.h>
+#include <inviwo/tensorvisbase/algorithm/tensorfieldresampling.h>
+
+#include <algorithm>
+#include <limits>
+
+namespace inviwo {
+
+namespace {
+template <typename F>
+dvec2 nonZeroRange(const size_t size, F value) {
+    auto range = dvec2(std::numeric_limits<double>::max(), std::numeric_limits<double>::lowest());
+    auto nonZero = range;
+    for (size_t i = 0; i < size; ++i) {
+        const auto v = value(i);
+        range.x = std::min(range.x, v);
+        range.y = std::max(range.y, v);
+        if (v >= std::numeric_limits<double>::epsilon()) {
+            nonZero.x = std::min(nonZero.x, v);
+            nonZero.y = std::max(nonZero.y, v);
+        }
+    }
+    if (size == 0) return dvec2(0.0);
+    // Only skip the zeros if there is anything else
+    return range.x == 0.0 && nonZero.x <= nonZero.y ? nonZero : range;
+}
+
+bool isSameField(const std::weak_ptr<const TensorField2D> &cached,
+                 const std::shared_ptr<const TensorField2D> &tensorField) {
+    return tensorField && cached.lock() == tensorField;
+}
+}  // namespace
+
+EigenValueRanges EigenValueRanges::compute(const std::shared_ptr<const TensorField2D> &tensorField,
+                                           const size2_t &resolution, const size_t jobs) {
+    tensorutil::ResamplingSettings settings;
+    settings.method = tensorutil::InterpolationMethod::Barycentric;
+    settings.filter = tensorutil::ResamplingFilter::None;
+    settings.jobs = jobs;
+    const auto resampled = tensorutil::resample(tensorField, resolution, settings);
+    const auto &major = resampled->majorEigenValues();
+    const auto &minor = resampled->minorEigenValues();
+
+    EigenValueRanges ranges;
+    ranges.major = nonZeroRange(major.size(), [&](size_t i) { return major[i]; });
+    ranges.minor = nonZeroRange(minor.size(), [&](size_t i) { return minor[i]; });
+    ranges.anisotropy =
+        nonZeroRange(major.size(), [&](size_t i) { return glm::abs(major[i] - minor[i]); });
+    return ranges;
+}
+
+const EigenValueRanges &EigenValueRangeCache::getRanges(
+    const std::shared_ptr<const TensorField2D> &tensorField, const size2_t &resolution) {
+    if (!isSameField(rangesField_, tensorField) || resolution_ != resolution) {
+        ranges_ = EigenValueRanges::compute(tensorField, resolution, jobs_);
+        rangesField_ = tensorField;
+        resolution_ = resolution;
+        ++computations_;
+    }
+    return ranges_;
+}
+
+std::shared_ptr<const Image> EigenValueRangeCache::getImage(
+    const std::shared_ptr<const TensorField2D> &tensorField) {
+    if (!isSameField(imageField_, tensorField)) {
+        image_ = tensorField->getImageRepresentation();
+        imageField_ = tensorField;
+    }
+    return image_;
+}
+
+void EigenValueRangeCache::clear() {
+    rangesField_.reset();
+    imageField_.reset();
+    image_.reset();
+}
+
+}  // namespace inviwo
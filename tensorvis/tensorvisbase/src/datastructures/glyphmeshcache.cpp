@@ -0,0 +1,148 @@
+#include <inviwo/tensorvisbase/datastructures/glyphmeshcache.h>
+#include <inviwo/core/util/hashcombine.h>
+
+#include <cmath>
+
+namespace inviwo {
+
+GlyphMeshCache::GlyphMeshCache(const size_t maxSizeInBytes, const double quantization)
+    : maxSizeInBytes_(maxSizeInBytes), quantization_(quantization) {}
+
+GlyphMeshCache::Key GlyphMeshCache::makeKey(const TensorGlyphType type, const size2_t &resolution,
+                                            const dvec4 &shape, const vec4 &color) const {
+    Key key{type, resolution, {}, 0};
+    for (glm::length_t i = 0; i < 4; ++i) {
+        key.shape[i] = static_cast<std::int32_t>(std::lround(shape[i] / quantization_));
+    }
+
+    const auto rgba = glm::u8vec4(glm::round(glm::clamp(color, vec4(0.0f), vec4(1.0f)) * 255.0f));
+    key.color = (static_cast<std::uint32_t>(rgba.r) << 24) |
+                (static_cast<std::uint32_t>(rgba.g) << 16) |
+                (static_cast<std::uint32_t>(rgba.b) << 8) | static_cast<std::uint32_t>(rgba.a);
+    return key;
+}
+
+dvec4 GlyphMeshCache::dequantize(const Key &key) const {
+    return dvec4(key.shape[0], key.shape[1], key.shape[2], key.shape[3]) * quantization_;
+}
+
+std::shared_ptr<const BasicMesh> GlyphMeshCache::get(
+    const Key &key, const std::function<std::shared_ptr<BasicMesh>()> &create) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = lookup_.find(key);
+        if (it != lookup_.end()) {
+            ++hits_;
+            entries_.splice(entries_.begin(), entries_, it->second);
+            return it->second->mesh;
+        }
+        ++misses_;
+    }
+
+    // Tessellate without holding the lock, other glyphs can be looked up in the meantime
+    std::shared_ptr<const BasicMesh> mesh = create();
+    const auto sizeInBytes = getSizeInBytes(*mesh);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = lookup_.find(key);
+    if (it != lookup_.end()) {  // created concurrently
+        entries_.splice(entries_.begin(), entries_, it->second);
+        return it->second->mesh;
+    }
+
+    entries_.push_front({key, mesh, sizeInBytes});
+    lookup_[key] = entries_.begin();
+    sizeInBytes_ += sizeInBytes;
+    evict();
+
+    return mesh;
+}
+
+std::shared_ptr<BasicMesh> GlyphMeshCache::instantiate(const BasicMesh &geometry) {
+    auto mesh = std::make_shared<BasicMesh>();
+    const auto &buffers = geometry.getBuffers();
+    for (size_t i = 0; i < buffers.size(); ++i) {
+        if (i < mesh->getNumberOfBuffers()) {
+            mesh->replaceBuffer(i, buffers[i].first, buffers[i].second);
+        } else {
+            mesh->addBuffer(buffers[i].first, buffers[i].second);
+        }
+    }
+    for (const auto &indexBuffer : geometry.getIndexBuffers()) {
+        mesh->addIndexBuffer(indexBuffer.first, indexBuffer.second);
+    }
+    mesh->setModelMatrix(geometry.getModelMatrix());
+    mesh->setWorldMatrix(geometry.getWorldMatrix());
+    return mesh;
+}
+
+size_t GlyphMeshCache::getSizeInBytes(const BasicMesh &mesh) {
+    size_t bytes = 0;
+    for (const auto &buffer : mesh.getBuffers()) {
+        bytes += buffer.second->getSizeInBytes();
+    }
+    for (const auto &indexBuffer : mesh.getIndexBuffers()) {
+        bytes += indexBuffer.second->getSizeInBytes();
+    }
+    return bytes;
+}
+
+size_t GlyphMeshCache::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+}
+
+size_t GlyphMeshCache::getSizeInBytes() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return sizeInBytes_;
+}
+
+size_t GlyphMeshCache::getMaxSizeInBytes() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return maxSizeInBytes_;
+}
+
+void GlyphMeshCache::setMaxSizeInBytes(const size_t maxSizeInBytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    maxSizeInBytes_ = maxSizeInBytes;
+    evict();
+}
+
+size_t GlyphMeshCache::getHits() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return hits_;
+}
+
+size_t GlyphMeshCache::getMisses() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return misses_;
+}
+
+void GlyphMeshCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+    lookup_.clear();
+    sizeInBytes_ = 0;
+}
+
+void GlyphMeshCache::evict() {
+    // Keep the most recent entry even if it alone exceeds the limit, it is in use by the caller
+    while (sizeInBytes_ > maxSizeInBytes_ && entries_.size() > 1) {
+        const auto &lru = entries_.back();
+        sizeInBytes_ -= lru.sizeInBytes;
+        lookup_.erase(lru.key);
+        entries_.pop_back();
+    }
+}
+
+size_t GlyphMeshCache::KeyHash::operator()(const Key &key) const {
+    size_t seed = 0;
+    util::hash_combine(seed, static_cast<int>(key.type));
+    util::hash_combine(seed, key.resolution.x);
+    util::hash_combine(seed, key.resolution.y);
+    for (const auto s : key.shape) util::hash_combine(seed, s);
+    util::hash_combine(seed, key.color);
+    return seed;
+}
+
+}  // namespace inviwo
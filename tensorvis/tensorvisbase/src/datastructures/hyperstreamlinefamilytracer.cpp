@@ -0,0 +1,50 @@
+#include <inviwo/tensorvisbase/datastructures/hyperstreamlinefamilytracer.h>
+#include <inviwo/tensorvisbase/util/tensorutil.h>
+
+namespace inviwo {
+
+EigenSystemSampler::EigenSystemSampler(std::shared_ptr<const TensorField3D> tensorField)
+    : sampler_(std::move(tensorField)) {}
+
+EigenSystemSampler::EigenSystem EigenSystemSampler::sample(const dvec3 &pos) const {
+    // Outside of the mask the tensor is zero, and so are its eigenvectors
+    const auto tensor = sampler_.sample<tensorutil::InterpolationMethod::Linear>(pos).second;
+    decompositions_.fetch_add(1, std::memory_order_relaxed);
+    return tensorutil::calculateSymmetricEigenValuesAndEigenVectors(tensor);
+}
+
+bool EigenSystemSampler::withinBounds(const dvec3 &pos) const {
+    return glm::all(glm::greaterThanEqual(pos, dvec3(0.0))) &&
+           glm::all(glm::lessThanEqual(pos, dvec3(1.0)));
+}
+
+HyperStreamLineFamilyTracer::HyperStreamLineFamilyTracer(
+    std::shared_ptr<const TensorField3D> tensorField, const IntegralLineProperties &properties)
+    : tensorField_(std::move(tensorField))
+    , sampler_(tensorField_)
+    , tracer_(*tensorField_, properties) {}
+
+HyperStreamLineFamilyTracer::Results HyperStreamLineFamilyTracer::traceFrom(
+    const dvec3 &pIn, const std::array<bool, 3> &families) {
+    return traceFromDataSpace(
+        detail::seedTransform<HyperStreamLineTracer::DataVector,
+                              HyperStreamLineTracer::DataHomogenousVector>(
+            tracer_.getSeedTransformationMatrix(), pIn),
+        families);
+}
+
+HyperStreamLineFamilyTracer::Results HyperStreamLineFamilyTracer::traceFromDataSpace(
+    const dvec3 &p, const std::array<bool, 3> &families) {
+    // Every family starts at the seed, decompose it once for all of them
+    const auto seed = sampler_.sample(p);
+
+    Results results;
+    for (size_t family = 0; family < 3; ++family) {
+        if (families[family]) {
+            results[family] = tracer_.traceWith(p, EigenVectorSampler(sampler_, family, &p, &seed));
+        }
+    }
+    return results;
+}
+
+}  // namespace inviwo
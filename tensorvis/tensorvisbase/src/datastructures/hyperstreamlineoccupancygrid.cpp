@@ -0,0 +1,48 @@
+#include <inviwo/tensorvisbase/datastructures/hyperstreamlineoccupancygrid.h>
+#include <inviwo/core/util/exception.h>
+
+namespace inviwo {
+
+HyperStreamLineOccupancyGrid::HyperStreamLineOccupancyGrid(const size3_t &dimensions,
+                                                           const size_t capacity)
+    : dimensions_(dimensions), capacity_(capacity) {
+    if (glm::any(glm::equal(dimensions_, size3_t(0))) || capacity_ == 0) {
+        throw Exception("Occupancy grid needs non-zero dimensions and capacity", IVW_CONTEXT);
+    }
+
+    counts_ = std::make_unique<std::atomic<std::uint32_t>[]>(getSize());
+    clear();
+}
+
+size_t HyperStreamLineOccupancyGrid::cellIndex(const dvec3 &pos) const {
+    if (glm::any(glm::lessThan(pos, dvec3(0.0))) || glm::any(glm::greaterThan(pos, dvec3(1.0)))) {
+        return npos;
+    }
+
+    // The upper boundary belongs to the last cell
+    const auto cell = glm::min(size3_t(pos * dvec3(dimensions_)), dimensions_ - size3_t(1));
+    return cell.x + dimensions_.x * (cell.y + dimensions_.y * cell.z);
+}
+
+dvec3 HyperStreamLineOccupancyGrid::cellCenter(const size_t cell) const {
+    const size3_t pos(cell % dimensions_.x, (cell / dimensions_.x) % dimensions_.y,
+                      cell / (dimensions_.x * dimensions_.y));
+    return (dvec3(pos) + 0.5) / dvec3(dimensions_);
+}
+
+bool HyperStreamLineOccupancyGrid::tryOccupy(const size_t cell) {
+    auto &count = counts_[cell];
+    auto current = count.load(std::memory_order_relaxed);
+    do {
+        if (current >= capacity_) return false;
+    } while (!count.compare_exchange_weak(current, current + 1, std::memory_order_relaxed));
+    return true;
+}
+
+void HyperStreamLineOccupancyGrid::clear() {
+    for (size_t i = 0; i < getSize(); ++i) {
+        counts_[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+}  // namespace inviwo
@@ -1,6 +1,21 @@
 #include <inviwo/tensorvisbase/datastructures/hyperstreamlinetracer.h>
+#include <inviwo/tensorvisbase/datastructures/hyperstreamlinefamilytracer.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
 
 namespace inviwo {
+
+namespace {
+
+template <typename T>
+void keepRange(std::vector<T> &values, size_t begin, size_t end) {
+    values.erase(values.begin() + end, values.end());
+    values.erase(values.begin(), values.begin() + begin);
+}
+
+}  // namespace
 HyperStreamLineTracer::HyperStreamLineTracer(
     std::shared_ptr<const SpatialSampler<3, 3, double>> sampler,
     const IntegralLineProperties &properties)
@@ -14,12 +29,43 @@ HyperStreamLineTracer::HyperStreamLineTracer(
     , seedTransformation_(
           properties.getSeedPointTransformationMatrix(sampler->getCoordinateTransformer()))
     , toWorld_(sampler->getCoordinateTransformer().getDataToWorldMatrix())
-    , transformOutputToWorldSpace_{false} {}
+    , transformOutputToWorldSpace_{false}
+    , adaptive_{false}
+    , tolerance_{1e-5}
+    , maxStepFactor_{10.0}
+    , occupancyFrozen_{false} {}
+
+HyperStreamLineTracer::HyperStreamLineTracer(const SpatialEntity<3> &entity,
+                                             const IntegralLineProperties &properties)
+    : integrationScheme_(properties.getIntegrationScheme())
+    , steps_(properties.getNumberOfSteps())
+    , stepSize_(properties.getStepSize())
+    , dir_(properties.getStepDirection())
+    , normalizeSamples_(properties.getNormalizeSamples())
+    , sampler_(nullptr)
+    , invBasis_(glm::inverse(DataMatrix(entity.getModelMatrix())))
+    , seedTransformation_(
+          properties.getSeedPointTransformationMatrix(entity.getCoordinateTransformer()))
+    , toWorld_(entity.getCoordinateTransformer().getDataToWorldMatrix())
+    , transformOutputToWorldSpace_{false}
+    , adaptive_{false}
+    , tolerance_{1e-5}
+    , maxStepFactor_{10.0}
+    , occupancyFrozen_{false} {}
 
 typename HyperStreamLineTracer::Result HyperStreamLineTracer::traceFrom(const SpatialVector &pIn) {
-    SpatialVector p =
-        detail::seedTransform<DataVector, DataHomogenousVector>(seedTransformation_, pIn);
+    return traceFromDataSpace(
+        detail::seedTransform<DataVector, DataHomogenousVector>(seedTransformation_, pIn));
+}
 
+typename HyperStreamLineTracer::Result HyperStreamLineTracer::traceFromDataSpace(
+    const SpatialVector &p) {
+    return traceWith(p, *sampler_);
+}
+
+template <typename Sampler>
+typename HyperStreamLineTracer::Result HyperStreamLineTracer::traceWith(const SpatialVector &p,
+                                                                        const Sampler &sampler) {
     Result res;
     IntegralLine &line = res.line;
 
@@ -44,33 +90,68 @@ typename HyperStreamLineTracer::Result HyperStreamLineTracer::traceFrom(const Sp
     stepsBWD++;  // for adjendency info
     stepsFWD++;
 
-    line.getPositions().reserve(steps_ + 2);
-    line.getMetaData<dvec3>("velocity", true).reserve(steps_ + 2);
-
-    for (auto &m : metaSamplers_) {
-        line.getMetaData<typename SpatialSampler<3, 3, double>::ReturnType>(m.first, true)
-            .reserve(steps_ + 2);
+    LineBuffer buffer;
+    buffer.positions.reserve(steps_ + 2);
+    buffer.velocities.reserve(steps_ + 2);
+    buffer.metaData.resize(metaSamplers_.size());
+    for (auto &column : buffer.metaData) {
+        column.reserve(steps_ + 2);
     }
 
-    if (!addPoint(line, p)) {
-        return res;  // Zero velocity at seed point
+    auto integrateFrom = [&](size_t steps, bool fwd) {
+        return adaptive_ ? integrateAdaptive(steps, p, buffer, fwd, sampler, res.steps)
+                         : integrate(steps, p, buffer, fwd, sampler, res.steps);
+    };
+
+    res.steps.samples++;
+    // Seeds in saturated cells and with zero velocity give empty lines
+    const bool seeded = enterCell(buffer, p);
+    if (!buffer.entered.empty()) {
+        res.cells.seed = buffer.entered.front().cell;
+        buffer.entered.clear();
     }
+    if (seeded && addPoint(buffer, p, sampler)) {
+        const auto seedCell = buffer.cell;
+        line.setBackwardTerminationReason(integrateFrom(stepsBWD, false));
+        std::swap(res.cells.backward, buffer.entered);
 
-    line.setBackwardTerminationReason(integrate(stepsBWD, p, line, false));
+        if (!buffer.positions.empty()) {
+            buffer.reverse();
+            res.seedIndex = buffer.positions.size() - 1;
+        }
 
-    if (!line.getPositions().empty()) {
-        line.reverse();
-        res.seedIndex = line.getPositions().size() - 1;
+        buffer.cell = seedCell;
+        line.setForwardTerminationReason(integrateFrom(stepsFWD, true));
+        std::swap(res.cells.forward, buffer.entered);
     }
 
-    line.setForwardTerminationReason(integrate(stepsFWD, p, line, true));
+    line.getPositions() = std::move(buffer.positions);
+    line.getMetaData<dvec3>("velocity", true) = std::move(buffer.velocities);
+    for (size_t i = 0; i < metaSamplers_.size(); ++i) {
+        line.getMetaData<MetaDataValue>(metaSamplers_[i].first, true) =
+            std::move(buffer.metaData[i]);
+    }
 
     return res;
 }
 
+void HyperStreamLineTracer::LineBuffer::reverse() {
+    std::reverse(positions.begin(), positions.end());
+    std::reverse(velocities.begin(), velocities.end());
+    for (auto &column : metaData) {
+        std::reverse(column.begin(), column.end());
+    }
+}
+
 void HyperStreamLineTracer::addMetaDataSampler(
     const std::string &name, std::shared_ptr<const SpatialSampler<3, 3, double>> sampler) {
-    metaSamplers_[name] = sampler;
+    auto it = std::find_if(metaSamplers_.begin(), metaSamplers_.end(),
+                           [&](const auto &m) { return m.first == name; });
+    if (it != metaSamplers_.end()) {
+        it->second = sampler;
+    } else {
+        metaSamplers_.emplace_back(name, sampler);
+    }
 }
 
 const typename HyperStreamLineTracer::DataHomogenouSpatialMatrixrix &
@@ -86,11 +167,101 @@ bool HyperStreamLineTracer::isTransformingOutputToWorldSpace() const {
     return transformOutputToWorldSpace_;
 }
 
-bool HyperStreamLineTracer::addPoint(IntegralLine &line, const SpatialVector &pos) {
-    return addPoint(line, pos, sampler_->sample(pos));
+void HyperStreamLineTracer::setAdaptiveStepSize(bool adaptive) { adaptive_ = adaptive; }
+
+bool HyperStreamLineTracer::isUsingAdaptiveStepSize() const { return adaptive_; }
+
+void HyperStreamLineTracer::setTolerance(double tolerance) { tolerance_ = tolerance; }
+
+double HyperStreamLineTracer::getTolerance() const { return tolerance_; }
+
+void HyperStreamLineTracer::setMaxStepFactor(double factor) {
+    maxStepFactor_ = std::max(1.0, factor);
+}
+
+double HyperStreamLineTracer::getMaxStepFactor() const { return maxStepFactor_; }
+
+void HyperStreamLineTracer::setOccupancyGrid(std::shared_ptr<HyperStreamLineOccupancyGrid> grid) {
+    occupancy_ = std::move(grid);
+}
+
+const std::shared_ptr<HyperStreamLineOccupancyGrid> &HyperStreamLineTracer::getOccupancyGrid()
+    const {
+    return occupancy_;
 }
 
-bool HyperStreamLineTracer::addPoint(IntegralLine &line, const SpatialVector &pos,
+void HyperStreamLineTracer::setOccupancyFrozen(bool frozen) { occupancyFrozen_ = frozen; }
+
+bool HyperStreamLineTracer::isOccupancyFrozen() const { return occupancyFrozen_; }
+
+void HyperStreamLineTracer::commitOccupancy(Result &result) const {
+    if (!occupancy_) return;
+
+    constexpr auto none = std::numeric_limits<size_t>::max();
+    // Point of the first entry into a saturated cell, none if every cell could be occupied
+    const auto occupy = [&](const std::vector<CellEntry> &entries) {
+        for (const auto &entry : entries) {
+            if (!occupancy_->tryOccupy(entry.cell)) return entry.point;
+        }
+        return none;
+    };
+
+    auto &line = result.line;
+    const auto size = line.getPositions().size();
+    size_t begin = 0;
+    size_t end = size;
+
+    if (result.cells.seed != HyperStreamLineOccupancyGrid::npos &&
+        !occupancy_->tryOccupy(result.cells.seed)) {
+        end = 0;
+        result.seedIndex = 0;
+    } else {
+        // A backward point k before reversal is the point seedIndex - k of the line
+        const auto backwardEnd = occupy(result.cells.backward);
+        if (backwardEnd != none) {
+            begin = result.seedIndex + 1 - backwardEnd;
+            line.setBackwardTerminationReason(IntegralLine::TerminationReason::Unknown);
+        }
+        const auto forwardEnd = occupy(result.cells.forward);
+        if (forwardEnd != none) {
+            end = forwardEnd;
+            line.setForwardTerminationReason(IntegralLine::TerminationReason::Unknown);
+        }
+        result.seedIndex -= begin;
+    }
+    result.cells = EnteredCells{};
+
+    if (begin == 0 && end == size) return;
+    keepRange(line.getPositions(), begin, end);
+    keepRange(line.getMetaData<dvec3>("velocity", true), begin, end);
+    for (const auto &metaSampler : metaSamplers_) {
+        keepRange(line.getMetaData<MetaDataValue>(metaSampler.first, true), begin, end);
+    }
+}
+
+bool HyperStreamLineTracer::enterCell(LineBuffer &line, const SpatialVector &pos) {
+    if (!occupancy_) return true;
+
+    const auto cell = occupancy_->cellIndex(util::glm_convert<dvec3>(pos));
+    if (cell == line.cell || cell == HyperStreamLineOccupancyGrid::npos) return true;
+    if (occupancyFrozen_) {
+        if (occupancy_->isSaturated(cell)) return false;
+        line.entered.push_back({cell, line.positions.size()});
+    } else if (!occupancy_->tryOccupy(cell)) {
+        return false;
+    }
+
+    line.cell = cell;
+    return true;
+}
+
+template <typename Sampler>
+bool HyperStreamLineTracer::addPoint(LineBuffer &line, const SpatialVector &pos,
+                                     const Sampler &sampler) {
+    return addPoint(line, pos, sampler.sample(pos));
+}
+
+bool HyperStreamLineTracer::addPoint(LineBuffer &line, const SpatialVector &pos,
                                      const DataVector &worldVelocity) {
 
     if (glm::length(worldVelocity) < std::numeric_limits<double>::epsilon()) {
@@ -101,36 +272,47 @@ bool HyperStreamLineTracer::addPoint(IntegralLine &line, const SpatialVector &po
         SpatialVector worldPos =
             detail::seedTransform<DataVector, DataHomogenousVector>(toWorld_, pos);
 
-        line.getPositions().emplace_back(util::glm_convert<dvec3>(worldPos));
+        line.positions.emplace_back(util::glm_convert<dvec3>(worldPos));
     } else {
-        line.getPositions().emplace_back(util::glm_convert<dvec3>(pos));
+        line.positions.emplace_back(util::glm_convert<dvec3>(pos));
     }
 
-    line.getMetaData<dvec3>("velocity").emplace_back(util::glm_convert<dvec3>(worldVelocity));
+    line.velocities.emplace_back(util::glm_convert<dvec3>(worldVelocity));
 
-    for (auto &m : metaSamplers_) {
-        line.getMetaData<typename SpatialSampler<3, 3, double>::ReturnType>(m.first).emplace_back(
-            util::glm_convert<dvec3>(m.second->sample(pos)));
+    for (size_t i = 0; i < metaSamplers_.size(); ++i) {
+        line.metaData[i].emplace_back(
+            util::glm_convert<dvec3>(metaSamplers_[i].second->sample(pos)));
     }
     return true;
 }
 
+template <typename Sampler>
 IntegralLine::TerminationReason HyperStreamLineTracer::integrate(size_t steps, SpatialVector pos,
-                                                                 IntegralLine &line, bool fwd) {
+                                                                 LineBuffer &line, bool fwd,
+                                                                 const Sampler &sampler,
+                                                                 StepStatistics &stats) {
     if (steps == 0) return IntegralLine::TerminationReason::StartPoint;
 
     DataVector worldVelocity;
     bool flipped{false};
 
     for (size_t i = 0; i < steps; i++) {
-        if (!sampler_->withinBounds(pos)) {
+        if (!sampler.withinBounds(pos)) {
             return IntegralLine::TerminationReason::OutOfBounds;
         }
 
         std::tie(pos, worldVelocity, flipped) = detail::hyperstep<SpatialVector, DataVector>(
             pos, integrationScheme_, stepSize_ * (fwd ? 1.0 : -1.0), invBasis_, normalizeSamples_,
-            *sampler_, flipped);
+            sampler, flipped);
 
+        stats.acceptedSteps++;
+        stats.samples += 4;
+        stats.minStepSize = std::min(stats.minStepSize, stepSize_);
+        stats.maxStepSize = std::max(stats.maxStepSize, stepSize_);
+
+        if (!enterCell(line, pos)) {
+            return IntegralLine::TerminationReason::Unknown;
+        }
         if (!addPoint(line, pos, worldVelocity)) {
             return IntegralLine::TerminationReason::ZeroVelocity;
         }
@@ -138,4 +320,70 @@ IntegralLine::TerminationReason HyperStreamLineTracer::integrate(size_t steps, S
 
     return IntegralLine::TerminationReason::Steps;
 }
-}  // namespace inviwo
\ No newline at end of file
+
+template <typename Sampler>
+IntegralLine::TerminationReason HyperStreamLineTracer::integrateAdaptive(
+    size_t steps, SpatialVector pos, LineBuffer &line, bool fwd, const Sampler &sampler,
+    StepStatistics &stats) {
+    if (steps == 0) return IntegralLine::TerminationReason::StartPoint;
+
+    // Standard step size control for a fifth-order method, with limits on how fast it may change
+    const auto scaleFor = [&](double error) {
+        if (error <= 0.0) return 5.0;
+        return glm::clamp(0.9 * std::pow(tolerance_ / error, 0.2), 0.2, 5.0);
+    };
+
+    const double minStepSize = stepSize_ / maxStepFactor_;
+    const double maxStepSize = stepSize_ * maxStepFactor_;
+    double stepSize = stepSize_;
+
+    DataVector dir = sampler.sample(pos);
+    stats.samples++;
+    if (normalizeSamples_) {
+        const auto l = glm::length(dir);
+        if (l != 0.0) dir /= l;
+    }
+
+    for (size_t i = 0; i < steps;) {
+        if (!sampler.withinBounds(pos)) {
+            return IntegralLine::TerminationReason::OutOfBounds;
+        }
+
+        SpatialVector next;
+        DataVector nextDir;
+        double error;
+        std::tie(next, nextDir, error) = detail::adaptiveHyperstep<SpatialVector, DataVector>(
+            pos, dir, stepSize * (fwd ? 1.0 : -1.0), invBasis_, normalizeSamples_, sampler);
+        stats.samples += 6;
+
+        if (error > tolerance_ && stepSize > minStepSize) {
+            stats.rejectedSteps++;
+            stepSize = std::max(minStepSize, stepSize * scaleFor(error));
+            continue;
+        }
+
+        stats.acceptedSteps++;
+        stats.minStepSize = std::min(stats.minStepSize, stepSize);
+        stats.maxStepSize = std::max(stats.maxStepSize, stepSize);
+
+        if (!enterCell(line, next)) {
+            return IntegralLine::TerminationReason::Unknown;
+        }
+        if (!addPoint(line, next, nextDir)) {
+            return IntegralLine::TerminationReason::ZeroVelocity;
+        }
+
+        pos = next;
+        dir = nextDir;
+        stepSize = glm::clamp(stepSize * scaleFor(error), minStepSize, maxStepSize);
+        ++i;
+    }
+
+    return IntegralLine::TerminationReason::Steps;
+}
+template HyperStreamLineTracer::Result HyperStreamLineTracer::traceWith(
+    const SpatialVector &, const SpatialSampler<3, 3, double> &);
+template HyperStreamLineTracer::Result HyperStreamLineTracer::traceWith(
+    const SpatialVector &, const EigenVectorSampler &);
+
+}  // namespace inviwo
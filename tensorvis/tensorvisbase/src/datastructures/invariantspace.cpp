@@ -1,6 +1,9 @@
 #include <inviwo/tensorvisbase/datastructures/invariantspace.h>
 #include <inviwo/tensorvisbase/util/misc.h>
 
+#include <algorithm>
+#include <limits>
+
 namespace inviwo {
 InvariantSpace::InvariantSpace(size_t numberOfDimensions,
                                const std::vector<std::string>& identifiers,
@@ -22,6 +25,104 @@ InvariantSpace::InvariantSpace(size_t numberOfDimensions,
                    std::array<glm::f64, 2>{std::numeric_limits<double>::max(),
                                            std::numeric_limits<double>::lowest()});
 }
+
+void InvariantSpace::addAxis(const std::string& identifier, const std::vector<double>& data,
+                             TensorFeature type) {
+    if (!appendColumn(data.begin(), data.end())) return;
+
+    identifiers_.push_back(identifier);
+    metaDataTypes_.push_back(type);
+
+    if (data.empty()) {
+        minmax_.push_back({{std::numeric_limits<double>::max(),
+                            std::numeric_limits<double>::lowest()}});
+    } else {
+        const auto minmax = std::minmax_element(data.begin(), data.end());
+        minmax_.push_back({{*minmax.first, *minmax.second}});
+    }
+}
+
+void InvariantSpace::addAxes(const InvariantSpace& invariantSpace) {
+    for (size_t i = 0; i < invariantSpace.dimensions_; ++i) {
+        const auto axis = invariantSpace.getAxis(i);
+        if (!appendColumn(axis.data(), axis.data() + axis.size())) return;
+
+        identifiers_.push_back(invariantSpace.identifiers_[i]);
+        metaDataTypes_.push_back(invariantSpace.metaDataTypes_[i]);
+        minmax_.push_back(invariantSpace.minmax_[i]);
+    }
+}
+
+void InvariantSpace::addPoint(const View& v) {
+    if (v.size() != dimensions_) {
+        LogError("Tried to add feature of wrong dimensionality ("
+                 << std::to_string(v.size()) << " instead of " << std::to_string(dimensions_)
+                 << ")");
+        return;
+    }
+
+    if (size_ == capacity_) reallocate(std::max(size_t{16}, 2 * capacity_));
+
+    for (size_t i = 0; i < dimensions_; ++i) {
+        const auto val = v[i];
+        column(i)[size_] = val;
+
+        minmax_[i][0] = std::min(minmax_[i][0], val);
+        minmax_[i][1] = std::max(minmax_[i][1], val);
+    }
+    ++size_;
+}
+
+std::vector<double> InvariantSpace::flatten() const {
+    std::vector<double> flattened(size_ * dimensions_);
+    for (size_t j = 0; j < dimensions_; ++j) {
+        const auto src = column(j);
+        for (size_t i = 0; i < size_; ++i) {
+            flattened[i * dimensions_ + j] = src[i];
+        }
+    }
+    return flattened;
+}
+
+void InvariantSpace::reserve(const size_t n) {
+    if (n > capacity_) reallocate(n);
+}
+
+void InvariantSpace::clear() {
+    size_ = 0;
+    std::fill(minmax_.begin(), minmax_.end(),
+              std::array<glm::f64, 2>{std::numeric_limits<double>::max(),
+                                      std::numeric_limits<double>::lowest()});
+}
+
+void InvariantSpace::setNumberOfDimensions(const size_t n) {
+    if (n < dimensions_) {
+        LogError("Reduction of dimensionality would mean loss of data. Aborting");
+        return;
+    }
+
+    dimensions_ = n;
+    data_.resize(dimensions_ * capacity_, 0.0);
+}
+
+void InvariantSpace::setNumberOfElements(const size_t n) {
+    if (n > capacity_) reallocate(n);
+    for (size_t j = 0; j < dimensions_; ++j) {
+        std::fill(column(j) + std::min(size_, n), column(j) + n, 0.0);
+    }
+    size_ = n;
+}
+
+void InvariantSpace::reallocate(const size_t capacity) {
+    std::vector<double> data(dimensions_ * capacity);
+    const auto count = std::min(size_, capacity);
+    for (size_t j = 0; j < dimensions_; ++j) {
+        std::copy_n(column(j), count, data.data() + j * capacity);
+    }
+    data_ = std::move(data);
+    capacity_ = capacity;
+}
+
 std::string InvariantSpace::getDataInfo() const {
     std::stringstream ss;
     ss << "<table border='0' cellspacing='0' cellpadding='0' "
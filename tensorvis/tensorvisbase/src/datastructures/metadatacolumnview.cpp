@@ -0,0 +1,106 @@
+#include <inviwo/tensorvisbase/datastructures/metadatacolumnview.h>
+#include <inviwo/core/datastructures/buffer/bufferramprecision.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace inviwo {
+
+namespace {
+template <typename Src, typename Dst>
+void copyConvert(const Src *src, const size_t count, Dst *dst) {
+    if constexpr (std::is_same<Src, Dst>::value) {
+        std::copy(src, src + count, dst);
+    } else {
+        std::transform(src, src + count, dst, [](const Src v) { return static_cast<Dst>(v); });
+    }
+}
+
+size_t scalarSize(const MetaDataPrecision precision) {
+    return precision == MetaDataPrecision::Float32 ? sizeof(float) : sizeof(double);
+}
+
+const DataFormatBase *columnFormat(const size_t numberOfComponents,
+                                   const MetaDataPrecision precision) {
+    return DataFormatBase::get(NumericType::Float, numberOfComponents, 8 * scalarSize(precision));
+}
+}  // namespace
+
+MetaDataColumnView::MetaDataColumnView(const void *data, const size_t size,
+                                       const size_t numberOfComponents,
+                                       const MetaDataPrecision precision)
+    : data_(data), size_(size), numberOfComponents_(numberOfComponents), precision_(precision) {}
+
+MetaDataColumnView MetaDataColumnView::fromMetaData(const MetaDataBase &metaData) {
+    const auto format = metaData.getDataFormat();
+    if (format->getNumericType() != NumericType::Float ||
+        (format->getPrecision() != 32 && format->getPrecision() != 64)) {
+        throw Exception("Metadata '" + metaData.getDisplayName() +
+                            "' does not hold float or double data.",
+                        IVW_CONTEXT_CUSTOM("MetaDataColumnView"));
+    }
+
+    return MetaDataColumnView(
+        metaData.getDataPtr(), metaData.getNumberOfElements(), format->getComponents(),
+        format->getPrecision() == 32 ? MetaDataPrecision::Float32 : MetaDataPrecision::Float64);
+}
+
+size_t MetaDataColumnView::getSizeInBytes() const {
+    return getNumberOfScalars() * scalarSize(precision_);
+}
+
+const DataFormatBase *MetaDataColumnView::getDataFormat() const {
+    return columnFormat(numberOfComponents_, precision_);
+}
+
+void MetaDataColumnView::copyTo(void *dst, const MetaDataPrecision precision) const {
+    const auto count = getNumberOfScalars();
+
+    if (precision_ == precision) {
+        std::memcpy(dst, data_, getSizeInBytes());
+    } else if (precision == MetaDataPrecision::Float32) {
+        copyConvert(data<double>(), count, static_cast<float *>(dst));
+    } else {
+        copyConvert(data<float>(), count, static_cast<double *>(dst));
+    }
+}
+
+namespace util {
+
+std::shared_ptr<BufferRAM> createBufferRAM(const MetaDataColumnView &column,
+                                           const MetaDataPrecision precision) {
+    const auto format = columnFormat(column.getNumberOfComponents(), precision);
+    auto ram = inviwo::createBufferRAM(column.size(), format, BufferUsage::Static);
+    column.copyTo(ram->getData(), precision);
+    return ram;
+}
+
+std::shared_ptr<BufferBase> createBuffer(const MetaDataColumnView &column,
+                                         const MetaDataPrecision precision) {
+    auto ram = createBufferRAM(column, precision);
+    return ram->dispatch<std::shared_ptr<BufferBase>, dispatching::filter::Floats>(
+        [ram](auto repr) -> std::shared_ptr<BufferBase> {
+            using ValueType = util::PrecisionValueType<decltype(repr)>;
+            return std::make_shared<Buffer<ValueType>>(
+                std::static_pointer_cast<BufferRAMPrecision<ValueType>>(ram));
+        });
+}
+
+std::shared_ptr<VolumeRAM> createVolumeRAM(const MetaDataColumnView &column,
+                                           const size3_t &dimensions,
+                                           const MetaDataPrecision precision) {
+    if (glm::compMul(dimensions) != column.size()) {
+        throw Exception("Volume dimensions do not match the column size.",
+                        IVW_CONTEXT_CUSTOM("util::createVolumeRAM"));
+    }
+
+    const auto format = columnFormat(column.getNumberOfComponents(), precision);
+    auto ram = inviwo::createVolumeRAM(dimensions, format);
+    column.copyTo(ram->getData(), precision);
+    return ram;
+}
+
+}  // namespace util
+
+}  // namespace inviwo
@@ -40,7 +40,6 @@ TensorField2D::TensorField2D(const size2_t dimensions, const std::vector<dmat2>&
     , dimensionality_(2)
     , indexMapper_(dimensions)
     , tensors_(data) {
-    computeEigenValuesAndEigenVectors();
     computeNormalizedScreenCoordinates();
 }
 
@@ -62,7 +61,6 @@ TensorField2D::TensorField2D(const size2_t dimensions, const std::vector<double>
         tensors_.push_back(tensor);
     }
 
-    computeEigenValuesAndEigenVectors();
     computeNormalizedScreenCoordinates();
 }
 
@@ -81,7 +79,8 @@ TensorField2D::TensorField2D(const size2_t dimensions, const std::vector<double>
     , size_(dimensions.x * dimensions.y)
     , rank_(2)
     , dimensionality_(2)
-    , indexMapper_(dimensions) {
+    , indexMapper_(dimensions)
+    , hasEigenDecomposition_(true) {
     for (size_t i = 0; i < data.size(); i += 4) {
         dmat3 tensor;
         tensor[0][0] = data[i];
@@ -110,7 +109,8 @@ TensorField2D::TensorField2D(const size2_t dimensions, const std::vector<dmat2>&
     , rank_(2)
     , dimensionality_(2)
     , indexMapper_(dimensions)
-    , tensors_(data) {
+    , tensors_(data)
+    , hasEigenDecomposition_(true) {
     computeNormalizedScreenCoordinates();
 }
 
@@ -123,7 +123,6 @@ TensorField2D::TensorField2D(const size_t x, const size_t y, const std::vector<d
     , dimensionality_(2)
     , indexMapper_(size2_t(x, y))
     , tensors_(data) {
-    computeEigenValuesAndEigenVectors();
     computeNormalizedScreenCoordinates();
 }
 
@@ -145,7 +144,6 @@ TensorField2D::TensorField2D(const size_t x, const size_t y, const std::vector<d
         tensors_.push_back(tensor);
     }
 
-    computeEigenValuesAndEigenVectors();
     computeNormalizedScreenCoordinates();
 }
 
@@ -164,7 +162,8 @@ TensorField2D::TensorField2D(const size_t x, const size_t y, const std::vector<d
     , size_(x * y)
     , rank_(2)
     , dimensionality_(2)
-    , indexMapper_(size2_t(x, y)) {
+    , indexMapper_(size2_t(x, y))
+    , hasEigenDecomposition_(true) {
     for (size_t i = 0; i < data.size(); i += 4) {
         dmat3 tensor;
         tensor[0][0] = data[i];
@@ -193,7 +192,8 @@ TensorField2D::TensorField2D(const size_t x, const size_t y, const std::vector<d
     , rank_(2)
     , dimensionality_(2)
     , indexMapper_(size2_t(x, y))
-    , tensors_(data) {
+    , tensors_(data)
+    , hasEigenDecomposition_(true) {
     computeNormalizedScreenCoordinates();
 }
 
@@ -224,48 +224,48 @@ std::string TensorField2D::getDataInfo() const {
        << "<td>"
        << "<nobr>" << glm::to_string(dimensions_) << "</nobr>"
        << "</td>"
-       << "</tr>"
-       << "<tr>"
-       << "<td style='color:#bbb;padding-right:8px;'>"
-       << "Max eigenvalue (major)"
-       << "</td>"
-       << "<td>"
-       << "<nobr>"
-       << static_cast<float>(*std::max_element(majorEigenValues_.begin(), majorEigenValues_.end()))
-       << "</nobr>"
-       << "</td>"
-       << "</tr>"
-       << "<tr>"
-       << "<td style='color:#bbb;padding-right:8px;'>"
-       << "Min eigenvalue (major)"
-       << "</td>"
-       << "<td>"
-       << "<nobr>"
-       << static_cast<float>(*std::min_element(majorEigenValues_.begin(), majorEigenValues_.end()))
-       << "</nobr>"
-       << "</td>"
-       << "</tr>"
-       << "<tr>"
-       << "<td style='color:#bbb;padding-right:8px;'>"
-       << "Max eigenvalue (minor)"
-       << "</td>"
-       << "<td>"
-       << "<nobr>"
-       << static_cast<float>(*std::max_element(minorEigenValues_.begin(), minorEigenValues_.end()))
-       << "</nobr>"
-       << "</td>"
-       << "</tr>"
-       << "<tr>"
-       << "<td style='color:#bbb;padding-right:8px;'>"
-       << "Min eigenvalue (minor)"
-       << "</td>"
-       << "<td>"
-       << "<nobr>"
-       << static_cast<float>(*std::min_element(minorEigenValues_.begin(), minorEigenValues_.end()))
-       << "</nobr>"
-       << "</td>"
-       << "</tr>"
-       << "<tr>"
+       << "</tr>";
+
+    // Don't trigger the eigen decomposition just for showing the data info
+    if (hasEigenDecomposition_ && !majorEigenValues_.empty()) {
+        const auto major = std::minmax_element(majorEigenValues_.begin(), majorEigenValues_.end());
+        const auto minor = std::minmax_element(minorEigenValues_.begin(), minorEigenValues_.end());
+
+        ss << "<tr>"
+           << "<td style='color:#bbb;padding-right:8px;'>"
+           << "Max eigenvalue (major)"
+           << "</td>"
+           << "<td>"
+           << "<nobr>" << static_cast<float>(*major.second) << "</nobr>"
+           << "</td>"
+           << "</tr>"
+           << "<tr>"
+           << "<td style='color:#bbb;padding-right:8px;'>"
+           << "Min eigenvalue (major)"
+           << "</td>"
+           << "<td>"
+           << "<nobr>" << static_cast<float>(*major.first) << "</nobr>"
+           << "</td>"
+           << "</tr>"
+           << "<tr>"
+           << "<td style='color:#bbb;padding-right:8px;'>"
+           << "Max eigenvalue (minor)"
+           << "</td>"
+           << "<td>"
+           << "<nobr>" << static_cast<float>(*minor.second) << "</nobr>"
+           << "</td>"
+           << "</tr>"
+           << "<tr>"
+           << "<td style='color:#bbb;padding-right:8px;'>"
+           << "Min eigenvalue (minor)"
+           << "</td>"
+           << "<td>"
+           << "<nobr>" << static_cast<float>(*minor.first) << "</nobr>"
+           << "</td>"
+           << "</tr>";
+    }
+
+    ss << "<tr>"
        << "<td style='color:#bbb;padding-right:8px;'>"
        << "Extends"
        << "</td>"
@@ -343,28 +343,44 @@ const dvec2& TensorField2D::getNormalizedImagePosition(const size_t index) const
 }
 
 const dvec2& TensorField2D::getMinorEigenVector(const size_t index) const {
+    ensureEigenDecomposition();
     return minorEigenVectors_[index];
 }
 
 const dvec2& TensorField2D::getMinorEigenVector(const size2_t& position) const {
+    ensureEigenDecomposition();
     return minorEigenVectors_[indexMapper_(position)];
 }
 
 const dvec2& TensorField2D::getMajorEigenVector(const size_t index) const {
+    ensureEigenDecomposition();
     return majorEigenVectors_[index];
 }
 
 const dvec2& TensorField2D::getMajorEigenVector(const size2_t& position) const {
+    ensureEigenDecomposition();
     return majorEigenVectors_[indexMapper_(position)];
 }
 
-const std::vector<dvec2>& TensorField2D::minorEigenVectors() const { return minorEigenVectors_; }
+const std::vector<dvec2>& TensorField2D::minorEigenVectors() const {
+    ensureEigenDecomposition();
+    return minorEigenVectors_;
+}
 
-const std::vector<dvec2>& TensorField2D::majorEigenVectors() const { return majorEigenVectors_; }
+const std::vector<dvec2>& TensorField2D::majorEigenVectors() const {
+    ensureEigenDecomposition();
+    return majorEigenVectors_;
+}
 
-const std::vector<double>& TensorField2D::minorEigenValues() const { return minorEigenValues_; }
+const std::vector<double>& TensorField2D::minorEigenValues() const {
+    ensureEigenDecomposition();
+    return minorEigenValues_;
+}
 
-const std::vector<double>& TensorField2D::majorEigenValues() const { return majorEigenValues_; }
+const std::vector<double>& TensorField2D::majorEigenValues() const {
+    ensureEigenDecomposition();
+    return majorEigenValues_;
+}
 
 const std::vector<dvec2>& TensorField2D::normalizedImagePositions() const {
     return normalizedImagePositions_;
@@ -374,6 +390,7 @@ const std::vector<dmat2>& TensorField2D::tensors() const { return tensors_; }
 
 std::array<std::pair<double, dvec2>, 2> TensorField2D::getSortedEigenValuesAndEigenVectorsForTensor(
     const size_t index) const {
+    ensureEigenDecomposition();
     const auto& majorEigenValue = majorEigenValues_[index];
     const auto& minorEigenValue = minorEigenValues_[index];
 
@@ -389,6 +406,7 @@ std::array<std::pair<double, dvec2>, 2> TensorField2D::getSortedEigenValuesAndEi
 
 std::array<std::pair<double, dvec2>, 2> TensorField2D::getSortedEigenValuesAndEigenVectorsForTensor(
     const size2_t& pos) const {
+    ensureEigenDecomposition();
     auto index = indexMapper_(pos);
 
     const auto& majorEigenValue = majorEigenValues_[index];
@@ -405,6 +423,7 @@ std::array<std::pair<double, dvec2>, 2> TensorField2D::getSortedEigenValuesAndEi
 }
 
 std::array<double, 2> TensorField2D::getSortedEigenValuesForTensor(const size_t index) const {
+    ensureEigenDecomposition();
     auto ret = std::array<double, 2>();
     ret[0] = majorEigenValues_[index];
     ret[1] = minorEigenValues_[index];
@@ -412,6 +431,7 @@ std::array<double, 2> TensorField2D::getSortedEigenValuesForTensor(const size_t
 }
 
 std::array<double, 2> TensorField2D::getSortedEigenValuesForTensor(const size2_t& pos) const {
+    ensureEigenDecomposition();
     auto index = indexMapper_(pos);
 
     auto ret = std::array<double, 2>();
@@ -421,6 +441,7 @@ std::array<double, 2> TensorField2D::getSortedEigenValuesForTensor(const size2_t
 }
 
 std::array<dvec2, 2> TensorField2D::getSortedEigenVectorsForTensor(const size_t index) const {
+    ensureEigenDecomposition();
     auto ret = std::array<dvec2, 2>();
     ret[0] = majorEigenVectors_[index];
     ret[1] = minorEigenVectors_[index];
@@ -428,6 +449,7 @@ std::array<dvec2, 2> TensorField2D::getSortedEigenVectorsForTensor(const size_t
 }
 
 std::array<dvec2, 2> TensorField2D::getSortedEigenVectorsForTensor(const size2_t& pos) const {
+    ensureEigenDecomposition();
     auto index = indexMapper_(pos);
 
     auto ret = std::array<dvec2, 2>();
@@ -436,7 +458,39 @@ std::array<dvec2, 2> TensorField2D::getSortedEigenVectorsForTensor(const size2_t
     return ret;
 }
 
-void TensorField2D::computeEigenValuesAndEigenVectors() {
+TensorField2D::TensorField2D(const TensorField2D& tf)
+    : normalizedImagePositions_(tf.normalizedImagePositions_)
+    , coordinates_(tf.coordinates_)
+    , dimensions_(tf.dimensions_)
+    , extends_(tf.extends_)
+    , offset_(tf.offset_)
+    , size_(tf.size_)
+    , rank_(tf.rank_)
+    , dimensionality_(tf.dimensionality_)
+    , indexMapper_(tf.indexMapper_)
+    , tensors_(tf.tensors_) {
+    // Only copy the eigen decomposition if it has already been computed
+    std::lock_guard<std::mutex> lock(tf.eigenDecompositionMutex_);
+    if (tf.hasEigenDecomposition_) {
+        majorEigenVectors_ = tf.majorEigenVectors_;
+        minorEigenVectors_ = tf.minorEigenVectors_;
+        majorEigenValues_ = tf.majorEigenValues_;
+        minorEigenValues_ = tf.minorEigenValues_;
+        hasEigenDecomposition_ = true;
+    }
+}
+
+void TensorField2D::ensureEigenDecomposition() const {
+    if (hasEigenDecomposition_) return;
+
+    std::lock_guard<std::mutex> lock(eigenDecompositionMutex_);
+    if (hasEigenDecomposition_) return;
+
+    computeEigenValuesAndEigenVectors();
+    hasEigenDecomposition_ = true;
+}
+
+void TensorField2D::computeEigenValuesAndEigenVectors() const {
     auto func = [](const dmat2& tensor) -> std::array<std::pair<double, dvec2>, 2> {
         Eigen::EigenSolver<Eigen::Matrix<double, 2, 2>> solver(util::glm2eigen(tensor));
 
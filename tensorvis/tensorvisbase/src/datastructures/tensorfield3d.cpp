@@ -1,14 +1,34 @@
 #include <inviwo/tensorvisbase/datastructures/tensorfield3d.h>
+#include <inviwo/tensorvisbase/algorithm/tensorfeatures.h>
 #include <inviwo/core/datastructures/volume/volumeram.h>
 #include <inviwo/core/util/stdextensions.h>
 #include <modules/eigenutils/eigenutils.h>
 #include <inviwo/tensorvisbase/util/misc.h>
 #include <inviwo/core/util/exception.h>
+#include <inviwo/core/util/stringconversion.h>
+
+#include <algorithm>
 
 namespace inviwo {
 
+namespace {
+// The raw data constructors expect each tensor as 9 doubles in row-major order
+TensorStorage3D fromRowMajor(const std::vector<double> &data) {
+    std::vector<dmat3> tensors(data.size() / 9);
+    for (size_t i = 0; i < tensors.size(); ++i) {
+        std::copy(data.data() + i * 9, data.data() + (i + 1) * 9, glm::value_ptr(tensors[i]));
+        tensors[i] = glm::transpose(tensors[i]);
+    }
+    return TensorStorage3D(std::move(tensors));
+}
+}  // namespace
+
 TensorField3D::TensorField3D(const size3_t dimensions, std::vector<dmat3> data, const vec3 &extent,
                              float sliceCoord)
+    : TensorField3D(dimensions, TensorStorage3D(std::move(data)), extent, sliceCoord) {}
+
+TensorField3D::TensorField3D(const size3_t dimensions, TensorStorage3D data, const vec3 &extent,
+                             float sliceCoord)
     : StructuredGridEntity<3>()
     , dimensions_(dimensions)
     , indexMapper_(dimensions)
@@ -20,9 +40,7 @@ TensorField3D::TensorField3D(const size3_t dimensions, std::vector<dmat3> data,
         throw Exception("Data/dimensions mismatch in TensorField3D constructor.", IVW_CONTEXT);
     }
 
-    computeEigenValuesAndEigenVectors();
     computeNormalizedScreenCoordinates(sliceCoord);
-    computeDataMaps();
     setBasis(
         {vec3{extent[0], 0.0f, 0.0f}, vec3{0.0f, extent[1], 0.0f}, vec3{0.0f, 0.0f, extent[2]}});
 }
@@ -35,24 +53,9 @@ TensorField3D::TensorField3D(const size3_t dimensions, const std::vector<double>
     , size_(glm::compMul(dimensions))
     , rank_(2)
     , dimensionality_(3) {
-    for (size_t i = 0; i < data.size(); i += 9) {
-        dmat3 tensor;
-        tensor[0][0] = data[i];
-        tensor[1][0] = data[i + 1];
-        tensor[2][0] = data[i + 2];
-        tensor[0][1] = data[i + 3];
-        tensor[1][1] = data[i + 4];
-        tensor[2][1] = data[i + 5];
-        tensor[0][2] = data[i + 6];
-        tensor[1][2] = data[i + 7];
-        tensor[2][2] = data[i + 8];
-
-        tensors_.push_back(tensor);
-    }
+    tensors_ = fromRowMajor(data);
 
-    computeEigenValuesAndEigenVectors();
     computeNormalizedScreenCoordinates(sliceCoord);
-    computeDataMaps();
     setBasis(
         {vec3{extent[0], 0.0f, 0.0f}, vec3{0.0f, extent[1], 0.0f}, vec3{0.0f, 0.0f, extent[2]}});
 }
@@ -71,20 +74,7 @@ TensorField3D::TensorField3D(const size3_t dimensions, const std::vector<double>
     , size_(glm::compMul(dimensions))
     , rank_(2)
     , dimensionality_(3) {
-    for (size_t i = 0; i < data.size(); i += 9) {
-        dmat3 tensor;
-        tensor[0][0] = data[i];
-        tensor[1][0] = data[i + 1];
-        tensor[2][0] = data[i + 2];
-        tensor[0][1] = data[i + 3];
-        tensor[1][1] = data[i + 4];
-        tensor[2][1] = data[i + 5];
-        tensor[0][2] = data[i + 6];
-        tensor[1][2] = data[i + 7];
-        tensor[2][2] = data[i + 8];
-
-        tensors_.push_back(tensor);
-    }
+    tensors_ = fromRowMajor(data);
 
     addMetaData<MajorEigenValues>(majorEigenValues, TensorFeature::Sigma1);
     addMetaData<IntermediateEigenValues>(middleEigenValues, TensorFeature::Sigma2);
@@ -96,7 +86,6 @@ TensorField3D::TensorField3D(const size3_t dimensions, const std::vector<double>
     addMetaData<MinorEigenVectors>(minorEigenVectors, TensorFeature::MinorEigenVector);
 
     computeNormalizedScreenCoordinates(sliceCoord);
-    computeDataMaps();
     setBasis(
         {vec3{extent[0], 0.0f, 0.0f}, vec3{0.0f, extent[1], 0.0f}, vec3{0.0f, 0.0f, extent[2]}});
 }
@@ -123,26 +112,13 @@ TensorField3D::TensorField3D(
     addMetaData<MinorEigenVectors>(minorEigenVectors, TensorFeature::MinorEigenVector);
 
     computeNormalizedScreenCoordinates(sliceCoord);
-    computeDataMaps();
     setBasis(
         {vec3{extent[0], 0.0f, 0.0f}, vec3{0.0f, extent[1], 0.0f}, vec3{0.0f, 0.0f, extent[2]}});
 }
 
 TensorField3D::TensorField3D(const size_t x, const size_t y, const size_t z,
                              std::vector<dmat3> data, const vec3 &extent, float sliceCoord)
-    : StructuredGridEntity<3>()
-    , dimensions_(size3_t(x, y, z))
-    , indexMapper_(size3_t(x, y, z))
-    , tensors_(std::move(data))
-    , size_(x * y * z)
-    , rank_(2)
-    , dimensionality_(3) {
-    computeEigenValuesAndEigenVectors();
-    computeNormalizedScreenCoordinates(sliceCoord);
-    computeDataMaps();
-    setBasis(
-        {vec3{extent[0], 0.0f, 0.0f}, vec3{0.0f, extent[1], 0.0f}, vec3{0.0f, 0.0f, extent[2]}});
-}
+    : TensorField3D(size3_t(x, y, z), TensorStorage3D(std::move(data)), extent, sliceCoord) {}
 
 TensorField3D::TensorField3D(const size_t x, const size_t y, const size_t z,
                              const std::vector<double> &data, const vec3 &extent, float sliceCoord)
@@ -152,24 +128,9 @@ TensorField3D::TensorField3D(const size_t x, const size_t y, const size_t z,
     , size_(x * y * z)
     , rank_(2)
     , dimensionality_(3) {
-    for (size_t i = 0; i < data.size(); i += 9) {
-        dmat3 tensor;
-        tensor[0][0] = data[i];
-        tensor[1][0] = data[i + 1];
-        tensor[2][0] = data[i + 2];
-        tensor[0][1] = data[i + 3];
-        tensor[1][1] = data[i + 4];
-        tensor[2][1] = data[i + 5];
-        tensor[0][2] = data[i + 6];
-        tensor[1][2] = data[i + 7];
-        tensor[2][2] = data[i + 8];
-
-        tensors_.push_back(tensor);
-    }
+    tensors_ = fromRowMajor(data);
 
-    computeEigenValuesAndEigenVectors();
     computeNormalizedScreenCoordinates(sliceCoord);
-    computeDataMaps();
     setBasis(
         {vec3{extent[0], 0.0f, 0.0f}, vec3{0.0f, extent[1], 0.0f}, vec3{0.0f, 0.0f, extent[2]}});
 }
@@ -179,17 +140,11 @@ TensorField3D::TensorField3D(size3_t dimensions, const double *data, const vec3
     : StructuredGridEntity<3>()
     , dimensions_(dimensions)
     , indexMapper_(dimensions)
-    , size_(dimensions.x * dimensions.y * dimensions.z)
+    , tensors_(TensorStorage3D::fromStrided(data, glm::compMul(dimensions)))
+    , size_(glm::compMul(dimensions))
     , rank_(2)
     , dimensionality_(3) {
-    tensors_.resize(size_);
-    for (size_t i = 0; i < size_; ++i) {
-        std::copy(data + i * 9, data + (i + 1) * 9, glm::value_ptr(tensors_[i]));
-    }
-
-    computeEigenValuesAndEigenVectors();
     computeNormalizedScreenCoordinates(sliceCoord);
-    computeDataMaps();
     setBasis(
         {vec3{extent[0], 0.0f, 0.0f}, vec3{0.0f, extent[1], 0.0f}, vec3{0.0f, 0.0f, extent[2]}});
 }
@@ -199,18 +154,11 @@ TensorField3D::TensorField3D(size3_t dimensions, const float *data, const vec3 &
     : StructuredGridEntity<3>()
     , dimensions_(dimensions)
     , indexMapper_(dimensions)
-    , size_(dimensions.x * dimensions.y * dimensions.z)
+    , tensors_(TensorStorage3D::fromStrided(data, glm::compMul(dimensions)))
+    , size_(glm::compMul(dimensions))
     , rank_(2)
     , dimensionality_(3) {
-
-    tensors_.resize(size_);
-    for (size_t i = 0; i < size_; ++i) {
-        std::copy(data + i * 9, data + (i + 1) * 9, glm::value_ptr(tensors_[i]));
-    }
-
-    computeEigenValuesAndEigenVectors();
     computeNormalizedScreenCoordinates(sliceCoord);
-    computeDataMaps();
     setBasis(
         {vec3{extent[0], 0.0f, 0.0f}, vec3{0.0f, extent[1], 0.0f}, vec3{0.0f, 0.0f, extent[2]}});
 }
@@ -227,20 +175,7 @@ TensorField3D::TensorField3D(
     , size_(x * y * z)
     , rank_(2)
     , dimensionality_(3) {
-    for (size_t i = 0; i < data.size(); i += 9) {
-        dmat3 tensor;
-        tensor[0][0] = data[i];
-        tensor[1][0] = data[i + 1];
-        tensor[2][0] = data[i + 2];
-        tensor[0][1] = data[i + 3];
-        tensor[1][1] = data[i + 4];
-        tensor[2][1] = data[i + 5];
-        tensor[0][2] = data[i + 6];
-        tensor[1][2] = data[i + 7];
-        tensor[2][2] = data[i + 8];
-
-        tensors_.push_back(tensor);
-    }
+    tensors_ = fromRowMajor(data);
 
     addMetaData<MajorEigenValues>(majorEigenValues, TensorFeature::Sigma1);
     addMetaData<IntermediateEigenValues>(middleEigenValues, TensorFeature::Sigma2);
@@ -252,7 +187,6 @@ TensorField3D::TensorField3D(
     addMetaData<MinorEigenVectors>(minorEigenVectors, TensorFeature::MinorEigenVector);
 
     computeNormalizedScreenCoordinates(sliceCoord);
-    computeDataMaps();
     setBasis(
         {vec3{extent[0], 0.0f, 0.0f}, vec3{0.0f, extent[1], 0.0f}, vec3{0.0f, 0.0f, extent[2]}});
 }
@@ -282,7 +216,6 @@ TensorField3D::TensorField3D(const size_t x, const size_t y, const size_t z,
     addMetaData<MinorEigenVectors>(minorEigenVectors, TensorFeature::MinorEigenVector);
 
     computeNormalizedScreenCoordinates(sliceCoord);
-    computeDataMaps();
     setBasis(
         {vec3{extent[0], 0.0f, 0.0f}, vec3{0.0f, extent[1], 0.0f}, vec3{0.0f, 0.0f, extent[2]}});
 }
@@ -291,6 +224,12 @@ TensorField3D::TensorField3D(
     const size3_t dimensions, std::vector<dmat3> data,
     const std::unordered_map<uint64_t, std::unique_ptr<MetaDataBase>> &metaData, const vec3 &extent,
     float sliceCoord)
+    : TensorField3D(dimensions, TensorStorage3D(std::move(data)), metaData, extent, sliceCoord) {}
+
+TensorField3D::TensorField3D(
+    const size3_t dimensions, TensorStorage3D data,
+    const std::unordered_map<uint64_t, std::unique_ptr<MetaDataBase>> &metaData, const vec3 &extent,
+    float sliceCoord)
     : StructuredGridEntity<3>()
     , dimensions_(dimensions)
     , indexMapper_(dimensions)
@@ -303,15 +242,21 @@ TensorField3D::TensorField3D(
     }
 
     computeNormalizedScreenCoordinates(sliceCoord);
-    computeDataMaps();
     setBasis(
         {vec3{extent[0], 0.0f, 0.0f}, vec3{0.0f, extent[1], 0.0f}, vec3{0.0f, 0.0f, extent[2]}});
 }
 
+TensorField3D::TensorField3D(const size3_t dimensions, TensorStorage3D data,
+                             std::unordered_map<uint64_t, std::unique_ptr<MetaDataBase>> &&metaData,
+                             const vec3 &extent, float sliceCoord)
+    : TensorField3D(dimensions, std::move(data), extent, sliceCoord) {
+    for (auto &dataItem : metaData) {
+        metaData_.insert(std::make_pair(dataItem.first, std::move(dataItem.second)));
+    }
+}
+
 TensorField3D::TensorField3D(const TensorField3D &tf)
     : StructuredGridEntity<3>()
-    , dataMapEigenValues_(tf.dataMapEigenValues_)
-    , dataMapEigenVectors_(tf.dataMapEigenVectors_)
     , dimensions_(tf.dimensions_)
     , indexMapper_(util::IndexMapper3D(dimensions_))
     , tensors_(tf.tensors_)
@@ -324,9 +269,14 @@ TensorField3D::TensorField3D(const TensorField3D &tf)
     setOffset(tf.getOffset());
     setBasis(tf.getBasis());
 
-    for (const auto &m : tf.metaData_) {
-        metaData_.insert(std::make_pair(m.first, m.second->clone()));
-    }
+    // Only metadata that has already been computed is shared, everything else is computed on
+    // demand for the copy as well.
+    std::lock_guard<std::recursive_mutex> lock(tf.metaDataMutex_);
+    metaData_ = tf.metaData_;
+    dataMapEigenValues_ = tf.dataMapEigenValues_;
+    dataMapEigenVectors_ = tf.dataMapEigenVectors_;
+    hasDataMapEigenValues_ = tf.hasDataMapEigenValues_;
+    hasDataMapEigenVectors_ = tf.hasDataMapEigenVectors_;
 }
 
 std::string TensorField3D::getDataInfo() const {
@@ -336,21 +286,30 @@ std::string TensorField3D::getDataInfo() const {
        << tensorutil::getHTMLTableRowString("Type", "3D tensor field")
        << tensorutil::getHTMLTableRowString("Number of tensors", tensors_.size())
        << tensorutil::getHTMLTableRowString("Dimensions", dimensions_)
-       << tensorutil::getHTMLTableRowString("Max major field eigenvalue",
-                                            dataMapEigenValues_[0].valueRange.y)
-       << tensorutil::getHTMLTableRowString("Min major field eigenvalue",
-                                            dataMapEigenValues_[0].valueRange.x)
-       << tensorutil::getHTMLTableRowString("Max intermediate field eigenvalue",
-                                            dataMapEigenValues_[1].valueRange.y)
-       << tensorutil::getHTMLTableRowString("Min intermediate field eigenvalue",
-                                            dataMapEigenValues_[1].valueRange.x)
-       << tensorutil::getHTMLTableRowString("Max minor field eigenvalue",
-                                            dataMapEigenValues_[2].valueRange.y)
-       << tensorutil::getHTMLTableRowString("Min minor field eigenvalue",
-                                            dataMapEigenValues_[2].valueRange.x)
-       << tensorutil::getHTMLTableRowString("Extends", getExtents())
-
-       << "</table>";
+       << tensorutil::getHTMLTableRowString("Tensor storage", toString(tensors_.getMode()))
+       << tensorutil::getHTMLTableRowString("Tensor memory (bytes)", tensors_.getSizeInBytes());
+
+    // Don't trigger the eigen decomposition just for showing the data info
+    std::unique_lock<std::recursive_mutex> lock(metaDataMutex_);
+    if (hasDataMapEigenValues_) {
+        ss << tensorutil::getHTMLTableRowString("Max major field eigenvalue",
+                                                dataMapEigenValues_[0].valueRange.y)
+           << tensorutil::getHTMLTableRowString("Min major field eigenvalue",
+                                                dataMapEigenValues_[0].valueRange.x)
+           << tensorutil::getHTMLTableRowString("Max intermediate field eigenvalue",
+                                                dataMapEigenValues_[1].valueRange.y)
+           << tensorutil::getHTMLTableRowString("Min intermediate field eigenvalue",
+                                                dataMapEigenValues_[1].valueRange.x)
+           << tensorutil::getHTMLTableRowString("Max minor field eigenvalue",
+                                                dataMapEigenValues_[2].valueRange.y)
+           << tensorutil::getHTMLTableRowString("Min minor field eigenvalue",
+                                                dataMapEigenValues_[2].valueRange.x);
+    } else {
+        ss << tensorutil::getHTMLTableRowString("Eigenvalues", "not computed yet");
+    }
+    lock.unlock();
+
+    ss << tensorutil::getHTMLTableRowString("Extends", getExtents()) << "</table>";
     return ss.str();
 }
 
@@ -399,53 +358,29 @@ std::pair<std::shared_ptr<Volume>, std::shared_ptr<Volume>> TensorField3D::getVo
     return ret;
 }
 
-std::pair<glm::uint8, dmat3 &> TensorField3D::at(const size3_t position) {
+std::pair<glm::uint8, dmat3> TensorField3D::at(const size3_t position) const {
     glm::uint8 maskVal = 0;
 
     if (hasMask()) maskVal = binaryMask_[indexMapper_(position)];
 
-    return std::pair<glm::uint8, dmat3 &>(maskVal, tensors_[indexMapper_(position)]);
+    return std::pair<glm::uint8, dmat3>(maskVal, tensors_[indexMapper_(position)]);
 }
 
-std::pair<glm::uint8, dmat3 &> TensorField3D::at(const size_t x, const size_t y, const size_t z) {
+std::pair<glm::uint8, dmat3> TensorField3D::at(const size_t x, const size_t y,
+                                               const size_t z) const {
     glm::uint8 maskVal = 0;
 
     if (hasMask()) maskVal = binaryMask_[indexMapper_(size3_t(x, y, z))];
 
-    return std::pair<glm::uint8, dmat3 &>(maskVal, tensors_[indexMapper_(size3_t(x, y, z))]);
+    return std::pair<glm::uint8, dmat3>(maskVal, tensors_[indexMapper_(size3_t(x, y, z))]);
 }
 
-std::pair<glm::uint8, dmat3 &> TensorField3D::at(const size_t index) {
+std::pair<glm::uint8, dmat3> TensorField3D::at(const size_t index) const {
     glm::uint8 maskVal = 0;
 
     if (hasMask()) maskVal = binaryMask_[index];
 
-    return std::pair<glm::uint8, dmat3 &>(maskVal, tensors_[index]);
-}
-
-std::pair<glm::uint8, const dmat3 &> TensorField3D::at(const size3_t position) const {
-    glm::uint8 maskVal = 0;
-
-    if (hasMask()) maskVal = binaryMask_[indexMapper_(position)];
-
-    return std::pair<glm::uint8, const dmat3 &>(maskVal, tensors_[indexMapper_(position)]);
-}
-
-std::pair<glm::uint8, const dmat3 &> TensorField3D::at(const size_t x, const size_t y,
-                                                       const size_t z) const {
-    glm::uint8 maskVal = 0;
-
-    if (hasMask()) maskVal = binaryMask_[indexMapper_(size3_t(x, y, z))];
-
-    return std::pair<glm::uint8, const dmat3 &>(maskVal, tensors_[indexMapper_(size3_t(x, y, z))]);
-}
-
-std::pair<glm::uint8, const dmat3 &> TensorField3D::at(const size_t index) const {
-    glm::uint8 maskVal = 0;
-
-    if (hasMask()) maskVal = binaryMask_[index];
-
-    return std::pair<glm::uint8, const dmat3 &>(maskVal, tensors_[index]);
+    return std::pair<glm::uint8, dmat3>(maskVal, tensors_[index]);
 }
 
 void TensorField3D::setExtents(const vec3 &extents) {
@@ -492,17 +427,17 @@ mat4 TensorField3D::getBasisAndOffset() const {
 
 std::array<std::pair<double, dvec3>, 3> TensorField3D::getSortedEigenValuesAndEigenVectorsForTensor(
     const size_t index) const {
-    const auto &majorEigenValues = getMetaData<MajorEigenValues>();
-    const auto &middleEigenValues = getMetaData<IntermediateEigenValues>();
-    const auto &minorEigenValues = getMetaData<MinorEigenValues>();
+    const auto &majorEigenValues = this->majorEigenValues();
+    const auto &middleEigenValues = this->middleEigenValues();
+    const auto &minorEigenValues = this->minorEigenValues();
 
     const auto &majorEigenValue = majorEigenValues[index];
     const auto &middleEigenValue = middleEigenValues[index];
     const auto &minorEigenValue = minorEigenValues[index];
 
-    const auto &majorEigenVectors = getMetaData<MajorEigenVectors>();
-    const auto &middleEigenVectors = getMetaData<IntermediateEigenVectors>();
-    const auto &minorEigenVectors = getMetaData<MinorEigenVectors>();
+    const auto &majorEigenVectors = this->majorEigenVectors();
+    const auto &middleEigenVectors = this->middleEigenVectors();
+    const auto &minorEigenVectors = this->minorEigenVectors();
 
     const auto &majorEigenVector = majorEigenVectors[index];
     const auto &middleEigenVector = middleEigenVectors[index];
@@ -520,17 +455,17 @@ std::array<std::pair<double, dvec3>, 3> TensorField3D::getSortedEigenValuesAndEi
     const size3_t pos) const {
     auto index = indexMapper_(pos);
 
-    const auto &majorEigenValues = getMetaData<MajorEigenValues>();
-    const auto &middleEigenValues = getMetaData<IntermediateEigenValues>();
-    const auto &minorEigenValues = getMetaData<MinorEigenValues>();
+    const auto &majorEigenValues = this->majorEigenValues();
+    const auto &middleEigenValues = this->middleEigenValues();
+    const auto &minorEigenValues = this->minorEigenValues();
 
     const auto &majorEigenValue = majorEigenValues[index];
     const auto &middleEigenValue = middleEigenValues[index];
     const auto &minorEigenValue = minorEigenValues[index];
 
-    const auto &majorEigenVectors = getMetaData<MajorEigenVectors>();
-    const auto &middleEigenVectors = getMetaData<IntermediateEigenVectors>();
-    const auto &minorEigenVectors = getMetaData<MinorEigenVectors>();
+    const auto &majorEigenVectors = this->majorEigenVectors();
+    const auto &middleEigenVectors = this->middleEigenVectors();
+    const auto &minorEigenVectors = this->minorEigenVectors();
 
     const auto &majorEigenVector = majorEigenVectors[index];
     const auto &middleEigenVector = middleEigenVectors[index];
@@ -547,9 +482,9 @@ std::array<std::pair<double, dvec3>, 3> TensorField3D::getSortedEigenValuesAndEi
 std::array<double, 3> TensorField3D::getSortedEigenValuesForTensor(const size_t index) const {
     auto ret = std::array<double, 3>();
 
-    const auto &majorEigenValues = getMetaData<MajorEigenValues>();
-    const auto &middleEigenValues = getMetaData<IntermediateEigenValues>();
-    const auto &minorEigenValues = getMetaData<MinorEigenValues>();
+    const auto &majorEigenValues = this->majorEigenValues();
+    const auto &middleEigenValues = this->middleEigenValues();
+    const auto &minorEigenValues = this->minorEigenValues();
 
     ret[0] = majorEigenValues[index];
     ret[1] = middleEigenValues[index];
@@ -561,9 +496,9 @@ std::array<double, 3> TensorField3D::getSortedEigenValuesForTensor(const size3_t
     auto index = indexMapper_(pos);
     auto ret = std::array<double, 3>();
 
-    const auto &majorEigenValues = getMetaData<MajorEigenValues>();
-    const auto &middleEigenValues = getMetaData<IntermediateEigenValues>();
-    const auto &minorEigenValues = getMetaData<MinorEigenValues>();
+    const auto &majorEigenValues = this->majorEigenValues();
+    const auto &middleEigenValues = this->middleEigenValues();
+    const auto &minorEigenValues = this->minorEigenValues();
 
     ret[0] = majorEigenValues[index];
     ret[1] = middleEigenValues[index];
@@ -575,9 +510,9 @@ std::array<double, 3> TensorField3D::getSortedEigenValuesForTensor(const size3_t
 std::array<dvec3, 3> TensorField3D::getSortedEigenVectorsForTensor(const size_t index) const {
     auto ret = std::array<dvec3, 3>();
 
-    const auto &majorEigenVectors = getMetaData<MajorEigenVectors>();
-    const auto &middleEigenVectors = getMetaData<IntermediateEigenVectors>();
-    const auto &minorEigenVectors = getMetaData<MinorEigenVectors>();
+    const auto &majorEigenVectors = this->majorEigenVectors();
+    const auto &middleEigenVectors = this->middleEigenVectors();
+    const auto &minorEigenVectors = this->minorEigenVectors();
 
     ret[0] = majorEigenVectors[index];
     ret[1] = middleEigenVectors[index];
@@ -590,9 +525,9 @@ std::array<dvec3, 3> TensorField3D::getSortedEigenVectorsForTensor(const size3_t
     auto index = indexMapper_(pos);
     auto ret = std::array<dvec3, 3>();
 
-    const auto &majorEigenVectors = getMetaData<MajorEigenVectors>();
-    const auto &middleEigenVectors = getMetaData<IntermediateEigenVectors>();
-    const auto &minorEigenVectors = getMetaData<MinorEigenVectors>();
+    const auto &majorEigenVectors = this->majorEigenVectors();
+    const auto &middleEigenVectors = this->middleEigenVectors();
+    const auto &minorEigenVectors = this->minorEigenVectors();
 
     ret[0] = majorEigenVectors[index];
     ret[1] = middleEigenVectors[index];
@@ -601,30 +536,35 @@ std::array<dvec3, 3> TensorField3D::getSortedEigenVectorsForTensor(const size3_t
 }
 
 const std::vector<dvec3> &TensorField3D::majorEigenVectors() const {
-    return getMetaData<MajorEigenVectors>();
+    return *eigenDecomposition().eigenVectors[0];
 }
 
 const std::vector<dvec3> &TensorField3D::middleEigenVectors() const {
-    return getMetaData<IntermediateEigenVectors>();
+    return *eigenDecomposition().eigenVectors[1];
 }
 
 const std::vector<dvec3> &TensorField3D::minorEigenVectors() const {
-    return getMetaData<MinorEigenVectors>();
+    return *eigenDecomposition().eigenVectors[2];
 }
 
 const std::vector<double> &TensorField3D::majorEigenValues() const {
-    return getMetaData<MajorEigenValues>();
+    return *eigenDecomposition().eigenValues[0];
 }
 
 const std::vector<double> &TensorField3D::middleEigenValues() const {
-    return getMetaData<IntermediateEigenValues>();
+    return *eigenDecomposition().eigenValues[1];
 }
 
 const std::vector<double> &TensorField3D::minorEigenValues() const {
-    return getMetaData<MinorEigenValues>();
+    return *eigenDecomposition().eigenValues[2];
 }
 
-const std::vector<dmat3> &TensorField3D::tensors() const { return tensors_; }
+const TensorStorage3D &TensorField3D::tensors() const { return tensors_; }
+
+void TensorField3D::setStorageMode(const TensorStorageMode mode) {
+    if (mode == tensors_.getMode()) return;
+    tensors_ = tensors_.convert(mode);
+}
 
 int TensorField3D::getNumDefinedEntries() const {
     return static_cast<int>(std::count(std::begin(binaryMask_), std::end(binaryMask_), 1));
@@ -689,36 +629,119 @@ bool TensorField3D::hasMetaData(const TensorFeature feature) const {
     return false;
 }
 
+namespace {
+bool isEigenDecomposition(const uint64_t id) {
+    return id == MajorEigenValues::id() || id == IntermediateEigenValues::id() ||
+           id == MinorEigenValues::id() || id == MajorEigenVectors::id() ||
+           id == IntermediateEigenVectors::id() || id == MinorEigenVectors::id();
+}
+
+bool isInvariant(const uint64_t id) {
+    return id == I1::id() || id == I2::id() || id == I3::id() || id == J1::id() ||
+           id == J2::id() || id == J3::id() || id == LodeAngle::id();
+}
+}  // namespace
+
 bool TensorField3D::hasMetaData(const uint64_t id) const {
+    return isEigenDecomposition(id) || isInvariant(id) || isMetaDataComputed(id);
+}
+
+bool TensorField3D::isMetaDataComputed(const uint64_t id) const {
+    std::lock_guard<std::recursive_mutex> lock(metaDataMutex_);
     return metaData_.find(id) != metaData_.end();
 }
 
-TensorField3D *TensorField3D::clone() const { return new TensorField3D(*this); }
+const MetaDataBase *TensorField3D::getMetaDataContainer(const uint64_t id) const {
+    std::lock_guard<std::recursive_mutex> lock(metaDataMutex_);
 
-void TensorField3D::computeEigenValuesAndEigenVectors() {
-    auto func = [](const dmat3 &tensor) -> std::array<std::pair<double, dvec3>, 3> {
-        if (tensor == dmat3(0.0)) {
-            return {{std::make_pair(0, dvec3{0}), std::make_pair(0, dvec3{0}),
-                     std::make_pair(0, dvec3{0})}};
-            return std::array<std::pair<double, dvec3>, 3>{std::pair<double, dvec3>{0, dvec3(0)},
-                                                           std::pair<double, dvec3>{0, dvec3(0)},
-                                                           std::pair<double, dvec3>{0, dvec3(0)}};
+    auto it = metaData_.find(id);
+    if (it == metaData_.end()) {
+        if (isEigenDecomposition(id)) {
+            computeEigenValuesAndEigenVectors();
+        } else if (isInvariant(id)) {
+            computeInvariant(id);
         }
+        it = metaData_.find(id);
+    }
+    if (it == metaData_.end()) {
+        throw Exception("Could not locate metadata for ID " + std::to_string(id), IVW_CONTEXT);
+    }
+    return it->second.get();
+}
 
-        Eigen::EigenSolver<Eigen::Matrix3d> solver(util::glm2eigen(tensor));
-        const auto eigenValues = util::eigen2glm<double, 3, 1>(solver.eigenvalues().real());
-        const auto eigenVectors = util::eigen2glm<double, 3, 3>(solver.eigenvectors().real());
+void TensorField3D::addMetaData(const uint64_t id, std::unique_ptr<MetaDataBase> metaData) {
+    std::lock_guard<std::recursive_mutex> lock(metaDataMutex_);
+    metaData_.insert(std::make_pair(id, std::move(metaData)));
+}
 
-        const auto range =
-            util::as_range(glm::value_ptr(eigenValues), glm::value_ptr(eigenValues) + 3);
+void TensorField3D::addMetaData(std::unique_ptr<MetaDataBase> metaData) {
+    std::lock_guard<std::recursive_mutex> lock(metaDataMutex_);
+    const auto id = metaData->getId();
+    if (isEigenDecomposition(id) && metaData_.count(id) != 0) {
+        throw Exception("The eigen decomposition of a tensor field cannot be replaced.",
+                        IVW_CONTEXT);
+    }
+    metaData_[id] = std::move(metaData);
+}
 
-        const auto ordering = util::ordering(range, std::greater<double>());
+void TensorField3D::removeMetaData(const uint64_t id) {
+    std::lock_guard<std::recursive_mutex> lock(metaDataMutex_);
+    if (isEigenDecomposition(id) && metaData_.count(id) != 0) {
+        throw Exception("The eigen decomposition of a tensor field cannot be removed.",
+                        IVW_CONTEXT);
+    }
+    metaData_.erase(id);
+}
 
-        return {{std::make_pair(eigenValues[ordering[0]], eigenVectors[ordering[0]]),
-                 std::make_pair(eigenValues[ordering[1]], eigenVectors[ordering[1]]),
-                 std::make_pair(eigenValues[ordering[2]], eigenVectors[ordering[2]])}};
-    };
+std::unordered_map<uint64_t, std::shared_ptr<const MetaDataBase>> TensorField3D::metaData()
+    const {
+    std::lock_guard<std::recursive_mutex> lock(metaDataMutex_);
+    return metaData_;
+}
+
+const TensorField3D::EigenDecomposition &TensorField3D::eigenDecomposition() const {
+    if (hasEigenDecomposition_) return eigenDecomposition_;
+
+    std::lock_guard<std::recursive_mutex> lock(metaDataMutex_);
+    if (!hasEigenDecomposition_) {
+        eigenDecomposition_.eigenValues = {{&getMetaData<MajorEigenValues>(),
+                                            &getMetaData<IntermediateEigenValues>(),
+                                            &getMetaData<MinorEigenValues>()}};
+        eigenDecomposition_.eigenVectors = {{&getMetaData<MajorEigenVectors>(),
+                                             &getMetaData<IntermediateEigenVectors>(),
+                                             &getMetaData<MinorEigenVectors>()}};
+        hasEigenDecomposition_ = true;
+    }
+    return eigenDecomposition_;
+}
 
+const std::array<DataMapper, 3> &TensorField3D::dataMapEigenValues() const {
+    std::lock_guard<std::recursive_mutex> lock(metaDataMutex_);
+    if (!hasDataMapEigenValues_) computeDataMaps();
+    return dataMapEigenValues_;
+}
+
+const std::array<DataMapper, 3> &TensorField3D::dataMapEigenVectors() const {
+    std::lock_guard<std::recursive_mutex> lock(metaDataMutex_);
+    if (!hasDataMapEigenVectors_) computeDataMaps();
+    return dataMapEigenVectors_;
+}
+
+void TensorField3D::setDataMapEigenValues(const std::array<DataMapper, 3> &dataMaps) {
+    std::lock_guard<std::recursive_mutex> lock(metaDataMutex_);
+    dataMapEigenValues_ = dataMaps;
+    hasDataMapEigenValues_ = true;
+}
+
+void TensorField3D::setDataMapEigenVectors(const std::array<DataMapper, 3> &dataMaps) {
+    std::lock_guard<std::recursive_mutex> lock(metaDataMutex_);
+    dataMapEigenVectors_ = dataMaps;
+    hasDataMapEigenVectors_ = true;
+}
+
+TensorField3D *TensorField3D::clone() const { return new TensorField3D(*this); }
+
+void TensorField3D::computeEigenValuesAndEigenVectors() const {
     std::vector<double> majorEigenValues;
     std::vector<double> middleEigenValues;
     std::vector<double> minorEigenValues;
@@ -727,36 +750,102 @@ void TensorField3D::computeEigenValuesAndEigenVectors() {
     std::vector<dvec3> middleEigenVectors;
     std::vector<dvec3> minorEigenVectors;
 
-    majorEigenValues.resize(size_);
-    middleEigenValues.resize(size_);
-    minorEigenValues.resize(size_);
+    const auto numTensors = tensors_.size();
 
-    majorEigenVectors.resize(size_);
-    middleEigenVectors.resize(size_);
-    minorEigenVectors.resize(size_);
+    majorEigenValues.resize(numTensors);
+    middleEigenValues.resize(numTensors);
+    minorEigenValues.resize(numTensors);
 
+    majorEigenVectors.resize(numTensors);
+    middleEigenVectors.resize(numTensors);
+    minorEigenVectors.resize(numTensors);
+
+    // Packed storage is symmetric by construction, full storage is checked once up front so that
+    // the cheaper symmetric solver can be used for the common case of symmetric input data.
+    const auto symmetric =
+        tensors_.isSymmetric() ||
+        std::all_of(tensors_.begin(), tensors_.end(),
+                    [](const dmat3 &tensor) { return tensorutil::isSymmetric(tensor); });
+
+    if (symmetric) {
+        constexpr size_t blockSize = 64;
+        const auto numBlocks = static_cast<int>((numTensors + blockSize - 1) / blockSize);
+
+#pragma omp parallel for
+        for (int block = 0; block < numBlocks; block++) {
+            const auto begin = static_cast<size_t>(block) * blockSize;
+            const auto count = std::min(blockSize, numTensors - begin);
+
+            const auto solve = [&](const auto *tensors) {
+                tensorutil::calculateSymmetricEigenValuesAndEigenVectors(
+                    tensors, count, &majorEigenValues[begin], &middleEigenValues[begin],
+                    &minorEigenValues[begin], &majorEigenVectors[begin],
+                    &middleEigenVectors[begin], &minorEigenVectors[begin]);
+            };
+
+            switch (tensors_.getMode()) {
+                case TensorStorageMode::Symmetric:
+                    solve(&tensors_.symmetricTensors()[begin]);
+                    break;
+                case TensorStorageMode::SymmetricFloat:
+                    solve(&tensors_.symmetricFloatTensors()[begin]);
+                    break;
+                case TensorStorageMode::Full: {
+                    std::array<SymmetricTensor3<double>, blockSize> packed;
+                    for (size_t i = 0; i < count; i++) {
+                        packed[i] = SymmetricTensor3<double>::fromMatrix(tensors_[begin + i]);
+                    }
+                    solve(packed.data());
+                    break;
+                }
+            }
+        }
+    } else {
 #pragma omp parallel for
-    for (int i = 0; i < static_cast<int>(tensors_.size()); i++) {
-        auto tensor = tensors_[i];
-        auto eigenValuesAndEigenVectors = func(tensor);
+        for (int i = 0; i < static_cast<int>(numTensors); i++) {
+            const auto eigenValuesAndEigenVectors =
+                tensorutil::calculateEigenValuesAndEigenVectors(tensors_[i]);
 
-        majorEigenVectors[i] = eigenValuesAndEigenVectors[0].second;
-        middleEigenVectors[i] = eigenValuesAndEigenVectors[1].second;
-        minorEigenVectors[i] = eigenValuesAndEigenVectors[2].second;
+            majorEigenVectors[i] = eigenValuesAndEigenVectors[0].second;
+            middleEigenVectors[i] = eigenValuesAndEigenVectors[1].second;
+            minorEigenVectors[i] = eigenValuesAndEigenVectors[2].second;
 
-        majorEigenValues[i] = eigenValuesAndEigenVectors[0].first;
-        middleEigenValues[i] = eigenValuesAndEigenVectors[1].first;
-        minorEigenValues[i] = eigenValuesAndEigenVectors[2].first;
+            majorEigenValues[i] = eigenValuesAndEigenVectors[0].first;
+            middleEigenValues[i] = eigenValuesAndEigenVectors[1].first;
+            minorEigenValues[i] = eigenValuesAndEigenVectors[2].first;
+        }
     }
 
-    addMetaData<MajorEigenValues>(majorEigenValues, TensorFeature::Sigma1);
-    addMetaData<IntermediateEigenValues>(middleEigenValues, TensorFeature::Sigma2);
-    addMetaData<MinorEigenValues>(minorEigenValues, TensorFeature::Sigma3);
-
-    addMetaData<MajorEigenVectors>(majorEigenVectors, TensorFeature::MajorEigenVector);
-    addMetaData<IntermediateEigenVectors>(middleEigenVectors,
-                                          TensorFeature::IntermediateEigenVector);
-    addMetaData<MinorEigenVectors>(minorEigenVectors, TensorFeature::MinorEigenVector);
+    // Eigen data that was handed to the constructor takes precedence, insert does not overwrite
+    metaData_.insert(std::make_pair(
+        MajorEigenValues::id(),
+        std::make_unique<MajorEigenValues>(majorEigenValues, TensorFeature::Sigma1)));
+    metaData_.insert(std::make_pair(
+        IntermediateEigenValues::id(),
+        std::make_unique<IntermediateEigenValues>(middleEigenValues, TensorFeature::Sigma2)));
+    metaData_.insert(std::make_pair(
+        MinorEigenValues::id(),
+        std::make_unique<MinorEigenValues>(minorEigenValues, TensorFeature::Sigma3)));
+
+    metaData_.insert(std::make_pair(
+        MajorEigenVectors::id(),
+        std::make_unique<MajorEigenVectors>(majorEigenVectors, TensorFeature::MajorEigenVector)));
+    metaData_.insert(
+        std::make_pair(IntermediateEigenVectors::id(),
+                       std::make_unique<IntermediateEigenVectors>(
+                           middleEigenVectors, TensorFeature::IntermediateEigenVector)));
+    metaData_.insert(std::make_pair(
+        MinorEigenVectors::id(),
+        std::make_unique<MinorEigenVectors>(minorEigenVectors, TensorFeature::MinorEigenVector)));
+}
+
+void TensorField3D::computeInvariant(const uint64_t id) const {
+    const auto feature = static_cast<TensorFeature>(id);
+    std::vector<double> values(tensors_.size());
+    tensorutil::computeTensorFeatures(tensors_, {{nullptr, nullptr, nullptr}}, {feature},
+                                      {values.data()});
+
+    metaData_.insert(std::make_pair(id, tensorutil::createMetaData(feature, std::move(values))));
 }
 
 void TensorField3D::computeNormalizedScreenCoordinates(double sliceCoord) {
@@ -781,53 +870,39 @@ void TensorField3D::computeNormalizedScreenCoordinates(double sliceCoord) {
     }
 }
 
-void TensorField3D::computeDataMaps() {
-    const auto &majorEigenValues = getMetaData<MajorEigenValues>();
-    const auto &middleEigenValues = getMetaData<IntermediateEigenValues>();
-    const auto &minorEigenValues = getMetaData<MinorEigenValues>();
-
-    dataMapEigenValues_[0].dataRange.x = dataMapEigenValues_[0].valueRange.x =
-        *std::min_element(majorEigenValues.begin(), majorEigenValues.end());
-    dataMapEigenValues_[0].dataRange.y = dataMapEigenValues_[0].valueRange.y =
-        *std::max_element(majorEigenValues.begin(), majorEigenValues.end());
-    dataMapEigenValues_[1].dataRange.x = dataMapEigenValues_[1].valueRange.x =
-        *std::min_element(middleEigenValues.begin(), middleEigenValues.end());
-    dataMapEigenValues_[1].dataRange.y = dataMapEigenValues_[1].valueRange.y =
-        *std::max_element(middleEigenValues.begin(), middleEigenValues.end());
-    dataMapEigenValues_[2].dataRange.x = dataMapEigenValues_[2].valueRange.x =
-        *std::min_element(minorEigenValues.begin(), minorEigenValues.end());
-    dataMapEigenValues_[2].dataRange.y = dataMapEigenValues_[2].valueRange.y =
-        *std::max_element(minorEigenValues.begin(), minorEigenValues.end());
-
-    auto min_f = [](const dvec3 &vec) -> double { return std::min(std::min(vec.x, vec.y), vec.z); };
-    auto max_f = [](const dvec3 &vec) -> double { return std::max(std::max(vec.x, vec.y), vec.z); };
-
-    auto min = std::numeric_limits<double>::max();
-    auto max = std::numeric_limits<double>::lowest();
-    for (const auto &v : getMetaData<MajorEigenVectors>()) {
-        min = std::min(min_f(v), min);
-        max = std::max(max_f(v), max);
-    }
-    dataMapEigenVectors_[0].dataRange.x = dataMapEigenVectors_[0].valueRange.x = min;
-    dataMapEigenVectors_[0].dataRange.y = dataMapEigenVectors_[0].valueRange.y = max;
-
-    min = std::numeric_limits<double>::max();
-    max = std::numeric_limits<double>::lowest();
-    for (const auto &v : getMetaData<IntermediateEigenVectors>()) {
-        min = std::min(min_f(v), min);
-        max = std::max(max_f(v), max);
+void TensorField3D::computeDataMaps() const {
+    // The ranges come from the cached statistics of the metadata columns, so they are only
+    // computed once per column and shared with everything else that asks for them
+    if (!hasDataMapEigenValues_) {
+        const std::array<const MetaDataBase *, 3> eigenValues{
+            {getMetaDataContainer<MajorEigenValues>(),
+             getMetaDataContainer<IntermediateEigenValues>(),
+             getMetaDataContainer<MinorEigenValues>()}};
+
+        for (size_t i = 0; i < 3; i++) {
+            const auto statistics = eigenValues[i]->getStatistics();
+            if (statistics->size == 0) continue;
+            dataMapEigenValues_[i].dataRange = dataMapEigenValues_[i].valueRange =
+                statistics->range();
+        }
+        hasDataMapEigenValues_ = true;
     }
-    dataMapEigenVectors_[1].dataRange.x = dataMapEigenVectors_[1].valueRange.x = min;
-    dataMapEigenVectors_[1].dataRange.y = dataMapEigenVectors_[1].valueRange.y = max;
-
-    min = std::numeric_limits<double>::max();
-    max = std::numeric_limits<double>::lowest();
-    for (const auto &v : getMetaData<MinorEigenVectors>()) {
-        min = std::min(min_f(v), min);
-        max = std::max(max_f(v), max);
+
+    if (!hasDataMapEigenVectors_) {
+        const std::array<const MetaDataBase *, 3> eigenVectors{
+            {getMetaDataContainer<MajorEigenVectors>(),
+             getMetaDataContainer<IntermediateEigenVectors>(),
+             getMetaDataContainer<MinorEigenVectors>()}};
+
+        for (size_t i = 0; i < 3; i++) {
+            const auto statistics = eigenVectors[i]->getStatistics();
+            auto range = dvec2(std::numeric_limits<double>::max(),
+                               std::numeric_limits<double>::lowest());
+            if (statistics->size != 0) range = statistics->range();
+            dataMapEigenVectors_[i].dataRange = dataMapEigenVectors_[i].valueRange = range;
+        }
+        hasDataMapEigenVectors_ = true;
     }
-    dataMapEigenVectors_[2].dataRange.x = dataMapEigenVectors_[2].valueRange.x = min;
-    dataMapEigenVectors_[2].dataRange.y = dataMapEigenVectors_[2].valueRange.y = max;
 }
 
 }  // namespace inviwo
@@ -0,0 +1,135 @@
+#include <inviwo/tensorvisbase/datastructures/tensorfieldsliceview.h>
+#include <inviwo/tensorvisbase/util/misc.h>
+#include <inviwo/core/util/exception.h>
+
+#include <algorithm>
+#include <sstream>
+
+namespace inviwo {
+
+TensorFieldSliceView::TensorFieldSliceView(std::shared_ptr<const TensorField3D> tensorField,
+                                           const CartesianCoordinateAxis axis,
+                                           const size_t sliceNumber)
+    : tensorField_(std::move(tensorField)), axis_(axis), sliceNumber_(sliceNumber) {
+    if (!tensorField_) {
+        throw Exception("No tensor field to slice", IVW_CONTEXT);
+    }
+
+    const auto dims = tensorField_->getDimensions();
+    const auto axisIndex = static_cast<glm::length_t>(axis_);
+    if (sliceNumber_ >= dims[axisIndex]) {
+        throw Exception("Slice number " + std::to_string(sliceNumber_) + " out of bounds",
+                        IVW_CONTEXT);
+    }
+
+    switch (axis_) {
+        case CartesianCoordinateAxis::X:
+            dimensions_ = size2_t(dims.y, dims.z);
+            offset_ = sliceNumber_;
+            strides_ = size2_t(dims.x, dims.x * dims.y);
+            break;
+        case CartesianCoordinateAxis::Y:
+            dimensions_ = size2_t(dims.x, dims.z);
+            offset_ = sliceNumber_ * dims.x;
+            strides_ = size2_t(1, dims.x * dims.y);
+            break;
+        case CartesianCoordinateAxis::Z:
+        default:
+            dimensions_ = size2_t(dims.x, dims.y);
+            offset_ = sliceNumber_ * dims.x * dims.y;
+            strides_ = size2_t(1, dims.x);
+            break;
+    }
+}
+
+dmat2 TensorFieldSliceView::projectedAt(const size2_t &pos) const {
+    return tensorutil::getProjectedTensor(tensorField_->tensors()[parentIndex(pos)], axis_);
+}
+
+size_t TensorFieldSliceView::getRowLength() const {
+    switch (axis_) {
+        case CartesianCoordinateAxis::X:
+            return 1;
+        case CartesianCoordinateAxis::Y:
+            return dimensions_.x;
+        case CartesianCoordinateAxis::Z:
+        default:
+            return getSize();
+    }
+}
+
+std::vector<size_t> TensorFieldSliceView::getRowStarts() const {
+    const auto rowLength = getRowLength();
+    std::vector<size_t> rowStarts(getSize() / rowLength);
+    for (size_t i = 0; i < rowStarts.size(); ++i) {
+        rowStarts[i] = parentIndex(i * rowLength);
+    }
+    return rowStarts;
+}
+
+std::shared_ptr<TensorField2D> TensorFieldSliceView::materialize2D() const {
+    const auto &tensors = tensorField_->tensors();
+    std::vector<dmat2> sliceData(getSize());
+    for (size_t i = 0; i < sliceData.size(); ++i) {
+        sliceData[i] = tensorutil::getProjectedTensor(tensors[parentIndex(i)], axis_);
+    }
+
+    auto tensorField = std::make_shared<TensorField2D>(dimensions_, sliceData);
+    tensorField->setOffset(tensorField_->getOffset());
+
+    return tensorField;
+}
+
+std::shared_ptr<TensorField3D> TensorFieldSliceView::materialize3D() const {
+    const auto axisIndex = static_cast<glm::length_t>(axis_);
+    auto dimensions = tensorField_->getDimensions();
+    dimensions[axisIndex] = 1;
+
+    const auto rowStarts = getRowStarts();
+    const auto rowLength = getRowLength();
+
+    std::unordered_map<uint64_t, std::unique_ptr<MetaDataBase>> metaData;
+    for (const auto &entry : tensorField_->metaData()) {
+        metaData.emplace(entry.first,
+                         std::unique_ptr<MetaDataBase>(entry.second->gather(rowStarts, rowLength)));
+    }
+
+    const auto frac =
+        static_cast<float>(sliceNumber_) * tensorField_->getSpacing<float>()[axisIndex];
+
+    auto tensorField = std::make_shared<TensorField3D>(
+        dimensions, tensorField_->tensors().gather(rowStarts, rowLength), std::move(metaData),
+        tensorField_->getExtents(), frac);
+
+    vec3 offset{0.0f};
+    offset[axisIndex] = frac;
+    tensorField->setOffset(offset);
+
+    if (tensorField_->hasMask()) {
+        const auto &mask = tensorField_->getMask();
+        std::vector<glm::uint8> sliceMask(getSize());
+        auto dst = sliceMask.begin();
+        for (const auto start : rowStarts) {
+            dst = std::copy_n(mask.begin() + start, rowLength, dst);
+        }
+        tensorField->setMask(sliceMask);
+    }
+
+    return tensorField;
+}
+
+std::string TensorFieldSliceView::getDataInfo() const {
+    std::stringstream ss;
+    ss << "<table border='0' cellspacing='0' cellpadding='0' "
+          "style='border-color:white;white-space:pre;'>/n"
+       << tensorutil::getHTMLTableRowString("Type", "3D tensor field slice")
+       << tensorutil::getHTMLTableRowString("Axis", std::string(1, "XYZ"[static_cast<int>(axis_)]))
+       << tensorutil::getHTMLTableRowString("Slice number", sliceNumber_)
+       << tensorutil::getHTMLTableRowString("Dimensions", size3_t(dimensions_, 1))
+       << tensorutil::getHTMLTableRowString("Parent dimensions", tensorField_->getDimensions())
+       << "</table>";
+
+    return ss.str();
+}
+
+}  // namespace inviwo
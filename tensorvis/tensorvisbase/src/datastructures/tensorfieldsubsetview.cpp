@@ -0,0 +1,136 @@
+#include <inviwo/tensorvisbase/datastructures/tensorfieldsubsetview.h>
+#include <inviwo/tensorvisbase/util/tensorfieldutil.h>
+#include <inviwo/tensorvisbase/util/datareductions.h>
+#include <inviwo/tensorvisbase/util/misc.h>
+#include <inviwo/core/util/exception.h>
+
+#include <algorithm>
+#include <sstream>
+
+namespace inviwo {
+
+namespace {
+/*
+ * Calls callback(i) for all i in [0, count) with at most as many jobs as there are threads in the
+ * pool, a single job runs serially. The calling thread takes part, so this is safe within pool
+ * tasks such as the exporters.
+ */
+template <typename C>
+void forEachRow(const size_t count, size_t jobs, C callback) {
+    if (jobs == 0) {
+        const auto settings = InviwoApplication::getPtr()->getSettingsByType<SystemSettings>();
+        jobs = static_cast<size_t>(settings->poolSize_.get());
+    }
+
+    const auto chunks = std::min(jobs, count);
+    tensorutil::detail::forEachChunk(count, chunks, [&](size_t, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) callback(i);
+    });
+}
+
+template <typename T>
+std::vector<T> gatherRows(const T *src, const std::vector<size_t> &rowStarts,
+                          const size_t rowLength, const size_t jobs) {
+    std::vector<T> res(rowStarts.size() * rowLength);
+    forEachRow(rowStarts.size(), jobs, [&](const size_t row) {
+        std::copy_n(src + rowStarts[row], rowLength, res.data() + row * rowLength);
+    });
+    return res;
+}
+
+TensorStorage3D gatherTensors(const TensorStorage3D &tensors, const std::vector<size_t> &rowStarts,
+                              const size_t rowLength, const size_t jobs) {
+    // A single run is shared with the parent instead of copied
+    if (rowStarts.size() == 1) return tensors.gather(rowStarts, rowLength);
+
+    switch (tensors.getMode()) {
+        case TensorStorageMode::Symmetric:
+            return TensorStorage3D(
+                gatherRows(tensors.symmetricTensors(), rowStarts, rowLength, jobs));
+        case TensorStorageMode::SymmetricFloat:
+            return TensorStorage3D(
+                gatherRows(tensors.symmetricFloatTensors(), rowStarts, rowLength, jobs));
+        case TensorStorageMode::Full:
+        default:
+            return TensorStorage3D(gatherRows(tensors.data(), rowStarts, rowLength, jobs));
+    }
+}
+}  // namespace
+
+TensorFieldSubsetView::TensorFieldSubsetView(std::shared_ptr<const TensorField3D> tensorField,
+                                             const size3_t &origin, const size3_t &dimensions)
+    : tensorField_(std::move(tensorField)), origin_(origin), dimensions_(dimensions) {
+    if (!tensorField_) {
+        throw Exception("No tensor field for the subset", IVW_CONTEXT);
+    }
+
+    const auto parentDims = tensorField_->getDimensions();
+    if (glm::any(glm::equal(dimensions_, size3_t(0))) ||
+        glm::any(glm::greaterThan(origin_ + dimensions_, parentDims))) {
+        throw Exception("Subset at " + glm::to_string(uvec3(origin_)) + " of dimensions " +
+                            glm::to_string(uvec3(dimensions_)) +
+                            " is not inside the tensor field",
+                        IVW_CONTEXT);
+    }
+
+    offset_ = tensorField_->indexMapper()(origin_);
+    strides_ = size2_t(parentDims.x, parentDims.x * parentDims.y);
+}
+
+size_t TensorFieldSubsetView::getRowLength() const {
+    const auto parentDims = tensorField_->getDimensions();
+    if (dimensions_.x != parentDims.x) return dimensions_.x;
+    if (dimensions_.y != parentDims.y) return dimensions_.x * dimensions_.y;
+    return getSize();
+}
+
+std::vector<size_t> TensorFieldSubsetView::getRowStarts() const {
+    const auto rowLength = getRowLength();
+    std::vector<size_t> rowStarts(getSize() / rowLength);
+    for (size_t i = 0; i < rowStarts.size(); ++i) {
+        rowStarts[i] = parentIndex(i * rowLength);
+    }
+    return rowStarts;
+}
+
+std::shared_ptr<TensorField3D> TensorFieldSubsetView::materialize(const size_t jobs) const {
+    const auto rowStarts = getRowStarts();
+    const auto rowLength = getRowLength();
+
+    std::unordered_map<uint64_t, std::unique_ptr<MetaDataBase>> metaData;
+    for (const auto &entry : tensorField_->metaData()) {
+        metaData.emplace(entry.first,
+                         std::unique_ptr<MetaDataBase>(entry.second->gather(rowStarts, rowLength)));
+    }
+
+    // Same convention as TensorField3D::getSpacing, the extents span the nodes of the subset
+    const auto spacing = tensorField_->getSpacing<float>();
+    const auto extents = spacing * vec3(glm::max(dimensions_ - size3_t(1), size3_t(1)));
+
+    auto tensorField = std::make_shared<TensorField3D>(
+        dimensions_, gatherTensors(tensorField_->tensors(), rowStarts, rowLength, jobs),
+        std::move(metaData), extents);
+    tensorField->setOffset(tensorField_->getOffset() + vec3(origin_) * spacing);
+
+    if (tensorField_->hasMask()) {
+        tensorField->setMask(
+            gatherRows(tensorField_->getMask().data(), rowStarts, rowLength, jobs));
+    }
+
+    return tensorField;
+}
+
+std::string TensorFieldSubsetView::getDataInfo() const {
+    std::stringstream ss;
+    ss << "<table border='0' cellspacing='0' cellpadding='0' "
+          "style='border-color:white;white-space:pre;'>/n"
+       << tensorutil::getHTMLTableRowString("Type", "3D tensor field subset")
+       << tensorutil::getHTMLTableRowString("Origin", origin_)
+       << tensorutil::getHTMLTableRowString("Dimensions", dimensions_)
+       << tensorutil::getHTMLTableRowString("Parent dimensions", tensorField_->getDimensions())
+       << "</table>";
+
+    return ss.str();
+}
+
+}  // namespace inviwo
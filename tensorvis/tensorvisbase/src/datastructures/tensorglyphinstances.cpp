@@ -0,0 +1,33 @@
+#include <inviwo/tensorvisbase/datastructures/tensorglyphinstances.h>
+#include <inviwo/core/util/exception.h>
+
+#include <sstream>
+
+namespace inviwo {
+
+TensorGlyphInstances::TensorGlyphInstances(TensorGlyphType type,
+                                           std::shared_ptr<const BasicMesh> baseMesh,
+                                           const size2_t &resolution,
+                                           std::vector<TensorGlyphInstance> instances,
+                                           std::vector<size_t> fieldIndices)
+    : type_(type)
+    , baseMesh_(std::move(baseMesh))
+    , resolution_(resolution)
+    , instances_(std::move(instances))
+    , fieldIndices_(std::move(fieldIndices)) {
+    if (instances_.size() != fieldIndices_.size()) {
+        throw Exception("Number of glyphs and field indices do not match", IVW_CONTEXT);
+    }
+}
+
+std::string TensorGlyphInstances::getDataInfo() const {
+    std::ostringstream oss;
+    oss << "Glyphs: " << size() << " (" << getSizeInBytes() / 1024 << " KiB)";
+    if (baseMesh_) {
+        oss << ", base mesh vertices: " << baseMesh_->getVertices()->getSize() << " ("
+            << resolution_.x << " x " << resolution_.y << ")";
+    }
+    return oss.str();
+}
+
+}  // namespace inviwo
@@ -0,0 +1,184 @@
+#include <inviwo/tensorvisbase/datastructures/tensorstorage.h>
+
+#include <algorithm>
+
+namespace inviwo {
+
+namespace {
+template <typename T>
+std::vector<SymmetricTensor3<T>> pack(const dmat3 *tensors, const size_t size) {
+    std::vector<SymmetricTensor3<T>> packed(size);
+    std::transform(tensors, tensors + size, packed.begin(),
+                   [](const dmat3 &tensor) { return SymmetricTensor3<T>::fromMatrix(tensor); });
+    return packed;
+}
+
+template <typename T>
+std::vector<T> gatherRows(const T *tensors, const std::vector<size_t> &rowStarts,
+                          const size_t rowLength) {
+    std::vector<T> res(rowStarts.size() * rowLength);
+    auto dst = res.data();
+    for (const auto start : rowStarts) {
+        dst = std::copy_n(tensors + start, rowLength, dst);
+    }
+    return res;
+}
+
+template <typename Dst, typename Src>
+std::vector<SymmetricTensor3<Dst>> convertPacked(const SymmetricTensor3<Src> *tensors,
+                                                 const size_t size) {
+    std::vector<SymmetricTensor3<Dst>> converted(size);
+    std::transform(tensors, tensors + size, converted.begin(),
+                   [](const SymmetricTensor3<Src> &t) {
+                       SymmetricTensor3<Dst> res;
+                       std::transform(t.components.begin(), t.components.end(),
+                                      res.components.begin(),
+                                      [](const Src val) { return static_cast<Dst>(val); });
+                       return res;
+                   });
+    return converted;
+}
+}  // namespace
+
+TensorStorage3D::TensorStorage3D(std::vector<dmat3> tensors, const TensorStorageMode mode)
+    : mode_(mode) {
+    switch (mode_) {
+        case TensorStorageMode::Full:
+            full_ = SharedArray<dmat3>(std::move(tensors));
+            break;
+        case TensorStorageMode::Symmetric:
+            symmetric_ = SharedArray<SymmetricTensor3<double>>(
+                pack<double>(tensors.data(), tensors.size()));
+            break;
+        case TensorStorageMode::SymmetricFloat:
+            symmetricFloat_ = SharedArray<SymmetricTensor3<float>>(
+                pack<float>(tensors.data(), tensors.size()));
+            break;
+    }
+}
+
+TensorStorage3D::TensorStorage3D(std::vector<SymmetricTensor3<double>> tensors)
+    : mode_(TensorStorageMode::Symmetric), symmetric_(std::move(tensors)) {}
+
+TensorStorage3D::TensorStorage3D(std::vector<SymmetricTensor3<float>> tensors)
+    : mode_(TensorStorageMode::SymmetricFloat), symmetricFloat_(std::move(tensors)) {}
+
+TensorStorage3D::TensorStorage3D(std::shared_ptr<const dmat3> tensors, const size_t size)
+    : mode_(TensorStorageMode::Full), full_(std::move(tensors), size) {}
+
+TensorStorage3D::TensorStorage3D(std::shared_ptr<const SymmetricTensor3<double>> tensors,
+                                 const size_t size)
+    : mode_(TensorStorageMode::Symmetric), symmetric_(std::move(tensors), size) {}
+
+TensorStorage3D::TensorStorage3D(std::shared_ptr<const SymmetricTensor3<float>> tensors,
+                                 const size_t size)
+    : mode_(TensorStorageMode::SymmetricFloat), symmetricFloat_(std::move(tensors), size) {}
+
+size_t TensorStorage3D::getSizeInBytes() const {
+    switch (mode_) {
+        case TensorStorageMode::Symmetric:
+            return size() * sizeof(SymmetricTensor3<double>);
+        case TensorStorageMode::SymmetricFloat:
+            return size() * sizeof(SymmetricTensor3<float>);
+        case TensorStorageMode::Full:
+        default:
+            return size() * sizeof(dmat3);
+    }
+}
+
+bool TensorStorage3D::isShared() const {
+    const auto shared = [](const auto &tensors) {
+        return !tensors.isOwned || tensors.data.use_count() > 1;
+    };
+
+    switch (mode_) {
+        case TensorStorageMode::Symmetric:
+            return shared(symmetric_);
+        case TensorStorageMode::SymmetricFloat:
+            return shared(symmetricFloat_);
+        case TensorStorageMode::Full:
+        default:
+            return shared(full_);
+    }
+}
+
+void TensorStorage3D::set(const size_t index, const dmat3 &tensor) {
+    switch (mode_) {
+        case TensorStorageMode::Symmetric:
+            detach(symmetric_)[index] = SymmetricTensor3<double>::fromMatrix(tensor);
+            break;
+        case TensorStorageMode::SymmetricFloat:
+            detach(symmetricFloat_)[index] = SymmetricTensor3<float>::fromMatrix(tensor);
+            break;
+        case TensorStorageMode::Full:
+            detach(full_)[index] = tensor;
+            break;
+    }
+}
+
+TensorStorage3D TensorStorage3D::convert(const TensorStorageMode mode) const {
+    if (mode == mode_) return *this;
+
+    switch (mode) {
+        case TensorStorageMode::Symmetric:
+            if (mode_ == TensorStorageMode::SymmetricFloat) {
+                return TensorStorage3D(
+                    convertPacked<double>(symmetricFloat_.get(), symmetricFloat_.size));
+            }
+            return TensorStorage3D(pack<double>(full_.get(), full_.size));
+        case TensorStorageMode::SymmetricFloat:
+            if (mode_ == TensorStorageMode::Symmetric) {
+                return TensorStorage3D(convertPacked<float>(symmetric_.get(), symmetric_.size));
+            }
+            return TensorStorage3D(pack<float>(full_.get(), full_.size));
+        case TensorStorageMode::Full:
+        default:
+            return TensorStorage3D(toMatrices());
+    }
+}
+
+std::vector<dmat3> TensorStorage3D::toMatrices() const {
+    if (mode_ == TensorStorageMode::Full) {
+        return std::vector<dmat3>(full_.get(), full_.get() + full_.size);
+    }
+
+    std::vector<dmat3> tensors(size());
+    for (size_t i = 0; i < tensors.size(); ++i) {
+        tensors[i] = (*this)[i];
+    }
+    return tensors;
+}
+
+TensorStorage3D TensorStorage3D::gather(const std::vector<size_t> &rowStarts,
+                                        const size_t rowLength) const {
+    if (rowStarts.size() == 1) {
+        // The aliasing constructor keeps the whole memory of this storage alive
+        const auto start = rowStarts.front();
+        switch (mode_) {
+            case TensorStorageMode::Symmetric:
+                return TensorStorage3D(std::shared_ptr<const SymmetricTensor3<double>>(
+                                           symmetric_.data, symmetric_.get() + start),
+                                       rowLength);
+            case TensorStorageMode::SymmetricFloat:
+                return TensorStorage3D(std::shared_ptr<const SymmetricTensor3<float>>(
+                                           symmetricFloat_.data, symmetricFloat_.get() + start),
+                                       rowLength);
+            case TensorStorageMode::Full:
+            default:
+                return TensorStorage3D(
+                    std::shared_ptr<const dmat3>(full_.data, full_.get() + start), rowLength);
+        }
+    }
+
+    switch (mode_) {
+        case TensorStorageMode::Symmetric:
+            return TensorStorage3D(gatherRows(symmetric_.get(), rowStarts, rowLength));
+        case TensorStorageMode::SymmetricFloat:
+            return TensorStorage3D(gatherRows(symmetricFloat_.get(), rowStarts, rowLength));
+        case TensorStorageMode::Full:
+        default:
+            return TensorStorage3D(gatherRows(full_.get(), rowStarts, rowLength));
+    }
+}
+
+}  // namespace inviwo
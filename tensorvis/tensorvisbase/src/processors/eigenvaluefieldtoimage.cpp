@@ -87,15 +87,12 @@ void EigenvalueFieldToImage::process() {
 
     TextureUnitContainer units;
 
-    std::shared_ptr<Image> tensorFieldTexture;
-
     // add tensorfield to texture unit container
-    tensorutil::bindTensorFieldAsColorTexture(tensorFieldTexture, inport_, shader_, units);
+    utilgl::bindAndSetUniforms(shader_, units, *cache_.getImage(inport_.getData()), "tensorField",
+                               ImageType::ColorOnly);
 
     TextureUnit tf;
 
-    // Create a subsampled tensorfield to find possible deviations from the initial min/max values
-    // for eigenvalues
     updateEigenValues();
     updateAnisotropy();
 
@@ -121,67 +118,26 @@ void EigenvalueFieldToImage::process() {
 }
 
 void EigenvalueFieldToImage::updateEigenValues() {
-    auto subsampled = tensorutil::subsample2D(inport_.getData(),
-                                              inport_.getData()->getDimensions() * size2_t(2, 2));
-
-    std::vector<double> eigenValues;
-    if (majorMinor_.get()) {
-        eigenValues = std::vector<double>(subsampled->minorEigenValues());
-    } else {
-        eigenValues = std::vector<double>(subsampled->majorEigenValues());
-    }
-
-    minVal_ = static_cast<float>(*std::min_element(eigenValues.begin(), eigenValues.end()));
-    maxVal_ = static_cast<float>(*std::max_element(eigenValues.begin(), eigenValues.end()));
-
-    if (minVal_ == 0.0) {
-        // Delete zero entries to find actual minimum
-        eigenValues.erase(
-            std::remove_if(eigenValues.begin(), eigenValues.end(),
-                           [](double x) { return x < std::numeric_limits<double>::epsilon(); }),
-            eigenValues.end());
-
-        minVal_ = static_cast<float>(*std::min_element(eigenValues.begin(), eigenValues.end()));
-        maxVal_ = static_cast<float>(*std::max_element(eigenValues.begin(), eigenValues.end()));
-    }
+    const auto &ranges = getRanges();
+    const auto &range = majorMinor_.get() ? ranges.minor : ranges.major;
 
+    minVal_ = static_cast<float>(range.x);
+    maxVal_ = static_cast<float>(range.y);
     eigenValueRange_ = glm::abs(minVal_ - maxVal_);
 }
 
 void EigenvalueFieldToImage::updateAnisotropy() {
-    auto subsampled = tensorutil::subsample2D(inport_.getData(),
-                                              inport_.getData()->getDimensions() * size2_t(2, 2));
-
-    std::vector<double> minorEigenValues;
-    std::vector<double> majorEigenValues;
-    std::vector<double> anisotropyValues;
-    minorEigenValues = std::vector<double>(subsampled->minorEigenValues());
-    majorEigenValues = std::vector<double>(subsampled->majorEigenValues());
-    anisotropyValues.resize(minorEigenValues.size());
-
-    for (size_t i = 0; i < minorEigenValues.size(); ++i) {
-        anisotropyValues[i] = glm::abs(majorEigenValues[i] - minorEigenValues[i]);
-    }
-
-    anisotropyMinVal_ =
-        static_cast<float>(*std::min_element(anisotropyValues.begin(), anisotropyValues.end()));
-    anisotropyMaxVal_ =
-        static_cast<float>(*std::max_element(anisotropyValues.begin(), anisotropyValues.end()));
-
-    if (anisotropyMinVal_ == 0.0) {
-        // Delete zero entries to find actual minimum
-        anisotropyValues.erase(
-            std::remove_if(anisotropyValues.begin(), anisotropyValues.end(),
-                           [](double x) { return x < std::numeric_limits<double>::epsilon(); }),
-            anisotropyValues.end());
-
-        anisotropyMinVal_ =
-            static_cast<float>(*std::min_element(anisotropyValues.begin(), anisotropyValues.end()));
-        anisotropyMaxVal_ =
-            static_cast<float>(*std::max_element(anisotropyValues.begin(), anisotropyValues.end()));
-    }
+    const auto &range = getRanges().anisotropy;
 
+    anisotropyMinVal_ = static_cast<float>(range.x);
+    anisotropyMaxVal_ = static_cast<float>(range.y);
     anisotropyValueRange_ = glm::abs(anisotropyMinVal_ - anisotropyMaxVal_);
 }
 
+const EigenValueRanges &EigenvalueFieldToImage::getRanges() {
+    // Ranges of the field resampled at twice its resolution, only recomputed for new fields
+    const auto tensorField = inport_.getData();
+    return cache_.getRanges(tensorField, tensorField->getDimensions() * size2_t(2));
+}
+
 }  // namespace inviwo
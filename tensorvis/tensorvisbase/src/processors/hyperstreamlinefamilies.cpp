@@ -0,0 +1,96 @@
+#include <inviwo/tensorvisbase/processors/hyperstreamlinefamilies.h>
+
+namespace inviwo {
+
+// The Class Identifier has to be globally unique. Use a reverse DNS naming scheme
+const ProcessorInfo HyperStreamlineFamilies::processorInfo_{
+    "org.inviwo.HyperStreamlineFamilies",  // Class identifier
+    "Hyper Streamline Families",           // Display name
+    "Tensor Visualization",                // Category
+    CodeState::Experimental,               // Code state
+    "CPU",                                 // Tags
+};
+const ProcessorInfo HyperStreamlineFamilies::getProcessorInfo() const { return processorInfo_; }
+
+HyperStreamlineFamilies::HyperStreamlineFamilies()
+    : tensorField_("tensorField")
+    , seeds_("seeds")
+    , majorLines_("majorLines")
+    , intermediateLines_("intermediateLines")
+    , minorLines_("minorLines")
+    , properties_("properties", "Properties")
+    , adaptiveStepSize_("adaptiveStepSize", "Adaptive Step Size", false)
+    , tolerance_("tolerance", "Tolerance", 1e-5, 1e-10, 1e-2, 1e-6)
+    , maxStepFactor_("maxStepFactor", "Max Step Size Factor", 10.0, 1.0, 1000.0) {
+    addPort(tensorField_);
+    addPort(seeds_);
+    addPort(majorLines_);
+    addPort(intermediateLines_);
+    addPort(minorLines_);
+
+    // Families are only traced while their outport is connected, see process()
+    for (auto outport : {&majorLines_, &intermediateLines_, &minorLines_}) {
+        outport->onConnect([this]() { invalidate(InvalidationLevel::InvalidOutput); });
+    }
+
+    addProperty(properties_);
+    addProperty(adaptiveStepSize_);
+    addProperty(tolerance_);
+    addProperty(maxStepFactor_);
+
+    auto updateVisibility = [this]() {
+        tolerance_.setVisible(adaptiveStepSize_.get());
+        maxStepFactor_.setVisible(adaptiveStepSize_.get());
+    };
+    adaptiveStepSize_.onChange(updateVisibility);
+    updateVisibility();
+
+    properties_.normalizeSamples_.set(true);
+    properties_.normalizeSamples_.setCurrentStateAsDefault();
+}
+
+void HyperStreamlineFamilies::process() {
+    const auto tensorField = tensorField_.getData();
+
+    const std::array<IntegralLineSetOutport *, 3> outports{&majorLines_, &intermediateLines_,
+                                                           &minorLines_};
+    std::array<bool, 3> families;
+    std::array<std::shared_ptr<IntegralLineSet>, 3> lines;
+    for (size_t family = 0; family < 3; ++family) {
+        families[family] = outports[family]->isConnected();
+        lines[family] = std::make_shared<IntegralLineSet>(tensorField->getModelMatrix(),
+                                                          tensorField->getWorldMatrix());
+    }
+
+    HyperStreamLineFamilyTracer tracer(tensorField, properties_);
+    tracer.getTracer().setAdaptiveStepSize(adaptiveStepSize_.get());
+    tracer.getTracer().setTolerance(tolerance_.get());
+    tracer.getTracer().setMaxStepFactor(maxStepFactor_.get());
+
+    // Every seed writes to its own slot, the lines are then added in seed order without locking
+    std::vector<HyperStreamLineFamilyTracer::Results> traced;
+    size_t startID = 0;
+    for (const auto &seeds : seeds_) {
+        traced.clear();
+        traced.resize(seeds->size());
+        util::forEachParallel(*seeds, [&](const auto &p, size_t i) {
+            traced[i] = tracer.traceFrom(p, families);
+        });
+
+        for (size_t i = 0; i < traced.size(); ++i) {
+            for (size_t family = 0; family < 3; ++family) {
+                auto &line = traced[i][family].line;
+                if (line.getPositions().size() > 1) {
+                    lines[family]->push_back(std::move(line), startID + i);
+                }
+            }
+        }
+        startID += seeds->size();
+    }
+
+    for (size_t family = 0; family < 3; ++family) {
+        outports[family]->setData(lines[family]);
+    }
+}
+
+}  // namespace inviwo
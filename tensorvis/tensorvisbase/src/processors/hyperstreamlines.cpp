@@ -1,4 +1,6 @@
 #include <inviwo/tensorvisbase/processors/hyperstreamlines.h>
+#include <inviwo/tensorvisbase/algorithm/hyperstreamlineseeding.h>
+#include <inviwo/core/util/exception.h>
 
 namespace inviwo {
 
@@ -15,13 +17,78 @@ const ProcessorInfo HyperStreamlines::getProcessorInfo() const { return processo
 HyperStreamlines::HyperStreamlines()
     : sampler_("sampler")
     , seeds_("seeds")
+    , tensorField_("tensorField")
     , lines_("lines")
-    , properties_("properties", "Properties") {
+    , properties_("properties", "Properties")
+    , adaptiveStepSize_("adaptiveStepSize", "Adaptive Step Size", false)
+    , tolerance_("tolerance", "Tolerance", 1e-5, 1e-10, 1e-2, 1e-6)
+    , maxStepFactor_("maxStepFactor", "Max Step Size Factor", 10.0, 1.0, 1000.0)
+    , seeding_("seeding", "Seeding")
+    , seedingMode_("seedingMode", "Mode",
+                   {{"seedPoints", "Seed points only", SeedingMode::SeedPoints},
+                    {"evenlySpaced", "Evenly spaced", SeedingMode::EvenlySpaced},
+                    {"featureWeighted", "Feature weighted", SeedingMode::FeatureWeighted}},
+                   0)
+    , useOccupancy_("useOccupancy", "Stop in Occupied Cells", false)
+    , occupancyResolution_("occupancyResolution", "Occupancy Resolution", size3_t(32),
+                           size3_t(1), size3_t(512))
+    , cellCapacity_("cellCapacity", "Lines per Cell", 1, 1, 64)
+    , seedSpacing_("seedSpacing", "Seed Spacing (Cells)", 3, 1, 16)
+    , feature_("feature", "Feature",
+               {{"anisotropy", "Anisotropy", TensorFeature::Anisotropy},
+                {"linearAnisotropy", "Linear anisotropy", TensorFeature::LinearAnisotropy},
+                {"planarAnisotropy", "Planar anisotropy", TensorFeature::PlanarAnisotropy},
+                {"frobeniusNorm", "Frobenius norm", TensorFeature::FrobeniusNorm},
+                {"majorEigenValue", "Major eigenvalue", TensorFeature::Sigma1}},
+               0)
+    , numberOfSeeds_("numberOfSeeds", "Number of Seeds", 1000, 1, 1000000)
+    , randomSeed_("randomSeed", "Random Seed", 0, 0, 1000000) {
     addPort(sampler_);
     addPort(seeds_);
+    addPort(tensorField_);
     addPort(lines_);
 
+    seeds_.setOptional(true);
+    tensorField_.setOptional(true);
+
     addProperty(properties_);
+    addProperty(adaptiveStepSize_);
+    addProperty(tolerance_);
+    addProperty(maxStepFactor_);
+
+    auto updateVisibility = [this]() {
+        tolerance_.setVisible(adaptiveStepSize_.get());
+        maxStepFactor_.setVisible(adaptiveStepSize_.get());
+    };
+    adaptiveStepSize_.onChange(updateVisibility);
+    updateVisibility();
+
+    seeding_.addProperty(seedingMode_);
+    seeding_.addProperty(useOccupancy_);
+    seeding_.addProperty(occupancyResolution_);
+    seeding_.addProperty(cellCapacity_);
+    seeding_.addProperty(seedSpacing_);
+    seeding_.addProperty(feature_);
+    seeding_.addProperty(numberOfSeeds_);
+    seeding_.addProperty(randomSeed_);
+    addProperty(seeding_);
+
+    // Evenly spaced seeding always uses the occupancy grid
+    auto updateSeedingVisibility = [this]() {
+        const auto mode = seedingMode_.get();
+        const auto evenlySpaced = mode == SeedingMode::EvenlySpaced;
+        const auto weighted = mode == SeedingMode::FeatureWeighted;
+        useOccupancy_.setVisible(!evenlySpaced);
+        occupancyResolution_.setVisible(evenlySpaced || useOccupancy_.get());
+        cellCapacity_.setVisible(evenlySpaced || useOccupancy_.get());
+        seedSpacing_.setVisible(evenlySpaced);
+        feature_.setVisible(weighted);
+        numberOfSeeds_.setVisible(weighted);
+        randomSeed_.setVisible(weighted);
+    };
+    seedingMode_.onChange(updateSeedingVisibility);
+    useOccupancy_.onChange(updateSeedingVisibility);
+    updateSeedingVisibility();
 
     properties_.normalizeSamples_.set(true);
     properties_.normalizeSamples_.setCurrentStateAsDefault();
@@ -35,19 +102,69 @@ void HyperStreamlines::process() {
         std::make_shared<IntegralLineSet>(sampler->getModelMatrix(), sampler->getWorldMatrix());
 
     HyperStreamLineTracer tracer(sampler, properties_);
+    tracer.setAdaptiveStepSize(adaptiveStepSize_.get());
+    tracer.setTolerance(tolerance_.get());
+    tracer.setMaxStepFactor(maxStepFactor_.get());
 
-    std::mutex mutex;
+    const auto mode = seedingMode_.get();
+    std::shared_ptr<HyperStreamLineOccupancyGrid> occupancy;
+    if (mode == SeedingMode::EvenlySpaced || useOccupancy_) {
+        occupancy = std::make_shared<HyperStreamLineOccupancyGrid>(occupancyResolution_.get(),
+                                                                   cellCapacity_.get());
+        tracer.setOccupancyGrid(occupancy);
+        tracer.setOccupancyFrozen(true);
+    }
+
+    // Every seed writes to its own slot, the lines are then added in seed order without locking.
+    // With an occupancy grid the seeds are traced against the grid as it was before the call and
+    // their cells are committed in seed order, so the result does not depend on scheduling.
+    std::vector<HyperStreamLineTracer::Result> traced;
     size_t startID = 0;
+    auto trace = [&](const auto &seeds, auto traceSeed) {
+        if (seeds.empty()) return;
+
+        traced.clear();
+        traced.resize(seeds.size());
+        util::forEachParallel(seeds, [&](const auto &p, size_t i) { traced[i] = traceSeed(p); });
+
+        for (size_t i = 0; i < traced.size(); ++i) {
+            tracer.commitOccupancy(traced[i]);
+            if (traced[i].line.getPositions().size() > 1) {
+                lines->push_back(std::move(traced[i].line), startID + i);
+            }
+        }
+        startID += seeds.size();
+    };
+
+    // Given seed points are traced first so that they get the occupancy grid to themselves
     for (const auto &seeds : seeds_) {
-        util::forEachParallel(*seeds, [&](const auto &p, size_t i) {
-            IntegralLine line = tracer.traceFrom(p);
-            auto size = line.getPositions().size();
-            if (size > 1) {
-                std::lock_guard<std::mutex> lock(mutex);
-                lines->push_back(std::move(line), startID + i);
+        trace(*seeds, [&](const auto &p) { return tracer.traceFrom(p); });
+    }
+
+    const auto traceGenerated = [&](const std::vector<dvec3> &seeds) {
+        trace(seeds, [&](const dvec3 &p) { return tracer.traceFromDataSpace(p); });
+    };
+    try {
+        if (mode == SeedingMode::EvenlySpaced) {
+            const auto rounds = tensorutil::numberOfSeedingRounds(seedSpacing_.get());
+            for (size_t round = 0; round < rounds; ++round) {
+                traceGenerated(
+                    tensorutil::evenlySpacedSeeds(*occupancy, seedSpacing_.get(), round));
+            }
+        } else if (mode == SeedingMode::FeatureWeighted) {
+            const auto tensorField = tensorField_.getData();
+            if (!tensorField) {
+                throw Exception("Feature weighted seeding needs a tensor field", IVW_CONTEXT);
             }
-        });
-        startID += seeds->size();
+            traceGenerated(tensorutil::weightedSeeds(
+                tensorutil::featureWeights(*tensorField, feature_.get()),
+                tensorField->getDimensions(), numberOfSeeds_.get(),
+                static_cast<std::uint32_t>(randomSeed_.get())));
+        }
+    } catch (const Exception &e) {
+        LogError(e.getMessage());
+        lines_.clear();
+        return;
     }
 
     lines_.setData(lines);
@@ -28,6 +28,7 @@
  *********************************************************************************/
 
 #include <inviwo/tensorvisbase/processors/invariantspacetodataframe.h>
+#include <inviwo/tensorvisbase/datastructures/metadatacolumnview.h>
 
 namespace inviwo {
 
@@ -53,21 +54,12 @@ void InvariantSpaceToDataFrame::process() {
 
     auto dataFrame = std::make_shared<DataFrame>();
 
-    size_t i{0};
-    for (const auto axis : invariantSpace) {
-        auto buffer = std::make_shared<Buffer<glm::f32>>();
+    for (size_t i = 0; i < invariantSpace.getNumberOfDimensions(); ++i) {
+        const auto axis = invariantSpace.getAxis(i);
+        const MetaDataColumnView column(axis.data(), axis.size(), 1, MetaDataPrecision::Float64);
 
-        buffer->setSize(axis->size());
-
-        const auto data = axis->data();
-
-        for (size_t j{0}; j < axis->size(); ++j) {
-            buffer->getEditableRepresentation<BufferRAM>()->setFromDouble(j, data[j]);
-        }
-
-        dataFrame->addColumnFromBuffer(invariantSpace.getIdentifier(i), buffer);
-
-        i++;
+        dataFrame->addColumnFromBuffer(invariantSpace.getIdentifier(i),
+                                       util::createBuffer(column, MetaDataPrecision::Float32));
     }
 
     dataFrame->updateIndexBuffer();
@@ -53,22 +53,38 @@ TensorField2DSubsample::TensorField2DSubsample()
           {{"linear", "Linear", tensorutil::InterpolationMethod::Linear},
            {"nearest", "Nearest neighbour", tensorutil::InterpolationMethod::Nearest},
            {"barycentric", "Barycentric", tensorutil::InterpolationMethod::Barycentric}},
-          0) {
+          0)
+    , filter_("filter", "Downsampling filter",
+              {{"none", "None", tensorutil::ResamplingFilter::None},
+               {"box", "Box", tensorutil::ResamplingFilter::Box},
+               {"gaussian", "Gaussian", tensorutil::ResamplingFilter::Gaussian}},
+              0)
+    , space_("space", "Averaging space",
+             {{"euclidean", "Euclidean", tensorutil::ResamplingSpace::Euclidean},
+              {"logEuclidean", "Log-Euclidean", tensorutil::ResamplingSpace::LogEuclidean}},
+             0) {
     addPort(inport_);
     addPort(outport_);
 
     addProperty(resolutionMultiplier_);
 
     addProperty(interpolationMethod_);
+    addProperty(filter_);
+    addProperty(space_);
 }
 
 void TensorField2DSubsample::initializeResources() {}
 
 void TensorField2DSubsample::process() {
-    outport_.setData(tensorutil::subsample2D(
+    tensorutil::ResamplingSettings settings;
+    settings.method = interpolationMethod_.get();
+    settings.filter = filter_.get();
+    settings.space = space_.get();
+
+    outport_.setData(tensorutil::resample(
         inport_.getData(),
         size2_t(glm::round(vec2(inport_.getData()->getDimensions()) * resolutionMultiplier_.get())),
-        interpolationMethod_.get()));
+        settings));
 }
 
 }  // namespace inviwo
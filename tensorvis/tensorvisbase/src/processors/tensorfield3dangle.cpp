@@ -70,6 +70,7 @@ void TensorField3DAngle::process() {
         3, std::vector<std::string>{u8"φmax", u8"φmiddle", u8"φmin"},
         std::vector<TensorFeature>{TensorFeature::Unspecified, TensorFeature::Unspecified,
                                    TensorFeature::Unspecified});
+    iv->reserve(numberOfElements);
 
     auto convertAngle = [](auto angle) {
         return angle >= glm::half_pi<double>() ? glm::pi<double>() - angle : angle;
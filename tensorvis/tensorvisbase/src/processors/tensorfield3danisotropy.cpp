@@ -28,11 +28,9 @@
  *********************************************************************************/
 
 #include <inviwo/tensorvisbase/processors/tensorfield3danisotropy.h>
-#include <inviwo/tensorvisbase/util/tensorfieldutil.h>
+#include <inviwo/tensorvisbase/algorithm/tensorfieldanisotropy.h>
 #include <inviwo/tensorvisbase/util/tensorutil.h>
 #include <inviwo/core/datastructures/volume/volume.h>
-#include <inviwo/core/datastructures/volume/volumeram.h>
-#include <inviwo/core/util/indexmapper.h>
 #include <modules/opengl/volume/volumegl.h>
 
 namespace inviwo {
@@ -60,6 +58,18 @@ TensorField3DAnisotropy::TensorField3DAnisotropy()
                    {"4", "|" + tensorutil::lamda1_str + "| - |" + tensorutil::lamda2_str + "|",
                     tensorutil::Anisotropy::abs_lamda1_minus_abs_lamda2}},
                   0)
+    , combineMeasures_("combineMeasures", "Combine measures", false)
+    , measures_("measures", "Measures")
+    , absLamda1MinusLamda2_("absLamda1MinusLamda2",
+                            "|" + tensorutil::lamda1_str + " - " + tensorutil::lamda2_str + "|",
+                            true)
+    , absLamda1MinusLamda3_("absLamda1MinusLamda3",
+                            "|" + tensorutil::lamda1_str + " - " + tensorutil::lamda3_str + "|",
+                            false)
+    , barycentric_("barycentric", "Barycentric", true)
+    , absLamda1MinusAbsLamda2_(
+          "absLamda1MinusAbsLamda2",
+          "|" + tensorutil::lamda1_str + "| - |" + tensorutil::lamda2_str + "|", false)
     , interpolationScheme_(
           "interpolationScheme", "Interpolation scheme",
           {{"nearest", "Nearest neighbour", GL_NEAREST}, {"linear", "Linear", GL_LINEAR}}, 1) {
@@ -67,127 +77,46 @@ TensorField3DAnisotropy::TensorField3DAnisotropy()
     addPort(volumeOutport_);
 
     addProperty(anisotropy_);
+    addProperty(combineMeasures_);
+    measures_.addProperty(absLamda1MinusLamda2_);
+    measures_.addProperty(absLamda1MinusLamda3_);
+    measures_.addProperty(barycentric_);
+    measures_.addProperty(absLamda1MinusAbsLamda2_);
+    addProperty(measures_);
     addProperty(interpolationScheme_);
+
+    measures_.setVisible(false);
+    combineMeasures_.onChange([this]() {
+        anisotropy_.setVisible(!combineMeasures_.get());
+        measures_.setVisible(combineMeasures_.get());
+    });
 }
 
 void TensorField3DAnisotropy::process() {
-    auto tensorField = tensorFieldInport_.getData();
-    std::shared_ptr<Volume> outputVolume;
-    auto dimensions = tensorField->getDimensions();
-    std::function<void(const size3_t&)> func;
-    util::IndexMapper3D indexMapper(dimensions);
-    const auto& majorEigenValues = tensorField->majorEigenValues();
-    const auto& intermediateEigenValues = tensorField->middleEigenValues();
-    const auto& minorEigenValues = tensorField->minorEigenValues();
-    auto min = std::numeric_limits<double>::max();
-    auto max = std::numeric_limits<double>::lowest();
-
-    switch (anisotropy_.get()) {
-        case tensorutil::Anisotropy::abs_lamda1_minus_lamda2:
-            outputVolume = std::make_shared<Volume>(dimensions, DataFloat32::get());
-            {
-                auto data = static_cast<glm::f32*>(
-                    outputVolume->getEditableRepresentation<VolumeRAM>()->getData());
-
-                tensorutil::forEachVoxelParallel(
-                    *(tensorField.get()), [&](const size3_t& pos) -> void {
-                        const auto index = indexMapper(pos);
-                        const auto val =
-                            glm::abs(majorEigenValues[index] - intermediateEigenValues[index]);
-                        max = std::max(max, val);
-                        min = std::min(min, val);
-                        data[index] = static_cast<glm::f32>(val);
-                    });
-            }
-            break;
-        case tensorutil::Anisotropy::abs_lamda1_minus_lamda3:
-            outputVolume = std::make_shared<Volume>(dimensions, DataFloat32::get());
-            {
-                auto data = static_cast<glm::f32*>(
-                    outputVolume->getEditableRepresentation<VolumeRAM>()->getData());
-
-                tensorutil::forEachVoxelParallel(
-                    *(tensorField.get()), [&](const size3_t& pos) -> void {
-                        const auto index = indexMapper(pos);
-                        const auto val =
-                            glm::abs(majorEigenValues[index] - minorEigenValues[index]);
-
-                        max = std::max(max, val);
-                        min = std::min(min, val);
-                        data[index] = static_cast<glm::f32>(val);
-                    });
-            }
-            break;
-        case tensorutil::Anisotropy::barycentric:
-            outputVolume = std::make_shared<Volume>(dimensions, DataVec3Float32::get());
-            {
-                auto data = static_cast<glm::vec3*>(
-                    outputVolume->getEditableRepresentation<VolumeRAM>()->getData());
-
-                tensorutil::forEachVoxelParallel(
-                    *(tensorField.get()), [&](const size3_t& pos) -> void {
-                        const auto index = indexMapper(pos);
-                        auto eigenValues = std::array<double, 3>{majorEigenValues[index],
-                                                                 intermediateEigenValues[index],
-                                                                 minorEigenValues[index]};
-
-                        std::transform(eigenValues.begin(), eigenValues.end(), eigenValues.begin(),
-                                       [](const double& val) { return glm::abs(val); });
-
-                        std::sort(
-                            eigenValues.begin(), eigenValues.end(),
-                            [](const double& valA, const double& valB) { return valA > valB; });
-
-                        auto denominator = eigenValues[0] + eigenValues[1] + eigenValues[2];
-                        if (denominator < std::numeric_limits<double>::epsilon())
-                            denominator = std::numeric_limits<double>::epsilon();
-                        const auto c_l_ = (eigenValues[0] - eigenValues[1]) / denominator;
-                        const auto c_p_ = (2. * (eigenValues[1] - eigenValues[2])) / denominator;
-                        const auto c_s_ = (3. * eigenValues[2]) / denominator;
-
-                        const auto barycentricCoordinates = dvec3(c_l_, c_p_, c_s_);
-
-                        max = std::max(max, barycentricCoordinates.x);
-                        max = std::max(max, barycentricCoordinates.y);
-                        max = std::max(max, barycentricCoordinates.z);
-                        min = std::min(min, barycentricCoordinates.x);
-                        min = std::min(min, barycentricCoordinates.y);
-                        min = std::min(min, barycentricCoordinates.z);
-
-                        data[index] = vec3(barycentricCoordinates);
-                    });
-            }
-            break;
-        case tensorutil::Anisotropy::abs_lamda1_minus_abs_lamda2:
-            outputVolume = std::make_shared<Volume>(dimensions, DataFloat32::get());
-            {
-                auto data = static_cast<glm::f32*>(
-                    outputVolume->getEditableRepresentation<VolumeRAM>()->getData());
-
-                tensorutil::forEachVoxelParallel(
-                    *(tensorField.get()), [&](const size3_t& pos) -> void {
-                        const auto index = indexMapper(pos);
-                        const auto val =
-                            glm::abs(majorEigenValues[index]) - glm::abs(minorEigenValues[index]);
-
-                        max = std::max(max, val);
-                        min = std::min(min, val);
-                        data[index] = static_cast<glm::f32>(val);
-                    });
-            }
-            break;
-        default:
-            break;
+    std::vector<tensorutil::Anisotropy> measures;
+    if (combineMeasures_.get()) {
+        if (absLamda1MinusLamda2_.get()) {
+            measures.push_back(tensorutil::Anisotropy::abs_lamda1_minus_lamda2);
+        }
+        if (absLamda1MinusLamda3_.get()) {
+            measures.push_back(tensorutil::Anisotropy::abs_lamda1_minus_lamda3);
+        }
+        if (barycentric_.get()) measures.push_back(tensorutil::Anisotropy::barycentric);
+        if (absLamda1MinusAbsLamda2_.get()) {
+            measures.push_back(tensorutil::Anisotropy::abs_lamda1_minus_abs_lamda2);
+        }
+    } else {
+        measures.push_back(anisotropy_.get());
     }
-    outputVolume->dataMap_.dataRange = vec2(min, max);
-    outputVolume->dataMap_.valueRange = vec2(min, max);
 
-    const auto extends = tensorField->getExtents();
-
-    outputVolume->setBasis(
-        mat3(vec3(extends.x, 0., 0.), vec3(0., extends.y, 0.), vec3(0., 0., extends.z)));
-
-    outputVolume->setOffset(tensorField->getOffset());
+    std::shared_ptr<Volume> outputVolume;
+    try {
+        outputVolume = tensorutil::computeAnisotropy(*tensorFieldInport_.getData(), measures);
+    } catch (const Exception& e) {
+        LogError(e.getMessage());
+        volumeOutport_.clear();
+        return;
+    }
 
     // HOTFIX: enable nearest neighbor sampling for volume
     TextureUnit unit;
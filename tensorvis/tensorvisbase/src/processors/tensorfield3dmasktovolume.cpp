@@ -1,5 +1,6 @@
 #include <inviwo/tensorvisbase/processors/tensorfield3dmasktovolume.h>
 #include <inviwo/core/datastructures/volume/volumeram.h>
+#include <inviwo/tensorvisbase/util/datareductions.h>
 
 namespace inviwo {
 
@@ -90,8 +91,7 @@ void TensorField3DMaskToVolume::process() {
         return 0.f;
     });
 
-    const auto min = *std::min_element(std::begin(f), std::end(f));
-    const auto max = *std::max_element(std::begin(f), std::end(f));
+    const auto range = tensorutil::computeStatistics(f.data(), f.size()).range();
 
     auto fData = f.data();
     std::memcpy(volumeData, fData, f.size());
@@ -104,8 +104,8 @@ void TensorField3DMaskToVolume::process() {
     volume->setBasis(basis);
     volume->setOffset(vec3(0.f));
 
-    volume->dataMap_.dataRange = vec2(min, max);
-    volume->dataMap_.valueRange = vec2(min, max);
+    volume->dataMap_.dataRange = range;
+    volume->dataMap_.valueRange = range;
 
     outport_.setData(volume);
 }
@@ -30,6 +30,7 @@
 #include <inviwo/tensorvisbase/processors/tensorfield3dmetadata.h>
 #include <inviwo/tensorvisbase/util/tensorutil.h>
 #include <inviwo/tensorvisbase/datastructures/tensorfieldmetadata.h>
+#include <inviwo/tensorvisbase/algorithm/tensorfeatures.h>
 
 namespace inviwo {
 
@@ -124,7 +125,8 @@ void TensorField3DMetaData::initializeResources() {
     if (inport_.hasData()) {
         auto tensorField = inport_.getData();
 
-        tensorFieldOut_ = std::shared_ptr<TensorField3D>(tensorField->clone());
+        // The copy shares the tensors and existing metadata with the input
+        tensorFieldOut_ = std::make_shared<TensorField3D>(*tensorField);
 
         sigma1_.set(tensorFieldOut_->hasMetaData<MajorEigenValues>());
         sigma2_.set(tensorFieldOut_->hasMetaData<IntermediateEigenValues>());
@@ -134,15 +136,15 @@ void TensorField3DMetaData::initializeResources() {
         ev2_.set(tensorFieldOut_->hasMetaData<IntermediateEigenVectors>());
         ev3_.set(tensorFieldOut_->hasMetaData<MinorEigenVectors>());
 
-        i1_.set(tensorFieldOut_->hasMetaData<I1>());
-        i2_.set(tensorFieldOut_->hasMetaData<I2>());
-        i3_.set(tensorFieldOut_->hasMetaData<I3>());
+        i1_.set(tensorFieldOut_->isMetaDataComputed(I1::id()));
+        i2_.set(tensorFieldOut_->isMetaDataComputed(I2::id()));
+        i3_.set(tensorFieldOut_->isMetaDataComputed(I3::id()));
 
-        j1_.set(tensorFieldOut_->hasMetaData<J1>());
-        j2_.set(tensorFieldOut_->hasMetaData<J2>());
-        j3_.set(tensorFieldOut_->hasMetaData<J3>());
+        j1_.set(tensorFieldOut_->isMetaDataComputed(J1::id()));
+        j2_.set(tensorFieldOut_->isMetaDataComputed(J2::id()));
+        j3_.set(tensorFieldOut_->isMetaDataComputed(J3::id()));
 
-        lodeAngle_.set(tensorFieldOut_->hasMetaData<LodeAngle>());
+        lodeAngle_.set(tensorFieldOut_->isMetaDataComputed(LodeAngle::id()));
 
         anisotropy_.set(tensorFieldOut_->hasMetaData<Anisotropy>());
 
@@ -160,326 +162,48 @@ void TensorField3DMetaData::initializeResources() {
     }
 }
 
-void TensorField3DMetaData::addMetaData() {
-    const auto& tensors = tensorFieldOut_->tensors();
-
-    if (i1_.get() && !tensorFieldOut_->hasMetaData<I1>()) {
-        std::vector<double> i1;
-
-        for (const auto& tensor : tensors) {
-            i1.emplace_back(tensorutil::calculateI1(tensor));
-        }
-
-        tensorFieldOut_->addMetaData<I1>(i1, TensorFeature::I1);
-    }
-    if (i2_.get() && !tensorFieldOut_->hasMetaData<I2>()) {
-        std::vector<double> i2;
-
-        for (const auto& tensor : tensors) {
-            i2.emplace_back(tensorutil::calculateI2(tensor));
-        }
-
-        tensorFieldOut_->addMetaData<I2>(i2, TensorFeature::I2);
-    }
-    if (i3_.get() && !tensorFieldOut_->hasMetaData<I3>()) {
-        std::vector<double> i3;
-
-        for (const auto& tensor : tensors) {
-            i3.emplace_back(tensorutil::calculateI3(tensor));
-        }
-
-        tensorFieldOut_->addMetaData<I3>(i3, TensorFeature::I3);
-    }
-    if (j1_.get() && !tensorFieldOut_->hasMetaData<J1>()) {
-        std::vector<double> j1;
-
-        for (const auto& tensor : tensors) {
-            j1.emplace_back(tensorutil::calculateJ1(tensor));
-        }
-
-        tensorFieldOut_->addMetaData<J1>(j1, TensorFeature::J1);
-    }
-    if (j2_.get() && !tensorFieldOut_->hasMetaData<J2>()) {
-        std::vector<double> j2;
-
-        for (const auto& tensor : tensors) {
-            j2.emplace_back(tensorutil::calculateJ2(tensor));
-        }
-
-        tensorFieldOut_->addMetaData<J2>(j2, TensorFeature::J2);
-    }
-    if (j3_.get() && !tensorFieldOut_->hasMetaData<J3>()) {
-        std::vector<double> j3;
-
-        for (const auto& tensor : tensors) {
-            j3.emplace_back(tensorutil::calculateJ3(tensor));
-        }
-
-        tensorFieldOut_->addMetaData<J3>(j3, TensorFeature::J3);
-    }
-    if (lodeAngle_.get() && !tensorFieldOut_->hasMetaData<LodeAngle>()) {
-        std::vector<double> lodeAngle;
-
-        for (const auto& tensor : tensors) {
-            lodeAngle.emplace_back(tensorutil::calculateLodeAngle(tensor));
-        }
-
-        tensorFieldOut_->addMetaData<LodeAngle>(lodeAngle, TensorFeature::LodeAngle);
-    }
-    if (anisotropy_.get() && !tensorFieldOut_->hasMetaData<Anisotropy>()) {
-        std::vector<double> anisotropy;
-        const auto& majorEigenValues = tensorFieldOut_->getMetaData<MajorEigenValues>();
-        const auto& minorEigenValues = tensorFieldOut_->getMetaData<MinorEigenValues>();
-
-        for (size_t i = 0; i < tensors.size(); i++) {
-            anisotropy.emplace_back(std::abs(majorEigenValues[i] - minorEigenValues[i]));
-        }
-
-        tensorFieldOut_->addMetaData<Anisotropy>(anisotropy, TensorFeature::Anisotropy);
-    }
-    if (linearAnisotropy_.get() && !tensorFieldOut_->hasMetaData<LinearAnisotropy>()) {
-        std::vector<double> linearAnisotropy;
-
-        const auto& majorEigenValues = tensorFieldOut_->getMetaData<MajorEigenValues>();
-        const auto& intermediateEigenValues =
-            tensorFieldOut_->getMetaData<IntermediateEigenValues>();
-        const auto& minorEigenValues = tensorFieldOut_->getMetaData<MinorEigenValues>();
-
-        for (size_t i = 0; i < majorEigenValues.size(); i++) {
-            std::array<double, 3> eigenValues{majorEigenValues[i], intermediateEigenValues[i],
-                                              minorEigenValues[i]};
-
-            std::transform(eigenValues.begin(), eigenValues.end(), eigenValues.begin(),
-                           [](const double& val) { return glm::abs(val); });
-
-            std::sort(eigenValues.begin(), eigenValues.end(),
-                      [](const double& valA, const double& valB) { return valA > valB; });
-
-            auto denominator = eigenValues[0] + eigenValues[1] + eigenValues[2];
-            if (denominator < std::numeric_limits<double>::epsilon())
-                denominator = std::numeric_limits<double>::epsilon();
-
-            linearAnisotropy.emplace_back((eigenValues[0] - eigenValues[1]) / denominator);
-        }
-
-        tensorFieldOut_->addMetaData<LinearAnisotropy>(linearAnisotropy,
-                                                       TensorFeature::LinearAnisotropy);
-    }
-    if (planarAnisotropy_.get() && !tensorFieldOut_->hasMetaData<PlanarAnisotropy>()) {
-        std::vector<double> planarAnisotropy;
-
-        const auto& majorEigenValues = tensorFieldOut_->getMetaData<MajorEigenValues>();
-        const auto& intermediateEigenValues =
-            tensorFieldOut_->getMetaData<IntermediateEigenValues>();
-        const auto& minorEigenValues = tensorFieldOut_->getMetaData<MinorEigenValues>();
-
-        for (size_t i = 0; i < majorEigenValues.size(); i++) {
-            std::array<double, 3> eigenValues{majorEigenValues[i], intermediateEigenValues[i],
-                                              minorEigenValues[i]};
-
-            std::transform(eigenValues.begin(), eigenValues.end(), eigenValues.begin(),
-                           [](const double& val) { return glm::abs(val); });
-
-            std::sort(eigenValues.begin(), eigenValues.end(),
-                      [](const double& valA, const double& valB) { return valA > valB; });
-
-            auto denominator = eigenValues[0] + eigenValues[1] + eigenValues[2];
-            if (denominator < std::numeric_limits<double>::epsilon())
-                denominator = std::numeric_limits<double>::epsilon();
-
-            planarAnisotropy.emplace_back((2.0 * (eigenValues[1] - eigenValues[2])) / denominator);
-        }
-
-        tensorFieldOut_->addMetaData<PlanarAnisotropy>(planarAnisotropy,
-                                                       TensorFeature::PlanarAnisotropy);
-    }
-    if (sphericalAnisotropy_.get() && !tensorFieldOut_->hasMetaData<SphericalAnisotropy>()) {
-        std::vector<double> sphericalAnisotropy;
-
-        const auto& majorEigenValues = tensorFieldOut_->getMetaData<MajorEigenValues>();
-        const auto& intermediateEigenValues =
-            tensorFieldOut_->getMetaData<IntermediateEigenValues>();
-        const auto& minorEigenValues = tensorFieldOut_->getMetaData<MinorEigenValues>();
-
-        for (size_t i = 0; i < majorEigenValues.size(); i++) {
-            std::array<double, 3> eigenValues{majorEigenValues[i], intermediateEigenValues[i],
-                                              minorEigenValues[i]};
-
-            std::transform(eigenValues.begin(), eigenValues.end(), eigenValues.begin(),
-                           [](const double& val) { return glm::abs(val); });
-
-            std::sort(eigenValues.begin(), eigenValues.end(),
-                      [](const double& valA, const double& valB) { return valA > valB; });
-
-            auto denominator = eigenValues[0] + eigenValues[1] + eigenValues[2];
-            if (denominator < std::numeric_limits<double>::epsilon())
-                denominator = std::numeric_limits<double>::epsilon();
-
-            sphericalAnisotropy.emplace_back((3.0 * eigenValues[2]) / denominator);
-        }
-
-        tensorFieldOut_->addMetaData<SphericalAnisotropy>(sphericalAnisotropy,
-                                                          TensorFeature::SphericalAnisotropy);
-    }
-    if (diffusivity_.get() && !tensorFieldOut_->hasMetaData<Diffusivity>()) {
-        std::vector<double> diffusivity;
-
-        const auto& majorEigenValues = tensorFieldOut_->getMetaData<MajorEigenValues>();
-        const auto& intermediateEigenValues =
-            tensorFieldOut_->getMetaData<IntermediateEigenValues>();
-        const auto& minorEigenValues = tensorFieldOut_->getMetaData<MinorEigenValues>();
-
-        for (size_t i = 0; i < majorEigenValues.size(); i++) {
-            std::array<double, 3> eigenValues{majorEigenValues[i], intermediateEigenValues[i],
-                                              minorEigenValues[i]};
-
-            std::transform(eigenValues.begin(), eigenValues.end(), eigenValues.begin(),
-                           [](const double& val) { return glm::abs(val); });
-
-            std::sort(eigenValues.begin(), eigenValues.end(),
-                      [](const double& valA, const double& valB) { return valA > valB; });
-
-            diffusivity.emplace_back(eigenValues[0] * eigenValues[0] +
-                                     eigenValues[1] * eigenValues[1] +
-                                     eigenValues[2] * eigenValues[2]);
-        }
-
-        tensorFieldOut_->addMetaData<Diffusivity>(diffusivity, TensorFeature::Diffusivity);
-    }
-    if (shearStress_.get() && !tensorFieldOut_->hasMetaData<ShearStress>()) {
-        std::vector<double> shearStress;
-
-        const auto& majorEigenValues = tensorFieldOut_->getMetaData<MajorEigenValues>();
-        const auto& minorEigenValues = tensorFieldOut_->getMetaData<MinorEigenValues>();
-
-        for (size_t i = 0; i < majorEigenValues.size(); i++) {
-            shearStress.emplace_back((majorEigenValues[i] - minorEigenValues[i]) / 2.0);
-        }
-
-        tensorFieldOut_->addMetaData<ShearStress>(shearStress, TensorFeature::ShearStress);
-    }
-    if (pureShear_.get() && !tensorFieldOut_->hasMetaData<PureShear>()) {
-        std::vector<double> pureShear;
-
-        const auto& majorEigenValues = tensorFieldOut_->getMetaData<MajorEigenValues>();
-
-        for (size_t i = 0; i < majorEigenValues.size(); i++) {
-            pureShear.emplace_back(0);
-        }
-
-        tensorFieldOut_->addMetaData<PureShear>(pureShear, TensorFeature::PureShear);
-    }
-    if (shapeFactor_.get() && !tensorFieldOut_->hasMetaData<ShapeFactor>()) {
-        std::vector<double> shapeFactor;
-
-        const auto& majorEigenValues = tensorFieldOut_->getMetaData<MajorEigenValues>();
-        const auto& intermediateEigenValues =
-            tensorFieldOut_->getMetaData<IntermediateEigenValues>();
-        const auto& minorEigenValues = tensorFieldOut_->getMetaData<MinorEigenValues>();
-        for (size_t i = 0; i < majorEigenValues.size(); i++) {
-            shapeFactor.emplace_back((majorEigenValues[i] - intermediateEigenValues[i]) /
-                                     (majorEigenValues[i] - minorEigenValues[i]));
-        }
-
-        tensorFieldOut_->addMetaData<ShapeFactor>(shapeFactor, TensorFeature::ShapeFactor);
-    }
-    if (isotropicScaling_.get() && !tensorFieldOut_->hasMetaData<IsotropicScaling>()) {
-        std::vector<double> isotropicScaling;
-
-        const auto& majorEigenValues = tensorFieldOut_->getMetaData<MajorEigenValues>();
-        const auto& intermediateEigenValues =
-            tensorFieldOut_->getMetaData<IntermediateEigenValues>();
-        const auto& minorEigenValues = tensorFieldOut_->getMetaData<MinorEigenValues>();
+std::vector<std::pair<const BoolProperty*, TensorFeature>>
+TensorField3DMetaData::scalarFeatures() const {
+    return {{&i1_, TensorFeature::I1},
+            {&i2_, TensorFeature::I2},
+            {&i3_, TensorFeature::I3},
+            {&j1_, TensorFeature::J1},
+            {&j2_, TensorFeature::J2},
+            {&j3_, TensorFeature::J3},
+            {&lodeAngle_, TensorFeature::LodeAngle},
+            {&anisotropy_, TensorFeature::Anisotropy},
+            {&linearAnisotropy_, TensorFeature::LinearAnisotropy},
+            {&planarAnisotropy_, TensorFeature::PlanarAnisotropy},
+            {&sphericalAnisotropy_, TensorFeature::SphericalAnisotropy},
+            {&diffusivity_, TensorFeature::Diffusivity},
+            {&shearStress_, TensorFeature::ShearStress},
+            {&pureShear_, TensorFeature::PureShear},
+            {&shapeFactor_, TensorFeature::ShapeFactor},
+            {&isotropicScaling_, TensorFeature::IsotropicScaling},
+            {&rotation_, TensorFeature::Rotation},
+            {&frobeniusNorm_, TensorFeature::FrobeniusNorm},
+            {&hillYieldCriterion_, TensorFeature::HillYieldCriterion}};
+}
 
-        for (size_t i = 0; i < majorEigenValues.size(); i++) {
-            isotropicScaling.emplace_back(
-                (majorEigenValues[i] + intermediateEigenValues[i] + minorEigenValues[i]) / 3.0);
+void TensorField3DMetaData::addMetaData() {
+    std::vector<TensorFeature> features;
+    for (const auto& feature : scalarFeatures()) {
+        const auto id = static_cast<uint64_t>(feature.second);
+        if (feature.first->get() && !tensorFieldOut_->isMetaDataComputed(id)) {
+            features.push_back(feature.second);
         }
-
-        tensorFieldOut_->addMetaData<IsotropicScaling>(isotropicScaling,
-                                                       TensorFeature::IsotropicScaling);
-    }
-    if (rotation_.get() && !tensorFieldOut_->hasMetaData<Rotation>()) {
-        std::vector<double> rotation;
-
-        rotation.resize(tensors.size(), 0.0);
-
-        tensorFieldOut_->addMetaData<Rotation>(rotation, TensorFeature::Rotation);
     }
-    if (frobeniusNorm_.get() && !tensorFieldOut_->hasMetaData<FrobeniusNorm>()) {
-        std::vector<double> frobeniusNorm;
+    if (features.empty()) return;
 
-        const auto& majorEigenValues = tensorFieldOut_->getMetaData<MajorEigenValues>();
-        const auto& intermediateEigenValues =
-            tensorFieldOut_->getMetaData<IntermediateEigenValues>();
-        const auto& minorEigenValues = tensorFieldOut_->getMetaData<MinorEigenValues>();
-
-        for (size_t i = 0; i < majorEigenValues.size(); i++) {
-            auto eigenValues = std::array<double, 3>{
-                majorEigenValues[i], intermediateEigenValues[i], minorEigenValues[i]};
-            frobeniusNorm.emplace_back(::sqrt(
-                std::accumulate(eigenValues.begin(), eigenValues.end(), 0.,
-                                [](const double& a, const double& b) { return a + (b * b); })));
-        }
-
-        tensorFieldOut_->addMetaData<FrobeniusNorm>(frobeniusNorm, TensorFeature::FrobeniusNorm);
+    // All missing features are computed in a single pass over the tensors and eigenvalues
+    for (auto& metaData : tensorutil::computeTensorFeatures(*tensorFieldOut_, features)) {
+        tensorFieldOut_->addMetaData(std::move(metaData));
     }
 }
 
 void TensorField3DMetaData::removeMetaData() {
-    if (!i1_.get()) {
-        tensorFieldOut_->removeMetaData<I1>();
-    }
-    if (!i2_.get()) {
-        tensorFieldOut_->removeMetaData<I2>();
-    }
-    if (!i3_.get()) {
-        tensorFieldOut_->removeMetaData<I3>();
-    }
-    if (!j1_.get()) {
-        tensorFieldOut_->removeMetaData<J1>();
-    }
-    if (!j2_.get()) {
-        tensorFieldOut_->removeMetaData<J2>();
-    }
-    if (!j3_.get()) {
-        tensorFieldOut_->removeMetaData<J3>();
-    }
-    if (!lodeAngle_.get()) {
-        tensorFieldOut_->removeMetaData<LodeAngle>();
-    }
-    if (!anisotropy_.get()) {
-        tensorFieldOut_->removeMetaData<Anisotropy>();
-    }
-    if (!linearAnisotropy_.get()) {
-        tensorFieldOut_->removeMetaData<LinearAnisotropy>();
-    }
-    if (!planarAnisotropy_.get()) {
-        tensorFieldOut_->removeMetaData<PlanarAnisotropy>();
-    }
-    if (!sphericalAnisotropy_.get()) {
-        tensorFieldOut_->removeMetaData<SphericalAnisotropy>();
-    }
-    if (!diffusivity_.get()) {
-        tensorFieldOut_->removeMetaData<Diffusivity>();
-    }
-    if (!shearStress_.get()) {
-        tensorFieldOut_->removeMetaData<ShearStress>();
-    }
-    if (!pureShear_.get()) {
-        tensorFieldOut_->removeMetaData<PureShear>();
-    }
-    if (!shapeFactor_.get()) {
-        tensorFieldOut_->removeMetaData<ShapeFactor>();
-    }
-    if (!isotropicScaling_.get()) {
-        tensorFieldOut_->removeMetaData<IsotropicScaling>();
-    }
-    if (!rotation_.get()) {
-        tensorFieldOut_->removeMetaData<Rotation>();
-    }
-    if (!frobeniusNorm_.get()) {
-        tensorFieldOut_->removeMetaData<FrobeniusNorm>();
+    for (const auto& feature : scalarFeatures()) {
+        if (!feature.first->get()) tensorFieldOut_->removeMetaData(uint64_t(feature.second));
     }
 }
 
@@ -502,6 +226,7 @@ void TensorField3DMetaData::selectAll() {
     isotropicScaling_.set(true);
     rotation_.set(true);
     frobeniusNorm_.set(true);
+    hillYieldCriterion_.set(true);
 }
 
 void TensorField3DMetaData::deselectAll() {
@@ -523,6 +248,7 @@ void TensorField3DMetaData::deselectAll() {
     isotropicScaling_.set(false);
     rotation_.set(false);
     frobeniusNorm_.set(false);
+    hillYieldCriterion_.set(false);
 }
 
 void TensorField3DMetaData::process() {
@@ -53,6 +53,15 @@ TensorField3DSubsample::TensorField3DSubsample()
           {{"linear", "Linear", tensorutil::InterpolationMethod::Linear},
            {"nearest", "Nearest neighbour", tensorutil::InterpolationMethod::Nearest}},
           0, InvalidationLevel::Valid)
+    , filter_("filter", "Downsampling filter",
+              {{"none", "None", tensorutil::ResamplingFilter::None},
+               {"box", "Box", tensorutil::ResamplingFilter::Box},
+               {"gaussian", "Gaussian", tensorutil::ResamplingFilter::Gaussian}},
+              0, InvalidationLevel::Valid)
+    , space_("space", "Averaging space",
+             {{"euclidean", "Euclidean", tensorutil::ResamplingSpace::Euclidean},
+              {"logEuclidean", "Log-Euclidean", tensorutil::ResamplingSpace::LogEuclidean}},
+             0, InvalidationLevel::Valid)
     , tf_(nullptr) {
     addPort(inport_);
     addPort(outport_);
@@ -60,10 +69,14 @@ TensorField3DSubsample::TensorField3DSubsample()
     addProperty(resolutionMultiplier_);
 
     addProperty(interpolationMethod_);
+    addProperty(filter_);
+    addProperty(space_);
 
     inport_.onChange([this]() { subsample(); });
     resolutionMultiplier_.onChange([this]() { subsample(); });
     interpolationMethod_.onChange([this]() { subsample(); });
+    filter_.onChange([this]() { subsample(); });
+    space_.onChange([this]() { subsample(); });
 }
 
 void TensorField3DSubsample::initializeResources() {}
@@ -79,24 +92,36 @@ void TensorField3DSubsample::subsample() {
                 auto on_progress = [&bar](float progress) { bar.updateProgress(progress); };
                 isRunning_ = true;
 
-                const auto resolutionMultiplier = resolutionMultiplier_.get();
-                const auto interpolationMethod = interpolationMethod_.get();
+                tensorutil::ResamplingSettings settings;
+                settings.progress = on_progress;
+                float resolutionMultiplier;
 
+                // Start over if the settings changed while resampling
                 do {
+                    resolutionMultiplier = resolutionMultiplier_.get();
+                    settings.method = interpolationMethod_.get();
+                    settings.filter = filter_.get();
+                    settings.space = space_.get();
+
                     bar.show();
                     bar.updateProgress(0.f);
 
-                    tf_ = tensorutil::subsample3D(
-                        inport_.getData(),
-                        size3_t(glm::round(vec3(inport_.getData()->getDimensions()) *
-                                           resolutionMultiplier)),
-                        interpolationMethod, on_progress);
+                    try {
+                        tf_ = tensorutil::resample(
+                            inport_.getData(),
+                            size3_t(glm::round(vec3(inport_.getData()->getDimensions()) *
+                                               resolutionMultiplier)),
+                            settings);
+                    } catch (const Exception& e) {
+                        LogError(e.getMessage());
+                    }
 
                     on_progress(1.f);
 
                     bar.hide();
                 } while (resolutionMultiplier != resolutionMultiplier_.get() ||
-                         interpolationMethod != interpolationMethod_.get());
+                         settings.method != interpolationMethod_.get() ||
+                         settings.filter != filter_.get() || settings.space != space_.get());
 
                 dispatchFront([this]() { invalidate(InvalidationLevel::InvalidOutput); });
 
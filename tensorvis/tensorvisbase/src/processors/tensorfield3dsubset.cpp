@@ -45,10 +45,15 @@ TensorField3DSubset::TensorField3DSubset()
     : Processor()
     , inport_("inport")
     , outport_("outport")
+    , viewOutport_("viewOutport")
     , origin_("origin", "Origin", ivec3(0))
     , offset_("offset", "Offset", ivec3(0), ivec3(0)) {
     addPort(inport_);
     addPort(outport_);
+    addPort(viewOutport_);
+
+    // The field outport is only filled while connected, see process()
+    outport_.onConnect([this]() { invalidate(InvalidationLevel::InvalidOutput); });
 
     offset_.setCurrentStateAsDefault();
 
@@ -84,27 +89,11 @@ TensorField3DSubset::TensorField3DSubset()
 }
 
 void TensorField3DSubset::process() {
-    auto tensorField = inport_.getData();
-
-    auto dimensions = size3_t(offset_.get() + size3_t(1));
-
-    auto spacing = tensorField->getSpacing<float>();
-
-    std::vector<dmat3> rawData;
-
-    for (size_t z = origin_.get().z; z <= origin_.get().z + offset_.get().z; ++z) {
-        for (size_t y = origin_.get().y; y <= origin_.get().y + offset_.get().y; ++y) {
-            for (size_t x = origin_.get().x; x <= origin_.get().x + offset_.get().x; ++x) {
-                rawData.push_back(tensorField->at(size3_t(x, y, z)).second);
-            }
-        }
-    }
-
-    auto outField =
-        std::make_shared<TensorField3D>(dimensions, rawData, spacing * vec3(dimensions));
-    outField->setOffset(tensorField->getOffset() + vec3(origin_.get()) * spacing);
+    const auto view = std::make_shared<TensorFieldSubsetView>(
+        inport_.getData(), size3_t(origin_.get()), size3_t(offset_.get()) + size3_t(1));
 
-    outport_.setData(outField);
+    viewOutport_.setData(view);
+    if (outport_.isConnected()) outport_.setData(view->materialize());
 }
 
 }  // namespace inviwo
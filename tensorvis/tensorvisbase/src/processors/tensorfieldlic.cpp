@@ -28,7 +28,6 @@
  *********************************************************************************/
 
 #include <inviwo/tensorvisbase/processors/tensorfieldlic.h>
-#include <algorithm>
 
 namespace inviwo {
 
@@ -86,30 +85,13 @@ void TensorFieldLIC::initializeResources() {
 }
 
 void TensorFieldLIC::updateEigenValues() {
-    auto subsampled = tensorutil::subsample2D(inport_.getData(),
-                                              inport_.getData()->getDimensions() * size2_t(2, 2));
-
-    std::vector<double> eigenValues;
-    if (majorMinor_.get()) {
-        eigenValues = std::vector<double>(subsampled->minorEigenValues());
-    } else {
-        eigenValues = std::vector<double>(subsampled->majorEigenValues());
-    }
-
-    minVal_ = static_cast<float>(*std::min_element(eigenValues.begin(), eigenValues.end()));
-    maxVal_ = static_cast<float>(*std::max_element(eigenValues.begin(), eigenValues.end()));
-
-    if (minVal_ == 0.0) {
-        // Delete zero entries to find actual minimum
-        eigenValues.erase(
-            std::remove_if(eigenValues.begin(), eigenValues.end(),
-                           [](double x) { return x < std::numeric_limits<double>::epsilon(); }),
-            eigenValues.end());
-
-        minVal_ = static_cast<float>(*std::min_element(eigenValues.begin(), eigenValues.end()));
-        maxVal_ = static_cast<float>(*std::max_element(eigenValues.begin(), eigenValues.end()));
-    }
+    // Ranges of the field resampled at twice its resolution, only recomputed for new fields
+    const auto tensorField = inport_.getData();
+    const auto &ranges = cache_.getRanges(tensorField, tensorField->getDimensions() * size2_t(2));
+    const auto &range = majorMinor_.get() ? ranges.minor : ranges.major;
 
+    minVal_ = static_cast<float>(range.x);
+    maxVal_ = static_cast<float>(range.y);
     eigenValueRange_ = glm::abs(minVal_ - maxVal_);
 }
 
@@ -118,10 +100,9 @@ void TensorFieldLIC::process() {
 
     shader_.activate();
     TextureUnitContainer units;
-    std::shared_ptr<Image> tensorFieldTexture;
     // add tensorfield to texture unit container
-    tensorutil::bindTensorFieldAsColorTexture(tensorFieldTexture, inport_.getData(), shader_,
-                                              units);
+    utilgl::bindAndSetUniforms(shader_, units, *cache_.getImage(inport_.getData()), "tensorField",
+                               ImageType::ColorOnly);
     // add noise texture to texture unit container
     utilgl::bindAndSetUniforms(shader_, units, noiseTexture_, ImageType::ColorOnly);
 
@@ -131,8 +112,6 @@ void TensorFieldLIC::process() {
         utilgl::bindAndSetUniforms(shader_, units, imageInport_, ImageType::ColorOnly);
     }
 
-    // Create a subsampled tensorfield to find possible deviations from the initial min/max values
-    // for eigenvalues
     updateEigenValues();
 
     utilgl::setUniforms(shader_, outport_, samples_, stepLength_, normalizeVectors_,
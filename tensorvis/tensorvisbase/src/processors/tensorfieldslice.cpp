@@ -28,7 +28,6 @@
  *********************************************************************************/
 
 #include <inviwo/tensorvisbase/processors/tensorfieldslice.h>
-#include <inviwo/tensorvisbase/algorithm/tensorfieldslicing.h>
 #include <inviwo/core/datastructures/geometry/geometrytype.h>
 #include <inviwo/tensorvisbase/util/tensorfieldutil.h>
 
@@ -50,6 +49,7 @@ TensorFieldSlice::TensorFieldSlice()
     , inport_("inport")
     , outport2D_("outport2D")
     , outport3D_("outport3D")
+    , viewOutport_("viewOutport")
     , sliceOutport_("meshOutport")
     , planeOutport_("planeOutport")
     , offsetOutport_("offsetOutport")
@@ -64,12 +64,17 @@ TensorFieldSlice::TensorFieldSlice()
     addPort(inport_);
     addPort(outport2D_);
     addPort(outport3D_);
+    addPort(viewOutport_);
     addPort(sliceOutport_);
     addPort(planeOutport_);
     addPort(offsetOutport_);
 
     offsetOutport_.setData(std::make_shared<size_t>(0));
 
+    // The field outports are only filled while connected, see process()
+    outport2D_.onConnect([this]() { invalidate(InvalidationLevel::InvalidOutput); });
+    outport3D_.onConnect([this]() { invalidate(InvalidationLevel::InvalidOutput); });
+
     addProperty(sliceAlongAxis_);
     addProperty(sliceNr_);
 
@@ -162,8 +167,12 @@ void TensorFieldSlice::process() {
     auto offset = offsetDimensions.x * offsetDimensions.y * (sliceNr_.get());
     offsetOutport_.setData(std::make_shared<size_t>(offset));
 
-    outport2D_.setData(slice<2>(inport_.getData(), sliceAlongAxis_.get(), sliceNr_.get()));
-    outport3D_.setData(slice<3>(inport_.getData(), sliceAlongAxis_.get(), sliceNr_.get()));
+    // The view only references the input, copies are only made for connected field outports
+    const auto view =
+        std::make_shared<TensorFieldSliceView>(tensorField, sliceAlongAxis_.get(), sliceNr_.get());
+    viewOutport_.setData(view);
+    if (outport2D_.isConnected()) outport2D_.setData(view->materialize2D());
+    if (outport3D_.isConnected()) outport3D_.setData(view->materialize3D());
     sliceOutport_.setData(tensorutil::generateSliceLevelGeometryForTensorField(
         inport_.getData(), sliceColor_.get(), sliceAlongAxis_.get(), sliceNr_.get()));
     planeOutport_.setData(tensorutil::generateSlicePlaneGeometryForTensorField(
@@ -32,7 +32,6 @@
 #include <inviwo/core/datastructures/volume/volumeram.h>
 #include <inviwo/core/datastructures/volume/volumeramprecision.h>
 #include <inviwo/core/util/volumeramutils.h>
-#include <modules/base/algorithm/dataminmax.h>
 #include <inviwo/tensorvisbase/util/tensorutil.h>
 
 namespace inviwo {
@@ -60,11 +59,16 @@ TensorFieldToVolume::TensorFieldToVolume()
                 {"intermediateEigenValue", "Intermediate eigenvalue", TensorFeature::Sigma2},
                 {"minorEigenValue", "Minor eigenvalue", TensorFeature::Sigma3},
                 {"hill", "Hill", TensorFeature::HillYieldCriterion}})
+    , precision_("precision", "Precision",
+                 {{"float32", "Float32", MetaDataPrecision::Float32},
+                  {"float64", "Float64", MetaDataPrecision::Float64}},
+                 0)
     , normalizeVectors_("normalize", "Normalize eigenvectors") {
     addPort(inport_);
     addPort(outport_);
 
     addProperty(feature_);
+    addProperty(precision_);
     addProperty(normalizeVectors_);
 
     /*feature_.onChange([this]() {
@@ -88,46 +92,17 @@ void TensorFieldToVolume::process() {
     }
 
     const auto metaData = tensorField->getMetaDataContainer(uint64_t(feature_.get()));
-    const auto numberOfComponents = metaData->getNumberOfComponents();
+    const auto column = MetaDataColumnView::fromMetaData(*metaData);
 
-    auto vol =
-        std::make_shared<Volume>(tensorField->getDimensions(),
-                                 DataFormatBase::get(NumericType::Float, numberOfComponents, 32));
+    auto ram = util::createVolumeRAM(column, tensorField->getDimensions(), precision_.get());
 
-    DataMapper map =
-        vol->getEditableRepresentation<VolumeRAM>()
-            ->dispatch<DataMapper, dispatching::filter::Floats>([metaData](auto repr) {
-                auto ptr = repr->getDataTyped();
-                using ValueType = util::PrecisionValueType<decltype(repr)>;
-                // TODO: use type of metadata instead of assuming double!
-                using P = typename util::same_extent<ValueType, double>::type;
-
-                const auto srcData = reinterpret_cast<const P *>(metaData->getDataPtr());
-#include <warn/push>
-#include <warn/ignore/conversion>
-                std::transform(srcData, srcData + glm::compMul(repr->getDimensions()), ptr,
-                               [](P v) { return static_cast<ValueType>(v); });
-#include <warn/pop>
-
-                const auto minmax = util::dataMinMax(srcData, glm::compMul(repr->getDimensions()));
-
-                DataMapper datamap;
-
-                double max = std::numeric_limits<float>::lowest();
-                double min = std::numeric_limits<float>::max();
-                for (size_t i = 0; i < 4; ++i) {
-                    if ((minmax.first[i] == minmax.second[i]) && (minmax.first[i] == 0.0)) {
-                        break;
-                    }
-                    max = std::max(max, minmax.second[i]);
-                    min = std::min(min, minmax.first[i]);
-                }
-
-                datamap.dataRange = dvec2{min, max};
-                datamap.valueRange = dvec2{min, max};
-                return datamap;
-            });
+    // Cached with the metadata, so only the first volume of a feature scans the data
+    const auto range = metaData->getStatistics()->range();
+    DataMapper map;
+    map.dataRange = range;
+    map.valueRange = range;
 
+    auto vol = std::make_shared<Volume>(ram);
     vol->setModelMatrix(tensorField->getBasisAndOffset());
     vol->dataMap_ = map;
     outport_.setData(vol);
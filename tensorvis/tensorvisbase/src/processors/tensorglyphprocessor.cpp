@@ -29,6 +29,8 @@
 
 #include <inviwo/tensorvisbase/processors/tensorglyphprocessor.h>
 #include <inviwo/tensorvisbase/util/tensorutil.h>
+#include <inviwo/tensorvisbase/util/tensorfieldutil.h>
+#include <inviwo/tensorvisbase/util/datareductions.h>
 
 namespace inviwo {
 
@@ -47,10 +49,12 @@ TensorGlyphProcessor::TensorGlyphProcessor()
     : Processor()
     , inport_("inport")
     , outport_("outport")
+    , glyphOutport_("glyphOutport")
     , glyphParameters_("glyphParameters", "Glyph parameters")
 
 {
     addPort(outport_);
+    addPort(glyphOutport_);
     addPort(inport_);
 
     addProperty(glyphParameters_);
@@ -61,34 +65,82 @@ void TensorGlyphProcessor::process() {
 
     auto tensorField = inport_.getData();
 
-    auto dimensions = tensorField->getDimensions();
+    const auto dimensions = tensorField->getDimensions();
+    const auto& tensors = tensorField->tensors();
 
-    util::IndexMapper3D indexMapper(dimensions);
+    const auto comp = glm::zero<dmat3>();
 
-    auto comp = glm::zero<dmat3>();
-
-    auto meshes = new std::vector<std::shared_ptr<Mesh>>();
+    std::vector<size_t> indices;
+    for (size_t i = 0; i < tensors.size(); ++i) {
+        if (tensors[i] != comp) indices.push_back(i);
+    }
 
     const vec3 voxelDist{tensorField->getSpacing()};
     const vec3 offset{tensorField->getOffset()};
 
-    for (size_t z = 0; z < dimensions.z; z++) {
-        for (size_t y = 0; y < dimensions.y; y++) {
-            for (size_t x = 0; x < dimensions.x; x++) {
-                const auto& tensor = tensorField->at(size3_t(x, y, z)).second;
-                if (tensor == comp) continue;
-                const auto index = indexMapper(size3_t(x, y, z));
+    const auto position = [&](size_t index) {
+        const size_t x = index % dimensions.x;
+        const size_t y = (index / dimensions.x) % dimensions.y;
+        const size_t z = index / (dimensions.x * dimensions.y);
+        return vec3{voxelDist * vec3{x, y, z} + offset};
+    };
+
+    // One mesh per glyph, only kept for networks rendering the glyphs as regular meshes
+    if (outport_.isConnected()) {
+        auto meshes = std::make_shared<std::vector<std::shared_ptr<Mesh>>>();
+        meshes->reserve(indices.size());
+        for (const auto index : indices) {
+            meshes->emplace_back(
+                glyphParameters_.generateGlyph(tensorField, index, position(index)));
+        }
+        outport_.setData(meshes);
+    }
 
-                // const auto dpos = tensorField->getNormalizedVolumePosition(index);
-                // const auto pos = vec3(dpos);
+    if (!glyphOutport_.isConnected()) return;
 
-                const vec3 pos{voxelDist * vec3{x, y, z} + offset};
+    if (!glyphParameters_.supportsInstancing()) {
+        LogWarn("The selected glyph type can not be rendered instanced.");
+        glyphOutport_.clear();
+        return;
+    }
 
-                meshes->emplace_back(glyphParameters_.generateGlyph(tensorField, index, pos));
-            }
+    // Fetch the eigen decomposition once, the accessors lock the field on every call
+    const auto& majorEigenValues = tensorField->majorEigenValues();
+    const auto& middleEigenValues = tensorField->middleEigenValues();
+    const auto& minorEigenValues = tensorField->minorEigenValues();
+    const auto& majorEigenVectors = tensorField->majorEigenVectors();
+    const auto& middleEigenVectors = tensorField->middleEigenVectors();
+    const auto& minorEigenVectors = tensorField->minorEigenVectors();
+
+    const auto type = glyphParameters_.type();
+    const FrobeniusNorm::DataType* frobeniusNorms =
+        type == TensorGlyphProperty::GlyphType::SuperquadricExtended
+            ? &tensorField->getMetaData<FrobeniusNorm>()
+            : nullptr;
+
+    // Generating an instance is costly enough to split even small fields over the pool
+    const auto settings = InviwoApplication::getPtr()->getSettingsByType<SystemSettings>();
+    const auto chunks = std::min(indices.size(), static_cast<size_t>(settings->poolSize_.get()));
+
+    std::vector<TensorGlyphInstance> instances(indices.size());
+    tensorutil::detail::forEachChunk(indices.size(), chunks, [&](size_t, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const auto index = indices[i];
+
+            const std::array<std::pair<double, dvec3>, 3> eigenSystem{
+                {{majorEigenValues[index], majorEigenVectors[index]},
+                 {middleEigenValues[index], middleEigenVectors[index]},
+                 {minorEigenValues[index], minorEigenVectors[index]}}};
+
+            instances[i] = glyphParameters_.generateInstance(
+                tensors[index], eigenSystem, frobeniusNorms ? (*frobeniusNorms)[index] : 1.0,
+                position(index));
         }
-    }
+    });
 
-    outport_.setData(meshes);
+    glyphOutport_.setData(std::make_shared<TensorGlyphInstances>(
+        type, glyphParameters_.createBaseMesh(),
+        size2_t(glyphParameters_.resolutionTheta(), glyphParameters_.resolutionPhi()),
+        std::move(instances), std::move(indices)));
 }
 }  // namespace inviwo
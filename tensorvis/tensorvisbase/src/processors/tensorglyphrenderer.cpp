@@ -29,12 +29,32 @@
 
 #include <inviwo/tensorvisbase/processors/tensorglyphrenderer.h>
 #include <modules/opengl/openglutils.h>
+#include <modules/opengl/geometry/meshgl.h>
+#include <modules/opengl/buffer/buffergl.h>
 #include <inviwo/core/interaction/events/mouseevent.h>
-#include <inviwo/core/rendering/meshdrawerfactory.h>
 #include <inviwo/core/interaction/events/pickingevent.h>
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+
 namespace inviwo {
 
+namespace {
+// Attribute locations of the instance parameters in tensorglyphinstanced.vert
+constexpr GLuint firstInstanceAttribute = 8;
+constexpr GLuint instanceIdAttribute = 14;
+
+void upload(std::unique_ptr<BufferObject>& buffer, const void* data, const size_t bytes,
+            const DataFormatBase* format) {
+    if (!buffer || buffer->getSizeInBytes() != static_cast<GLsizeiptr>(bytes)) {
+        buffer = std::make_unique<BufferObject>(bytes, format, BufferUsage::Static);
+    }
+    buffer->upload(data, bytes);
+}
+}  // namespace
+
 // The Class Identifier has to be globally unique. Use a reverse DNS naming scheme
 const ProcessorInfo TensorGlyphRenderer::processorInfo_{
     "org.inviwo.TensorGlyphRenderer",  // Class identifier
@@ -47,7 +67,7 @@ const ProcessorInfo TensorGlyphRenderer::getProcessorInfo() const { return proce
 
 TensorGlyphRenderer::TensorGlyphRenderer()
     : Processor()
-    , meshInport_("meshInport")
+    , glyphInport_("glyphInport")
     , tensorFieldInport_("tensorFieldInport")
     , offsetInport_("offsetInport")
     , imageInport_("imageInport")
@@ -65,12 +85,18 @@ TensorGlyphRenderer::TensorGlyphRenderer()
     , picking_(this, 1, [&](PickingEvent* p) { handlePickingEvent(p); })
     , selectedIDProperty_("selectedID", "Selected ID", 0, 0, std::numeric_limits<size_t>::max(), 1,
                           InvalidationLevel::Valid)
-    , shader_("geometryrendering.vert", "tensorglyphpicking.frag", false)
+    , shader_("tensorglyphinstanced.vert", "tensorglyphpicking.frag", false)
     , selectedID_(-1)
     , previouslySelectedID_(-1)
     , selectMode_("selectMode", "Select mode", true)
-    , glyphType_("glyphType", "Glyph type") {
-    addPort(meshInport_);
+    , glyphType_("glyphType", "Glyph type")
+    , lod_("lod", "Level of Detail")
+    , cullGlyphs_("cullGlyphs", "Cull glyphs", true)
+    , minPixelRadius_("minPixelRadius", "Min radius (pixels)", 0.5f, 0.0f, 10.0f, 0.1f)
+    , useLod_("useLod", "Adapt resolution", true)
+    , pixelsPerSegment_("pixelsPerSegment", "Pixels per segment", 4.0f, 1.0f, 32.0f, 0.5f)
+    , lodLevels_("lodLevels", "Levels", 4, 1, 8, 1) {
+    addPort(glyphInport_);
     addPort(tensorFieldInport_);
     offsetInport_.setOptional(true);
     addPort(offsetInport_);
@@ -88,17 +114,23 @@ TensorGlyphRenderer::TensorGlyphRenderer()
 
     addProperty(cullFace_);
 
-    shader_.onReload([this]() { invalidate(InvalidationLevel::InvalidResources); });
+    lod_.addProperty(cullGlyphs_);
+    lod_.addProperty(minPixelRadius_);
+    lod_.addProperty(useLod_);
+    lod_.addProperty(pixelsPerSegment_);
+    lod_.addProperty(lodLevels_);
+    addProperty(lod_);
+    // The glyphs only have to be re-uploaded per frame if they are culled or their level changes
+    cullGlyphs_.onChange([this]() { uploadInstances_ = true; });
+    useLod_.onChange([this]() { uploadInstances_ = true; });
 
-    meshInport_.onChange([&]() {
-        meshDrawers_.clear();
+    shader_.onReload([this]() { invalidate(InvalidationLevel::InvalidResources); });
 
-        for (const auto& mesh : *meshInport_.getData()) {
-            meshDrawers_.emplace_back(
-                InviwoApplication::getPtr()->getMeshDrawerFactory()->create(mesh.get()));
+    glyphInport_.onChange([&]() {
+        if (auto glyphs = glyphInport_.getData()) {
+            picking_.resize(std::max<size_t>(glyphs->size(), 1));
         }
-
-        picking_.resize(meshInport_.getData()->size());
+        uploadInstances_ = true;
     });
 
     indexOutport_.setData(std::make_shared<size_t>(0));
@@ -131,7 +163,8 @@ void TensorGlyphRenderer::handlePickingEvent(PickingEvent* p) {
                     offset = *offsetInport_.getData();
                 }
 
-                selectedIDProperty_.set(selectedID_ + offset);
+                selectedIDProperty_.set(
+                    glyphInport_.getData()->getFieldIndices()[selectedID_] + offset);
 
                 triggerSelect_ = false;
 
@@ -166,25 +199,139 @@ void TensorGlyphRenderer::addCommonShaderDefines(Shader& shader) {
     shader.build();
 }
 
+GlyphLodSettings TensorGlyphRenderer::getLodSettings() const {
+    GlyphLodSettings settings;
+    settings.cull = cullGlyphs_.get();
+    settings.minPixelRadius = minPixelRadius_.get();
+    settings.lod = useLod_.get();
+    settings.pixelsPerSegment = pixelsPerSegment_.get();
+    settings.levels = lodLevels_.get();
+    return settings;
+}
+
+void TensorGlyphRenderer::updateInstances(const TensorGlyphInstances& glyphs) {
+    const auto settings = getLodSettings();
+    const auto& instances = glyphs.getInstances();
+
+    if (!settings.cull && !settings.lod) {
+        if (!uploadInstances_) return;
+
+        std::vector<std::uint32_t> ids(instances.size());
+        std::iota(ids.begin(), ids.end(), 0u);
+        upload(instanceBuffer_, instances.data(), glyphs.getSizeInBytes(), DataFloat32::get());
+        upload(instanceIdBuffer_, ids.data(), ids.size() * sizeof(std::uint32_t),
+               DataUInt32::get());
+        lodRanges_ = {{glyphs.getBaseMesh(), 0, instances.size()}};
+        uploadInstances_ = false;
+        return;
+    }
+
+    // Instance positions and frames are given in the data space of the base mesh
+    const auto dataToClip =
+        camera_.projectionMatrix() * camera_.viewMatrix() *
+        glyphs.getBaseMesh()->getCoordinateTransformer().getDataToWorldMatrix();
+    const auto selection =
+        util::selectGlyphLods(glyphs, dataToClip, outport_.getDimensions(), settings);
+
+    std::vector<TensorGlyphInstance> visible;
+    std::vector<std::uint32_t> ids;
+    visible.reserve(selection.getNumberOfVisibleGlyphs());
+    ids.reserve(selection.getNumberOfVisibleGlyphs());
+
+    lodRanges_.clear();
+    for (size_t level = 0; level < selection.instances.size(); ++level) {
+        const auto& levelInstances = selection.instances[level];
+        if (levelInstances.empty()) continue;
+
+        // The finest level is the resolution the glyphs were generated with
+        lodRanges_.push_back({level == 0 ? glyphs.getBaseMesh()
+                                         : glyphType_.createBaseMesh(selection.resolutions[level]),
+                              visible.size(), levelInstances.size()});
+        for (const auto index : levelInstances) {
+            visible.push_back(instances[index]);
+            ids.push_back(static_cast<std::uint32_t>(index));
+        }
+    }
+
+    if (!visible.empty()) {
+        upload(instanceBuffer_, visible.data(), visible.size() * sizeof(TensorGlyphInstance),
+               DataFloat32::get());
+        upload(instanceIdBuffer_, ids.data(), ids.size() * sizeof(std::uint32_t),
+               DataUInt32::get());
+    }
+    uploadInstances_ = false;
+}
+
+void TensorGlyphRenderer::drawInstances(const LodRange& range, const TensorGlyphType type) {
+    shader_.setUniform("glyphType", static_cast<int>(type));
+
+    auto meshGL = range.mesh->getRepresentation<MeshGL>();
+    meshGL->enable();
+
+    // mat3 frame (3 x vec3), vec3 position, vec4 shape, vec4 color, see TensorGlyphInstance
+    const auto base = range.first * sizeof(TensorGlyphInstance);
+    const std::array<std::pair<GLint, size_t>, 6> attributes{
+        {{3, offsetof(TensorGlyphInstance, frame)},
+         {3, offsetof(TensorGlyphInstance, frame) + sizeof(vec3)},
+         {3, offsetof(TensorGlyphInstance, frame) + 2 * sizeof(vec3)},
+         {3, offsetof(TensorGlyphInstance, position)},
+         {4, offsetof(TensorGlyphInstance, shape)},
+         {4, offsetof(TensorGlyphInstance, color)}}};
+    instanceBuffer_->bind();
+    for (GLuint i = 0; i < attributes.size(); ++i) {
+        glEnableVertexAttribArray(firstInstanceAttribute + i);
+        glVertexAttribPointer(firstInstanceAttribute + i, attributes[i].first, GL_FLOAT, GL_FALSE,
+                              sizeof(TensorGlyphInstance),
+                              reinterpret_cast<const void*>(base + attributes[i].second));
+        glVertexAttribDivisor(firstInstanceAttribute + i, 1);
+    }
+    instanceIdBuffer_->bind();
+    glEnableVertexAttribArray(instanceIdAttribute);
+    glVertexAttribIPointer(
+        instanceIdAttribute, 1, GL_UNSIGNED_INT, sizeof(std::uint32_t),
+        reinterpret_cast<const void*>(range.first * sizeof(std::uint32_t)));
+    glVertexAttribDivisor(instanceIdAttribute, 1);
+
+    for (const auto& indexBuffer : range.mesh->getIndexBuffers()) {
+        auto bufferGL = indexBuffer.second->getRepresentation<BufferGL>();
+        bufferGL->bind();
+        glDrawElementsInstanced(GL_TRIANGLES, static_cast<GLsizei>(bufferGL->getSize()),
+                                bufferGL->getFormatType(), nullptr,
+                                static_cast<GLsizei>(range.count));
+    }
+
+    for (GLuint i = firstInstanceAttribute; i <= instanceIdAttribute; ++i) {
+        glVertexAttribDivisor(i, 0);
+        glDisableVertexAttribArray(i);
+    }
+    meshGL->disable();
+}
+
 void TensorGlyphRenderer::process() {
     utilgl::activateAndClearTarget(outport_, ImageType::ColorDepthPicking);
 
+    auto glyphs = glyphInport_.getData();
+
+    if (!glyphs->empty()) updateInstances(*glyphs);
+
     shader_.activate();
 
     utilgl::setShaderUniforms(shader_, camera_, "camera");
     utilgl::setShaderUniforms(shader_, lighting_, "light");
-    shader_.setUniform("pickingColor", picking_.getColor());
-
-    signed long long i = 0;
-    for (auto& drawer : meshDrawers_) {
-        shader_.setUniform("pickingColor", picking_.getColor(i));
-        utilgl::setShaderUniforms(shader_, *(drawer->getMesh()), "geometry");
-        shader_.setUniform("highlight", i == selectedID_);
-        {
-            utilgl::CullFaceState culling1(cullFace_.get());
-            drawer->draw();
+    utilgl::setShaderUniforms(shader_, *glyphs->getBaseMesh(), "geometry");
+    shader_.setUniform("pickingOffset", static_cast<int>(picking_.getPickingId(0)));
+    shader_.setUniform("selectedInstance", selectedID_);
+
+    if (!glyphs->empty()) {
+        utilgl::CullFaceState culling(cullFace_.get());
+        for (const auto& range : lodRanges_) {
+            if (glyphs->getType() == TensorGlyphType::CombinedReynoldsHYW) {
+                drawInstances(range, TensorGlyphType::Reynolds);
+                drawInstances(range, TensorGlyphType::HYW);
+            } else {
+                drawInstances(range, glyphs->getType());
+            }
         }
-        i++;
     }
 
     shader_.deactivate();
@@ -201,11 +348,11 @@ void TensorGlyphRenderer::process() {
         if (offsetInport_.isConnected() && offsetInport_.hasData()) {
             offset = *offsetInport_.getData();
         }
+        const auto index = glyphs->getFieldIndices()[selectedID_] + offset;
 
-        selectedMeshOutport_.setData(
-            glyphType_.generateGlyph(tensorField, selectedID_ + offset, vec3(0.f)));
+        selectedMeshOutport_.setData(glyphType_.generateGlyph(tensorField, index, vec3(0.f)));
 
-        indexOutport_.setData(std::make_shared<size_t>(selectedID_ + offset));
+        indexOutport_.setData(std::make_shared<size_t>(index));
     } else {
         selectedMeshOutport_.setData(
             glyphType_.generateQuadric(dmat3(1), dvec3(0), glyphType_.size(), dvec4(1)));
@@ -1,5 +1,6 @@
 #include <inviwo/tensorvisbase/processors/volumeactualdataandvaluerange.h>
 #include <inviwo/core/datastructures/volume/volumeram.h>
+#include <inviwo/tensorvisbase/util/datareductions.h>
 
 namespace inviwo {
 
@@ -34,16 +35,10 @@ void VolumeActualDataAndValueRange::process() {
 
     auto outVolume = inVolume->clone();
 
-    auto min = std::numeric_limits<float>::max();
-    auto max = std::numeric_limits<float>::lowest();
+    const auto range = tensorutil::computeStatistics(inVolumeData, numElements).range();
 
-    for (size_t i = 0; i < numElements; i++) {
-        min = std::min(min, inVolumeData[i]);
-        max = std::max(max, inVolumeData[i]);
-    }
-
-    outVolume->dataMap_.dataRange = vec2(min, max);
-    outVolume->dataMap_.valueRange = vec2(min, max);
+    outVolume->dataMap_.dataRange = range;
+    outVolume->dataMap_.valueRange = range;
 
     outport_.setData(std::make_shared<Volume>(*outVolume));
 }
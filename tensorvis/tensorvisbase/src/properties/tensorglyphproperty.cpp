@@ -31,8 +31,95 @@
 #include <inviwo/tensorvisbase/datastructures/deformablesphere.h>
 #include <inviwo/tensorvisbase/datastructures/deformablecube.h>
 #include <inviwo/tensorvisbase/datastructures/deformablecylinder.h>
+#include <inviwo/tensorvisbase/tensorvisbasemodule.h>
+#include <inviwo/core/common/inviwoapplication.h>
 
 namespace inviwo {
+
+namespace {
+double signedExponentiation(double x, double a) {
+    auto sgn = glm::sign(x);
+    return sgn * std::pow(std::abs(x), a);
+}
+
+dvec3 cartesianToSpherical(const dvec3& pos) {
+    auto r = glm::length(pos);
+    auto phi = glm::acos(pos.z / r);
+    auto theta = std::atan2(pos.y, pos.x);
+    return dvec3(r, phi, theta);
+}
+
+// Maps a vertex of the unit sphere onto the superquadric, shape holds alpha, beta and whether the
+// glyph is planar
+dvec3 superquadricVertex(const dvec3& u, const dvec3& shape) {
+    const auto sphericalCoords = cartesianToSpherical(u);
+    const auto alpha = shape.x;
+    const auto beta = shape.y;
+
+    const auto sinphi = glm::sin(sphericalCoords.y);
+    const auto cosphi = glm::cos(sphericalCoords.y);
+    const auto sintheta = glm::sin(sphericalCoords.z);
+    const auto costheta = glm::cos(sphericalCoords.z);
+
+    dvec3 v{signedExponentiation(cosphi, beta),
+            -signedExponentiation(sintheta, alpha) * signedExponentiation(sinphi, beta),
+            signedExponentiation(costheta, alpha) * signedExponentiation(sinphi, beta)};
+
+    if (shape.z > 0.0) {
+        std::swap(v.x, v.z);
+        v.y *= -1.0;
+    }
+    return v;
+}
+
+// Maps a vertex of the unit sphere onto the extended superquadric given alpha, beta and beta'
+dvec3 superquadricExtendedVertex(const dvec3& u, const dvec3& alphaBetaBetaPrim) {
+    const auto alpha = alphaBetaBetaPrim.x;
+    const auto beta = alphaBetaBetaPrim.y;
+    const auto beta_prim = alphaBetaBetaPrim.z;
+
+    const auto spherical_coords = cartesianToSpherical(u);
+    const auto phi = spherical_coords.y;
+    const auto theta = spherical_coords.z;
+
+    const auto sinphiBeta = signedExponentiation(glm::sin(phi), beta);
+    const auto x = signedExponentiation(glm::cos(theta), alpha) * sinphiBeta;
+    const auto y = signedExponentiation(glm::sin(theta), alpha) * sinphiBeta;
+    const auto z = signedExponentiation(glm::cos(phi), beta);
+
+    dvec3 v{x, y, z};
+    if (beta_prim > 0.) {
+        auto s_beta_prim = signedExponentiation(glm::acos(glm::pow(z, 1. / beta_prim)), beta_prim);
+        v.y = y * s_beta_prim / sinphiBeta;
+    }
+    return v;
+}
+
+// The factor that scales the largest vertex of a glyph to unit length
+double normalization(double maxLength) { return maxLength > 0.0 ? 1.0 / maxLength : 1.0; }
+
+// Eigenvalues normalized by the largest magnitude and the right-handed eigenvector basis. The
+// shape of Reynolds, HWY and quadric glyphs only depends on the former.
+std::pair<dvec3, dmat3> eigenFrame(const std::array<std::pair<double, dvec3>, 3>& eigenSystem) {
+    const dvec3 eigenValues(eigenSystem[0].first, eigenSystem[1].first, eigenSystem[2].first);
+    dmat3 basis(glm::normalize(eigenSystem[0].second), glm::normalize(eigenSystem[1].second),
+                glm::normalize(eigenSystem[2].second));
+    if (glm::dot(glm::cross(basis[0], basis[1]), basis[2]) < 0.0) {
+        basis[2] = -basis[2];
+    }
+    return {eigenValues * normalization(glm::compMax(glm::abs(eigenValues))), basis};
+}
+
+GlyphMeshCache* sharedGlyphMeshCache() {
+    if (auto app = InviwoApplication::getPtr()) {
+        if (auto module = app->getModuleByType<TensorVisBaseModule>()) {
+            return &module->getGlyphMeshCache();
+        }
+    }
+    return nullptr;
+}
+}  // namespace
+
 const std::string TensorGlyphProperty::classIdentifier{"org.inviwo.TensorGlyphProperty"};
 std::string TensorGlyphProperty::getClassIdentifier() const { return classIdentifier; }
 
@@ -144,21 +231,9 @@ void TensorGlyphProperty::evalColorReadOnly() {
     }
 }
 
-double TensorGlyphProperty::signedExponentiation(double x, double a) {
-    auto sgn = glm::sign(x);
-    return sgn * std::pow(std::abs(x), a);
-}
-
-dvec3 TensorGlyphProperty::cartesianToSpherical(const dvec3& pos) const {
-    auto r = glm::length(pos);
-    auto phi = glm::acos(pos.z / r);
-    auto theta = std::atan2(pos.y, pos.x);
-    return dvec3(r, phi, theta);
-}
-
 // From Ericsson Real-time collision detection
 std::pair<bool, dvec3> TensorGlyphProperty::intersectTriangle(
-    const dvec2& coord, const std::array<dvec2, 3>& tri_verts) {
+    const dvec2& coord, const std::array<dvec2, 3>& tri_verts) const {
     dvec2 p = coord;
     dvec2 a = tri_verts[0];
     dvec2 b = tri_verts[1];
@@ -184,14 +259,8 @@ std::pair<bool, dvec3> TensorGlyphProperty::intersectTriangle(
     return {true, dvec3(1. - v - w, v, w)};
 }
 
-const std::shared_ptr<BasicMesh> TensorGlyphProperty::generateSuperquadric(
-    std::shared_ptr<const TensorField3D> tensorField, size_t index, const dvec3 pos,
-    const dvec4& color, const float size) {
-    DeformableSphere sphere(resolutionTheta_.get(), resolutionPhi_.get(), color);
-
-    auto eigenValuesAndEigenVectors =
-        tensorField->getSortedEigenValuesAndEigenVectorsForTensor(index);
-
+TensorGlyphProperty::GlyphAxes TensorGlyphProperty::glyphAxes(
+    std::array<std::pair<double, dvec3>, 3> eigenValuesAndEigenVectors) const {
     auto magicScalingNumer = 0.00001;
     std::transform(eigenValuesAndEigenVectors.begin(), eigenValuesAndEigenVectors.end(),
                    eigenValuesAndEigenVectors.begin(),
@@ -214,24 +283,52 @@ const std::shared_ptr<BasicMesh> TensorGlyphProperty::generateSuperquadric(
             return std::make_pair(newVal, pair.second * newVal);
         });
 
-    std::array<double, 3> eigenValues{glm::abs(eigenValuesAndEigenVectors[0].first),
-                                      glm::abs(eigenValuesAndEigenVectors[1].first),
-                                      glm::abs(eigenValuesAndEigenVectors[2].first)};
+    GlyphAxes axes;
+    axes.eigenValues = {glm::abs(eigenValuesAndEigenVectors[0].first),
+                        glm::abs(eigenValuesAndEigenVectors[1].first),
+                        glm::abs(eigenValuesAndEigenVectors[2].first)};
 
-    auto basis = dmat3(eigenValuesAndEigenVectors[0].second, eigenValuesAndEigenVectors[1].second,
+    axes.basis = dmat3(eigenValuesAndEigenVectors[0].second, eigenValuesAndEigenVectors[1].second,
                        eigenValuesAndEigenVectors[2].second);
     if (!useEigenBasis_.get())
-        basis = glm::diagonal3x3(dvec3(eigenValues[0], eigenValues[1], eigenValues[2]));
+        axes.basis = glm::diagonal3x3(
+            dvec3(axes.eigenValues[0], axes.eigenValues[1], axes.eigenValues[2]));
 
     // Ensure RHS
-    if (glm::dot(glm::cross(basis[0], basis[1]), basis[2]) < 0.0) {
-        basis[2] = -basis[2];
+    if (glm::dot(glm::cross(axes.basis[0], axes.basis[1]), axes.basis[2]) < 0.0) {
+        axes.basis[2] = -axes.basis[2];
     }
 
-    auto mesh = createSuperquadric(eigenValues, pos, size, color);
-    mesh->setBasis(basis);
+    return axes;
+}
 
-    return mesh;
+dvec3 TensorGlyphProperty::superquadricShape(const std::array<double, 3>& eigenValues) const {
+    auto denominator = eigenValues[0] + eigenValues[1] + eigenValues[2];
+    auto linearAnisotropy = (eigenValues[0] - eigenValues[1]) / denominator;
+    auto planarAnisotropy = (2. * (eigenValues[1] - eigenValues[2])) / denominator;
+
+    double alpha;
+    double beta;
+
+    if (linearAnisotropy >= planarAnisotropy) {
+        alpha = glm::pow(1. - planarAnisotropy, gamma_.get());
+        beta = glm::pow(1. - linearAnisotropy, gamma_.get());
+    } else {
+        alpha = glm::pow(1. - linearAnisotropy, gamma_.get());
+        beta = glm::pow(1. - planarAnisotropy, gamma_.get());
+    }
+
+    return dvec3(alpha, beta, linearAnisotropy < planarAnisotropy ? 1.0 : 0.0);
+}
+
+const std::shared_ptr<BasicMesh> TensorGlyphProperty::generateSuperquadric(
+    std::shared_ptr<const TensorField3D> tensorField, size_t index, const dvec3 pos,
+    const dvec4& color, const float size) {
+    const auto axes = glyphAxes(tensorField->getSortedEigenValuesAndEigenVectorsForTensor(index));
+
+    return cachedGlyph(GlyphType::Superquadric, dvec4(superquadricShape(axes.eigenValues), 0.0),
+                       color, axes.basis, pos, size,
+                       [&](const dvec4& shape) { return createSuperquadric(dvec3(shape), color); });
 }
 
 const std::shared_ptr<BasicMesh> TensorGlyphProperty::generateSuperquadric(const dmat3&,
@@ -247,65 +344,24 @@ const std::shared_ptr<BasicMesh> TensorGlyphProperty::generateSuperquadric(
 
     auto basis = glm::diagonal3x3(dvec3(eigenValues[0], eigenValues[1], eigenValues[2]));
 
-    auto mesh = createSuperquadric(eigenValues, pos, size, color);
-    mesh->setBasis(basis);
-
-    return mesh;
+    return cachedGlyph(GlyphType::Superquadric, dvec4(superquadricShape(eigenValues), 0.0),
+                       color, basis, pos, size,
+                       [&](const dvec4& shape) { return createSuperquadric(dvec3(shape), color); });
 }
 
-std::shared_ptr<BasicMesh> TensorGlyphProperty::createSuperquadric(
-    const std::array<double, 3>& eigenValues, const dvec3& pos, const float size,
-    const dvec4& color) const {
+std::shared_ptr<BasicMesh> TensorGlyphProperty::createSuperquadric(const dvec3& shape,
+                                                                   const dvec4& color) const {
     DeformableSphere sphere(resolutionTheta_.get(), resolutionPhi_.get(), color);
 
-    auto denominator = eigenValues[0] + eigenValues[1] + eigenValues[2];
-    auto linearAnisotropy = (eigenValues[0] - eigenValues[1]) / denominator;
-    auto planarAnisotropy = (2. * (eigenValues[1] - eigenValues[2])) / denominator;
-
-    double alpha;
-    double beta;
-
-    if (linearAnisotropy >= planarAnisotropy) {
-        alpha = glm::pow(1. - planarAnisotropy, gamma_.get());
-        beta = glm::pow(1. - linearAnisotropy, gamma_.get());
-    } else {
-        alpha = glm::pow(1. - linearAnisotropy, gamma_.get());
-        beta = glm::pow(1. - planarAnisotropy, gamma_.get());
-    }
-
-    sphere.deform(
-        [&](vec3& v) {
-            /// Geometry calculation
-            auto sphericalCoords = cartesianToSpherical(v);
-
-            const auto sinphi = glm::sin(sphericalCoords.y);
-            const auto cosphi = glm::cos(sphericalCoords.y);
-            const auto sintheta = glm::sin(sphericalCoords.z);
-            const auto costheta = glm::cos(sphericalCoords.z);
-
-            v = {glm::sign(cosphi) * std::pow(std::abs(cosphi), beta),
-                 (-glm::sign(sintheta) * std::pow(std::abs(sintheta), alpha)) *
-                     (glm::sign(sinphi) * std::pow(std::abs(sinphi), beta)),
-                 (glm::sign(costheta) * std::pow(std::abs(costheta), alpha)) *
-                     (glm::sign(sinphi) * std::pow(std::abs(sinphi), beta))};
-
-            if (linearAnisotropy < planarAnisotropy) {
-                std::swap(v.x, v.z);
-                v.y *= -1.0f;
-            }
-        },
-        false);
-    sphere.transform(pos, dvec3(size));
+    sphere.deform([&](vec3& v) { v = vec3(superquadricVertex(dvec3(v), shape)); }, false);
 
     return sphere.getGeometry();
 }
 
-const std::shared_ptr<BasicMesh> TensorGlyphProperty::generateReynolds(
-    std::shared_ptr<const TensorField3D> tensorField, size_t index, const dvec3 pos,
-    const float size) {
+std::shared_ptr<BasicMesh> TensorGlyphProperty::createReynolds(const dvec3& eigenValues) const {
     DeformableSphere sphere(resolutionTheta_.get(), resolutionPhi_.get());
 
-    const auto tensor = mat3(tensorField->at(index).second);
+    const auto tensor = mat3(glm::diagonal3x3(eigenValues));
 
     sphere.deform([tensor](vec3& v, vec4& c) {
         const auto displacement = tensor * v;
@@ -319,25 +375,76 @@ const std::shared_ptr<BasicMesh> TensorGlyphProperty::generateReynolds(
         }
     });
 
-    sphere.transform(pos, dvec3(size));
-
     return sphere.getGeometry();
 }
 
-const std::shared_ptr<BasicMesh> TensorGlyphProperty::generateQuadric(
-    std::shared_ptr<const TensorField3D> tensorField, size_t index, const dvec3 pos,
-    const dvec4& color, const float size) {
+std::shared_ptr<BasicMesh> TensorGlyphProperty::createHWY(const dvec3& eigenValues,
+                                                          const dvec4& color) const {
     DeformableSphere sphere(resolutionTheta_.get(), resolutionPhi_.get(), color);
 
-    const auto tensor = mat3(tensorField->at(index).second);
+    const auto tensor = mat3(glm::diagonal3x3(eigenValues));
 
-    sphere.deform([tensor](vec3& v) { v = tensor * v; });
+    sphere.deform([tensor](vec3& v) {
+        const auto displacement = tensor * v;
+        const auto normalPart = v * glm::dot(displacement, v);
+        const auto orthoPart = displacement - normalPart;
 
-    sphere.transform(pos, dvec3(size));
+        auto scale = glm::length(orthoPart);
+        v = v * scale;
+    });
 
     return sphere.getGeometry();
 }
 
+std::shared_ptr<BasicMesh> TensorGlyphProperty::cachedGlyph(
+    const GlyphType type, const dvec4& shape, const dvec4& color, const dmat3& basis,
+    const dvec3& pos, const float size,
+    const std::function<std::shared_ptr<BasicMesh>(const dvec4&)>& create) const {
+    std::shared_ptr<const BasicMesh> geometry;
+    if (auto cache = sharedGlyphMeshCache()) {
+        const auto key = cache->makeKey(
+            type, size2_t(resolutionTheta_.get(), resolutionPhi_.get()), shape, vec4(color));
+        // Build the geometry from the quantized shape, it is shared by all glyphs with this key
+        const auto quantized = cache->dequantize(key);
+        geometry = cache->get(key, [&]() { return create(quantized); });
+    } else {
+        geometry = create(shape);
+    }
+
+    auto mesh = GlyphMeshCache::instantiate(*geometry);
+    mesh->setBasis(basis);
+    mesh->setWorldMatrix(glm::translate(vec3(pos)) * glm::scale(vec3(size)));
+    return mesh;
+}
+
+const std::shared_ptr<BasicMesh> TensorGlyphProperty::generateReynolds(
+    std::shared_ptr<const TensorField3D> tensorField, size_t index, const dvec3 pos,
+    const float size) {
+    const auto frame =
+        eigenFrame(tensorField->getSortedEigenValuesAndEigenVectorsForTensor(index));
+
+    // Reynolds glyphs are colored by the sign of the normal stress, not by the glyph color
+    return cachedGlyph(GlyphType::Reynolds, dvec4(frame.first, 0.0), dvec4(0.0), frame.second,
+                       pos, size,
+                       [&](const dvec4& shape) { return createReynolds(dvec3(shape)); });
+}
+
+const std::shared_ptr<BasicMesh> TensorGlyphProperty::generateQuadric(
+    std::shared_ptr<const TensorField3D> tensorField, size_t index, const dvec3 pos,
+    const dvec4& color, const float size) {
+    const auto frame =
+        eigenFrame(tensorField->getSortedEigenValuesAndEigenVectorsForTensor(index));
+
+    return cachedGlyph(GlyphType::Quadric, dvec4(frame.first, 0.0), color, frame.second, pos, size,
+                       [&](const dvec4& shape) {
+                           DeformableSphere sphere(resolutionTheta_.get(), resolutionPhi_.get(),
+                                                   color);
+                           const auto tensor = mat3(glm::diagonal3x3(dvec3(shape)));
+                           sphere.deform([tensor](vec3& v) { v = tensor * v; });
+                           return sphere.getGeometry();
+                       });
+}
+
 const std::shared_ptr<BasicMesh> TensorGlyphProperty::generateQuadric(const dmat3& tensor,
                                                                       const dvec3& pos,
                                                                       const float size,
@@ -380,37 +487,30 @@ const std::shared_ptr<BasicMesh> TensorGlyphProperty::generateCylinder(const dma
 const std::shared_ptr<BasicMesh> TensorGlyphProperty::generateHWY(
     std::shared_ptr<const TensorField3D> tensorField, size_t index, const dvec3 pos,
     const dvec4& color, const float size) {
-    DeformableSphere sphere(resolutionTheta_.get(), resolutionPhi_.get(), color);
-
-    const auto tensor = mat3(tensorField->at(index).second);
-
-    sphere.deform([tensor](vec3& v) {
-        const auto displacement = tensor * v;
-        const auto normalPart = v * glm::dot(displacement, v);
-        const auto orthoPart = displacement - normalPart;
-
-        auto scale = glm::length(orthoPart);
-        v = v * scale;
-    });
-
-    sphere.transform(pos, dvec3(size));
+    const auto frame =
+        eigenFrame(tensorField->getSortedEigenValuesAndEigenVectorsForTensor(index));
 
-    return sphere.getGeometry();
+    return cachedGlyph(GlyphType::HYW, dvec4(frame.first, 0.0), color, frame.second, pos, size,
+                       [&](const dvec4& shape) { return createHWY(dvec3(shape), color); });
 }
 
 const std::shared_ptr<BasicMesh> TensorGlyphProperty::generateCombinedReynoldsHWY(
     std::shared_ptr<const TensorField3D> tensorField, size_t index, const dvec3 pos,
     const dvec4& color, const float size) {
-    auto reynolds = generateReynolds(tensorField, index, pos, size);
-    auto hwy = generateHWY(tensorField, index, pos, color, size);
-    reynolds->append(hwy.get());
-
-    return reynolds;
+    const auto frame =
+        eigenFrame(tensorField->getSortedEigenValuesAndEigenVectorsForTensor(index));
+
+    return cachedGlyph(GlyphType::CombinedReynoldsHYW, dvec4(frame.first, 0.0), color,
+                       frame.second, pos, size, [&](const dvec4& shape) {
+                           auto reynolds = createReynolds(dvec3(shape));
+                           auto hwy = createHWY(dvec3(shape), color);
+                           reynolds->append(hwy.get());
+                           return reynolds;
+                       });
 }
 
-const std::shared_ptr<BasicMesh> TensorGlyphProperty::generateSuperquadricExtended(
-    std::shared_ptr<const TensorField3D> tensorField, size_t index, const dvec3 pos,
-    const float size) {
+dvec3 TensorGlyphProperty::superquadricExtendedShape(std::array<double, 3> lamda,
+                                                     const double frobeniusNorm) const {
     std::array<std::array<dvec2, 3>, 10> tri_uv{
         {{dvec2(0.00, 0.00), dvec2(0.50, 0.00), dvec2(0.25, 0.25)},
          {dvec2(0.00, 0.00), dvec2(0.25, 0.25), dvec2(0.00, 0.50)},
@@ -435,52 +535,6 @@ const std::shared_ptr<BasicMesh> TensorGlyphProperty::generateSuperquadricExtend
          {dvec3(1.0, 4.0, 0.0), dvec3(0.0, 2.0, 0.0), dvec3(0.0, 4.0, 2.0)},
          {dvec3(1.0, 4.0, 0.0), dvec3(0.0, 4.0, 2.0), dvec3(1.0, 2.0, 0.0)}}};
 
-    DeformableSphere sphere(resolutionTheta_.get(), resolutionPhi_.get());
-
-    auto eigenValuesAndEigenVectors =
-        tensorField->getSortedEigenValuesAndEigenVectorsForTensor(index);
-
-    auto magicScalingNumer = 0.00001;
-    std::transform(eigenValuesAndEigenVectors.begin(), eigenValuesAndEigenVectors.end(),
-                   eigenValuesAndEigenVectors.begin(),
-                   [magicScalingNumer](const std::pair<double, dvec3>& a) {
-                       return std::make_pair(
-                           glm::sign(a.first) * glm::max(glm::abs(a.first), magicScalingNumer),
-                           glm::normalize(a.second));
-                   });
-
-    std::sort(eigenValuesAndEigenVectors.begin(), eigenValuesAndEigenVectors.end(),
-              [](const std::pair<double, dvec3>& pairA, const std::pair<double, dvec3>& pairB) {
-                  return glm::abs(pairA.first) > glm::abs(pairB.first);
-              });
-
-    std::transform(
-        eigenValuesAndEigenVectors.begin(), eigenValuesAndEigenVectors.end(),
-        eigenValuesAndEigenVectors.begin(),
-        [maxEv = eigenValuesAndEigenVectors[0].first](const std::pair<double, dvec3>& pair) {
-            auto newVal = pair.first / maxEv;
-            return std::make_pair(newVal, pair.second * newVal);
-        });
-
-    if (glm::dot(
-            glm::cross(eigenValuesAndEigenVectors[0].second, eigenValuesAndEigenVectors[1].second),
-            eigenValuesAndEigenVectors[2].second) < 0.0) {
-        eigenValuesAndEigenVectors[2].second = -eigenValuesAndEigenVectors[2].second;
-    }
-
-    std::array<double, 3> eigenValues{glm::abs(eigenValuesAndEigenVectors[0].first),
-                                      glm::abs(eigenValuesAndEigenVectors[1].first),
-                                      glm::abs(eigenValuesAndEigenVectors[2].first)};
-
-    auto basis = dmat3(eigenValuesAndEigenVectors[0].second, eigenValuesAndEigenVectors[1].second,
-                       eigenValuesAndEigenVectors[2].second);
-
-    if (!useEigenBasis_.get())
-        basis = glm::diagonal3x3(dvec3(eigenValues[0], eigenValues[1], eigenValues[2]));
-
-    const auto frobeniusNorm = tensorField->getMetaData<FrobeniusNorm>()[index];
-    auto lamda = tensorField->getSortedEigenValuesForTensor(index);
-
     std::transform(lamda.begin(), lamda.end(), lamda.begin(),
                    [frobeniusNorm](const double& a) { return a / frobeniusNorm; });
 
@@ -514,55 +568,29 @@ const std::shared_ptr<BasicMesh> TensorGlyphProperty::generateSuperquadricExtend
         }
     }
 
-    sphere.deform([&](vec3& v, vec4& c) {
-        auto alpha = alpha_beta_betaprim.x;
-        auto beta = alpha_beta_betaprim.y;
-        auto beta_prim = alpha_beta_betaprim.z;
-
-        auto spherical_coords = cartesianToSpherical(v);
-        auto phi = spherical_coords.y;
-        auto theta = spherical_coords.z;
-
-        if (beta_prim > 0.) {
-            auto y_beta = signedExponentiation(glm::sin(theta), alpha) *
-                          signedExponentiation(glm::sin(phi), beta);
-            auto z = signedExponentiation(glm::cos(phi), beta);
-            auto s_beta_prim =
-                signedExponentiation(glm::acos(glm::pow(z, 1. / beta_prim)), beta_prim);
-            auto s_max = signedExponentiation(glm::sin(phi), beta);
-
-            v.x = static_cast<float>(signedExponentiation(glm::cos(theta), alpha) *
-                                     signedExponentiation(glm::sin(phi), beta));
-            v.y = static_cast<float>(y_beta * s_beta_prim / s_max);
-            v.z = static_cast<float>(z);
-        } else {
-            v.x = static_cast<float>(signedExponentiation(glm::cos(theta), alpha) *
-                                     signedExponentiation(glm::sin(phi), beta));
-            v.y = static_cast<float>(signedExponentiation(glm::sin(theta), alpha) *
-                                     signedExponentiation(glm::sin(phi), beta));
-            v.z = static_cast<float>(signedExponentiation(glm::cos(phi), beta));
-        }
-
-        std::array<double, 3> eigenValues{glm::abs(eigenValuesAndEigenVectors[0].first),
-                                          glm::abs(eigenValuesAndEigenVectors[1].first),
-                                          glm::abs(eigenValuesAndEigenVectors[2].first)};
-
-        auto mat = glm::diagonal3x3(dvec3(eigenValues[0], eigenValues[1], eigenValues[2]));
-        auto sign = glm::dot(dvec3(v), mat * dvec3(v));
-        if (sign >= 0.) {
-            c = vec4(0., 0., 1., 1.);
-        } else {
-            c = vec4(1., 0., 0., 1.);
-        }
-    });
-
-    sphere.transform(pos, dvec3(size));
-
-    auto mesh = sphere.getGeometry();
-
-    mesh->setBasis(basis);
+    return alpha_beta_betaprim;
+}
 
-    return mesh;
+const std::shared_ptr<BasicMesh> TensorGlyphProperty::generateSuperquadricExtended(
+    std::shared_ptr<const TensorField3D> tensorField, size_t index, const dvec3 pos,
+    const float size) {
+    const auto axes = glyphAxes(tensorField->getSortedEigenValuesAndEigenVectorsForTensor(index));
+
+    const auto alpha_beta_betaprim =
+        superquadricExtendedShape(tensorField->getSortedEigenValuesForTensor(index),
+                                  tensorField->getMetaData<FrobeniusNorm>()[index]);
+
+    return cachedGlyph(GlyphType::SuperquadricExtended, dvec4(alpha_beta_betaprim, 0.0),
+                       dvec4(0.0), axes.basis, pos, size, [&](const dvec4& shape) {
+                           DeformableSphere sphere(resolutionTheta_.get(), resolutionPhi_.get());
+                           // The glyph axes are scaled by the absolute eigenvalues, the quadratic
+                           // form v^T diag(|lambda|) v is never negative and the glyph is blue
+                           sphere.deform([&](vec3& v, vec4& c) {
+                               v = vec3(superquadricExtendedVertex(dvec3(v), dvec3(shape)));
+                               c = vec4(0., 0., 1., 1.);
+                           });
+                           return sphere.getGeometry();
+                       });
 }
 
 const std::shared_ptr<BasicMesh> TensorGlyphProperty::generateGlyph(
@@ -676,4 +704,90 @@ const std::shared_ptr<BasicMesh> TensorGlyphProperty::generateGlyph(
     return generateSuperquadric(eigenvalues, pos, size, color);
 }
 
+bool TensorGlyphProperty::supportsInstancing() const {
+    return glyphType_.get() != GlyphType::Cube && glyphType_.get() != GlyphType::Cylinder;
+}
+
+std::shared_ptr<const BasicMesh> TensorGlyphProperty::createBaseMesh() const {
+    return createBaseMesh(size2_t(resolutionTheta_.get(), resolutionPhi_.get()));
+}
+
+std::shared_ptr<const BasicMesh> TensorGlyphProperty::createBaseMesh(
+    const size2_t& resolution) const {
+    const auto create = [&]() {
+        return DeformableSphere(resolution.x, resolution.y).getGeometry();
+    };
+    // Same geometry as an isotropic quadric
+    if (auto cache = sharedGlyphMeshCache()) {
+        return cache->get(
+            cache->makeKey(GlyphType::Quadric, resolution, dvec4(1.0, 1.0, 1.0, 0.0), vec4(1.0f)),
+            create);
+    }
+    return create();
+}
+
+TensorGlyphInstance TensorGlyphProperty::generateInstance(
+    const dmat3& tensor, const std::array<std::pair<double, dvec3>, 3>& eigenSystem,
+    const double frobeniusNorm, const vec3& pos) const {
+    const auto size = static_cast<double>(size_.get());
+    // The largest deformation of a unit vector by the tensor
+    const auto maxAbsEigenValue =
+        glm::max(glm::abs(eigenSystem[0].first), glm::abs(eigenSystem[2].first));
+
+    TensorGlyphInstance instance{mat3(1.0f), pos, vec4(0.0f), color_.get()};
+
+    switch (glyphType_.get()) {
+        case GlyphType::Reynolds:
+        case GlyphType::HYW:
+        case GlyphType::CombinedReynoldsHYW: {
+            // The HWY glyph is largest halfway between the major and the minor eigenvector
+            const auto maxShear = 0.5 * (eigenSystem[0].first - eigenSystem[2].first);
+            instance.frame = mat3(tensor * size);
+            instance.shape = vec4(normalization(maxAbsEigenValue), normalization(maxShear), 0, 0);
+            break;
+        }
+        case GlyphType::Superquadric: {
+            const auto axes = glyphAxes(eigenSystem);
+            const auto shape = superquadricShape(axes.eigenValues);
+            instance.frame = mat3(axes.basis * size);
+            instance.shape = vec4(shape.x, shape.y, 0.0f, shape.z);
+            break;
+        }
+        case GlyphType::SuperquadricExtended: {
+            const auto axes = glyphAxes(eigenSystem);
+            const auto shape = superquadricExtendedShape(
+                {eigenSystem[0].first, eigenSystem[1].first, eigenSystem[2].first}, frobeniusNorm);
+
+            // Approximate the size of the glyph on a coarse sampling of the sphere instead of
+            // deforming every vertex of the base mesh
+            constexpr size_t numTheta = 16;
+            constexpr size_t numPhi = 9;
+            double maxLength = 0.0;
+            for (size_t j = 0; j < numPhi; ++j) {
+                const auto phi = static_cast<double>(j) * glm::pi<double>() / (numPhi - 1);
+                for (size_t i = 0; i < numTheta; ++i) {
+                    const auto theta = static_cast<double>(i) * glm::two_pi<double>() / numTheta;
+                    const dvec3 u(std::cos(theta) * std::sin(phi), std::sin(theta) * std::sin(phi),
+                                  std::cos(phi));
+                    const auto length = glm::length(superquadricExtendedVertex(u, shape));
+                    if (length > maxLength) maxLength = length;
+                }
+            }
+
+            instance.frame = mat3(axes.basis * size);
+            instance.shape = vec4(vec3(shape), normalization(maxLength));
+            // The vertices always lie on the positive side of the glyph
+            instance.color = vec4(0.0f, 0.0f, 1.0f, 1.0f);
+            break;
+        }
+        case GlyphType::Quadric:
+            instance.frame = mat3(tensor * (size * normalization(maxAbsEigenValue)));
+            break;
+        default:
+            break;
+    }
+
+    return instance;
+}
+
 }  // namespace inviwo
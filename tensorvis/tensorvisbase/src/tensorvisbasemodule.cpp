@@ -37,6 +37,7 @@
 
 #include <inviwo/tensorvisbase/ports/tensorfieldport.h>
 #include <inviwo/tensorvisbase/processors/eigenvaluefieldtoimage.h>
+#include <inviwo/tensorvisbase/processors/hyperstreamlinefamilies.h>
 #include <inviwo/tensorvisbase/processors/hyperstreamlines.h>
 #include <inviwo/tensorvisbase/processors/imagetospherefield.h>
 #include <inviwo/tensorvisbase/processors/invariantspacecombine.h>
@@ -73,6 +74,7 @@ TensorVisBaseModule::TensorVisBaseModule(InviwoApplication* app)
     ShaderManager::getPtr()->addShaderSearchPath(getPath(ModulePath::GLSL));
 
     registerProcessor<EigenvalueFieldToImage>();
+    registerProcessor<HyperStreamlineFamilies>();
     registerProcessor<HyperStreamlines>();
     registerProcessor<ImageToSphereField>();
     registerProcessor<InvariantSpaceCombine>();
@@ -0,0 +1,117 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/tensorvisbase/util/datareductions.h>
+#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/util/settings/systemsettings.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+
+namespace inviwo {
+namespace tensorutil {
+
+namespace {
+// Chunks smaller than this are not worth dispatching to the thread pool
+constexpr size_t minimumChunkSize = 1 << 16;
+}  // namespace
+
+dvec2 DataStatistics::range() const {
+    if (numberOfComponents == 0) return dvec2(0.0);
+
+    dvec2 res(min[0], max[0]);
+    for (glm::length_t i = 1; i < static_cast<glm::length_t>(numberOfComponents); ++i) {
+        res.x = std::min(res.x, min[i]);
+        res.y = std::max(res.y, max[i]);
+    }
+    return res;
+}
+
+namespace detail {
+
+size_t numberOfChunks(const size_t size, size_t jobs) {
+    const auto maxChunks = std::max(size_t{1}, size / minimumChunkSize);
+    if (maxChunks == 1) return 1;
+
+    if (jobs == 0) {
+        const auto settings = InviwoApplication::getPtr()->getSettingsByType<SystemSettings>();
+        jobs = std::max(size_t{1}, static_cast<size_t>(settings->poolSize_.get()));
+    }
+    return std::min(jobs, maxChunks);
+}
+
+void forEachChunk(const size_t size, const size_t chunks,
+                  const std::function<void(size_t, size_t, size_t)> &callback) {
+    if (chunks <= 1) {
+        callback(0, 0, size);
+        return;
+    }
+
+    // Chunks are claimed by the pool tasks and by the caller. Tasks that only start once all
+    // chunks have been claimed return without touching the callback, which is why the caller
+    // does not have to wait for them.
+    struct State {
+        std::atomic<size_t> next{0};
+        size_t done = 0;
+        std::exception_ptr exception;
+        std::mutex mutex;
+        std::condition_variable finished;
+    };
+    const auto state = std::make_shared<State>();
+
+    const auto work = [state, &callback, size, chunks]() {
+        for (auto chunk = state->next++; chunk < chunks; chunk = state->next++) {
+            std::exception_ptr exception;
+            try {
+                callback(chunk, chunk * size / chunks, (chunk + 1) * size / chunks);
+            } catch (...) {
+                exception = std::current_exception();
+            }
+
+            std::lock_guard<std::mutex> lock(state->mutex);
+            if (exception && !state->exception) state->exception = exception;
+            if (++state->done == chunks) state->finished.notify_all();
+        }
+    };
+
+    for (size_t i = 1; i < chunks; ++i) dispatchPool(work);
+    work();
+
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->finished.wait(lock, [&]() { return state->done == chunks; });
+    if (state->exception) std::rethrow_exception(state->exception);
+}
+
+}  // namespace detail
+
+}  // namespace tensorutil
+}  // namespace inviwo
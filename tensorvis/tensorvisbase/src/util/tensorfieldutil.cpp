@@ -31,6 +31,7 @@
 #include <modules/opengl/texture/textureutils.h>
 #include <inviwo/tensorvisbase/util/tensorfieldutil.h>
 #include <inviwo/tensorvisbase/algorithm/tensorfieldsampling.h>
+#include <inviwo/tensorvisbase/algorithm/tensorfieldresampling.h>
 
 namespace inviwo {
 namespace tensorutil {
@@ -59,100 +60,29 @@ void bindTensorFieldAsColorTextures(std::shared_ptr<const TensorField3D> &, Shad
 std::shared_ptr<TensorField2D> subsample2D(std::shared_ptr<const TensorField2D> tensorField,
                                            size2_t newDimensions,
                                            const InterpolationMethod method) {
-    std::vector<dmat2> dataNew;
-    dataNew.resize(newDimensions.x * newDimensions.y);
-
-    util::IndexMapper2D indexMapperNew(newDimensions);
-
-    auto xFrac = static_cast<double>(tensorField->getDimensions().x - 1) /
-                 static_cast<double>(newDimensions.x - 1);
-    auto yFrac = static_cast<double>(tensorField->getDimensions().y - 1) /
-                 static_cast<double>(newDimensions.y - 1);
-
-    for (size_t x = 0; x < newDimensions.x; x++) {
-        for (size_t y = 0; y < newDimensions.y; y++) {
-            // Find position in old tensor field
-            auto pos = dvec2(xFrac * static_cast<double>(x), yFrac * static_cast<double>(y));
-            auto posNormalized =
-                pos / dvec2(static_cast<double>(tensorField->getDimensions().x - 1),
-                            static_cast<double>(tensorField->getDimensions().y - 1));
-
-            // Sample old tensor field at position
-            auto tensor = sample(tensorField, posNormalized, method);
-
-            // Assign tensor at x,y
-            dataNew[indexMapperNew(size2_t(x, y))] = tensor;
-        }
-    }
-
-    return std::make_shared<TensorField2D>(newDimensions, dataNew);
+    ResamplingSettings settings;
+    settings.method = method;
+    settings.filter = ResamplingFilter::None;
+    return resample(tensorField, newDimensions, settings);
 }
 
 std::shared_ptr<TensorField3D> IVW_MODULE_TENSORVISBASE_API
 subsample3D(std::shared_ptr<const TensorField3D> tensorField, size3_t newDimensions,
             const InterpolationMethod method) {
-    std::vector<dmat3> dataNew;
-    dataNew.resize(newDimensions.x * newDimensions.y * newDimensions.z);
-
-    util::IndexMapper3D indexMapperNew(newDimensions);
-
-    auto xFrac = 1. / static_cast<double>(newDimensions.x - 1);
-    auto yFrac = 1. / static_cast<double>(newDimensions.y - 1);
-    auto zFrac = 1. / static_cast<double>(newDimensions.z - 1);
-
-    for (size_t x = 0; x < newDimensions.x; x++) {
-        for (size_t y = 0; y < newDimensions.y; y++) {
-            for (size_t z = 0; z < newDimensions.z; z++) {
-                // Find position in old tensor field
-                auto pos = dvec3(xFrac * static_cast<double>(x), yFrac * static_cast<double>(y),
-                                 zFrac * static_cast<double>(z));
-
-                // Sample old tensor field at position
-                auto tensor = sample(tensorField, pos, method);
-
-                // Assign tensor at x,y
-                dataNew[indexMapperNew(size3_t(x, y, z))] = tensor.second;
-            }
-        }
-    }
-
-    return std::make_shared<TensorField3D>(newDimensions, dataNew, tensorField->getExtents());
+    ResamplingSettings settings;
+    settings.method = method;
+    settings.filter = ResamplingFilter::None;
+    return resample(tensorField, newDimensions, settings);
 }
 
 std::shared_ptr<TensorField3D> IVW_MODULE_TENSORVISBASE_API
 subsample3D(std::shared_ptr<const TensorField3D> tensorField, size3_t newDimensions,
             const InterpolationMethod method, std::function<void(float)> fun) {
-    std::vector<dmat3> dataNew;
-    dataNew.resize(newDimensions.x * newDimensions.y * newDimensions.z);
-
-    util::IndexMapper3D indexMapperNew(newDimensions);
-
-    auto xFrac = 1. / static_cast<double>(newDimensions.x - 1);
-    auto yFrac = 1. / static_cast<double>(newDimensions.y - 1);
-    auto zFrac = 1. / static_cast<double>(newDimensions.z - 1);
-
-    const auto numElements =
-        static_cast<float>(newDimensions.x * newDimensions.y * newDimensions.z);
-    float i = 0.f;
-
-    for (size_t x = 0; x < newDimensions.x; x++) {
-        for (size_t y = 0; y < newDimensions.y; y++) {
-            for (size_t z = 0; z < newDimensions.z; z++) {
-                fun(std::min(0.99f, i++ / numElements));
-                // Find position in old tensor field
-                auto pos = dvec3(xFrac * static_cast<double>(x), yFrac * static_cast<double>(y),
-                                 zFrac * static_cast<double>(z));
-
-                // Sample old tensor field at position
-                auto tensor = sample(tensorField, pos, method);
-
-                // Assign tensor at x,y
-                dataNew[indexMapperNew(size3_t(x, y, z))] = tensor.second;
-            }
-        }
-    }
-
-    return std::make_shared<TensorField3D>(newDimensions, dataNew, tensorField->getExtents());
+    ResamplingSettings settings;
+    settings.method = method;
+    settings.filter = ResamplingFilter::None;
+    settings.progress = std::move(fun);
+    return resample(tensorField, newDimensions, settings);
 }
 
 std::shared_ptr<PosTexColorMesh> generateBoundingBoxAdjacencyForTensorField(
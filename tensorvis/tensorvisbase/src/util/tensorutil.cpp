@@ -31,6 +31,9 @@
 
 #include <inviwo/core/util/exception.h>
 
+#include <algorithm>
+#include <limits>
+
 namespace inviwo {
 namespace tensorutil {
 vec4 tensor2DToDvec4(const dmat2 &tensor) {
@@ -221,6 +224,249 @@ dmat3 IVW_MODULE_TENSORVISBASE_API calculateEigenSystem(const dmat3 &tensor) {
     return dmat3(sortable[0].second, sortable[1].second, sortable[2].second);
 }
 
+namespace {
+constexpr double symmetricEigenGapThreshold = 1e-6;
+
+std::array<std::pair<double, dvec3>, 3> sortedEigenSystem(
+    std::array<std::pair<double, dvec3>, 3> eigenSystem) {
+    std::stable_sort(
+        eigenSystem.begin(), eigenSystem.end(),
+        [](const std::pair<double, dvec3> &pairA, const std::pair<double, dvec3> &pairB) {
+            return pairA.first > pairB.first;
+        });
+    return eigenSystem;
+}
+
+/*
+ * Flips the vector such that its largest component is positive. Eigenvectors are only defined up
+ * to their sign, this makes the result independent of the solver.
+ */
+dvec3 orient(const dvec3 &v) {
+    size_t maxIndex = 0;
+    for (size_t i = 1; i < 3; ++i) {
+        if (std::abs(v[i]) > std::abs(v[maxIndex])) maxIndex = i;
+    }
+    return v[maxIndex] < 0.0 ? -v : v;
+}
+
+/*
+ * Returns a unit vector in the null space of the symmetric tensor T - lambda * I by taking the
+ * largest cross product of two of its rows.
+ */
+dvec3 nullVector(const std::array<double, 6> &t, const double lambda) {
+    const dvec3 r0{t[0] - lambda, t[3], t[5]};
+    const dvec3 r1{t[3], t[1] - lambda, t[4]};
+    const dvec3 r2{t[5], t[4], t[2] - lambda};
+
+    const std::array<dvec3, 3> candidates{
+        {glm::cross(r0, r1), glm::cross(r0, r2), glm::cross(r1, r2)}};
+    const std::array<double, 3> lengths{{glm::dot(candidates[0], candidates[0]),
+                                         glm::dot(candidates[1], candidates[1]),
+                                         glm::dot(candidates[2], candidates[2])}};
+
+    size_t maxIndex = 0;
+    for (size_t i = 1; i < 3; ++i) {
+        if (lengths[i] > lengths[maxIndex]) maxIndex = i;
+    }
+
+    return candidates[maxIndex] / std::sqrt(lengths[maxIndex]);
+}
+
+/*
+ * Closed form eigenvalues of a symmetric 3x3 tensor given by its components xx, yy, zz, xy, yz,
+ * xz. The method is branch free apart from the min/max so the batched loop can be vectorized.
+ * See Smith, "Eigenvalues of a symmetric 3 × 3 matrix", Communications of the ACM, 1961.
+ */
+inline void symmetricEigenValues(const double xx, const double yy, const double zz,
+                                 const double xy, const double yz, const double xz, double &major,
+                                 double &middle, double &minor) {
+    const double q = (xx + yy + zz) / 3.0;
+    const double p1 = xy * xy + yz * yz + xz * xz;
+    const double p2 = (xx - q) * (xx - q) + (yy - q) * (yy - q) + (zz - q) * (zz - q) + 2.0 * p1;
+    const double p = std::sqrt(p2 / 6.0);
+    const double invP = p > 0.0 ? 1.0 / p : 0.0;
+
+    const double bxx = (xx - q) * invP;
+    const double byy = (yy - q) * invP;
+    const double bzz = (zz - q) * invP;
+    const double bxy = xy * invP;
+    const double byz = yz * invP;
+    const double bxz = xz * invP;
+
+    const double detB = bxx * (byy * bzz - byz * byz) - bxy * (bxy * bzz - byz * bxz) +
+                        bxz * (bxy * byz - byy * bxz);
+    const double r = std::min(1.0, std::max(-1.0, 0.5 * detB));
+    const double phi = std::acos(r) / 3.0;
+
+    major = q + 2.0 * p * std::cos(phi);
+    minor = q + 2.0 * p * std::cos(phi + (2.0 * glm::pi<double>() / 3.0));
+    middle = 3.0 * q - major - minor;
+}
+
+template <typename T>
+void symmetricEigenSystemBatch(const SymmetricTensor3<T> *tensors, const size_t count,
+                               double *majorEigenValues, double *middleEigenValues,
+                               double *minorEigenValues, dvec3 *majorEigenVectors,
+                               dvec3 *middleEigenVectors, dvec3 *minorEigenVectors) {
+    // Eigenvalues for the whole batch first, this loop has no data dependent control flow
+    for (size_t i = 0; i < count; ++i) {
+        const auto &c = tensors[i].components;
+        symmetricEigenValues(static_cast<double>(c[0]), static_cast<double>(c[1]),
+                             static_cast<double>(c[2]), static_cast<double>(c[3]),
+                             static_cast<double>(c[4]), static_cast<double>(c[5]),
+                             majorEigenValues[i], middleEigenValues[i], minorEigenValues[i]);
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        std::array<double, 6> t;
+        std::transform(tensors[i].components.begin(), tensors[i].components.end(), t.begin(),
+                       [](const T val) { return static_cast<double>(val); });
+
+        if (std::all_of(t.begin(), t.end(), [](const double val) { return val == 0.0; })) {
+            majorEigenVectors[i] = middleEigenVectors[i] = minorEigenVectors[i] = dvec3(0.0);
+            continue;
+        }
+
+        const auto l1 = majorEigenValues[i];
+        const auto l2 = middleEigenValues[i];
+        const auto l3 = minorEigenValues[i];
+        const auto scale = std::max(std::abs(l1), std::abs(l3));
+
+        if ((l1 - l2) <= symmetricEigenGapThreshold * scale ||
+            (l2 - l3) <= symmetricEigenGapThreshold * scale) {
+            const auto eigenSystem = calculateSymmetricEigenValuesAndEigenVectorsJacobi(
+                dmat3(t[0], t[3], t[5], t[3], t[1], t[4], t[5], t[4], t[2]));
+            majorEigenValues[i] = eigenSystem[0].first;
+            middleEigenValues[i] = eigenSystem[1].first;
+            minorEigenValues[i] = eigenSystem[2].first;
+            majorEigenVectors[i] = eigenSystem[0].second;
+            middleEigenVectors[i] = eigenSystem[1].second;
+            minorEigenVectors[i] = eigenSystem[2].second;
+            continue;
+        }
+
+        const auto v1 = orient(nullVector(t, l1));
+        const auto v3 = orient(nullVector(t, l3));
+        majorEigenVectors[i] = v1;
+        middleEigenVectors[i] = orient(glm::normalize(glm::cross(v3, v1)));
+        minorEigenVectors[i] = v3;
+    }
+}
+}  // namespace
+
+bool isSymmetric(const dmat3 &tensor, const double epsilon) {
+    const auto scale = std::max({std::abs(tensor[0][1]), std::abs(tensor[1][0]),
+                                 std::abs(tensor[0][2]), std::abs(tensor[2][0]),
+                                 std::abs(tensor[1][2]), std::abs(tensor[2][1]), 1.0});
+    return std::abs(tensor[0][1] - tensor[1][0]) <= epsilon * scale &&
+           std::abs(tensor[0][2] - tensor[2][0]) <= epsilon * scale &&
+           std::abs(tensor[1][2] - tensor[2][1]) <= epsilon * scale;
+}
+
+std::array<std::pair<double, dvec3>, 3> calculateSymmetricEigenValuesAndEigenVectors(
+    const dmat3 &tensor) {
+    const auto symmetric = SymmetricTensor3<double>::fromMatrix(tensor);
+
+    std::array<double, 3> eigenValues;
+    std::array<dvec3, 3> eigenVectors;
+    symmetricEigenSystemBatch(&symmetric, 1, &eigenValues[0], &eigenValues[1], &eigenValues[2],
+                              &eigenVectors[0], &eigenVectors[1], &eigenVectors[2]);
+
+    return {{std::make_pair(eigenValues[0], eigenVectors[0]),
+             std::make_pair(eigenValues[1], eigenVectors[1]),
+             std::make_pair(eigenValues[2], eigenVectors[2])}};
+}
+
+std::array<std::pair<double, dvec3>, 3> calculateSymmetricEigenValuesAndEigenVectorsJacobi(
+    const dmat3 &tensor) {
+    if (tensor == dmat3(0.0)) {
+        return std::array<std::pair<double, dvec3>, 3>{std::pair<double, dvec3>{0, dvec3(0)},
+                                                       std::pair<double, dvec3>{0, dvec3(0)},
+                                                       std::pair<double, dvec3>{0, dvec3(0)}};
+    }
+
+    // Work on the symmetric part, a[row][col]
+    double a[3][3];
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            a[i][j] = 0.5 * (tensor[j][i] + tensor[i][j]);
+        }
+    }
+    double v[3][3] = {{1.0, 0.0, 0.0}, {0.0, 1.0, 0.0}, {0.0, 0.0, 1.0}};
+
+    constexpr int maxSweeps = 50;
+    constexpr std::array<std::pair<int, int>, 3> pivots{{{0, 1}, {0, 2}, {1, 2}}};
+    const auto eps = std::numeric_limits<double>::epsilon();
+
+    for (int sweep = 0; sweep < maxSweeps; ++sweep) {
+        const auto offDiagonal = a[0][1] * a[0][1] + a[0][2] * a[0][2] + a[1][2] * a[1][2];
+        const auto diagonal = a[0][0] * a[0][0] + a[1][1] * a[1][1] + a[2][2] * a[2][2];
+        if (offDiagonal <= eps * eps * diagonal) break;
+
+        for (const auto &pivot : pivots) {
+            const auto p = pivot.first;
+            const auto q = pivot.second;
+            if (a[p][q] == 0.0) continue;
+
+            const auto theta = (a[q][q] - a[p][p]) / (2.0 * a[p][q]);
+            const auto t = (theta >= 0.0 ? 1.0 : -1.0) /
+                           (std::abs(theta) + std::sqrt(theta * theta + 1.0));
+            const auto c = 1.0 / std::sqrt(t * t + 1.0);
+            const auto s = t * c;
+
+            for (int k = 0; k < 3; ++k) {
+                const auto akp = a[k][p];
+                const auto akq = a[k][q];
+                a[k][p] = c * akp - s * akq;
+                a[k][q] = s * akp + c * akq;
+            }
+            for (int k = 0; k < 3; ++k) {
+                const auto apk = a[p][k];
+                const auto aqk = a[q][k];
+                a[p][k] = c * apk - s * aqk;
+                a[q][k] = s * apk + c * aqk;
+            }
+            for (int k = 0; k < 3; ++k) {
+                const auto vkp = v[k][p];
+                const auto vkq = v[k][q];
+                v[k][p] = c * vkp - s * vkq;
+                v[k][q] = s * vkp + c * vkq;
+            }
+        }
+    }
+
+    return sortedEigenSystem(
+        {{std::make_pair(a[0][0], orient(dvec3(v[0][0], v[1][0], v[2][0]))),
+          std::make_pair(a[1][1], orient(dvec3(v[0][1], v[1][1], v[2][1]))),
+          std::make_pair(a[2][2], orient(dvec3(v[0][2], v[1][2], v[2][2])))}});
+}
+
+std::array<double, 3> calculateSymmetricEigenValues(const dmat3 &tensor) {
+    const auto t = SymmetricTensor3<double>::fromMatrix(tensor).components;
+    std::array<double, 3> eigenValues;
+    symmetricEigenValues(t[0], t[1], t[2], t[3], t[4], t[5], eigenValues[0], eigenValues[1],
+                         eigenValues[2]);
+    return eigenValues;
+}
+
+void calculateSymmetricEigenValuesAndEigenVectors(
+    const SymmetricTensor3<double> *tensors, const size_t count, double *majorEigenValues,
+    double *middleEigenValues, double *minorEigenValues, dvec3 *majorEigenVectors,
+    dvec3 *middleEigenVectors, dvec3 *minorEigenVectors) {
+    symmetricEigenSystemBatch(tensors, count, majorEigenValues, middleEigenValues,
+                              minorEigenValues, majorEigenVectors, middleEigenVectors,
+                              minorEigenVectors);
+}
+
+void calculateSymmetricEigenValuesAndEigenVectors(
+    const SymmetricTensor3<float> *tensors, const size_t count, double *majorEigenValues,
+    double *middleEigenValues, double *minorEigenValues, dvec3 *majorEigenVectors,
+    dvec3 *middleEigenVectors, dvec3 *minorEigenVectors) {
+    symmetricEigenSystemBatch(tensors, count, majorEigenValues, middleEigenValues,
+                              minorEigenValues, majorEigenVectors, middleEigenVectors,
+                              minorEigenVectors);
+}
+
 dmat2 getProjectedTensor(const dmat3 tensor, const CartesianCoordinateAxis axis) {
     dmat2 newTensor;
 
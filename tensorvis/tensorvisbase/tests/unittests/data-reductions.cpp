@@ -0,0 +1,81 @@
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/tensorvisbase/util/datareductions.h>
+#include <inviwo/tensorvisbase/datastructures/tensorfieldmetadata.h>
+
+#include <atomic>
+
+namespace inviwo {
+
+TEST(TensorUtilTests, statisticsOfScalars) {
+    const std::vector<float> data{3.0f, -1.0f, 4.0f, 2.0f};
+    const auto statistics = tensorutil::computeStatistics(data.data(), data.size(), 1);
+
+    EXPECT_EQ(1u, statistics.numberOfComponents);
+    EXPECT_EQ(4u, statistics.size);
+    EXPECT_DOUBLE_EQ(-1.0, statistics.min.x);
+    EXPECT_DOUBLE_EQ(4.0, statistics.max.x);
+    EXPECT_DOUBLE_EQ(2.0, statistics.mean.x);
+    EXPECT_EQ(dvec2(-1.0, 4.0), statistics.range());
+}
+
+TEST(TensorUtilTests, statisticsOfVectors) {
+    const std::vector<dvec3> data{dvec3(1.0, -2.0, 0.0), dvec3(3.0, 2.0, -5.0)};
+    const auto statistics = tensorutil::computeStatistics(data.data(), data.size(), 1);
+
+    EXPECT_EQ(3u, statistics.numberOfComponents);
+    EXPECT_EQ(dvec4(1.0, -2.0, -5.0, 0.0), statistics.min);
+    EXPECT_EQ(dvec4(3.0, 2.0, 0.0, 0.0), statistics.max);
+    EXPECT_EQ(dvec4(2.0, 0.0, -2.5, 0.0), statistics.mean);
+    EXPECT_EQ(dvec2(-5.0, 3.0), statistics.range());
+}
+
+TEST(TensorUtilTests, statisticsOfEmptyData) {
+    const auto statistics = tensorutil::computeStatistics(static_cast<const double *>(nullptr), 0);
+    EXPECT_EQ(0u, statistics.size);
+    EXPECT_EQ(dvec2(0.0), statistics.range());
+}
+
+TEST(TensorUtilTests, histogram) {
+    const std::vector<double> data{-1.0, 0.0, 0.1, 0.5, 0.99, 1.0, 2.0};
+    const auto histogram =
+        tensorutil::computeHistogram(data.data(), data.size(), 4, dvec2(0.0, 1.0), 0, 1);
+
+    EXPECT_EQ((std::vector<size_t>{3, 0, 1, 3}), histogram);
+}
+
+TEST(TensorUtilTests, chunkExceptionsArePropagated) {
+    std::atomic<size_t> processed{0};
+    EXPECT_THROW(tensorutil::detail::forEachChunk(8, 4,
+                                                  [&](size_t chunk, size_t, size_t) {
+                                                      ++processed;
+                                                      if (chunk == 2) throw Exception("chunk");
+                                                  }),
+                 Exception);
+    EXPECT_EQ(4u, processed.load());
+}
+
+TEST(TensorUtilTests, metaDataStatisticsAreCached) {
+    struct Values : MetaDataType<glm::f64> {
+        using MetaDataType<glm::f64>::MetaDataType;
+        Values *clone() const final { return new Values(data_, type_); }
+        Values *create(DataType data) const final { return new Values(std::move(data), type_); }
+        uint64_t getId() const final { return 0; }
+    };
+
+    Values values({2.0, 8.0, 5.0}, TensorFeature::FrobeniusNorm);
+    const auto statistics = values.getStatistics();
+    EXPECT_EQ(statistics, values.getStatistics());
+    EXPECT_EQ(std::make_pair(2.0, 8.0), values.getMinMax());
+
+    auto data = static_cast<double *>(values.allocate(2, TensorFeature::FrobeniusNorm));
+    data[0] = -1.0;
+    data[1] = 1.0;
+    EXPECT_NE(statistics, values.getStatistics());
+    EXPECT_EQ(std::make_pair(-1.0, 1.0), values.getMinMax());
+}
+
+}  // namespace inviwo
@@ -0,0 +1,55 @@
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/tensorvisbase/datastructures/eigenvaluerangecache.h>
+
+#include "tensorfieldtestutil.h"
+
+namespace inviwo {
+namespace {
+// 3x3 field where every tensor is diag(major, minor)
+std::shared_ptr<const TensorField2D> makeField(double major, double minor) {
+    return tensorfieldtest::makeField(size2_t(3), dmat2(major, 0.0, 0.0, minor));
+}
+}  // namespace
+
+TEST(TensorUtilTests, eigenValueRanges) {
+    const auto ranges = EigenValueRanges::compute(makeField(3.0, 1.0), size2_t(6), 1);
+
+    EXPECT_DOUBLE_EQ(3.0, ranges.major.x);
+    EXPECT_DOUBLE_EQ(3.0, ranges.major.y);
+    EXPECT_DOUBLE_EQ(1.0, ranges.minor.x);
+    EXPECT_DOUBLE_EQ(1.0, ranges.minor.y);
+    EXPECT_DOUBLE_EQ(2.0, ranges.anisotropy.x);
+    EXPECT_DOUBLE_EQ(2.0, ranges.anisotropy.y);
+}
+
+TEST(TensorUtilTests, eigenValueRangeCacheFollowsField) {
+    EigenValueRangeCache cache(1);
+
+    const auto field = makeField(3.0, 1.0);
+    EXPECT_DOUBLE_EQ(3.0, cache.getRanges(field, size2_t(6)).major.y);
+    EXPECT_EQ(1u, cache.getNumberOfComputations());
+
+    // The same field at the same resolution is a lookup, another resolution is computed again
+    EXPECT_DOUBLE_EQ(3.0, cache.getRanges(field, size2_t(6)).major.y);
+    EXPECT_EQ(1u, cache.getNumberOfComputations());
+    EXPECT_DOUBLE_EQ(3.0, cache.getRanges(field, size2_t(8)).major.y);
+    EXPECT_EQ(2u, cache.getNumberOfComputations());
+
+    const auto image = cache.getImage(field);
+    EXPECT_EQ(image, cache.getImage(field));
+
+    const auto other = makeField(5.0, 2.0);
+    EXPECT_DOUBLE_EQ(5.0, cache.getRanges(other, size2_t(8)).major.y);
+    EXPECT_EQ(3u, cache.getNumberOfComputations());
+    EXPECT_NE(image, cache.getImage(other));
+
+    cache.clear();
+    EXPECT_DOUBLE_EQ(5.0, cache.getRanges(other, size2_t(8)).major.y);
+    EXPECT_EQ(4u, cache.getNumberOfComputations());
+}
+
+}  // namespace inviwo
@@ -0,0 +1,115 @@
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/tensorvisbase/algorithm/glyphlod.h>
+
+namespace inviwo {
+namespace {
+// Camera at the origin looking down the negative z axis
+mat4 perspectiveCamera() {
+    return glm::perspective(glm::radians(60.0f), 1.0f, 0.1f, 100.0f) *
+           glm::lookAt(vec3(0.0f), vec3(0.0f, 0.0f, -1.0f), vec3(0.0f, 1.0f, 0.0f));
+}
+
+TensorGlyphInstance sphereInstance(const vec3& position, float radius) {
+    TensorGlyphInstance instance{};
+    instance.frame = mat3(radius / std::sqrt(3.0f));
+    instance.position = position;
+    return instance;
+}
+}  // namespace
+
+TEST(TensorUtilTests, glyphLodFrustumCulling) {
+    const auto worldToClip = perspectiveCamera();
+
+    EXPECT_TRUE(util::isInFrustum(vec3(0.0f, 0.0f, -10.0f), 1.0f, worldToClip));
+    EXPECT_FALSE(util::isInFrustum(vec3(0.0f, 0.0f, 10.0f), 1.0f, worldToClip));
+    EXPECT_FALSE(util::isInFrustum(vec3(50.0f, 0.0f, -10.0f), 1.0f, worldToClip));
+    EXPECT_FALSE(util::isInFrustum(vec3(0.0f, 0.0f, -200.0f), 1.0f, worldToClip));
+    // Partially visible glyphs are kept
+    EXPECT_TRUE(util::isInFrustum(vec3(0.0f, 0.0f, 0.5f), 1.0f, worldToClip));
+}
+
+TEST(TensorUtilTests, glyphLodProjectedRadius) {
+    const auto worldToClip = perspectiveCamera();
+    const size2_t viewport(512, 512);
+
+    const auto near = util::projectedRadius(vec3(0.0f, 0.0f, -5.0f), 1.0f, worldToClip, viewport);
+    const auto far = util::projectedRadius(vec3(0.0f, 0.0f, -10.0f), 1.0f, worldToClip, viewport);
+    EXPECT_NEAR(2.0f, near / far, 1.0e-4f);
+
+    // The half height of the view at distance d is d * tan(30 degrees)
+    EXPECT_NEAR(256.0f / (10.0f * std::tan(glm::radians(30.0f))), far, 1.0e-2f);
+
+    // Orthographic projections do not depend on the distance
+    const auto ortho = glm::ortho(-4.0f, 4.0f, -4.0f, 4.0f, 0.1f, 100.0f);
+    EXPECT_NEAR(64.0f, util::projectedRadius(vec3(0.0f, 0.0f, -5.0f), 1.0f, ortho, viewport),
+                1.0e-3f);
+    EXPECT_NEAR(64.0f, util::projectedRadius(vec3(0.0f, 0.0f, -50.0f), 1.0f, ortho, viewport),
+                1.0e-3f);
+}
+
+TEST(TensorUtilTests, glyphLodResolutions) {
+    GlyphLodSettings settings;
+    settings.levels = 4;
+    settings.minResolution = size2_t(6, 4);
+
+    const std::vector<size2_t> expected{{64, 32}, {32, 16}, {16, 8}, {8, 4}};
+    EXPECT_EQ(expected, util::glyphLodResolutions(size2_t(64, 32), settings));
+
+    // Levels stop at the minimum resolution
+    const std::vector<size2_t> clamped{{16, 8}, {8, 4}, {6, 4}};
+    EXPECT_EQ(clamped, util::glyphLodResolutions(size2_t(16, 8), settings));
+
+    settings.lod = false;
+    EXPECT_EQ(std::vector<size2_t>{size2_t(64, 32)},
+              util::glyphLodResolutions(size2_t(64, 32), settings));
+}
+
+TEST(TensorUtilTests, glyphLodSelectsCoarserLevelsFarAway) {
+    const auto worldToClip = perspectiveCamera();
+    const size2_t viewport(512, 512);
+    GlyphLodSettings settings;
+    const auto resolutions = util::glyphLodResolutions(size2_t(64, 32), settings);
+
+    const auto level = [&](float distance) {
+        return util::selectGlyphLod(vec3(0.0f, 0.0f, -distance), 1.0f, worldToClip, viewport,
+                                    resolutions, settings);
+    };
+
+    EXPECT_EQ(0, level(1.0f));
+    EXPECT_LE(level(1.0f), level(10.0f));
+    EXPECT_LE(level(10.0f), level(90.0f));
+    EXPECT_EQ(static_cast<int>(resolutions.size()) - 1, level(90.0f));
+
+    // Glyphs smaller than a pixel are culled
+    settings.minPixelRadius = 1.0f;
+    EXPECT_EQ(-1, util::selectGlyphLod(vec3(0.0f, 0.0f, -50.0f), 0.01f, worldToClip, viewport,
+                                       resolutions, settings));
+    settings.cull = false;
+    EXPECT_EQ(static_cast<int>(resolutions.size()) - 1,
+              util::selectGlyphLod(vec3(0.0f, 0.0f, -50.0f), 0.01f, worldToClip, viewport,
+                                   resolutions, settings));
+}
+
+TEST(TensorUtilTests, glyphLodSelection) {
+    std::vector<TensorGlyphInstance> instances{sphereInstance(vec3(0.0f, 0.0f, -1.0f), 0.5f),
+                                               sphereInstance(vec3(0.0f, 0.0f, 10.0f), 0.5f),
+                                               sphereInstance(vec3(0.0f, 0.0f, -50.0f), 0.5f)};
+    TensorGlyphInstances glyphs(TensorGlyphType::Quadric, nullptr, size2_t(64, 32), instances,
+                                {0, 1, 2});
+
+    GlyphLodSettings settings;
+    const auto selection =
+        util::selectGlyphLods(glyphs, perspectiveCamera(), size2_t(512, 512), settings, 1);
+
+    EXPECT_EQ(1u, selection.culled);
+    EXPECT_EQ(2u, selection.getNumberOfVisibleGlyphs());
+    ASSERT_FALSE(selection.instances.empty());
+    EXPECT_EQ(std::vector<size_t>{0}, selection.instances.front());
+    EXPECT_EQ(std::vector<size_t>{2}, selection.instances.back());
+}
+
+}  // namespace inviwo
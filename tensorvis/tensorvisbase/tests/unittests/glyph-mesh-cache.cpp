@@ -0,0 +1,93 @@
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/tensorvisbase/datastructures/glyphmeshcache.h>
+
+namespace inviwo {
+namespace {
+std::shared_ptr<BasicMesh> createMesh(size_t numVertices) {
+    auto mesh = std::make_shared<BasicMesh>();
+    auto indices = mesh->addIndexBuffer(DrawType::Triangles, ConnectivityType::None);
+    for (size_t i = 0; i < numVertices; ++i) {
+        indices->add(mesh->addVertex(vec3(static_cast<float>(i)), vec3(0.0f, 0.0f, 1.0f),
+                                     vec3(0.0f), vec4(1.0f)));
+    }
+    return mesh;
+}
+}  // namespace
+
+TEST(TensorUtilTests, glyphMeshCacheSharesQuantizedShapes) {
+    GlyphMeshCache cache(GlyphMeshCache::defaultMaxSizeInBytes, 0.01);
+    const size2_t resolution(16, 8);
+
+    const auto key1 = cache.makeKey(TensorGlyphType::Superquadric, resolution,
+                                    dvec4(0.5, 0.25, 0.0, 0.0), vec4(1.0f));
+    const auto key2 = cache.makeKey(TensorGlyphType::Superquadric, resolution,
+                                    dvec4(0.501, 0.249, 0.0, 0.0), vec4(1.0f));
+    const auto key3 = cache.makeKey(TensorGlyphType::Superquadric, size2_t(32, 8),
+                                    dvec4(0.5, 0.25, 0.0, 0.0), vec4(1.0f));
+
+    EXPECT_EQ(key1, key2);
+    EXPECT_FALSE(key1 == key3);
+    EXPECT_NEAR(0.5, cache.dequantize(key2).x, 1.0e-12);
+
+    size_t created = 0;
+    const auto create = [&]() {
+        ++created;
+        return createMesh(3);
+    };
+
+    auto mesh1 = cache.get(key1, create);
+    auto mesh2 = cache.get(key2, create);
+    cache.get(key3, create);
+
+    EXPECT_EQ(mesh1, mesh2);
+    EXPECT_EQ(2u, created);
+    EXPECT_EQ(1u, cache.getHits());
+    EXPECT_EQ(2u, cache.getMisses());
+}
+
+TEST(TensorUtilTests, glyphMeshCacheEvictsLeastRecentlyUsed) {
+    const auto meshSize = GlyphMeshCache::getSizeInBytes(*createMesh(3));
+    GlyphMeshCache cache(2 * meshSize);
+
+    const auto key = [&](double shape) {
+        return cache.makeKey(TensorGlyphType::Reynolds, size2_t(8), dvec4(shape));
+    };
+    const auto create = []() { return createMesh(3); };
+
+    auto first = cache.get(key(0.1), create);
+    cache.get(key(0.2), create);
+    EXPECT_EQ(first, cache.get(key(0.1), create));  // 0.2 is now least recently used
+    cache.get(key(0.3), create);
+
+    EXPECT_EQ(2u, cache.size());
+    EXPECT_LE(cache.getSizeInBytes(), cache.getMaxSizeInBytes());
+
+    const auto misses = cache.getMisses();
+    cache.get(key(0.1), create);
+    EXPECT_EQ(misses, cache.getMisses());
+    cache.get(key(0.2), create);
+    EXPECT_EQ(misses + 1, cache.getMisses());
+
+    cache.setMaxSizeInBytes(0);
+    EXPECT_EQ(1u, cache.size());
+    cache.clear();
+    EXPECT_EQ(0u, cache.size());
+    EXPECT_EQ(0u, cache.getSizeInBytes());
+}
+
+TEST(TensorUtilTests, glyphMeshCacheInstancesShareBuffers) {
+    auto geometry = createMesh(3);
+    auto instance = GlyphMeshCache::instantiate(*geometry);
+    instance->setWorldMatrix(glm::translate(vec3(1.0f, 2.0f, 3.0f)));
+
+    EXPECT_EQ(geometry->getVertices(), instance->getVertices());
+    EXPECT_EQ(geometry->getIndexBuffers().front().second,
+              instance->getIndexBuffers().front().second);
+    EXPECT_EQ(mat4(1.0f), geometry->getWorldMatrix());
+}
+
+}  // namespace inviwo
@@ -0,0 +1,141 @@
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/tensorvisbase/datastructures/hyperstreamlinetracer.h>
+#include <inviwo/tensorvisbase/datastructures/hyperstreamlinefamilytracer.h>
+#include <inviwo/tensorvisbase/datastructures/hyperstreamlineoccupancygrid.h>
+
+namespace inviwo {
+namespace {
+// Samplers with the interface used by detail::adaptiveHyperstep
+struct ConstantSampler {
+    dvec3 sample(const dvec3 &) const { return dvec3(1.0, 0.0, 0.0); }
+};
+
+// Same direction, but with the sign of the eigenvector changing along x
+struct FlippingSampler {
+    dvec3 sample(const dvec3 &pos) const {
+        return pos.x < 0.05 ? dvec3(1.0, 0.0, 0.0) : dvec3(-1.0, 0.0, 0.0);
+    }
+};
+
+// Circles around the z axis
+struct RotationSampler {
+    dvec3 sample(const dvec3 &pos) const { return dvec3(-pos.y, pos.x, 0.0); }
+};
+
+template <typename Sampler>
+std::tuple<dvec3, dvec3, double> step(const dvec3 &pos, double stepSize) {
+    const Sampler sampler;
+    return detail::adaptiveHyperstep<dvec3, dvec3>(pos, sampler.sample(pos), stepSize, dmat3(1.0),
+                                                  false, sampler);
+}
+}  // namespace
+
+TEST(TensorUtilTests, adaptiveHyperstepConstantField) {
+    const auto res = step<ConstantSampler>(dvec3(0.0), 0.1);
+    EXPECT_NEAR(0.1, std::get<0>(res).x, 1e-12);
+    EXPECT_NEAR(0.0, std::get<2>(res), 1e-12);
+
+    const auto bwd = step<ConstantSampler>(dvec3(0.0), -0.1);
+    EXPECT_NEAR(-0.1, std::get<0>(bwd).x, 1e-12);
+}
+
+TEST(TensorUtilTests, adaptiveHyperstepAlignsEigenvectors) {
+    const auto res = step<FlippingSampler>(dvec3(0.0), 0.1);
+    EXPECT_NEAR(0.1, std::get<0>(res).x, 1e-12);
+    EXPECT_GT(std::get<1>(res).x, 0.0);
+    EXPECT_NEAR(0.0, std::get<2>(res), 1e-12);
+}
+
+TEST(TensorUtilTests, adaptiveHyperstepErrorEstimate) {
+    const dvec3 start(1.0, 0.0, 0.0);
+    const auto coarse = step<RotationSampler>(start, 0.2);
+    const auto fine = step<RotationSampler>(start, 0.1);
+
+    EXPECT_GT(std::get<2>(coarse), 0.0);
+    // The error estimate is of fourth order in the step size
+    EXPECT_LT(std::get<2>(fine), std::get<2>(coarse) / 8.0);
+    // and the fifth-order solution stays on the unit circle
+    EXPECT_NEAR(1.0, glm::length(std::get<0>(coarse)), 1e-6);
+}
+
+TEST(TensorUtilTests, eigenSystemSamplerFamilies) {
+    dmat3 tensor(0.0);
+    tensor[0][0] = 1.0;
+    tensor[1][1] = 3.0;
+    tensor[2][2] = 2.0;
+    auto field = std::make_shared<TensorField3D>(
+        size3_t(3), TensorStorage3D(std::vector<dmat3>(27, tensor), TensorStorageMode::Full));
+
+    const EigenSystemSampler sampler(field);
+    const dvec3 pos(0.3, 0.5, 0.7);
+    const auto eigenSystem = sampler.sample(pos);
+    EXPECT_DOUBLE_EQ(3.0, eigenSystem[0].first);
+    EXPECT_DOUBLE_EQ(1.0, eigenSystem[2].first);
+
+    const dvec3 major = EigenVectorSampler(sampler, 0).sample(pos);
+    const dvec3 intermediate = EigenVectorSampler(sampler, 1).sample(pos);
+    const dvec3 minor = EigenVectorSampler(sampler, 2).sample(pos);
+    EXPECT_EQ(4u, sampler.getNumberOfDecompositions());
+    EXPECT_NEAR(1.0, glm::abs(major.y), 1e-12);
+    EXPECT_NEAR(1.0, glm::abs(intermediate.z), 1e-12);
+    EXPECT_NEAR(1.0, glm::abs(minor.x), 1e-12);
+
+    // Pinned seeds are never decomposed again
+    const dvec3 seed(0.1);
+    EXPECT_EQ(major, EigenVectorSampler(sampler, 0, &seed, &eigenSystem).sample(seed));
+    EXPECT_EQ(4u, sampler.getNumberOfDecompositions());
+    EigenVectorSampler(sampler, 0, &seed, &eigenSystem).sample(pos);
+    EXPECT_EQ(5u, sampler.getNumberOfDecompositions());
+
+    EXPECT_TRUE(sampler.withinBounds(dvec3(1.0)));
+    EXPECT_FALSE(sampler.withinBounds(dvec3(0.5, -0.01, 0.5)));
+}
+
+TEST(TensorUtilTests, frozenOccupancyMatchesSerialTracing) {
+    dmat3 tensor(0.0);
+    tensor[0][0] = 1.0;
+    tensor[1][1] = 3.0;
+    tensor[2][2] = 2.0;
+    auto field = std::make_shared<TensorField3D>(
+        size3_t(3), TensorStorage3D(std::vector<dmat3>(27, tensor), TensorStorageMode::Full));
+    const EigenSystemSampler eigenSystems(field);
+    const EigenVectorSampler sampler(eigenSystems, 0);
+    const IntegralLineProperties properties("properties", "Properties");
+
+    // Seeds along the major eigenvector, so that the lines compete for the same cells
+    std::vector<dvec3> seeds;
+    for (size_t i = 1; i < 20; ++i) seeds.emplace_back(0.5, 0.05 * i, 0.5);
+
+    auto liveGrid = std::make_shared<HyperStreamLineOccupancyGrid>(size3_t(8));
+    HyperStreamLineTracer live(*field, properties);
+    live.setOccupancyGrid(liveGrid);
+
+    auto frozenGrid = std::make_shared<HyperStreamLineOccupancyGrid>(size3_t(8));
+    HyperStreamLineTracer frozen(*field, properties);
+    frozen.setOccupancyGrid(frozenGrid);
+    frozen.setOccupancyFrozen(true);
+
+    std::vector<HyperStreamLineTracer::Result> traced;
+    for (const auto &seed : seeds) traced.push_back(frozen.traceWith(seed, sampler));
+    for (size_t i = 0; i < frozenGrid->getSize(); ++i) {
+        EXPECT_EQ(0u, frozenGrid->getCount(i));
+    }
+
+    for (size_t i = 0; i < seeds.size(); ++i) {
+        const auto expected = live.traceWith(seeds[i], sampler);
+        frozen.commitOccupancy(traced[i]);
+        EXPECT_EQ(expected.line.getPositions(), traced[i].line.getPositions());
+        EXPECT_EQ(expected.seedIndex, traced[i].seedIndex);
+        EXPECT_EQ(expected.line.getPositions().size(),
+                  traced[i].line.getMetaData<dvec3>("velocity").size());
+    }
+    for (size_t i = 0; i < liveGrid->getSize(); ++i) {
+        EXPECT_EQ(liveGrid->getCount(i), frozenGrid->getCount(i));
+    }
+}
+
+}  // namespace inviwo
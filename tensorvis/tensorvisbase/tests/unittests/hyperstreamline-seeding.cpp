@@ -0,0 +1,94 @@
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/tensorvisbase/algorithm/hyperstreamlineseeding.h>
+#include <inviwo/tensorvisbase/datastructures/hyperstreamlineoccupancygrid.h>
+#include <inviwo/core/util/exception.h>
+
+#include <thread>
+
+namespace inviwo {
+
+TEST(TensorUtilTests, occupancyGridCells) {
+    const HyperStreamLineOccupancyGrid grid(size3_t(4, 2, 2));
+
+    EXPECT_EQ(16u, grid.getSize());
+    EXPECT_EQ(0u, grid.cellIndex(dvec3(0.0)));
+    EXPECT_EQ(15u, grid.cellIndex(dvec3(1.0)));
+    EXPECT_EQ(1u + 4u + 8u, grid.cellIndex(dvec3(0.3, 0.6, 0.6)));
+    EXPECT_EQ(HyperStreamLineOccupancyGrid::npos, grid.cellIndex(dvec3(-0.1, 0.5, 0.5)));
+    EXPECT_EQ(HyperStreamLineOccupancyGrid::npos, grid.cellIndex(dvec3(0.5, 1.1, 0.5)));
+
+    for (size_t cell = 0; cell < grid.getSize(); ++cell) {
+        EXPECT_EQ(cell, grid.cellIndex(grid.cellCenter(cell)));
+    }
+
+    EXPECT_THROW(HyperStreamLineOccupancyGrid(size3_t(0, 1, 1)), Exception);
+    EXPECT_THROW(HyperStreamLineOccupancyGrid(size3_t(1), 0), Exception);
+}
+
+TEST(TensorUtilTests, occupancyGridCapacity) {
+    HyperStreamLineOccupancyGrid grid(size3_t(2), 10);
+
+    // Competing threads never push a cell beyond its capacity
+    std::vector<std::thread> threads;
+    std::vector<size_t> occupied(4, 0);
+    for (size_t t = 0; t < occupied.size(); ++t) {
+        threads.emplace_back([&, t]() {
+            for (size_t i = 0; i < 100; ++i) {
+                if (grid.tryOccupy(3)) ++occupied[t];
+            }
+        });
+    }
+    for (auto &thread : threads) thread.join();
+
+    EXPECT_EQ(10u, occupied[0] + occupied[1] + occupied[2] + occupied[3]);
+    EXPECT_EQ(10u, grid.getCount(3));
+    EXPECT_TRUE(grid.isSaturated(3));
+    EXPECT_FALSE(grid.isSaturated(2));
+
+    grid.clear();
+    EXPECT_EQ(0u, grid.getCount(3));
+}
+
+TEST(TensorUtilTests, evenlySpacedSeeds) {
+    HyperStreamLineOccupancyGrid grid(size3_t(6));
+
+    EXPECT_EQ(27u, tensorutil::numberOfSeedingRounds(3));
+    EXPECT_EQ(8u, tensorutil::evenlySpacedSeeds(grid, 3, 0).size());
+
+    // Rounds cover every cell exactly once
+    size_t total = 0;
+    for (size_t round = 0; round < tensorutil::numberOfSeedingRounds(3); ++round) {
+        total += tensorutil::evenlySpacedSeeds(grid, 3, round).size();
+    }
+    EXPECT_EQ(grid.getSize(), total);
+
+    // Occupied cells get no seeds
+    grid.tryOccupy(grid.cellIndex(dvec3(0.01)));
+    const auto seeds = tensorutil::evenlySpacedSeeds(grid, 3, 0);
+    EXPECT_EQ(7u, seeds.size());
+    for (const auto &seed : seeds) {
+        EXPECT_EQ(0u, grid.getCount(grid.cellIndex(seed)));
+    }
+}
+
+TEST(TensorUtilTests, weightedSeeds) {
+    const size3_t dims(4, 3, 2);
+    std::vector<double> weights(dims.x * dims.y * dims.z, 0.0);
+    weights[1 + 4 * 2 + 12] = 2.0;  // voxel (1, 2, 1)
+
+    const auto seeds = tensorutil::weightedSeeds(weights, dims, 50, 7);
+    ASSERT_EQ(50u, seeds.size());
+    for (const auto &seed : seeds) {
+        EXPECT_EQ(size3_t(1, 2, 1), size3_t(seed * dvec3(dims)));
+    }
+    EXPECT_EQ(seeds, tensorutil::weightedSeeds(weights, dims, 50, 7));
+
+    EXPECT_THROW(tensorutil::weightedSeeds(std::vector<double>(24, 0.0), dims, 1), Exception);
+    EXPECT_THROW(tensorutil::weightedSeeds(std::vector<double>(5, 1.0), dims, 1), Exception);
+}
+
+}  // namespace inviwo
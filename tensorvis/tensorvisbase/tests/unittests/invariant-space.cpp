@@ -0,0 +1,101 @@
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/tensorvisbase/datastructures/invariantspace.h>
+
+namespace inviwo {
+namespace {
+// Two axes where point i is (i, 10 * i)
+InvariantSpace makeSpace(const size_t numberOfPoints) {
+    InvariantSpace space(2, {"a", "b"}, {TensorFeature::I1, TensorFeature::I2});
+    for (size_t i = 0; i < numberOfPoints; ++i) {
+        space.addPoint({static_cast<double>(i), 10.0 * static_cast<double>(i)});
+    }
+    return space;
+}
+}  // namespace
+
+TEST(TensorUtilTests, invariantSpacePointsAndAxes) {
+    const auto space = makeSpace(20);
+
+    EXPECT_EQ(2u, space.getNumberOfDimensions());
+    EXPECT_EQ(20u, space.getNumElements());
+    EXPECT_LE(20u, space.getCapacity());
+
+    const auto point = space.getPoint(7);
+    EXPECT_EQ(2u, point.size());
+    EXPECT_EQ(7.0, point[0]);
+    EXPECT_EQ(70.0, point[1]);
+    EXPECT_EQ((std::vector<double>{7.0, 70.0}), point.toVector());
+
+    const auto axis = space.getAxis(1);
+    ASSERT_TRUE(axis.isContiguous());
+    EXPECT_EQ(20u, axis.size());
+    for (size_t i = 0; i < axis.size(); ++i) {
+        EXPECT_EQ(10.0 * static_cast<double>(i), axis.data()[i]);
+    }
+    EXPECT_EQ(axis.data(), space[1].data());
+
+    EXPECT_EQ(0.0, space.getMinMax(0)[0]);
+    EXPECT_EQ(19.0, space.getMinMax(0)[1]);
+    EXPECT_EQ(190.0, space.getMinMax(1)[1]);
+}
+
+TEST(TensorUtilTests, invariantSpaceFlatten) {
+    const auto space = makeSpace(3);
+    EXPECT_EQ((std::vector<double>{0.0, 0.0, 1.0, 10.0, 2.0, 20.0}), space.flatten());
+}
+
+TEST(TensorUtilTests, invariantSpaceReserve) {
+    auto space = makeSpace(0);
+    space.reserve(100);
+    EXPECT_EQ(100u, space.getCapacity());
+
+    space.addPoint({1.0, 2.0});
+    const auto data = space.getAxis(0).data();
+    for (size_t i = 1; i < 100; ++i) space.addPoint({1.0, 2.0});
+    EXPECT_EQ(data, space.getAxis(0).data());
+    EXPECT_EQ(100u, space.getCapacity());
+}
+
+TEST(TensorUtilTests, invariantSpaceWrongDimensionality) {
+    auto space = makeSpace(4);
+    space.addPoint({1.0, 2.0, 3.0});
+    space.addAxis("c", std::vector<double>{1.0, 2.0}, TensorFeature::I3);
+    EXPECT_EQ(4u, space.getNumElements());
+    EXPECT_EQ(2u, space.getNumberOfDimensions());
+}
+
+TEST(TensorUtilTests, invariantSpaceAddAxes) {
+    auto space = makeSpace(5);
+    InvariantSpace other;
+    other.addAxis("c", std::vector<double>{4.0, 3.0, 2.0, 1.0, 0.0}, TensorFeature::I3);
+    space.addAxes(other);
+
+    ASSERT_EQ(3u, space.getNumberOfDimensions());
+    EXPECT_EQ("c", space.getIdentifier(2));
+    EXPECT_EQ(TensorFeature::I3, space.getMetaDataType(2));
+    EXPECT_EQ((std::vector<double>{1.0, 10.0, 3.0}), space.getPoint(1).toVector());
+    EXPECT_EQ(0.0, space.getMinMax(2)[0]);
+    EXPECT_EQ(4.0, space.getMinMax(2)[1]);
+
+    // The copied axis does not alias the source
+    EXPECT_NE(other.getAxis(0).data(), space.getAxis(2).data());
+}
+
+TEST(TensorUtilTests, invariantSpaceClear) {
+    auto space = makeSpace(8);
+    space.clear();
+    EXPECT_EQ(0u, space.getNumElements());
+    EXPECT_EQ(2u, space.getNumberOfDimensions());
+    EXPECT_EQ("b", space.getIdentifier(1));
+
+    space.addPoint({-1.0, 5.0});
+    EXPECT_EQ((std::vector<double>{-1.0, 5.0}), space.getPoint(0).toVector());
+    EXPECT_EQ(-1.0, space.getMinMax(0)[1]);
+    EXPECT_EQ(5.0, space.getMinMax(1)[0]);
+}
+
+}  // namespace inviwo
@@ -0,0 +1,43 @@
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/tensorvisbase/datastructures/metadatacolumnview.h>
+
+#include <vector>
+
+namespace inviwo {
+TEST(TensorUtilTests, metaDataColumnViewOfMetaData) {
+    const MajorEigenVectors vectors(
+        std::vector<dvec3>{dvec3(1.0, 2.0, 3.0), dvec3(0.5, 0.25, 0.125)},
+        TensorFeature::MajorEigenVector);
+
+    const auto view = MetaDataColumnView::fromMetaData(vectors);
+    EXPECT_EQ(2u, view.size());
+    EXPECT_EQ(3u, view.getNumberOfComponents());
+    EXPECT_EQ(6u, view.getNumberOfScalars());
+    EXPECT_EQ(MetaDataPrecision::Float64, view.getPrecision());
+    EXPECT_EQ(vectors.getDataPtr(), view.getDataPtr());
+    EXPECT_THROW(view.data<float>(), Exception);
+}
+
+TEST(TensorUtilTests, metaDataColumnViewCopyConvertsPrecision) {
+    const MajorEigenVectors vectors(
+        std::vector<dvec3>{dvec3(1.0, 2.0, 3.0), dvec3(0.5, 0.25, 0.125)},
+        TensorFeature::MajorEigenVector);
+    const auto view = MetaDataColumnView::fromMetaData(vectors);
+
+    std::vector<float> data(view.getNumberOfScalars());
+    view.copyTo(data.data(), MetaDataPrecision::Float32);
+    EXPECT_EQ(1.0f, data[0]);
+    EXPECT_EQ(3.0f, data[2]);
+    EXPECT_EQ(0.125f, data[5]);
+
+    const MetaDataColumnView floats(data.data(), 2, 3, MetaDataPrecision::Float32);
+    std::vector<double> roundTrip(floats.getNumberOfScalars());
+    floats.copyTo(roundTrip.data(), MetaDataPrecision::Float64);
+    EXPECT_EQ(0.25, roundTrip[4]);
+}
+
+}  // namespace inviwo
@@ -0,0 +1,73 @@
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/tensorvisbase/util/tensorutil.h>
+
+namespace inviwo {
+namespace {
+void expectValidEigenSystem(const dmat3 &tensor,
+                            const std::array<std::pair<double, dvec3>, 3> &eigenSystem) {
+    const auto scale = std::max(1.0, std::abs(eigenSystem[0].first));
+    EXPECT_GE(eigenSystem[0].first, eigenSystem[1].first);
+    EXPECT_GE(eigenSystem[1].first, eigenSystem[2].first);
+
+    for (const auto &pair : eigenSystem) {
+        EXPECT_NEAR(1.0, glm::length(pair.second), 1e-10);
+        const auto residual = tensor * pair.second - pair.first * pair.second;
+        EXPECT_NEAR(0.0, glm::length(residual), 1e-9 * scale);
+    }
+}
+}  // namespace
+
+TEST(TensorUtilTests, symmetricEigenDecompositionMatchesGeneralSolver) {
+    const dmat3 tensor(4.0, 1.0, -2.0, 1.0, 2.0, 0.5, -2.0, 0.5, 3.0);
+
+    const auto symmetric = tensorutil::calculateSymmetricEigenValuesAndEigenVectors(tensor);
+    const auto general = tensorutil::calculateEigenValuesAndEigenVectors(tensor);
+
+    for (size_t i = 0; i < 3; ++i) {
+        EXPECT_NEAR(general[i].first, symmetric[i].first, 1e-10);
+        EXPECT_NEAR(1.0, std::abs(glm::dot(general[i].second, symmetric[i].second)), 1e-10);
+    }
+    expectValidEigenSystem(tensor, symmetric);
+}
+
+TEST(TensorUtilTests, symmetricEigenDecompositionDegenerate) {
+    const std::array<dmat3, 3> tensors{{dmat3(2.0),
+                                        dmat3(3.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0),
+                                        dmat3(2.0, 1.0, 0.0, 1.0, 2.0, 0.0, 0.0, 0.0, 3.0)}};
+
+    for (const auto &tensor : tensors) {
+        expectValidEigenSystem(tensor,
+                               tensorutil::calculateSymmetricEigenValuesAndEigenVectors(tensor));
+        expectValidEigenSystem(
+            tensor, tensorutil::calculateSymmetricEigenValuesAndEigenVectorsJacobi(tensor));
+    }
+}
+
+TEST(TensorUtilTests, symmetricEigenDecompositionBatch) {
+    std::vector<dmat3> tensors{dmat3(4.0, 1.0, -2.0, 1.0, 2.0, 0.5, -2.0, 0.5, 3.0), dmat3(0.0),
+                               dmat3(1.0)};
+    const TensorStorage3D storage(tensors, TensorStorageMode::Symmetric);
+
+    std::vector<double> major(3), middle(3), minor(3);
+    std::vector<dvec3> majorVectors(3), middleVectors(3), minorVectors(3);
+    tensorutil::calculateSymmetricEigenValuesAndEigenVectors(
+        storage.symmetricTensors(), tensors.size(), major.data(), middle.data(),
+        minor.data(), majorVectors.data(), middleVectors.data(), minorVectors.data());
+
+    for (size_t i = 0; i < tensors.size(); ++i) {
+        const auto single = tensorutil::calculateSymmetricEigenValuesAndEigenVectors(tensors[i]);
+        EXPECT_DOUBLE_EQ(single[0].first, major[i]);
+        EXPECT_DOUBLE_EQ(single[1].first, middle[i]);
+        EXPECT_DOUBLE_EQ(single[2].first, minor[i]);
+        EXPECT_EQ(single[0].second, majorVectors[i]);
+        EXPECT_EQ(single[2].second, minorVectors[i]);
+    }
+
+    EXPECT_EQ(dvec3(0.0), majorVectors[1]);
+}
+
+}  // namespace inviwo
@@ -0,0 +1,49 @@
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/tensorvisbase/algorithm/tensorfeatures.h>
+
+namespace inviwo {
+TEST(TensorUtilTests, fusedFeaturesMatchSingleFeatures) {
+    const std::vector<dmat3> matrices{dmat3(1.0, 4.0, 6.0, 4.0, 2.0, 5.0, 6.0, 5.0, 3.0),
+                                      dmat3(3.0, 0.0, 0.0, 0.0, -2.0, 0.0, 0.0, 0.0, 1.0)};
+    const TensorStorage3D tensors(matrices);
+
+    const std::vector<double> major{3.0, 3.0};
+    const std::vector<double> middle{1.0, 1.0};
+    const std::vector<double> minor{-2.0, -2.0};
+    const std::array<const double *, 3> eigenValues{{major.data(), middle.data(), minor.data()}};
+
+    const std::vector<TensorFeature> features{TensorFeature::I1, TensorFeature::Anisotropy,
+                                              TensorFeature::LinearAnisotropy,
+                                              TensorFeature::FrobeniusNorm,
+                                              TensorFeature::HillYieldCriterion};
+    std::vector<std::vector<double>> data(features.size(), std::vector<double>(2));
+    std::vector<double *> columns;
+    for (auto &column : data) columns.push_back(column.data());
+
+    tensorutil::computeTensorFeatures(tensors, eigenValues, features, columns);
+
+    for (size_t i = 0; i < matrices.size(); i++) {
+        EXPECT_DOUBLE_EQ(tensorutil::calculateI1(matrices[i]), data[0][i]);
+        EXPECT_DOUBLE_EQ(5.0, data[1][i]);
+        EXPECT_DOUBLE_EQ((3.0 - 2.0) / 6.0, data[2][i]);
+        EXPECT_DOUBLE_EQ(std::sqrt(14.0), data[3][i]);
+        EXPECT_DOUBLE_EQ(std::sqrt(19.0), data[4][i]);
+    }
+}
+
+TEST(TensorUtilTests, featureMetaDataMatchesFeature) {
+    const auto metaData = tensorutil::createMetaData(TensorFeature::J2, {1.0, 2.0});
+
+    ASSERT_NE(nullptr, metaData);
+    EXPECT_EQ(J2::id(), metaData->getId());
+    EXPECT_EQ(2u, metaData->getNumberOfElements());
+    EXPECT_EQ(nullptr, tensorutil::createMetaData(TensorFeature::MajorEigenVector, {}));
+    EXPECT_TRUE(tensorutil::isScalarTensorFeature(TensorFeature::HillYieldCriterion));
+    EXPECT_TRUE(tensorutil::requiresEigenValues(TensorFeature::HillYieldCriterion));
+}
+
+}  // namespace inviwo
@@ -0,0 +1,66 @@
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/tensorvisbase/algorithm/tensorfieldanisotropy.h>
+#include <inviwo/core/datastructures/volume/volumeram.h>
+#include <inviwo/core/util/exception.h>
+
+#include "tensorfieldtestutil.h"
+
+namespace inviwo {
+namespace {
+// 2x2x2 field of diagonal tensors where the tensor at index i is (1 + i) * diag(3, 2, 1)
+std::shared_ptr<TensorField3D> makeField() {
+    return tensorfieldtest::makeField(size3_t(2), TensorStorageMode::Full,
+                                      dmat3(3.0, 0.0, 0.0, 0.0, 2.0, 0.0, 0.0, 0.0, 1.0));
+}
+
+const glm::f32 *data(const Volume &volume) {
+    return static_cast<const glm::f32 *>(volume.getRepresentation<VolumeRAM>()->getData());
+}
+}  // namespace
+
+TEST(TensorUtilTests, anisotropySingleMeasure) {
+    const auto field = makeField();
+    const auto volume = tensorutil::computeAnisotropy(
+        *field, {tensorutil::Anisotropy::abs_lamda1_minus_lamda3}, 1);
+
+    EXPECT_EQ(1u, volume->getDataFormat()->getComponents());
+    for (size_t i = 0; i < 8; ++i) {
+        EXPECT_FLOAT_EQ(2.0f * (1.0f + static_cast<float>(i)), data(*volume)[i]);
+    }
+    EXPECT_EQ(dvec2(2.0, 16.0), volume->dataMap_.dataRange);
+}
+
+TEST(TensorUtilTests, anisotropyCombinedMeasures) {
+    const auto field = makeField();
+    const std::vector<tensorutil::Anisotropy> measures{
+        tensorutil::Anisotropy::barycentric, tensorutil::Anisotropy::abs_lamda1_minus_lamda2};
+    const auto volume = tensorutil::computeAnisotropy(*field, measures, 1);
+
+    ASSERT_EQ(4u, volume->getDataFormat()->getComponents());
+    for (size_t i = 0; i < 8; ++i) {
+        const auto voxel = data(*volume) + 4 * i;
+        // Barycentric coordinates of (3, 2, 1) are (1/6, 2/6, 3/6) regardless of the scale
+        EXPECT_FLOAT_EQ(1.0f / 6.0f, voxel[0]);
+        EXPECT_FLOAT_EQ(2.0f / 6.0f, voxel[1]);
+        EXPECT_FLOAT_EQ(3.0f / 6.0f, voxel[2]);
+        EXPECT_FLOAT_EQ(1.0f + static_cast<float>(i), voxel[3]);
+    }
+    EXPECT_DOUBLE_EQ(1.0 / 6.0, volume->dataMap_.dataRange.x);
+    EXPECT_DOUBLE_EQ(8.0, volume->dataMap_.dataRange.y);
+}
+
+TEST(TensorUtilTests, anisotropyTooManyChannels) {
+    const auto field = makeField();
+    EXPECT_THROW(tensorutil::computeAnisotropy(*field,
+                                               {tensorutil::Anisotropy::barycentric,
+                                                tensorutil::Anisotropy::barycentric},
+                                               1),
+                 Exception);
+    EXPECT_THROW(tensorutil::computeAnisotropy(*field, {}, 1), Exception);
+}
+
+}  // namespace inviwo
@@ -0,0 +1,135 @@
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/tensorvisbase/algorithm/tensorfieldresampling.h>
+#include <inviwo/core/util/exception.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace inviwo {
+namespace {
+tensorutil::ResamplingSettings serialSettings(tensorutil::ResamplingFilter filter) {
+    tensorutil::ResamplingSettings settings;
+    settings.filter = filter;
+    settings.jobs = 1;
+    return settings;
+}
+
+// Field along x where the tensor at voxel x is values[x] * I
+std::shared_ptr<TensorField3D> makeLine(const std::vector<double>& values) {
+    std::vector<dmat3> tensors;
+    for (const auto v : values) tensors.push_back(dmat3(v));
+    return std::make_shared<TensorField3D>(size3_t(values.size(), 1, 1), std::move(tensors));
+}
+}  // namespace
+
+TEST(TensorUtilTests, resampleIdentity) {
+    std::vector<dmat3> tensors;
+    for (size_t i = 0; i < 27; ++i) tensors.push_back(dmat3(static_cast<double>(i)));
+    auto field = std::make_shared<TensorField3D>(size3_t(3), tensors);
+
+    const auto res = tensorutil::resample(field, size3_t(3),
+                                          serialSettings(tensorutil::ResamplingFilter::Box));
+    EXPECT_EQ(tensors, res->tensors().toMatrices());
+}
+
+TEST(TensorUtilTests, resampleUpsampleLinear) {
+    const auto res = tensorutil::resample(makeLine({1.0, 3.0}), size3_t(3, 1, 1),
+                                          serialSettings(tensorutil::ResamplingFilter::Box));
+    const std::vector<dmat3> expected{dmat3(1.0), dmat3(2.0), dmat3(3.0)};
+    EXPECT_EQ(expected, res->tensors().toMatrices());
+}
+
+TEST(TensorUtilTests, resampleBoxFilter) {
+    const auto field = makeLine({0.0, 1.0, 2.0, 3.0});
+
+    // Every output voxel averages the two source voxels it covers
+    const auto box = tensorutil::resample(field, size3_t(2, 1, 1),
+                                          serialSettings(tensorutil::ResamplingFilter::Box));
+    EXPECT_DOUBLE_EQ(0.5, box->tensors()[0][0][0]);
+    EXPECT_DOUBLE_EQ(2.5, box->tensors()[1][0][0]);
+
+    // Without filter the field is point sampled
+    const auto none = tensorutil::resample(field, size3_t(2, 1, 1),
+                                           serialSettings(tensorutil::ResamplingFilter::None));
+    EXPECT_DOUBLE_EQ(0.0, none->tensors()[0][0][0]);
+    EXPECT_DOUBLE_EQ(3.0, none->tensors()[1][0][0]);
+}
+
+TEST(TensorUtilTests, resampleGaussianKeepsConstantFields) {
+    std::vector<dmat3> tensors(8 * 8 * 8, dmat3(2.0, 1.0, 0.0, 1.0, 3.0, 0.0, 0.0, 0.0, 1.0));
+    auto field = std::make_shared<TensorField3D>(size3_t(8), tensors);
+
+    const auto res = tensorutil::resample(field, size3_t(3),
+                                          serialSettings(tensorutil::ResamplingFilter::Gaussian));
+    for (const auto& tensor : res->tensors()) {
+        for (glm::length_t i = 0; i < 3; ++i) {
+            for (glm::length_t j = 0; j < 3; ++j) {
+                EXPECT_NEAR(tensors.front()[i][j], tensor[i][j], 1.0e-12);
+            }
+        }
+    }
+}
+
+TEST(TensorUtilTests, resampleLogEuclidean) {
+    const auto field = makeLine({std::exp(0.0), std::exp(2.0), std::exp(4.0)});
+
+    auto settings = serialSettings(tensorutil::ResamplingFilter::Box);
+    const auto euclidean = tensorutil::resample(field, size3_t(1), settings);
+    EXPECT_NEAR((1.0 + std::exp(2.0) + std::exp(4.0)) / 3.0, euclidean->tensors()[0][0][0],
+                1.0e-9);
+
+    // The log-Euclidean mean of isotropic tensors is their geometric mean
+    settings.space = tensorutil::ResamplingSpace::LogEuclidean;
+    const auto logEuclidean = tensorutil::resample(field, size3_t(1), settings);
+    EXPECT_NEAR(std::exp(2.0), logEuclidean->tensors()[0][0][0], 1.0e-9);
+    EXPECT_NEAR(0.0, logEuclidean->tensors()[0][1][0], 1.0e-9);
+
+    EXPECT_THROW(tensorutil::resample(makeLine({1.0, -1.0}), size3_t(1), settings), Exception);
+}
+
+TEST(TensorUtilTests, resampleMask) {
+    auto field = makeLine({1.0, 5.0, 9.0});
+    field->setMask({1, 1, 0});
+
+    const auto res = tensorutil::resample(field, size3_t(5, 1, 1),
+                                          serialSettings(tensorutil::ResamplingFilter::Box));
+    ASSERT_TRUE(res->hasMask());
+    const std::vector<glm::uint8> expectedMask{1, 1, 1, 1, 0};
+    EXPECT_EQ(expectedMask, res->getMask());
+    EXPECT_DOUBLE_EQ(3.0, res->tensors()[1][0][0]);
+    // Only the defined neighbour contributes
+    EXPECT_DOUBLE_EQ(5.0, res->tensors()[3][0][0]);
+    EXPECT_EQ(dmat3(0.0), res->tensors()[4]);
+}
+
+TEST(TensorUtilTests, resampleProgressPerBrick) {
+    auto field = std::make_shared<TensorField3D>(size3_t(8), std::vector<dmat3>(512, dmat3(1.0)));
+
+    auto settings = serialSettings(tensorutil::ResamplingFilter::Box);
+    settings.brickSize = 4;
+    std::vector<float> progress;
+    settings.progress = [&](float p) { progress.push_back(p); };
+
+    tensorutil::resample(field, size3_t(8), settings);
+    ASSERT_EQ(8u, progress.size());
+    EXPECT_FLOAT_EQ(1.0f, progress.back());
+    EXPECT_TRUE(std::is_sorted(progress.begin(), progress.end()));
+}
+
+TEST(TensorUtilTests, resample2D) {
+    std::vector<dmat2> tensors;
+    for (size_t i = 0; i < 16; ++i) tensors.push_back(dmat2(static_cast<double>(i % 4)));
+    auto field = std::make_shared<TensorField2D>(size2_t(4), tensors);
+
+    const auto res = tensorutil::resample(field, size2_t(2),
+                                          serialSettings(tensorutil::ResamplingFilter::Box));
+    ASSERT_EQ(size2_t(2), res->getDimensions());
+    EXPECT_DOUBLE_EQ(0.5, res->at(size2_t(0, 0))[0][0]);
+    EXPECT_DOUBLE_EQ(2.5, res->at(size2_t(1, 1))[0][0]);
+}
+
+}  // namespace inviwo
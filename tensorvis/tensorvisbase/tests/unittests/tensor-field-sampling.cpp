@@ -0,0 +1,103 @@
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/tensorvisbase/algorithm/tensorfieldsampling.h>
+
+#include "tensorfieldtestutil.h"
+
+namespace inviwo {
+using tensorfieldtest::makeField;
+
+namespace {
+constexpr auto linear = tensorutil::InterpolationMethod::Linear;
+constexpr auto nearest = tensorutil::InterpolationMethod::Nearest;
+
+// The tensor at voxel (x, y, z) of the 2x2x2 test field is (1 + x + 2y + 4z) * I
+const size3_t dims(2);
+}  // namespace
+
+TEST(TensorUtilTests, samplerTrilinear) {
+    const TensorField3DSampler sampler(makeField(dims));
+
+    EXPECT_EQ(dmat3(1.0), sampler.sample<linear>(dvec3(0.0)).second);
+    EXPECT_EQ(dmat3(8.0), sampler.sample<linear>(dvec3(1.0)).second);
+
+    const auto center = sampler.sample<linear>(dvec3(0.5));
+    EXPECT_EQ(1, center.first);
+    EXPECT_DOUBLE_EQ(4.5, center.second[0][0]);
+    EXPECT_DOUBLE_EQ(0.0, center.second[1][0]);
+
+    const auto x = sampler.sample<linear>(dvec3(0.25, 0.0, 0.0));
+    EXPECT_DOUBLE_EQ(1.25, x.second[0][0]);
+
+    // Positions outside the field are clamped to the border
+    EXPECT_EQ(dmat3(8.0), sampler.sample<linear>(dvec3(2.0)).second);
+    EXPECT_EQ(dmat3(1.0), sampler.sample<linear>(dvec3(-1.0)).second);
+}
+
+TEST(TensorUtilTests, samplerNearest) {
+    const TensorField3DSampler sampler(makeField(dims));
+
+    EXPECT_EQ(dmat3(2.0), sampler.sample<nearest>(dvec3(0.9, 0.1, 0.2)).second);
+    EXPECT_EQ(dmat3(7.0), sampler.sample<nearest>(dvec3(0.0, 0.6, 1.0)).second);
+}
+
+TEST(TensorUtilTests, samplerRuntimeDispatchMatchesTemplate) {
+    auto field = makeField(dims);
+    const dvec3 position(0.3, 0.6, 0.8);
+
+    const auto expected = TensorField3DSampler(field).sample<linear>(position).second;
+    EXPECT_NE(dmat3(0.0), expected);
+    EXPECT_EQ(expected, sample(field, position, linear).second);
+    EXPECT_EQ(expected, sample<linear>(field, position).second);
+}
+
+TEST(TensorUtilTests, samplerSymmetricStorage) {
+    const TensorField3DSampler full(makeField(dims));
+    const TensorField3DSampler symmetric(makeField(dims, TensorStorageMode::Symmetric));
+
+    const dvec3 position(0.3, 0.6, 0.8);
+    EXPECT_EQ(full.sample(position, linear),
+              symmetric.sample(position, linear));
+}
+
+TEST(TensorUtilTests, samplerMask) {
+    auto field = makeField(dims);
+    // Only voxels with x == 0 are defined
+    field->setMask({1, 0, 1, 0, 1, 0, 1, 0});
+    const TensorField3DSampler sampler(field);
+
+    // Masked voxels do not contribute, the weights of the others are renormalized
+    const auto center = sampler.sample<linear>(dvec3(0.5));
+    EXPECT_EQ(1, center.first);
+    EXPECT_DOUBLE_EQ(4.0, center.second[0][0]);
+
+    const auto outside = sampler.sample<linear>(dvec3(1.0));
+    EXPECT_EQ(0, outside.first);
+    EXPECT_EQ(dmat3(0.0), outside.second);
+
+    EXPECT_EQ(0, sampler.sample<nearest>(dvec3(0.9)).first);
+    EXPECT_EQ(1, sampler.sample<nearest>(dvec3(0.1)).first);
+}
+
+TEST(TensorUtilTests, samplerBatch) {
+    auto field = makeField(dims);
+    field->setMask({1, 0, 1, 0, 1, 0, 1, 0});
+    const TensorField3DSampler sampler(field);
+
+    const std::vector<dvec3> positions{dvec3(0.0), dvec3(0.5), dvec3(1.0), dvec3(0.2, 0.7, 0.4)};
+    std::vector<dmat3> tensors(positions.size());
+    std::vector<glm::uint8> mask(positions.size());
+    sampler.sample(positions.data(), positions.size(), tensors.data(), mask.data(), linear);
+
+    for (size_t i = 0; i < positions.size(); ++i) {
+        const auto expected = sampler.sample(positions[i], linear);
+        EXPECT_EQ(expected.first, mask[i]);
+        EXPECT_EQ(expected.second, tensors[i]);
+    }
+    EXPECT_EQ(tensors, sampler.sample(positions, linear));
+}
+
+}  // namespace inviwo
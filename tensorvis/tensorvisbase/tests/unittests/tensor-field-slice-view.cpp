@@ -0,0 +1,120 @@
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/tensorvisbase/datastructures/tensorfieldsliceview.h>
+#include <inviwo/tensorvisbase/datastructures/tensorfieldmetadataspecializations.h>
+#include <inviwo/core/util/exception.h>
+
+#include "tensorfieldtestutil.h"
+
+namespace inviwo {
+using tensorfieldtest::makeField;
+
+namespace {
+// The tensor at voxel index i of the 3x4x5 test field is (1 + i) * I
+const size3_t fieldDims(3, 4, 5);
+
+constexpr CartesianCoordinateAxis axes[] = {CartesianCoordinateAxis::X, CartesianCoordinateAxis::Y,
+                                            CartesianCoordinateAxis::Z};
+
+size3_t toVoxel(const CartesianCoordinateAxis axis, const size_t slice, const size2_t &pos) {
+    switch (axis) {
+        case CartesianCoordinateAxis::X:
+            return size3_t(slice, pos.x, pos.y);
+        case CartesianCoordinateAxis::Y:
+            return size3_t(pos.x, slice, pos.y);
+        case CartesianCoordinateAxis::Z:
+        default:
+            return size3_t(pos.x, pos.y, slice);
+    }
+}
+}  // namespace
+
+TEST(TensorUtilTests, sliceViewIndexing) {
+    auto field = makeField(fieldDims);
+
+    for (const auto axis : axes) {
+        const TensorFieldSliceView view(field, axis, 2);
+        const auto dims = view.getDimensions();
+        EXPECT_EQ(field->getSize() / field->getDimensions()[static_cast<int>(axis)],
+                  view.getSize());
+
+        for (size_t v = 0; v < dims.y; ++v) {
+            for (size_t u = 0; u < dims.x; ++u) {
+                const auto voxel = toVoxel(axis, 2, size2_t(u, v));
+                EXPECT_EQ(field->at(voxel).second, view.at(size2_t(u, v)).second);
+                EXPECT_EQ(field->indexMapper()(voxel), view.parentIndex(size2_t(u, v)));
+            }
+        }
+    }
+}
+
+TEST(TensorUtilTests, sliceViewOutOfBounds) {
+    auto field = makeField(fieldDims);
+    EXPECT_THROW(TensorFieldSliceView(field, CartesianCoordinateAxis::X, 3), Exception);
+    EXPECT_THROW(TensorFieldSliceView(field, CartesianCoordinateAxis::Z, 5), Exception);
+    EXPECT_NO_THROW(TensorFieldSliceView(field, CartesianCoordinateAxis::Z, 4));
+}
+
+TEST(TensorUtilTests, sliceViewMaterialize) {
+    for (const auto mode : {TensorStorageMode::Full, TensorStorageMode::SymmetricFloat}) {
+        // Compare through const handles, reads must work for every storage mode
+        const std::shared_ptr<const TensorField3D> field = makeField(fieldDims, mode);
+
+        for (const auto axis : axes) {
+            const TensorFieldSliceView view(field, axis, 1);
+            const std::shared_ptr<const TensorField3D> slice3D = view.materialize3D();
+            const auto slice2D = view.materialize2D();
+
+            EXPECT_EQ(mode, slice3D->getStorageMode());
+            EXPECT_EQ(view.getSize(), slice3D->getSize());
+            EXPECT_EQ(view.getDimensions(), slice2D->getDimensions());
+
+            for (size_t i = 0; i < view.getSize(); ++i) {
+                EXPECT_EQ(field->at(view.parentIndex(i)).second, slice3D->at(i).second);
+            }
+        }
+    }
+}
+
+TEST(TensorUtilTests, sliceViewSharesContiguousSlices) {
+    auto field = makeField(fieldDims);
+
+    const auto slice = TensorFieldSliceView(field, CartesianCoordinateAxis::Z, 3).materialize3D();
+    EXPECT_TRUE(slice->tensors().isShared());
+    EXPECT_EQ(field->tensors().data() + 3 * 12, slice->tensors().data());
+
+    const auto copy = TensorFieldSliceView(field, CartesianCoordinateAxis::X, 1).materialize3D();
+    EXPECT_FALSE(copy->tensors().isShared());
+}
+
+TEST(TensorUtilTests, sliceViewKeepsMaskAndMetaData) {
+    auto field = makeField(fieldDims);
+
+    std::vector<glm::uint8> mask(field->getSize());
+    std::vector<double> norms(field->getSize());
+    for (size_t i = 0; i < mask.size(); ++i) {
+        mask[i] = static_cast<glm::uint8>(i % 2);
+        norms[i] = static_cast<double>(i);
+    }
+    field->setMask(mask);
+    field->addMetaData<FrobeniusNorm>(norms, TensorFeature::FrobeniusNorm);
+
+    const TensorFieldSliceView view(field, CartesianCoordinateAxis::Y, 2);
+    const auto slice = view.materialize3D();
+
+    ASSERT_TRUE(slice->hasMask());
+    ASSERT_TRUE(slice->hasMetaData<FrobeniusNorm>());
+    const auto &sliceNorms = slice->getMetaData<FrobeniusNorm>();
+    const auto dims = view.getDimensions();
+    for (size_t i = 0; i < view.getSize(); ++i) {
+        const auto parent = view.parentIndex(i);
+        EXPECT_EQ(mask[parent], slice->getMask()[i]);
+        EXPECT_EQ(norms[parent], sliceNorms[i]);
+        EXPECT_EQ(norms[parent], view.getMetaData<FrobeniusNorm>(size2_t(i % dims.x, i / dims.x)));
+    }
+}
+
+}  // namespace inviwo
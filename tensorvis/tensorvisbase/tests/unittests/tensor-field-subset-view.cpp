@@ -0,0 +1,104 @@
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/tensorvisbase/datastructures/tensorfieldsubsetview.h>
+#include <inviwo/tensorvisbase/datastructures/tensorfieldmetadataspecializations.h>
+#include <inviwo/core/util/exception.h>
+
+#include "tensorfieldtestutil.h"
+
+namespace inviwo {
+using tensorfieldtest::makeField;
+
+namespace {
+// The tensor at voxel index i of the 4x5x6 test field is (1 + i) * I
+const size3_t fieldDims(4, 5, 6);
+}  // namespace
+
+TEST(TensorUtilTests, subsetViewIndexing) {
+    auto field = makeField(fieldDims);
+    const TensorFieldSubsetView view(field, size3_t(1, 2, 3), size3_t(2, 3, 2));
+
+    EXPECT_EQ(12u, view.getSize());
+    for (size_t z = 0; z < 2; ++z) {
+        for (size_t y = 0; y < 3; ++y) {
+            for (size_t x = 0; x < 2; ++x) {
+                const size3_t pos(x, y, z);
+                EXPECT_EQ(field->at(pos + size3_t(1, 2, 3)).second, view.at(pos).second);
+            }
+        }
+    }
+    EXPECT_EQ(view.parentIndex(size3_t(1, 2, 1)), view.parentIndex(size_t{11}));
+}
+
+TEST(TensorUtilTests, subsetViewOutOfBounds) {
+    auto field = makeField(fieldDims);
+    EXPECT_THROW(TensorFieldSubsetView(field, size3_t(3, 0, 0), size3_t(2, 1, 1)), Exception);
+    EXPECT_THROW(TensorFieldSubsetView(field, size3_t(0), size3_t(0, 1, 1)), Exception);
+    EXPECT_NO_THROW(TensorFieldSubsetView(field, size3_t(0), size3_t(4, 5, 6)));
+}
+
+TEST(TensorUtilTests, subsetViewRows) {
+    auto field = makeField(fieldDims);
+
+    const TensorFieldSubsetView rows(field, size3_t(1, 1, 1), size3_t(2, 2, 2));
+    EXPECT_EQ(2u, rows.getRowLength());
+    EXPECT_EQ(4u, rows.getRowStarts().size());
+
+    const TensorFieldSubsetView planes(field, size3_t(0, 1, 1), size3_t(4, 2, 3));
+    EXPECT_EQ(8u, planes.getRowLength());
+    EXPECT_EQ(3u, planes.getRowStarts().size());
+
+    const TensorFieldSubsetView block(field, size3_t(0, 0, 2), size3_t(4, 5, 3));
+    EXPECT_EQ(60u, block.getRowLength());
+    EXPECT_EQ(std::vector<size_t>{40}, block.getRowStarts());
+}
+
+TEST(TensorUtilTests, subsetViewMaterialize) {
+    for (const auto mode : {TensorStorageMode::Full, TensorStorageMode::Symmetric}) {
+        auto field = makeField(fieldDims, mode);
+
+        std::vector<glm::uint8> mask(field->getSize());
+        std::vector<double> norms(field->getSize());
+        for (size_t i = 0; i < mask.size(); ++i) {
+            mask[i] = static_cast<glm::uint8>(i % 3 == 0);
+            norms[i] = static_cast<double>(i);
+        }
+        field->setMask(mask);
+        field->addMetaData<FrobeniusNorm>(norms, TensorFeature::FrobeniusNorm);
+
+        const TensorFieldSubsetView view(field, size3_t(1, 0, 2), size3_t(3, 4, 2));
+        // Compare through const handles, reads must work for every storage mode
+        const std::shared_ptr<const TensorField3D> parent = field;
+        const std::shared_ptr<const TensorField3D> subset = view.materialize(1);
+
+        EXPECT_EQ(view.getDimensions(), subset->getDimensions());
+        EXPECT_EQ(mode, subset->getStorageMode());
+        for (glm::length_t i = 0; i < 3; ++i) {
+            EXPECT_NEAR(parent->getSpacing<double>()[i], subset->getSpacing<double>()[i], 1e-6);
+        }
+        ASSERT_TRUE(subset->hasMask());
+        ASSERT_TRUE(subset->hasMetaData<FrobeniusNorm>());
+
+        const auto &subsetNorms = subset->getMetaData<FrobeniusNorm>();
+        for (size_t i = 0; i < view.getSize(); ++i) {
+            const auto index = view.parentIndex(i);
+            EXPECT_EQ(parent->at(index).second, subset->at(i).second);
+            EXPECT_EQ(mask[index], subset->getMask()[i]);
+            EXPECT_EQ(norms[index], subsetNorms[i]);
+        }
+    }
+}
+
+TEST(TensorUtilTests, subsetViewSharesContiguousBlocks) {
+    auto field = makeField(fieldDims);
+
+    const TensorFieldSubsetView view(field, size3_t(0, 0, 1), size3_t(4, 5, 2));
+    const auto block = view.materialize(1);
+    EXPECT_TRUE(block->tensors().isShared());
+    EXPECT_EQ(field->tensors().data() + 20, block->tensors().data());
+}
+
+}  // namespace inviwo
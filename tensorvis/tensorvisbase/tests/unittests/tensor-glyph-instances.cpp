@@ -0,0 +1,77 @@
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/tensorvisbase/properties/tensorglyphproperty.h>
+
+namespace inviwo {
+namespace {
+void setGlyphType(TensorGlyphProperty& property, TensorGlyphType type) {
+    auto glyphType = dynamic_cast<TemplateOptionProperty<TensorGlyphType>*>(
+        property.getPropertyByIdentifier("glyphType"));
+    ASSERT_NE(nullptr, glyphType);
+    glyphType->setSelectedValue(type);
+}
+
+std::array<std::pair<double, dvec3>, 3> diagonalEigenSystem(const dvec3& eigenValues) {
+    return {{{eigenValues.x, dvec3(1.0, 0.0, 0.0)},
+             {eigenValues.y, dvec3(0.0, 1.0, 0.0)},
+             {eigenValues.z, dvec3(0.0, 0.0, 1.0)}}};
+}
+}  // namespace
+
+TEST(TensorUtilTests, glyphInstanceQuadricIsNormalized) {
+    TensorGlyphProperty property;
+    setGlyphType(property, TensorGlyphType::Quadric);
+
+    const dvec3 eigenValues(2.0, 1.0, 0.5);
+    const auto instance =
+        property.generateInstance(glm::diagonal3x3(eigenValues), diagonalEigenSystem(eigenValues),
+                                  1.0, vec3(1.0f, 2.0f, 3.0f));
+
+    EXPECT_EQ(mat3(glm::diagonal3x3(vec3(1.0f, 0.5f, 0.25f))), instance.frame);
+    EXPECT_EQ(vec3(1.0f, 2.0f, 3.0f), instance.position);
+    EXPECT_EQ(property.color(), instance.color);
+}
+
+TEST(TensorUtilTests, glyphInstanceReynoldsNormalization) {
+    TensorGlyphProperty property;
+    setGlyphType(property, TensorGlyphType::Reynolds);
+
+    const dvec3 eigenValues(3.0, 1.0, -1.0);
+    const auto tensor = glm::diagonal3x3(eigenValues);
+    const auto instance =
+        property.generateInstance(tensor, diagonalEigenSystem(eigenValues), 1.0, vec3(0.0f));
+
+    EXPECT_EQ(mat3(tensor), instance.frame);
+    EXPECT_FLOAT_EQ(1.0f / 3.0f, instance.shape.x);
+    EXPECT_FLOAT_EQ(0.5f, instance.shape.y);
+}
+
+TEST(TensorUtilTests, glyphInstanceSuperquadricLinearTensor) {
+    TensorGlyphProperty property;
+    setGlyphType(property, TensorGlyphType::Superquadric);
+
+    const dvec3 eigenValues(1.0, 0.0, 0.0);
+    const auto instance = property.generateInstance(
+        glm::diagonal3x3(eigenValues), diagonalEigenSystem(eigenValues), 1.0, vec3(0.0f));
+
+    // A linear tensor is a cylinder along the major eigenvector
+    EXPECT_NEAR(1.0f, instance.shape.x, 1.0e-4f);
+    EXPECT_NEAR(0.0f, instance.shape.y, 1.0e-4f);
+    EXPECT_EQ(0.0f, instance.shape.w);
+    EXPECT_NEAR(1.0f, glm::length(instance.frame[0]), 1.0e-5f);
+    EXPECT_NEAR(0.0f, glm::length(instance.frame[1]), 1.0e-4f);
+    EXPECT_GE(glm::dot(glm::cross(instance.frame[0], instance.frame[1]), instance.frame[2]), 0.0f);
+}
+
+TEST(TensorUtilTests, glyphInstanceTypeSupport) {
+    TensorGlyphProperty property;
+    EXPECT_TRUE(property.supportsInstancing());
+
+    setGlyphType(property, TensorGlyphType::Cube);
+    EXPECT_FALSE(property.supportsInstancing());
+}
+
+}  // namespace inviwo
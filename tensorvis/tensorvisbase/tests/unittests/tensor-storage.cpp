@@ -0,0 +1,133 @@
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/tensorvisbase/datastructures/tensorstorage.h>
+#include <inviwo/tensorvisbase/datastructures/tensorfield3d.h>
+
+namespace inviwo {
+TEST(TensorUtilTests, symmetricStorageRoundTrip) {
+    const dmat3 tensor(1.0, 4.0, 6.0, 4.0, 2.0, 5.0, 6.0, 5.0, 3.0);
+    std::vector<dmat3> tensors{tensor, 2.0 * tensor};
+
+    TensorStorage3D full(tensors);
+    TensorStorage3D symmetric(tensors, TensorStorageMode::Symmetric);
+    TensorStorage3D symmetricFloat(tensors, TensorStorageMode::SymmetricFloat);
+
+    EXPECT_EQ(2u, symmetric.size());
+    EXPECT_EQ(nullptr, symmetric.data());
+    EXPECT_NE(nullptr, full.data());
+
+    for (size_t i = 0; i < tensors.size(); ++i) {
+        EXPECT_EQ(tensors[i], full[i]);
+        EXPECT_EQ(tensors[i], symmetric[i]);
+        EXPECT_EQ(tensors[i], symmetricFloat[i]);
+    }
+
+    EXPECT_EQ(tensors, symmetricFloat.convert(TensorStorageMode::Full).toMatrices());
+}
+
+TEST(TensorUtilTests, symmetricStorageSize) {
+    std::vector<dmat3> tensors(10, dmat3(1.0));
+
+    EXPECT_EQ(10 * 9 * sizeof(double), TensorStorage3D(tensors).getSizeInBytes());
+    EXPECT_EQ(10 * 6 * sizeof(double),
+              TensorStorage3D(tensors, TensorStorageMode::Symmetric).getSizeInBytes());
+    EXPECT_EQ(10 * 6 * sizeof(float),
+              TensorStorage3D(tensors, TensorStorageMode::SymmetricFloat).getSizeInBytes());
+}
+
+TEST(TensorUtilTests, symmetricStorageDropsAntiSymmetricPart) {
+    const dmat3 tensor(1.0, 2.0, 0.0, 4.0, 1.0, 0.0, 0.0, 0.0, 1.0);
+    TensorStorage3D symmetric(std::vector<dmat3>{tensor}, TensorStorageMode::Symmetric);
+
+    EXPECT_EQ(3.0, symmetric[0][1][0]);
+    EXPECT_EQ(3.0, symmetric[0][0][1]);
+}
+
+TEST(TensorUtilTests, storageCopiesAreCopyOnWrite) {
+    TensorStorage3D original(std::vector<dmat3>(4, dmat3(1.0)), TensorStorageMode::Symmetric);
+    auto copy = original;
+
+    EXPECT_TRUE(original.isShared());
+    EXPECT_EQ(original.symmetricTensors(), copy.symmetricTensors());
+
+    copy.set(0, dmat3(2.0));
+
+    EXPECT_FALSE(original.isShared());
+    EXPECT_EQ(dmat3(1.0), original[0]);
+    EXPECT_EQ(dmat3(2.0), copy[0]);
+}
+
+TEST(TensorUtilTests, storageAdoptsExternalMemory) {
+    std::vector<dmat3> external(3, dmat3(1.0));
+    std::shared_ptr<const dmat3> adopted(external.data(), [](const dmat3 *) {});
+
+    TensorStorage3D storage(adopted, external.size());
+
+    EXPECT_EQ(3u, storage.size());
+    EXPECT_TRUE(storage.isShared());
+    EXPECT_EQ(external.data(), static_cast<const TensorStorage3D &>(storage).data());
+
+    // Writing detaches, the external memory is left untouched
+    storage.set(0, dmat3(2.0));
+    EXPECT_FALSE(storage.isShared());
+    EXPECT_EQ(dmat3(1.0), external[0]);
+    EXPECT_EQ(dmat3(2.0), storage[0]);
+}
+
+TEST(TensorUtilTests, fieldReadsDoNotModifyStorage) {
+    std::vector<dmat3> tensors;
+    for (size_t i = 0; i < 4; ++i) tensors.push_back(dmat3(1.0 + static_cast<double>(i)));
+
+    for (const auto mode : {TensorStorageMode::Full, TensorStorageMode::Symmetric,
+                            TensorStorageMode::SymmetricFloat}) {
+        const auto original =
+            std::make_shared<TensorField3D>(size3_t(2, 2, 1), TensorStorage3D(tensors, mode));
+        // Reads through a non-const field must neither throw nor detach the shared tensors
+        std::shared_ptr<TensorField3D> field(original->clone());
+        ASSERT_TRUE(field->tensors().isShared());
+
+        for (size_t i = 0; i < tensors.size(); ++i) {
+            EXPECT_EQ(tensors[i], field->at(i).second);
+            EXPECT_EQ(tensors[i], field->at(size3_t(i % 2, i / 2, 0)).second);
+        }
+        EXPECT_TRUE(field->tensors().isShared());
+        EXPECT_EQ(mode, field->getStorageMode());
+    }
+}
+
+TEST(TensorUtilTests, fieldEigenDecompositionIsImmutable) {
+    const std::vector<dmat3> tensors(4, dmat3(3.0, 0.0, 0.0, 0.0, 2.0, 0.0, 0.0, 0.0, 1.0));
+    TensorField3D field(size3_t(2, 2, 1), TensorStorage3D(tensors));
+
+    const auto &major = field.majorEigenValues();
+    const auto majorData = major.data();
+    EXPECT_THROW(field.addMetaData(std::make_unique<MajorEigenValues>(
+                     std::vector<double>(4, 0.0), TensorFeature::Sigma1)),
+                 Exception);
+    EXPECT_THROW(field.removeMetaData<MajorEigenValues>(), Exception);
+
+    EXPECT_EQ(majorData, field.majorEigenValues().data());
+    EXPECT_NEAR(3.0, field.getMajorEigenValue<double>(0), 1e-12);
+    EXPECT_NEAR(3.0, major[3], 1e-12);
+}
+
+TEST(TensorUtilTests, storageFromStridedData) {
+    // Two tensors with one padding value each
+    const std::vector<float> data{1, 4, 6, 4, 2, 5, 6, 5, 3, -1, 2, 0, 0, 0, 2, 0, 0, 0, 2, -1};
+    const dmat3 first(1.0, 4.0, 6.0, 4.0, 2.0, 5.0, 6.0, 5.0, 3.0);
+
+    const auto full = TensorStorage3D::fromStrided(data.data(), 2, 10);
+    EXPECT_EQ(first, full[0]);
+    EXPECT_EQ(dmat3(2.0), full[1]);
+
+    const auto symmetric =
+        TensorStorage3D::fromStrided(data.data(), 2, 10, TensorStorageMode::SymmetricFloat);
+    EXPECT_EQ(TensorStorageMode::SymmetricFloat, symmetric.getMode());
+    EXPECT_EQ(first, symmetric[0]);
+    EXPECT_EQ(dmat3(2.0), symmetric[1]);
+}
+
+}  // namespace inviwo
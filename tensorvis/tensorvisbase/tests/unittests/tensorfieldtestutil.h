@@ -0,0 +1,38 @@
+#pragma once
+
+#include <inviwo/tensorvisbase/datastructures/tensorfield2d.h>
+#include <inviwo/tensorvisbase/datastructures/tensorfield3d.h>
+
+#include <memory>
+#include <vector>
+
+namespace inviwo {
+
+namespace tensorfieldtest {
+
+/*
+ * Field where the tensor at voxel index i is (1 + i) * tensor, so every voxel can be told apart.
+ */
+inline std::shared_ptr<TensorField3D> makeField(const size3_t &dimensions,
+                                                TensorStorageMode mode = TensorStorageMode::Full,
+                                                const dmat3 &tensor = dmat3(1.0)) {
+    std::vector<dmat3> tensors;
+    tensors.reserve(dimensions.x * dimensions.y * dimensions.z);
+    for (size_t i = 0; i < dimensions.x * dimensions.y * dimensions.z; ++i) {
+        tensors.push_back((1.0 + static_cast<double>(i)) * tensor);
+    }
+    return std::make_shared<TensorField3D>(dimensions,
+                                           TensorStorage3D(std::move(tensors), mode));
+}
+
+/*
+ * Field where every tensor is tensor.
+ */
+inline std::shared_ptr<TensorField2D> makeField(const size2_t &dimensions, const dmat2 &tensor) {
+    return std::make_shared<TensorField2D>(
+        dimensions, std::vector<dmat2>(dimensions.x * dimensions.y, tensor));
+}
+
+}  // namespace tensorfieldtest
+
+}  // namespace inviwo
@@ -56,8 +56,8 @@ namespace inviwo {
 
 /**
  * \class NRRDReader
- * \brief VERY_BRIEFLY_DESCRIBE_THE_PROCESSOR
- * DESCRIBE_THE_PROCESSOR_FROM_A_DEVELOPER_PERSPECTIVE
+ * \brief Reads a 3D tensor field from a NRRD file, see nrrd::readTensors.
+ * The confidence of masked tensor kinds is also output as a volume.
  */
 class IVW_MODULE_TENSORVISIO_API NRRDReader : public Processor {
 public:
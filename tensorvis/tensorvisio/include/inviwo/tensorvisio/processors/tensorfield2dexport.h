@@ -34,11 +34,15 @@
 #include <inviwo/core/common/inviwo.h>
 #include <inviwo/tensorvisbase/ports/tensorfieldport.h>
 #include <inviwo/core/processors/processor.h>
+#include <inviwo/core/processors/progressbarowner.h>
 #include <inviwo/core/properties/compositeproperty.h>
 #include <inviwo/core/properties/fileproperty.h>
 #include <inviwo/core/properties/buttonproperty.h>
 #include <inviwo/core/properties/boolproperty.h>
 
+#include <memory>
+#include <functional>
+
 namespace inviwo {
 
 /** \docpage{org.inviwo.TensorField2DExport, Tensor Field2DExport}
@@ -61,7 +65,7 @@ namespace inviwo {
  * \brief VERY_BRIEFLY_DESCRIBE_THE_PROCESSOR
  * DESCRIBE_THE_PROCESSOR_FROM_A_DEVELOPER_PERSPECTIVE
  */
-class IVW_MODULE_TENSORVISIO_API TensorField2DExport : public Processor {
+class IVW_MODULE_TENSORVISIO_API TensorField2DExport : public Processor, public ProgressBarOwner {
 public:
     TensorField2DExport();
     virtual ~TensorField2DExport() = default;
@@ -79,7 +83,18 @@ private:
     ButtonProperty exportButton_;
     BoolProperty includeEigenInfo_;
 
-    void exportBinary() const;
+    /*
+     * Writes the field on the thread pool, reporting the progress in the progress bar.
+     */
+    void exportBinary();
+
+    static void writeBinary(const TensorField2D &tensorField, const std::string &filePath,
+                            bool includeEigenInfo, const std::function<void(float)> &progress);
+
+    // Only accessed on the front thread
+    bool isExporting_{false};
+    // Expires with the processor, export tasks check it before touching the processor
+    std::shared_ptr<int> lifetime_ = std::make_shared<int>(0);
 };
 }  // namespace inviwo
 
@@ -34,10 +34,14 @@
 #include <inviwo/core/common/inviwo.h>
 #include <inviwo/tensorvisbase/ports/tensorfieldport.h>
 #include <inviwo/core/processors/processor.h>
+#include <inviwo/core/processors/progressbarowner.h>
 #include <inviwo/core/properties/compositeproperty.h>
 #include <inviwo/core/properties/fileproperty.h>
 #include <inviwo/core/properties/buttonproperty.h>
 #include <inviwo/core/properties/boolproperty.h>
+#include <inviwo/core/properties/ordinalproperty.h>
+
+#include <memory>
 
 namespace inviwo {
 
@@ -54,6 +58,11 @@ namespace inviwo {
  * ### Properties
  *   * __<Prop1>__ <description>.
  *   * __<Prop2>__ <description>
+ *   * __Brick size__ Edge length of the bricks the field is split into. Smaller bricks allow
+ *     loading small regions faster, a brick size covering the whole field allows using the
+ *     tensors directly from the memory mapped file.
+ *   * __Compress__ Losslessly compress each brick using deflate with byte shuffling.
+ *   * __Store as float__ Store tensors and metadata in single precision, halving the file size.
  */
 
 /**
@@ -61,7 +70,7 @@ namespace inviwo {
  * \brief <brief description>
  * <Detailed description from a developer prespective>
  */
-class IVW_MODULE_TENSORVISIO_API TensorField3DExport : public Processor {
+class IVW_MODULE_TENSORVISIO_API TensorField3DExport : public Processor, public ProgressBarOwner {
 public:
     TensorField3DExport();
     virtual ~TensorField3DExport() = default;
@@ -78,8 +87,19 @@ private:
     FileProperty exportFile_;
     ButtonProperty exportButton_;
     BoolProperty includeMetaData_;
+    IntProperty brickSize_;
+    BoolProperty compress_;
+    BoolProperty floatPrecision_;
+
+    /*
+     * Writes the field on the thread pool, reporting the progress in the progress bar.
+     */
+    void exportBinary();
 
-    void exportBinary() const;
+    // Only accessed on the front thread
+    bool isExporting_{false};
+    // Expires with the processor, export tasks check it before touching the processor
+    std::shared_ptr<int> lifetime_ = std::make_shared<int>(0);
 };
 
 }  // namespace inviwo
@@ -35,6 +35,7 @@
 #include <inviwo/core/properties/boolproperty.h>
 #include <inviwo/core/properties/fileproperty.h>
 #include <inviwo/core/properties/ordinalproperty.h>
+#include <inviwo/core/properties/optionproperty.h>
 #include <inviwo/tensorvisbase/ports/tensorfieldport.h>
 #include <inviwo/tensorvisio/tensorvisiomoduledefine.h>
 
@@ -53,6 +54,10 @@ namespace inviwo {
  * ### Properties
  *   * __<Prop1>__ <description>.
  *   * __<Prop2>__ <description>
+ *   * __Tensor storage__ Memory layout of the loaded tensors. The symmetric modes only keep the
+ *     6 unique components of each tensor.
+ *   * __Load region__ Only load the region given by __Region origin__ and __Region size__. For
+ *     chunked files only the bricks overlapping the region are read from disk.
  */
 
 /**
@@ -77,6 +82,10 @@ private:
     TensorField3DOutport outport_;
 
     BoolProperty normalizeExtents_;
+    TemplateOptionProperty<TensorStorageMode> storageMode_;
+    BoolProperty loadRegion_;
+    IntVec3Property regionOrigin_;
+    IntVec3Property regionSize_;
 
     FloatVec3Property extents_;
 
@@ -85,8 +94,6 @@ private:
     std::shared_ptr<TensorField3D> tensorFieldOut_;
 
     dvec3 dextents_;
-
-    void buildTensors(const std::vector<double> &data, std::vector<dmat3> &tensors) const;
 };
 
 }  // namespace inviwo
@@ -0,0 +1,129 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/tensorvisio/tensorvisiomoduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/util/formats.h>
+
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace inviwo {
+
+namespace nrrd {
+
+enum class Endian { Little, Big };
+enum class Encoding { Raw, Gzip };
+
+/*
+ * The tensor kinds of the NRRD specification that can be read as a TensorField3D. The masked
+ * kinds store a confidence value in front of the tensor components.
+ */
+enum class TensorKind { SymmetricMatrix, MaskedSymmetricMatrix, Matrix, MaskedMatrix };
+
+/*
+ * The fields of a NRRD header (.nhdr or the header of an attached .nrrd file) that are needed to
+ * locate and interpret the data. Per-axis fields have one entry per axis, axes without a space
+ * direction (e.g. the tensor axis) have no value.
+ */
+struct Header {
+    std::string filePath;
+    size_t dimension = 0;
+    std::vector<size_t> sizes;
+    std::vector<std::string> kinds;
+    std::vector<double> spacings;
+    std::vector<std::optional<dvec3>> spaceDirections;
+    std::optional<dvec3> spaceOrigin;
+    // Columns are the basis vectors of the frame the tensor components are given in
+    std::optional<dmat3> measurementFrame;
+
+    const DataFormatBase *format = nullptr;
+    Endian endian = Endian::Little;
+    Encoding encoding = Encoding::Raw;
+
+    // Absolute paths of the data files, the header file itself for attached data
+    std::vector<std::string> dataFiles;
+    // Offset of the data in an attached .nrrd file, i.e. the first byte after the header
+    size_t dataOffset = 0;
+    size_t lineSkip = 0;
+    // -1 means that the data is located at the end of the file
+    std::ptrdiff_t byteSkip = 0;
+
+    // key:=value pairs
+    std::map<std::string, std::string> keyValues;
+
+    // Throw a DataReaderException if the sizes overflow
+    size_t getNumberOfElements() const;
+    size_t getSizeInBytes() const;
+};
+
+/*
+ * Parses the header of a detached (.nhdr) or attached (.nrrd) NRRD file. Data file names are
+ * resolved relative to the header. Throws a DataReaderException for malformed or unsupported
+ * headers.
+ */
+IVW_MODULE_TENSORVISIO_API Header readHeader(const std::string &filePath);
+
+/*
+ * Reads the data described by the header in native byte order. Every data file is read (and
+ * inflated) in one go and the byte order is fixed in a single pass over the whole buffer.
+ */
+IVW_MODULE_TENSORVISIO_API std::vector<unsigned char> readData(const Header &header);
+
+/*
+ * Swaps the byte order of count consecutive scalars of elementSize bytes in place.
+ */
+IVW_MODULE_TENSORVISIO_API void swapBytes(void *data, size_t count, size_t elementSize);
+
+struct TensorVolume {
+    size3_t dimensions{0};
+    TensorKind kind = TensorKind::SymmetricMatrix;
+    std::vector<dmat3> tensors;
+    // Confidence of each tensor, all ones for the kinds without a mask
+    std::vector<float> confidence;
+    // Full extent of the volume, columns are the axes
+    dmat3 basis{1.0};
+    dvec3 offset{0.0};
+};
+
+/*
+ * Reads a 4D NRRD holding one tensor per sample of a 3D grid. The tensor axis is found through
+ * its kind and may be any of the four axes, if no axis has a tensor kind the first axis is used
+ * and the kind is deduced from its size (6, 7, 9 or 10 components). Tensors are transformed by
+ * the measurement frame if there is one. Tensors with a confidence below 1 are set to zero.
+ */
+IVW_MODULE_TENSORVISIO_API TensorVolume readTensors(const std::string &filePath);
+
+}  // namespace nrrd
+
+}  // namespace inviwo
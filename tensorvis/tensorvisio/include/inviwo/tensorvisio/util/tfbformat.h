@@ -0,0 +1,205 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/tensorvisio/tensorvisiomoduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/util/constexprhash.h>
+#include <inviwo/tensorvisbase/datastructures/tensorfield3d.h>
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace inviwo {
+
+namespace tfb {
+
+/*
+ * Layout of a chunked TFB file (TFB_CURRENT_VERSION). The file starts with the same preamble as
+ * the stream format, i.e. the length prefixed string "TFBVersion:" followed by the version, then
+ *
+ *   FileHeader
+ *   StreamInfo[numStreams]
+ *   ChunkInfo[numStreams * numBricks]   (the chunk index, grouped by stream)
+ *   chunks, each starting at a multiple of chunkAlignment
+ *
+ * The field is split into bricks of brickSize elements, smaller at the upper borders, ordered x
+ * fastest. Each stream (the tensors, the mask and every metadata entry) stores one chunk per
+ * brick holding the elements of the brick in x fastest order. Tensors are stored as 9 scalars in
+ * column-major order, i.e. a dmat3 for ScalarType::Float64. All values are stored in native
+ * (little-endian) byte order.
+ *
+ * Chunks are either stored raw or deflate compressed. Before compression the bytes of the scalars
+ * can be shuffled, i.e. all first bytes of the scalars are stored first, then all second bytes
+ * and so on, which makes floating point data considerably more compressible.
+ */
+constexpr size_t streamVersion = 5;
+constexpr size_t chunkAlignment = 4096;
+
+constexpr uint64_t tensorStreamId = util::constexpr_hash("TFB.Tensors");
+constexpr uint64_t maskStreamId = util::constexpr_hash("TFB.Mask");
+
+enum class ScalarType : uint32_t { Float64 = 0, UInt8 = 1, Float32 = 2 };
+enum class Encoding : uint32_t { Raw = 0, Deflate = 1 };
+enum class Filter : uint32_t { None = 0, ByteShuffle = 1 };
+
+struct FileHeader {
+    uint64_t dimensions[3];
+    uint64_t brickSize[3];
+    double extents[3];
+    double offset[3];
+    double eigenValueRanges[3][2];
+    double eigenVectorRanges[3][2];
+    uint64_t numStreams;
+};
+
+struct StreamInfo {
+    uint64_t id;       // tensorStreamId, maskStreamId or the id of the metadata
+    uint64_t feature;  // TensorFeature of metadata streams
+    uint32_t numberOfComponents;
+    ScalarType scalarType;
+};
+
+struct ChunkInfo {
+    uint64_t offset;  // from the start of the file
+    uint64_t size;    // in bytes as stored in the file
+    Encoding encoding;
+    Filter filter;
+};
+
+static_assert(sizeof(FileHeader) == 200, "Unexpected padding in tfb::FileHeader");
+static_assert(sizeof(StreamInfo) == 24, "Unexpected padding in tfb::StreamInfo");
+static_assert(sizeof(ChunkInfo) == 24, "Unexpected padding in tfb::ChunkInfo");
+
+struct WriteSettings {
+    size3_t brickSize{64};
+    // Without metadata only eigenvalues and eigenvectors are written
+    bool includeMetaData = true;
+    // Deflate compress each chunk, chunks that do not get smaller are stored raw
+    bool compress = false;
+    // Shuffle the bytes of the scalars before compressing
+    bool shuffle = true;
+    // Store tensors and metadata as float instead of double
+    bool floatPrecision = false;
+    // Called with the fraction of chunks written so far
+    std::function<void(float)> progress;
+};
+
+/*
+ * Writes the tensor field in the chunked format. Chunks are written in bulk on a background thread
+ * while the next chunk is being encoded. The file is written next to the target and replaces it
+ * when complete, so fields that are still memory mapped from the target stay valid. On Windows
+ * the old file is left next to the target with a .old suffix if it is still mapped.
+ * Throws a FileException on failure.
+ */
+IVW_MODULE_TENSORVISIO_API void write(const TensorField3D &tensorField, const std::string &filePath,
+                                      const WriteSettings &settings = WriteSettings{});
+
+/*
+ * Returns a default constructed metadata container for the given id, nullptr if the id is unknown.
+ */
+IVW_MODULE_TENSORVISIO_API std::unique_ptr<MetaDataBase> createMetaData(uint64_t id);
+
+}  // namespace tfb
+
+/**
+ * \class TFBFile
+ * \brief Reader for 3D tensor field binary (tfb) files.
+ * Opening a file only reads its header and chunk index, the tensors and metadata are memory mapped
+ * and only the bricks that are needed are read when calling read(). Files in the old stream format
+ * (tfb::streamVersion) are read into memory completely but can be accessed in the same way.
+ */
+class IVW_MODULE_TENSORVISIO_API TFBFile {
+public:
+    /*
+     * Opens the file and reads its header, throws if the file is not a valid 3D tfb file.
+     */
+    explicit TFBFile(const std::string &filePath);
+
+    size_t getVersion() const { return version_; }
+    bool isChunked() const { return version_ != tfb::streamVersion; }
+    size3_t getDimensions() const;
+    size3_t getBrickSize() const;
+    bool hasMask() const;
+    std::vector<uint64_t> getMetaDataIds() const;
+
+    /*
+     * Reads the whole tensor field. For TensorStorageMode::Full and files consisting of a single
+     * brick of raw double tensors, the tensors are used directly from the mapped file without
+     * copying them.
+     */
+    std::shared_ptr<TensorField3D> read(TensorStorageMode mode = TensorStorageMode::Full) const;
+
+    /*
+     * Reads the region of the given size starting at origin, only touching the bricks that overlap
+     * the region. The bricks are decoded in parallel on the thread pool. The extents and offset
+     * of the result are adjusted to the position of the region.
+     */
+    std::shared_ptr<TensorField3D> read(const size3_t &origin, const size3_t &size,
+                                        TensorStorageMode mode = TensorStorageMode::Full) const;
+
+private:
+    void readStreamFormat(std::istream &in);
+    void readChunkedFormat(size_t headerOffset);
+
+    size_t findStream(uint64_t id) const;
+    size_t getElementSize(const tfb::StreamInfo &stream) const;
+    size_t getNumberOfBricks() const;
+    const unsigned char *getChunk(size_t stream, size_t brick) const;
+
+    /*
+     * Returns the decoded data of the chunk, which is either the mapped data itself for raw
+     * chunks or the decompressed data in buffer.
+     */
+    const unsigned char *decodeChunk(size_t stream, size_t brick,
+                                     std::vector<unsigned char> &buffer) const;
+
+    /*
+     * Copies the elements of the region from all bricks overlapping it into dst, which has to hold
+     * compMul(size) elements of the stream.
+     */
+    void gather(size_t stream, const size3_t &origin, const size3_t &size, void *dst) const;
+
+    std::string filePath_;
+    size_t version_ = 0;
+    tfb::FileHeader header_{};
+    std::vector<tfb::StreamInfo> streams_;
+    std::vector<tfb::ChunkInfo> chunks_;
+
+    // The memory mapped file or the data of a stream format file, chunk offsets are relative to it
+    std::shared_ptr<const void> memory_;
+    const unsigned char *data_ = nullptr;
+    size_t size_ = 0;
+};
+
+}  // namespace inviwo
@@ -1,5 +1,6 @@
 #include <inviwo/tensorvisio/processors/flowguifilereader.h>
 #include <inviwo/core/datastructures/volume/volumeram.h>
+#include <inviwo/tensorvisbase/util/datareductions.h>
 
 namespace inviwo {
 
@@ -113,13 +114,9 @@ void FlowGUIFileReader::process() {
 
             inFile.read(reinterpret_cast<char*>(volumeData), sizeof(float) * numElements);
 
-            auto min = std::numeric_limits<float>::max();
-            auto max = std::numeric_limits<float>::lowest();
-
-            for (int j = 0; j < numElements; j++) {
-                min = std::min(min, volumeData[j]);
-                max = std::max(max, volumeData[j]);
-            }
+            const auto range =
+                tensorutil::computeStatistics(volumeData, static_cast<size_t>(numElements))
+                    .range();
 
             volume->setOffset(minBounds);
             auto basis = mat3(1);
@@ -129,8 +126,8 @@ void FlowGUIFileReader::process() {
             basis[2][2] = extents.z;
             volume->setBasis(basis);
 
-            volume->dataMap_.valueRange = vec2(min, max);
-            volume->dataMap_.dataRange = vec2(min, max);
+            volume->dataMap_.valueRange = range;
+            volume->dataMap_.dataRange = range;
         }
 
         outport_.setData(volumes);
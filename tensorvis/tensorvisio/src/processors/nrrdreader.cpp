@@ -30,7 +30,9 @@
 #include <inviwo/tensorvisio/processors/nrrdreader.h>
 #include <inviwo/core/datastructures/volume/volume.h>
 #include <inviwo/core/datastructures/volume/volumeram.h>
-#include <inviwo/core/util/filesystem.h>
+#include <inviwo/tensorvisio/util/nrrdformat.h>
+
+#include <algorithm>
 
 namespace inviwo {
 
@@ -52,166 +54,48 @@ NRRDReader::NRRDReader()
     addPort(outport3D_);
     addPort(volumeOutport_);
     addProperty(inFile_);
+
+    inFile_.clearNameFilters();
+    inFile_.addNameFilter("NRRD header (*.nhdr)");
+    inFile_.addNameFilter("NRRD (*.nrrd)");
 }
 
 void NRRDReader::process() {
-    std::ifstream inFile(inFile_.get());
-
-    if (!inFile) {
-        LogError("Couldn't open file");
-        return;
-    }
-
-    auto extension = filesystem::getFileExtension(inFile_.get());
-    if (extension != "nhdr") {
-        LogError("Not a NHDR file");
+    nrrd::TensorVolume data;
+    try {
+        data = nrrd::readTensors(inFile_.get());
+    } catch (const Exception &e) {
+        LogError(e.getMessage());
         return;
     }
 
-    std::map<std::string, std::string> values;
-
-    // Get first line
-    std::string version;
-    std::getline(inFile, version);
-
-    std::string line;
-    while (std::getline(inFile, line)) {
-        std::istringstream iss(line);
-        std::string component;
-        std::string value;
-
-        std::getline(iss, component, ':');
-        std::getline(iss, value, ':');
-
-        if (component[0] == '#') continue;
-
-        value.erase(0, 1);
-
-        value.erase(std::remove(value.begin(), value.end(), '"'), value.end());
+    const auto basis = mat3(data.basis);
+    const auto offset = vec3(data.offset);
 
-        values.insert(std::pair<std::string, std::string>(component, value));
-    }
-
-    size3_t dimensions{0};
-    std::string rawFileName;
-    {
-        auto it = values.find("sizes");
-        if (it != values.end()) {
-            auto dimensionString = (*it).second;
-            std::istringstream iss(dimensionString);
-
-            std::string numberOfItemsPerTensorString;
-            std::getline(iss, numberOfItemsPerTensorString, ' ');
-
-            std::string dimXString;
-            std::getline(iss, dimXString, ' ');
-            dimensions.x = std::stoull(dimXString);
-
-            std::string dimYString;
-            std::getline(iss, dimYString, ' ');
-            dimensions.y = std::stoull(dimYString);
-
-            std::string dimZString;
-            std::getline(iss, dimZString, ' ');
-            dimensions.z = std::stoull(dimZString);
-        }
-    }
-
-    {
-        auto it = values.find("data file");
-        if (it != values.end()) {
-            auto path = filesystem::getFileDirectory(inFile_.get());
-            rawFileName = path + '/' + (*it).second;
-        }
-    }
-
-    if (!filesystem::fileExists(rawFileName)) {
-        LogError("Raw file does not exist");
-        return;
-    }
-    std::ifstream rawFile(rawFileName, std::ios::in | std::ios::binary);
-
-    if (!rawFile) {
-        LogError("Couldn't open raw file");
-        return;
-    }
-
-    auto numberOfTensors = dimensions.x * dimensions.y * dimensions.z;
-
-    std::vector<dmat3> dataForTensorField;
-
-    dataForTensorField.resize(numberOfTensors);
-
-    util::IndexMapper3D indexMapper(dimensions);
-
-    auto vol = std::make_shared<Volume>(dimensions, DataFloat32::get());
+    auto vol = std::make_shared<Volume>(data.dimensions, DataFloat32::get());
     auto volRam = vol->getEditableRepresentation<VolumeRAM>();
-    auto volRamData = static_cast<float*>(volRam->getData());
-
-    auto toLittleEndian = [](const float val) -> float {
-        float read = val;
-        float write;
-        auto r_ptr = reinterpret_cast<char*>(&read);
-        auto w_ptr = reinterpret_cast<char*>(&write);
-        w_ptr[0] = r_ptr[3];
-        w_ptr[1] = r_ptr[2];
-        w_ptr[2] = r_ptr[1];
-        w_ptr[3] = r_ptr[0];
-        return write;
-    };
-
-    for (size_t z = 0; z < dimensions.z; z++) {
-        for (size_t y = 0; y < dimensions.y; y++) {
-            for (size_t x = 0; x < dimensions.x; x++) {
-                auto index = indexMapper(size3_t(x, y, z));
-                float confidence;
-                float xx;
-                float yy;
-                float zz;
-                float xy;
-                float xz;
-                float yz;
+    std::copy(data.confidence.begin(), data.confidence.end(),
+              static_cast<float *>(volRam->getData()));
 
-                rawFile.read(reinterpret_cast<char*>(&confidence), sizeof(float));
-
-                rawFile.read(reinterpret_cast<char*>(&xx), sizeof(float));
-                rawFile.read(reinterpret_cast<char*>(&xy), sizeof(float));
-                rawFile.read(reinterpret_cast<char*>(&xz), sizeof(float));
-
-                rawFile.read(reinterpret_cast<char*>(&yy), sizeof(float));
-                rawFile.read(reinterpret_cast<char*>(&yz), sizeof(float));
-                rawFile.read(reinterpret_cast<char*>(&zz), sizeof(float));
-
-                confidence = toLittleEndian(confidence);
-                xx = toLittleEndian(xx);
-                yy = toLittleEndian(yy);
-                zz = toLittleEndian(zz);
-                xy = toLittleEndian(xy);
-                xz = toLittleEndian(xz);
-                yz = toLittleEndian(yz);
-
-                double weight = 0.;
-                if (confidence == 1.) {
-                    weight = 1.;
-                }
-
-                dvec3 col1(xx, xy, xz);
-                dvec3 col2(xy, yy, yz);
-                dvec3 col3(xz, yz, zz);
-
-                dataForTensorField[index] = dmat3(col1, col2, col3) * weight;
-                volRamData[index] = confidence;
-            }
-        }
-    }
-
-    vol->setBasis(mat3(1.f));
-    vol->setOffset(vec3(0.f));
+    vol->setBasis(basis);
+    vol->setOffset(offset);
     vol->dataMap_.dataRange = vec2(0, 1);
     vol->dataMap_.valueRange = vec2(0, 1);
     volumeOutport_.setData(vol);
 
-    outport3D_.setData(std::make_shared<TensorField3D>(dimensions, dataForTensorField));
+    auto tensorField = std::make_shared<TensorField3D>(data.dimensions, std::move(data.tensors));
+    tensorField->setBasis(basis);
+    tensorField->setOffset(offset);
+
+    if (data.kind == nrrd::TensorKind::MaskedSymmetricMatrix ||
+        data.kind == nrrd::TensorKind::MaskedMatrix) {
+        std::vector<glm::uint8> mask(data.confidence.size());
+        std::transform(data.confidence.begin(), data.confidence.end(), mask.begin(),
+                       [](const float confidence) { return confidence < 1.0f ? 0 : 1; });
+        tensorField->setMask(mask);
+    }
+
+    outport3D_.setData(tensorField);
 }
 
 }  // namespace inviwo
@@ -28,6 +28,9 @@
  *********************************************************************************/
 
 #include <inviwo/tensorvisio/processors/tensorfield2dexport.h>
+#include <inviwo/core/common/inviwoapplication.h>
+
+#include <fstream>
 
 namespace inviwo {
 
@@ -66,18 +69,66 @@ TensorField2DExport::TensorField2DExport()
 
 void TensorField2DExport::process() {}
 
-void TensorField2DExport::exportBinary() const {
+void TensorField2DExport::exportBinary() {
     if (!inport_.hasData() || !inport_.getData().get()) {
         LogWarn("Inport has no data");
         return;
     }
+    if (isExporting_) {
+        LogWarn("Export already in progress");
+        return;
+    }
 
     LogInfo("Exporting...");
 
-    auto tensorField = inport_.getData();
+    isExporting_ = true;
+    progressBar_.show();
+    progressBar_.updateProgress(0.0f);
+
+    // The task may outlive the processor. It only touches the processor on the front thread, and
+    // only while the processor is still alive.
+    const auto onFront = [this, alive = std::weak_ptr<int>(lifetime_)](
+                             std::function<void(TensorField2DExport &)> func) {
+        dispatchFront([this, alive, func]() {
+            if (alive.lock()) func(*this);
+        });
+    };
+
+    dispatchPool([onFront, tensorField = inport_.getData(), filePath = exportFile_.get(),
+                  includeEigenInfo = includeEigenInfo_.get()]() {
+        const auto onProgress = [onFront](float progress) {
+            onFront([progress](TensorField2DExport &p) {
+                p.progressBar_.updateProgress(progress);
+            });
+        };
+
+        try {
+            writeBinary(*tensorField, filePath, includeEigenInfo, onProgress);
+            LogInfoCustom("TensorField2DExport", "Exporting done.");
+        } catch (const Exception &e) {
+            LogErrorCustom("TensorField2DExport", e.getMessage());
+        } catch (const std::exception &e) {
+            LogErrorCustom("TensorField2DExport", "Exporting failed: " << e.what());
+        } catch (...) {
+            LogErrorCustom("TensorField2DExport", "Exporting failed");
+        }
+
+        onFront([](TensorField2DExport &p) {
+            p.progressBar_.hide();
+            p.isExporting_ = false;
+        });
+    });
+}
 
+void TensorField2DExport::writeBinary(const TensorField2D &tensorField, const std::string &filePath,
+                                      const bool includeEigenInfo,
+                                      const std::function<void(float)> &progress) {
     std::ofstream outFile;
-    outFile.open(exportFile_.get(), std::ios::out | std::ios::binary);
+    outFile.open(filePath, std::ios::out | std::ios::binary);
+    if (!outFile) {
+        throw Exception("Could not open \"" + filePath + "\" for writing",
+                        IVW_CONTEXT_CUSTOM("TensorField2DExport"));
+    }
 
     std::string versionStr("TFBVersion:");
     size_t size = versionStr.size();
@@ -87,50 +138,50 @@ void TensorField2DExport::exportBinary() const {
     size_t version = 2;
     outFile.write(reinterpret_cast<const char *>(&version), sizeof(size_t));
 
-    size_t dimensionality = tensorField->dimensionality();
+    size_t dimensionality = tensorField.dimensionality();
     outFile.write(reinterpret_cast<const char *>(&dimensionality), sizeof(size_t));
 
-    size_t rank = tensorField->rank();
+    size_t rank = tensorField.rank();
     outFile.write(reinterpret_cast<const char *>(&rank), sizeof(size_t));
 
-    bool hasEigenInfo = includeEigenInfo_.get();
+    bool hasEigenInfo = includeEigenInfo;
     outFile.write(reinterpret_cast<const char *>(&hasEigenInfo), sizeof(bool));
 
-    auto dimensions = tensorField->getDimensions();
+    auto dimensions = tensorField.getDimensions();
     outFile.write(reinterpret_cast<const char *>(&dimensions), sizeof(size_t) * 2);
 
-    auto extents = tensorField->getExtents();
+    auto extents = tensorField.getExtents();
     outFile.write(reinterpret_cast<const char *>(&extents), sizeof(double) * 2);
 
-    const auto &data = tensorField->tensors();
-
-    for (const auto &val : data) {
-        // Diagonal
-        outFile.write(reinterpret_cast<const char *>(&val[0][0]), sizeof(double));
-        outFile.write(reinterpret_cast<const char *>(&val[1][1]), sizeof(double));
-
-        // Symmetric part
-        outFile.write(reinterpret_cast<const char *>(&val[1][0]), sizeof(double));
+    // Gather the unique components (xx, yy, xy) of all tensors and write them at once
+    const auto &data = tensorField.tensors();
+    std::vector<double> components(data.size() * 3);
+    for (size_t i = 0; i < data.size(); ++i) {
+        components[3 * i + 0] = data[i][0][0];
+        components[3 * i + 1] = data[i][1][1];
+        components[3 * i + 2] = data[i][1][0];
     }
-
-    if (includeEigenInfo_.get()) {
-        // Create tensor field here so eigen properties get calculated
-        auto majorEigenValues = tensorField->majorEigenValues().data();
-        auto minorEigenValues = tensorField->minorEigenValues().data();
-
-        auto majorEigenVectors = tensorField->majorEigenVectors().data();
-        auto minorEigenVectors = tensorField->minorEigenVectors().data();
-
-        auto numItems = tensorField->getSize();
-
-        outFile.write(reinterpret_cast<const char *>(majorEigenValues), sizeof(double) * numItems);
-
-        outFile.write(reinterpret_cast<const char *>(minorEigenValues), sizeof(double) * numItems);
-
-        outFile.write(reinterpret_cast<const char *>(majorEigenVectors),
+    outFile.write(reinterpret_cast<const char *>(components.data()),
+                  sizeof(double) * components.size());
+    progress(includeEigenInfo ? 0.2f : 0.9f);
+
+    if (includeEigenInfo) {
+        // Accessing the eigen data computes it if necessary
+        const auto &majorEigenValues = tensorField.majorEigenValues();
+        const auto &minorEigenValues = tensorField.minorEigenValues();
+        const auto &majorEigenVectors = tensorField.majorEigenVectors();
+        const auto &minorEigenVectors = tensorField.minorEigenVectors();
+        progress(0.6f);
+
+        const auto numItems = tensorField.getSize();
+
+        outFile.write(reinterpret_cast<const char *>(majorEigenValues.data()),
+                      sizeof(double) * numItems);
+        outFile.write(reinterpret_cast<const char *>(minorEigenValues.data()),
+                      sizeof(double) * numItems);
+        outFile.write(reinterpret_cast<const char *>(majorEigenVectors.data()),
                       sizeof(double) * numItems * 2);
-
-        outFile.write(reinterpret_cast<const char *>(minorEigenVectors),
+        outFile.write(reinterpret_cast<const char *>(minorEigenVectors.data()),
                       sizeof(double) * numItems * 2);
     }
 
@@ -140,8 +191,11 @@ void TensorField2DExport::exportBinary() const {
     outFile.write(&str[0], size);
 
     outFile.close();
-
-    LogInfo("Exporting done.");
+    if (!outFile) {
+        throw Exception("Failed writing \"" + filePath + "\"",
+                        IVW_CONTEXT_CUSTOM("TensorField2DExport"));
+    }
+    progress(1.0f);
 }
 
 }  // namespace inviwo
@@ -28,8 +28,11 @@
  *********************************************************************************/
 
 #include <inviwo/tensorvisio/processors/tensorfield3dexport.h>
+#include <inviwo/core/common/inviwoapplication.h>
 #include <inviwo/tensorvisbase/ports/tensorfieldport.h>
-#include <inviwo/tensorvisbase/datastructures/tensorfieldmetadata.h>
+#include <inviwo/tensorvisio/util/tfbformat.h>
+
+#include <functional>
 
 namespace inviwo {
 
@@ -49,10 +52,16 @@ TensorField3DExport::TensorField3DExport()
     , export_("export", "Export")
     , exportFile_("exportFile", "Export to", "")
     , exportButton_("exportButton", "Export")
-    , includeMetaData_("includeMetaData", "Include meta data", true) {
+    , includeMetaData_("includeMetaData", "Include meta data", true)
+    , brickSize_("brickSize", "Brick size", 64, 1, 1024)
+    , compress_("compress", "Compress", false)
+    , floatPrecision_("floatPrecision", "Store as float", false) {
     export_.addProperty(exportFile_);
     export_.addProperty(exportButton_);
     export_.addProperty(includeMetaData_);
+    export_.addProperty(brickSize_);
+    export_.addProperty(compress_);
+    export_.addProperty(floatPrecision_);
     addProperty(export_);
 
     exportFile_.setFileMode(FileMode::AnyFile);
@@ -69,134 +78,60 @@ TensorField3DExport::TensorField3DExport()
 
 void TensorField3DExport::process() {}
 
-void TensorField3DExport::exportBinary() const {
+void TensorField3DExport::exportBinary() {
     if (!inport_.hasData() || !inport_.getData().get()) {
         LogWarn("Inport has no data");
         return;
     }
-
-    LogInfo("Exporting...");
-
-    auto tensorField = inport_.getData();
-
-    std::ofstream outFile;
-    outFile.open(exportFile_.get(), std::ios::out | std::ios::binary);
-
-    std::string versionStr("TFBVersion:");
-    size_t size = versionStr.size();
-    outFile.write(reinterpret_cast<const char *>(&size), sizeof(size_t));
-    outFile.write(&versionStr[0], size);
-
-    size_t version = TFB_CURRENT_VERSION;
-    outFile.write(reinterpret_cast<const char *>(&version), sizeof(size_t));
-
-    size_t dimensionality = tensorField->dimensionality();
-    outFile.write(reinterpret_cast<const char *>(&dimensionality), sizeof(size_t));
-
-    size_t rank = tensorField->rank();
-    outFile.write(reinterpret_cast<const char *>(&rank), sizeof(size_t));
-
-    auto hasMetaData = glm::uint8(includeMetaData_.get());
-    outFile.write(reinterpret_cast<const char *>(&hasMetaData), sizeof(glm::uint8));
-
-    auto dimensions = tensorField->getDimensions();
-    outFile.write(reinterpret_cast<const char *>(&dimensions), sizeof(size_t) * 3);
-
-    auto extents = tensorField->getExtents();
-    outFile.write(reinterpret_cast<const char *>(&extents), sizeof(double) * 3);
-
-    auto offset = tensorField->getOffset();
-    outFile.write(reinterpret_cast<const char *>(&offset), sizeof(double) * 3);
-
-    auto &eigenValueDataMaps = tensorField->dataMapEigenValues_;
-    outFile.write(reinterpret_cast<const char *>(&eigenValueDataMaps[0].dataRange),
-                  sizeof(double) * 2);
-    outFile.write(reinterpret_cast<const char *>(&eigenValueDataMaps[1].dataRange),
-                  sizeof(double) * 2);
-    outFile.write(reinterpret_cast<const char *>(&eigenValueDataMaps[2].dataRange),
-                  sizeof(double) * 2);
-
-    auto &eigenVectorDataMaps = tensorField->dataMapEigenVectors_;
-    outFile.write(reinterpret_cast<const char *>(&eigenVectorDataMaps[0].dataRange),
-                  sizeof(double) * 2);
-    outFile.write(reinterpret_cast<const char *>(&eigenVectorDataMaps[1].dataRange),
-                  sizeof(double) * 2);
-    outFile.write(reinterpret_cast<const char *>(&eigenVectorDataMaps[2].dataRange),
-                  sizeof(double) * 2);
-
-    const auto &data = tensorField->tensors();
-
-    for (const auto &val : data) {
-        // Upper row
-        outFile.write(reinterpret_cast<const char *>(&val[0][0]), sizeof(double));
-        outFile.write(reinterpret_cast<const char *>(&val[1][0]), sizeof(double));
-        outFile.write(reinterpret_cast<const char *>(&val[2][0]), sizeof(double));
-
-        // Middle row
-        outFile.write(reinterpret_cast<const char *>(&val[0][1]), sizeof(double));
-        outFile.write(reinterpret_cast<const char *>(&val[1][1]), sizeof(double));
-        outFile.write(reinterpret_cast<const char *>(&val[2][1]), sizeof(double));
-
-        // Bottom row
-        outFile.write(reinterpret_cast<const char *>(&val[0][2]), sizeof(double));
-        outFile.write(reinterpret_cast<const char *>(&val[1][2]), sizeof(double));
-        outFile.write(reinterpret_cast<const char *>(&val[2][2]), sizeof(double));
-    }
-
-    auto hasMask = glm::uint8(tensorField->hasMask());
-    outFile.write(reinterpret_cast<char *>(&hasMask), sizeof(glm::uint8));
-
-    if (hasMask) {
-        auto &mask = tensorField->getMask();
-        auto maskData = mask.data();
-        outFile.write(reinterpret_cast<const char *>(maskData), sizeof(glm::uint8) * mask.size());
+    if (isExporting_) {
+        LogWarn("Export already in progress");
+        return;
     }
 
-    if (includeMetaData_.get()) {
-        const auto numMetaDataEntries = tensorField->metaData().size();
-        outFile.write(reinterpret_cast<const char *>(&numMetaDataEntries), sizeof(size_t));
+    LogInfo("Exporting...");
 
-        for (const auto &dataItem : tensorField->metaData()) {
-            dataItem.second->serialize(outFile);
-        }
-    }
-    // We always include eigenvalues and eigenvectors
-    else {
-        for (const auto &dataItem : tensorField->metaData()) {
-            auto id = dataItem.first;
-
-            switch (id) {
-                case MajorEigenValues::id():
-                    dataItem.second->serialize(outFile);
-                    break;
-                case IntermediateEigenValues::id():
-                    dataItem.second->serialize(outFile);
-                    break;
-                case MinorEigenValues::id():
-                    dataItem.second->serialize(outFile);
-                    break;
-                case MajorEigenVectors::id():
-                    dataItem.second->serialize(outFile);
-                    break;
-                case IntermediateEigenVectors::id():
-                    dataItem.second->serialize(outFile);
-                    break;
-                case MinorEigenVectors::id():
-                    dataItem.second->serialize(outFile);
-                    break;
-                default:
-                    break;
-            }
+    tfb::WriteSettings settings;
+    settings.brickSize = size3_t(brickSize_.get());
+    settings.includeMetaData = includeMetaData_.get();
+    settings.compress = compress_.get();
+    settings.floatPrecision = floatPrecision_.get();
+
+    isExporting_ = true;
+    progressBar_.show();
+    progressBar_.updateProgress(0.0f);
+
+    // The task may outlive the processor. It only touches the processor on the front thread, and
+    // only while the processor is still alive.
+    const auto onFront = [this, alive = std::weak_ptr<int>(lifetime_)](
+                             std::function<void(TensorField3DExport &)> func) {
+        dispatchFront([this, alive, func]() {
+            if (alive.lock()) func(*this);
+        });
+    };
+
+    dispatchPool([onFront, tensorField = inport_.getData(), filePath = exportFile_.get(),
+                  settings]() mutable {
+        settings.progress = [onFront](float progress) {
+            onFront([progress](TensorField3DExport &p) {
+                p.progressBar_.updateProgress(progress);
+            });
+        };
+
+        try {
+            tfb::write(*tensorField, filePath, settings);
+            LogInfoCustom("TensorField3DExport", "Exporting done.");
+        } catch (const Exception &e) {
+            LogErrorCustom("TensorField3DExport", e.getMessage());
+        } catch (const std::exception &e) {
+            LogErrorCustom("TensorField3DExport", "Exporting failed: " << e.what());
+        } catch (...) {
+            LogErrorCustom("TensorField3DExport", "Exporting failed");
         }
-    }
-
-    std::string str("EOFreached");
-    size = str.size();
-    outFile.write(reinterpret_cast<const char *>(&size), sizeof(size_t));
-    outFile.write(&str[0], size);
-
-    outFile.close();
 
-    LogInfo("Exporting done.");
+        onFront([](TensorField3DExport &p) {
+            p.progressBar_.hide();
+            p.isExporting_ = false;
+        });
+    });
 }
 }  // namespace inviwo
\ No newline at end of file
@@ -41,6 +41,7 @@
 #include <vtkFloatArray.h>
 #include <vtkPointData.h>
 #include <vtkCellData.h>
+#include <vtkSmartPointer.h>
 #include <warn/pop>
 
 namespace inviwo {
@@ -155,8 +156,14 @@ void VTKDataSetToTensorField3D::generate() {
 
         std::shared_ptr<TensorField3D> tensorField;
         if (tensorArray->GetDataType() == VTK_DOUBLE) {
+            // The 9 doubles per tuple have the same layout as a dmat3, so the tensor field can
+            // use the array memory directly. The deleter only holds a reference to the array.
+            const auto tensors = reinterpret_cast<const dmat3*>(
+                vtkDoubleArray::SafeDownCast(tensorArray)->GetPointer(0));
+            vtkSmartPointer<vtkDataArray> array{tensorArray};
+            std::shared_ptr<const dmat3> adopted(tensors, [array](const dmat3*) {});
             tensorField = std::make_shared<TensorField3D>(
-                dimensions, vtkDoubleArray::SafeDownCast(tensorArray)->GetPointer(0), extent);
+                dimensions, TensorStorage3D(std::move(adopted), glm::compMul(dimensions)), extent);
             tensorField->setOffset(offset);
 
         } else if (tensorArray->GetDataType() == VTK_FLOAT) {
@@ -174,27 +181,20 @@ void VTKDataSetToTensorField3D::generate() {
             auto scalarArray = dataSet->GetPointData()->GetArray(scalars_.get().c_str());
             const auto size = scalarArray->GetNumberOfValues();
 
-            std::vector<double> scalars{};
-            scalars.resize(size);
-            auto scalarIterator = scalars.begin();
+            std::vector<double> scalars(size);
 
             if (scalarArray->GetDataType() == VTK_DOUBLE) {
                 const auto data = vtkDoubleArray::SafeDownCast(scalarArray)->GetPointer(0);
+                std::copy(data, data + size, scalars.begin());
 
-                for (int i = 0; i < size; ++i) {
-                    std::copy(data + i, data + (i + 1), scalarIterator++);
-                }
-
-                tensorField->addMetaData<HillYieldCriterion>(scalars,
-                                                             TensorFeature::HillYieldCriterion);
+                tensorField->addMetaData(std::make_unique<HillYieldCriterion>(
+                    std::move(scalars), TensorFeature::HillYieldCriterion));
             } else if (scalarArray->GetDataType() == VTK_FLOAT) {
                 const auto data = vtkFloatArray::SafeDownCast(scalarArray)->GetPointer(0);
+                std::copy(data, data + size, scalars.begin());
 
-                for (int i = 0; i < size; ++i) {
-                    std::copy(data + i, data + (i + 1), scalarIterator++);
-                }
-                tensorField->addMetaData<HillYieldCriterion>(scalars,
-                                                             TensorFeature::HillYieldCriterion);
+                tensorField->addMetaData(std::make_unique<HillYieldCriterion>(
+                    std::move(scalars), TensorFeature::HillYieldCriterion));
             } else {
                 LogProcessorError("Failed to generate meta data from array \""
                                   << std::string{scalarArray->GetName()}
@@ -0,0 +1,123 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/tensorvisio/util/memorymappedfile.h>
+#include <inviwo/core/util/exception.h>
+#include <inviwo/core/util/stringconversion.h>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace inviwo {
+
+#ifdef _WIN32
+
+MemoryMappedFile::MemoryMappedFile(const std::string &filePath) {
+    // Sharing delete access allows writers to rename the file while it is mapped, see tfb::write
+    file_ = CreateFileW(util::toWstring(filePath).c_str(), GENERIC_READ,
+                        FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING,
+                        FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file_ == INVALID_HANDLE_VALUE) {
+        throw FileException("Could not open file: " + filePath, IVW_CONTEXT);
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file_, &fileSize)) {
+        CloseHandle(file_);
+        throw FileException("Could not determine size of file: " + filePath, IVW_CONTEXT);
+    }
+    size_ = static_cast<size_t>(fileSize.QuadPart);
+    if (size_ == 0) return;
+
+    mapping_ = CreateFileMappingW(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping_) {
+        CloseHandle(file_);
+        throw FileException("Could not map file: " + filePath, IVW_CONTEXT);
+    }
+
+    data_ = static_cast<const unsigned char *>(MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+    if (!data_) {
+        CloseHandle(mapping_);
+        CloseHandle(file_);
+        throw FileException("Could not map file: " + filePath, IVW_CONTEXT);
+    }
+}
+
+MemoryMappedFile::~MemoryMappedFile() {
+    if (data_) UnmapViewOfFile(data_);
+    if (mapping_) CloseHandle(mapping_);
+    if (file_ && file_ != INVALID_HANDLE_VALUE) CloseHandle(file_);
+}
+
+#else
+
+MemoryMappedFile::MemoryMappedFile(const std::string &filePath) {
+    const int fd = open(filePath.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw FileException("Could not open file: " + filePath, IVW_CONTEXT);
+    }
+
+    struct stat fileInfo;
+    if (fstat(fd, &fileInfo) != 0) {
+        close(fd);
+        throw FileException("Could not determine size of file: " + filePath, IVW_CONTEXT);
+    }
+    size_ = static_cast<size_t>(fileInfo.st_size);
+
+    if (size_ > 0) {
+        // The mapping stays valid after the descriptor has been closed
+        void *ptr = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (ptr == MAP_FAILED) {
+            close(fd);
+            throw FileException("Could not map file: " + filePath, IVW_CONTEXT);
+        }
+        data_ = static_cast<const unsigned char *>(ptr);
+    }
+    close(fd);
+}
+
+MemoryMappedFile::~MemoryMappedFile() {
+    if (data_) munmap(const_cast<unsigned char *>(data_), size_);
+}
+
+#endif
+
+}  // namespace inviwo
@@ -0,0 +1,825 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/tensorvisio/util/nrrdformat.h>
+#include <inviwo/core/io/datareaderexception.h>
+#include <inviwo/core/util/filesystem.h>
+#include <inviwo/core/util/stringconversion.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <sstream>
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <zlib.h>
+#include <warn/pop>
+
+namespace inviwo {
+
+namespace {
+
+std::vector<std::string> tokenize(const std::string &str) {
+    std::istringstream iss(str);
+    std::vector<std::string> tokens;
+    std::string token;
+    while (iss >> token) tokens.push_back(token);
+    return tokens;
+}
+
+size_t parseSize(const std::string &str, const std::string &field) {
+    try {
+        return std::stoull(str);
+    } catch (const std::exception &) {
+        throw DataReaderException("Invalid value '" + str + "' for NRRD field '" + field + "'",
+                                  IVW_CONTEXT_CUSTOM("nrrd::readHeader"));
+    }
+}
+
+long long parseInteger(const std::string &str, const std::string &field) {
+    try {
+        size_t end = 0;
+        const auto value = std::stoll(str, &end);
+        if (end == str.size()) return value;
+    } catch (const std::exception &) {
+    }
+    throw DataReaderException("Invalid value '" + str + "' for NRRD field '" + field + "'",
+                              IVW_CONTEXT_CUSTOM("nrrd::readHeader"));
+}
+
+double parseDouble(const std::string &str, const std::string &field) {
+    if (toLower(str) == "nan") return std::numeric_limits<double>::quiet_NaN();
+    try {
+        return std::stod(str);
+    } catch (const std::exception &) {
+        throw DataReaderException("Invalid value '" + str + "' for NRRD field '" + field + "'",
+                                  IVW_CONTEXT_CUSTOM("nrrd::readHeader"));
+    }
+}
+
+// Parses "(x,y,z)", returns no value for "none"
+std::optional<dvec3> parseVector(const std::string &str, const std::string &field) {
+    if (toLower(str) == "none") return std::nullopt;
+
+    auto values = str;
+    values.erase(std::remove_if(values.begin(), values.end(),
+                                [](char c) { return c == '(' || c == ')'; }),
+                 values.end());
+    std::replace(values.begin(), values.end(), ',', ' ');
+
+    const auto components = tokenize(values);
+    if (components.size() != 3) {
+        throw DataReaderException("Only 3D space vectors are supported, got '" + str +
+                                      "' for NRRD field '" + field + "'",
+                                  IVW_CONTEXT_CUSTOM("nrrd::readHeader"));
+    }
+    return dvec3(parseDouble(components[0], field), parseDouble(components[1], field),
+                 parseDouble(components[2], field));
+}
+
+const DataFormatBase *parseType(const std::string &type) {
+    static const std::map<std::string, DataFormatId> types{
+        {"signed char", DataFormatId::Int8},
+        {"int8", DataFormatId::Int8},
+        {"int8_t", DataFormatId::Int8},
+        {"uchar", DataFormatId::UInt8},
+        {"unsigned char", DataFormatId::UInt8},
+        {"uint8", DataFormatId::UInt8},
+        {"uint8_t", DataFormatId::UInt8},
+        {"short", DataFormatId::Int16},
+        {"short int", DataFormatId::Int16},
+        {"signed short", DataFormatId::Int16},
+        {"signed short int", DataFormatId::Int16},
+        {"int16", DataFormatId::Int16},
+        {"int16_t", DataFormatId::Int16},
+        {"ushort", DataFormatId::UInt16},
+        {"unsigned short", DataFormatId::UInt16},
+        {"unsigned short int", DataFormatId::UInt16},
+        {"uint16", DataFormatId::UInt16},
+        {"uint16_t", DataFormatId::UInt16},
+        {"int", DataFormatId::Int32},
+        {"signed int", DataFormatId::Int32},
+        {"int32", DataFormatId::Int32},
+        {"int32_t", DataFormatId::Int32},
+        {"uint", DataFormatId::UInt32},
+        {"unsigned int", DataFormatId::UInt32},
+        {"uint32", DataFormatId::UInt32},
+        {"uint32_t", DataFormatId::UInt32},
+        {"longlong", DataFormatId::Int64},
+        {"long long", DataFormatId::Int64},
+        {"long long int", DataFormatId::Int64},
+        {"signed long long", DataFormatId::Int64},
+        {"signed long long int", DataFormatId::Int64},
+        {"int64", DataFormatId::Int64},
+        {"int64_t", DataFormatId::Int64},
+        {"ulonglong", DataFormatId::UInt64},
+        {"unsigned long long", DataFormatId::UInt64},
+        {"unsigned long long int", DataFormatId::UInt64},
+        {"uint64", DataFormatId::UInt64},
+        {"uint64_t", DataFormatId::UInt64},
+        {"float", DataFormatId::Float32},
+        {"double", DataFormatId::Float64}};
+
+    const auto it = types.find(toLower(type));
+    if (it == types.end()) {
+        throw DataReaderException("Unsupported NRRD type '" + type + "'",
+                                  IVW_CONTEXT_CUSTOM("nrrd::readHeader"));
+    }
+    return DataFormatBase::get(it->second);
+}
+
+/*
+ * A data file name pattern with a single %d conversion and an optional width, e.g.
+ * "slice%03d.raw". The pattern comes straight from the file, so it is never handed to printf.
+ */
+struct FilePattern {
+    std::string prefix;
+    std::string suffix;
+    size_t width = 0;
+    bool zeroPad = false;
+
+    static FilePattern parse(const std::string &pattern) {
+        const auto invalid = [&]() {
+            return DataReaderException("Invalid NRRD data file pattern '" + pattern +
+                                           "', expected a single %d conversion",
+                                       IVW_CONTEXT_CUSTOM("nrrd::readHeader"));
+        };
+
+        const auto percent = pattern.find('%');
+        auto pos = percent + 1;
+        while (pos < pattern.size() && pattern[pos] >= '0' && pattern[pos] <= '9') ++pos;
+        const auto widthDigits = pos - percent - 1;
+        if (pos == pattern.size() || pattern[pos] != 'd' || widthDigits > 2 ||
+            pattern.find('%', pos) != std::string::npos) {
+            throw invalid();
+        }
+
+        FilePattern res;
+        res.prefix = pattern.substr(0, percent);
+        res.suffix = pattern.substr(pos + 1);
+        res.zeroPad = widthDigits > 0 && pattern[percent + 1] == '0';
+        if (widthDigits > 0) res.width = std::stoul(pattern.substr(percent + 1, widthDigits));
+        return res;
+    }
+
+    std::string format(const long long index) const {
+        std::string sign = index < 0 ? "-" : "";
+        auto digits = std::to_string(index < 0 ? -index : index);
+        if (sign.size() + digits.size() < width) {
+            const auto padding = width - sign.size() - digits.size();
+            if (zeroPad) {
+                digits.insert(0, padding, '0');
+            } else {
+                sign.insert(0, padding, ' ');
+            }
+        }
+        return prefix + sign + digits + suffix;
+    }
+};
+
+/*
+ * Expands the "data file" field, which is either a single file name, a %d pattern followed by
+ * min, max and step, or "LIST" in which case the remaining lines of the header are the file
+ * names.
+ */
+std::vector<std::string> parseDataFiles(const std::string &value, std::istream &header) {
+    const auto tokens = tokenize(value);
+    if (tokens.empty()) {
+        throw DataReaderException("Empty NRRD data file field",
+                                  IVW_CONTEXT_CUSTOM("nrrd::readHeader"));
+    }
+
+    std::vector<std::string> files;
+    if (tokens[0] == "LIST") {
+        std::string line;
+        while (std::getline(header, line)) {
+            line = trim(line);
+            if (!line.empty()) files.push_back(line);
+        }
+    } else if (tokens.size() >= 4 && tokens[0].find('%') != std::string::npos) {
+        const auto pattern = FilePattern::parse(tokens[0]);
+
+        // The indices are ints in the NRRD format, which keeps the arithmetic below in range
+        const auto index = [&](const std::string &token) {
+            const auto i = parseInteger(token, "data file");
+            if (i < std::numeric_limits<int>::min() || i > std::numeric_limits<int>::max()) {
+                throw DataReaderException("Invalid NRRD data file range '" + value + "'",
+                                          IVW_CONTEXT_CUSTOM("nrrd::readHeader"));
+            }
+            return i;
+        };
+        const auto first = index(tokens[1]);
+        const auto last = index(tokens[2]);
+        const auto step = index(tokens[3]);
+        if (step == 0 || (last - first) / step < 0) {
+            throw DataReaderException("Invalid NRRD data file range '" + value + "'",
+                                      IVW_CONTEXT_CUSTOM("nrrd::readHeader"));
+        }
+        const auto count = (last - first) / step + 1;
+        for (long long i = 0; i < count; ++i) {
+            files.push_back(pattern.format(first + i * step));
+        }
+    } else {
+        files.push_back(trim(value));
+    }
+    return files;
+}
+
+bool isLittleEndianHost() {
+    const uint16_t value = 1;
+    unsigned char first;
+    std::memcpy(&first, &value, 1);
+    return first == 1;
+}
+
+template <typename T>
+T byteSwap(T value) {
+    T res = 0;
+    for (size_t i = 0; i < sizeof(T); ++i) {
+        res = static_cast<T>((res << 8) | ((value >> (8 * i)) & 0xFF));
+    }
+    return res;
+}
+
+template <typename T>
+void byteSwap(unsigned char *data, const size_t count) {
+    // Fixed size memcpy and shifts are recognized as a byte swap and vectorized by the compiler
+    for (size_t i = 0; i < count; ++i) {
+        T value;
+        std::memcpy(&value, data + i * sizeof(T), sizeof(T));
+        value = byteSwap(value);
+        std::memcpy(data + i * sizeof(T), &value, sizeof(T));
+    }
+}
+
+class Inflater {
+public:
+    Inflater(const unsigned char *src, size_t srcSize) : src_(src), srcSize_(srcSize) {
+        // 15 + 32 accepts both gzip and zlib headers
+        if (inflateInit2(&stream_, 15 + 32) != Z_OK) {
+            throw DataReaderException("Could not initialize zlib",
+                                      IVW_CONTEXT_CUSTOM("nrrd::readData"));
+        }
+    }
+    Inflater(const Inflater &) = delete;
+    Inflater &operator=(const Inflater &) = delete;
+    ~Inflater() { inflateEnd(&stream_); }
+
+    // Inflates up to size bytes into dst and returns the number of bytes written
+    size_t read(unsigned char *dst, size_t size) {
+        constexpr size_t maxChunk = std::numeric_limits<uInt>::max();
+        size_t written = 0;
+        while (written < size) {
+            if (stream_.avail_in == 0 && pos_ < srcSize_) {
+                const auto chunk = std::min(srcSize_ - pos_, maxChunk);
+                stream_.next_in = const_cast<Bytef *>(src_ + pos_);
+                stream_.avail_in = static_cast<uInt>(chunk);
+                pos_ += chunk;
+            }
+            const auto chunk = std::min(size - written, maxChunk);
+            stream_.next_out = dst + written;
+            stream_.avail_out = static_cast<uInt>(chunk);
+
+            const auto ret = inflate(&stream_, Z_NO_FLUSH);
+            written += chunk - stream_.avail_out;
+            if (ret == Z_STREAM_END) break;
+            if (ret == Z_BUF_ERROR && stream_.avail_in == 0 && pos_ == srcSize_) break;
+            if (ret != Z_OK) {
+                throw DataReaderException("Corrupt gzip data in NRRD file",
+                                          IVW_CONTEXT_CUSTOM("nrrd::readData"));
+            }
+        }
+        return written;
+    }
+
+    void skip(size_t size) {
+        std::vector<unsigned char> discard(std::min<size_t>(size, 1 << 16));
+        while (size > 0) {
+            const auto chunk = std::min(size, discard.size());
+            if (read(discard.data(), chunk) != chunk) {
+                throw DataReaderException("Byte skip exceeds the gzip data in NRRD file",
+                                          IVW_CONTEXT_CUSTOM("nrrd::readData"));
+            }
+            size -= chunk;
+        }
+    }
+
+private:
+    z_stream stream_{};
+    const unsigned char *src_;
+    size_t srcSize_;
+    size_t pos_ = 0;
+};
+
+// Upper bound of the deflate compression ratio, see zlib's deflateBound
+constexpr size_t maxDeflateRatio = 1032;
+
+/*
+ * Returns an upper bound of the number of bytes the data file can provide, used to validate
+ * the header before allocating the data.
+ */
+size_t maxDataSize(const nrrd::Header &header, const std::string &fileName) {
+    std::ifstream file(fileName, std::ios::in | std::ios::binary | std::ios::ate);
+    if (!file) {
+        throw DataReaderException("Could not open NRRD data file " + fileName,
+                                  IVW_CONTEXT_CUSTOM("nrrd::readData"));
+    }
+    const auto fileSize = static_cast<size_t>(file.tellg());
+    const auto start = fileName == header.filePath ? header.dataOffset : 0;
+    const auto available = fileSize > start ? fileSize - start : 0;
+
+    if (header.encoding == nrrd::Encoding::Raw) return available;
+    return available > std::numeric_limits<size_t>::max() / maxDeflateRatio
+               ? std::numeric_limits<size_t>::max()
+               : available * maxDeflateRatio;
+}
+
+void readDataFile(const nrrd::Header &header, const std::string &fileName, unsigned char *dst,
+                  const size_t size) {
+    std::ifstream file(fileName, std::ios::in | std::ios::binary);
+    if (!file) {
+        throw DataReaderException("Could not open NRRD data file " + fileName,
+                                  IVW_CONTEXT_CUSTOM("nrrd::readData"));
+    }
+
+    if (fileName == header.filePath) file.seekg(header.dataOffset);
+    for (size_t i = 0; i < header.lineSkip; ++i) {
+        file.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+    }
+
+    const auto start = static_cast<size_t>(file.tellg());
+    file.seekg(0, std::ios::end);
+    const auto fileSize = static_cast<size_t>(file.tellg());
+    if (!file || start > fileSize) {
+        throw DataReaderException("Unexpected end of NRRD data file " + fileName,
+                                  IVW_CONTEXT_CUSTOM("nrrd::readData"));
+    }
+
+    const auto tooShort = [&]() {
+        return DataReaderException("NRRD data file " + fileName + " holds less data than expected",
+                                   IVW_CONTEXT_CUSTOM("nrrd::readData"));
+    };
+
+    if (header.encoding == nrrd::Encoding::Raw) {
+        // The byte skip of -1 places the data at the end of the file
+        if (header.byteSkip < 0 && fileSize < size) throw tooShort();
+        const auto offset = header.byteSkip < 0 ? fileSize - size
+                                                : start + static_cast<size_t>(header.byteSkip);
+        if (offset > fileSize || fileSize - offset < size) throw tooShort();
+
+        file.seekg(offset);
+        file.read(reinterpret_cast<char *>(dst), size);
+        if (static_cast<size_t>(file.gcount()) != size) throw tooShort();
+    } else {
+        if (header.byteSkip < 0) {
+            throw DataReaderException("A byte skip of -1 is only supported for raw encoding",
+                                      IVW_CONTEXT_CUSTOM("nrrd::readData"));
+        }
+
+        std::vector<unsigned char> compressed(fileSize - start);
+        file.seekg(start);
+        file.read(reinterpret_cast<char *>(compressed.data()), compressed.size());
+
+        // For compressed data the byte skip applies to the decompressed stream
+        Inflater inflater(compressed.data(), compressed.size());
+        inflater.skip(static_cast<size_t>(header.byteSkip));
+        if (inflater.read(dst, size) != size) throw tooShort();
+    }
+}
+
+size_t numberOfComponents(const nrrd::TensorKind kind) {
+    switch (kind) {
+        case nrrd::TensorKind::SymmetricMatrix:
+            return 6;
+        case nrrd::TensorKind::MaskedSymmetricMatrix:
+            return 7;
+        case nrrd::TensorKind::Matrix:
+            return 9;
+        case nrrd::TensorKind::MaskedMatrix:
+        default:
+            return 10;
+    }
+}
+
+std::optional<nrrd::TensorKind> tensorKind(const std::string &kind) {
+    static const std::map<std::string, nrrd::TensorKind> kinds{
+        {"3d-symmetric-matrix", nrrd::TensorKind::SymmetricMatrix},
+        {"3d-masked-symmetric-matrix", nrrd::TensorKind::MaskedSymmetricMatrix},
+        {"3d-matrix", nrrd::TensorKind::Matrix},
+        {"3d-masked-matrix", nrrd::TensorKind::MaskedMatrix}};
+
+    const auto it = kinds.find(toLower(kind));
+    if (it == kinds.end()) return std::nullopt;
+    return it->second;
+}
+
+template <typename F>
+void dispatchScalar(const DataFormatBase *format, const void *data, F &&callback) {
+    switch (format->getId()) {
+        case DataFormatId::Int8:
+            return callback(static_cast<const glm::i8 *>(data));
+        case DataFormatId::UInt8:
+            return callback(static_cast<const glm::u8 *>(data));
+        case DataFormatId::Int16:
+            return callback(static_cast<const glm::i16 *>(data));
+        case DataFormatId::UInt16:
+            return callback(static_cast<const glm::u16 *>(data));
+        case DataFormatId::Int32:
+            return callback(static_cast<const glm::i32 *>(data));
+        case DataFormatId::UInt32:
+            return callback(static_cast<const glm::u32 *>(data));
+        case DataFormatId::Int64:
+            return callback(static_cast<const glm::i64 *>(data));
+        case DataFormatId::UInt64:
+            return callback(static_cast<const glm::u64 *>(data));
+        case DataFormatId::Float32:
+            return callback(static_cast<const float *>(data));
+        case DataFormatId::Float64:
+            return callback(static_cast<const double *>(data));
+        default:
+            throw DataReaderException("Unsupported NRRD type " + std::string(format->getString()),
+                                      IVW_CONTEXT_CUSTOM("nrrd::readTensors"));
+    }
+}
+
+}  // namespace
+
+namespace nrrd {
+
+size_t Header::getNumberOfElements() const {
+    size_t count = 1;
+    for (const auto size : sizes) {
+        if (size != 0 && count > std::numeric_limits<size_t>::max() / size) {
+            throw DataReaderException("NRRD sizes exceed the addressable memory",
+                                      IVW_CONTEXT_CUSTOM("nrrd::Header"));
+        }
+        count *= size;
+    }
+    return count;
+}
+
+size_t Header::getSizeInBytes() const {
+    const auto count = getNumberOfElements();
+    if (count > std::numeric_limits<size_t>::max() / format->getSize()) {
+        throw DataReaderException("NRRD sizes exceed the addressable memory",
+                                  IVW_CONTEXT_CUSTOM("nrrd::Header"));
+    }
+    return count * format->getSize();
+}
+
+Header readHeader(const std::string &filePath) {
+    std::ifstream file(filePath, std::ios::in | std::ios::binary);
+    if (!file) {
+        throw DataReaderException("Could not open NRRD file " + filePath,
+                                  IVW_CONTEXT_CUSTOM("nrrd::readHeader"));
+    }
+
+    std::string line;
+    std::getline(file, line);
+    if (line.compare(0, 4, "NRRD") != 0) {
+        throw DataReaderException("Not a NRRD file: " + filePath,
+                                  IVW_CONTEXT_CUSTOM("nrrd::readHeader"));
+    }
+
+    Header header;
+    header.filePath = filePath;
+    std::map<std::string, std::string> fields;
+
+    while (std::getline(file, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        // An empty line ends the header, the data of attached files starts right after it
+        if (line.empty()) break;
+        if (line[0] == '#') continue;
+
+        const auto keyValue = line.find(":=");
+        if (keyValue != std::string::npos) {
+            header.keyValues[line.substr(0, keyValue)] = line.substr(keyValue + 2);
+            continue;
+        }
+
+        const auto separator = line.find(": ");
+        if (separator == std::string::npos) {
+            throw DataReaderException("Invalid NRRD header line '" + line + "'",
+                                      IVW_CONTEXT_CUSTOM("nrrd::readHeader"));
+        }
+        auto field = toLower(trim(line.substr(0, separator)));
+        auto value = trim(line.substr(separator + 2));
+        value.erase(std::remove(value.begin(), value.end(), '"'), value.end());
+
+        if (field == "datafile" || field == "data file") {
+            // A LIST consumes the remaining lines of the header
+            header.dataFiles = parseDataFiles(value, file);
+            continue;
+        }
+        fields[field] = value;
+    }
+
+    if (header.dataFiles.empty()) {
+        header.dataFiles.push_back(filePath);
+        header.dataOffset = file ? static_cast<size_t>(file.tellg()) : 0;
+    } else {
+        const auto directory = filesystem::getFileDirectory(filePath);
+        for (auto &dataFile : header.dataFiles) {
+            if (!filesystem::isAbsolutePath(dataFile)) dataFile = directory + '/' + dataFile;
+        }
+    }
+
+    const auto get = [&](const std::string &field,
+                         const std::string &alias = "") -> std::optional<std::string> {
+        auto it = fields.find(field);
+        if (it == fields.end() && !alias.empty()) it = fields.find(alias);
+        if (it == fields.end()) return std::nullopt;
+        return it->second;
+    };
+    const auto require = [&](const std::string &field) {
+        if (auto value = get(field)) return *value;
+        throw DataReaderException("NRRD header is missing the required field '" + field + "'",
+                                  IVW_CONTEXT_CUSTOM("nrrd::readHeader"));
+    };
+
+    header.dimension = parseSize(require("dimension"), "dimension");
+    for (const auto &size : tokenize(require("sizes"))) {
+        header.sizes.push_back(parseSize(size, "sizes"));
+        if (header.sizes.back() == 0) {
+            throw DataReaderException("NRRD sizes have to be positive",
+                                      IVW_CONTEXT_CUSTOM("nrrd::readHeader"));
+        }
+    }
+    if (header.sizes.size() != header.dimension) {
+        throw DataReaderException("Number of NRRD sizes does not match the dimension",
+                                  IVW_CONTEXT_CUSTOM("nrrd::readHeader"));
+    }
+    header.format = parseType(require("type"));
+    // Throws if the size of the data overflows
+    header.getSizeInBytes();
+
+    const auto encoding = toLower(require("encoding"));
+    if (encoding == "raw") {
+        header.encoding = Encoding::Raw;
+    } else if (encoding == "gzip" || encoding == "gz") {
+        header.encoding = Encoding::Gzip;
+    } else {
+        throw DataReaderException("Unsupported NRRD encoding '" + encoding + "'",
+                                  IVW_CONTEXT_CUSTOM("nrrd::readHeader"));
+    }
+
+    if (const auto endian = get("endian")) {
+        header.endian = toLower(*endian) == "big" ? Endian::Big : Endian::Little;
+    } else if (header.format->getSize() > 1) {
+        throw DataReaderException("NRRD header is missing the required field 'endian'",
+                                  IVW_CONTEXT_CUSTOM("nrrd::readHeader"));
+    }
+
+    if (const auto lineSkip = get("line skip", "lineskip")) {
+        header.lineSkip = parseSize(*lineSkip, "line skip");
+    }
+    if (const auto byteSkip = get("byte skip", "byteskip")) {
+        header.byteSkip = static_cast<std::ptrdiff_t>(parseDouble(*byteSkip, "byte skip"));
+    }
+
+    if (const auto kinds = get("kinds")) {
+        header.kinds = tokenize(*kinds);
+    }
+    if (const auto spacings = get("spacings")) {
+        for (const auto &spacing : tokenize(*spacings)) {
+            header.spacings.push_back(parseDouble(spacing, "spacings"));
+        }
+    }
+    if (const auto directions = get("space directions")) {
+        for (const auto &direction : tokenize(*directions)) {
+            header.spaceDirections.push_back(parseVector(direction, "space directions"));
+        }
+    }
+    if (const auto origin = get("space origin")) {
+        header.spaceOrigin = parseVector(*origin, "space origin");
+    }
+    if (const auto frame = get("measurement frame")) {
+        const auto columns = tokenize(*frame);
+        if (columns.size() != 3) {
+            throw DataReaderException("Only 3D measurement frames are supported",
+                                      IVW_CONTEXT_CUSTOM("nrrd::readHeader"));
+        }
+        dmat3 measurementFrame;
+        for (glm::length_t i = 0; i < 3; ++i) {
+            const auto column = parseVector(columns[i], "measurement frame");
+            if (!column) {
+                throw DataReaderException("Invalid NRRD measurement frame",
+                                          IVW_CONTEXT_CUSTOM("nrrd::readHeader"));
+            }
+            measurementFrame[i] = *column;
+        }
+        header.measurementFrame = measurementFrame;
+    }
+
+    if (!header.kinds.empty() && header.kinds.size() != header.dimension) {
+        throw DataReaderException("Number of NRRD kinds does not match the dimension",
+                                  IVW_CONTEXT_CUSTOM("nrrd::readHeader"));
+    }
+
+    return header;
+}
+
+void swapBytes(void *data, const size_t count, const size_t elementSize) {
+    auto bytes = static_cast<unsigned char *>(data);
+    switch (elementSize) {
+        case 2:
+            byteSwap<uint16_t>(bytes, count);
+            break;
+        case 4:
+            byteSwap<uint32_t>(bytes, count);
+            break;
+        case 8:
+            byteSwap<uint64_t>(bytes, count);
+            break;
+        default:
+            break;
+    }
+}
+
+std::vector<unsigned char> readData(const Header &header) {
+    const auto size = header.getSizeInBytes();
+    const auto numFiles = header.dataFiles.size();
+    if (numFiles == 0 || size % numFiles != 0) {
+        throw DataReaderException("NRRD data cannot be split evenly across the data files",
+                                  IVW_CONTEXT_CUSTOM("nrrd::readData"));
+    }
+
+    const auto sizePerFile = size / numFiles;
+    for (const auto &fileName : header.dataFiles) {
+        if (sizePerFile > maxDataSize(header, fileName)) {
+            throw DataReaderException("NRRD data file " + fileName +
+                                          " holds less data than expected",
+                                      IVW_CONTEXT_CUSTOM("nrrd::readData"));
+        }
+    }
+
+    std::vector<unsigned char> data(size);
+    for (size_t i = 0; i < numFiles; ++i) {
+        readDataFile(header, header.dataFiles[i], data.data() + i * sizePerFile, sizePerFile);
+    }
+
+    const auto littleEndian = header.endian == Endian::Little;
+    if (littleEndian != isLittleEndianHost()) {
+        swapBytes(data.data(), header.getNumberOfElements(), header.format->getSize());
+    }
+    return data;
+}
+
+TensorVolume readTensors(const std::string &filePath) {
+    const auto header = readHeader(filePath);
+    if (header.dimension != 4) {
+        throw DataReaderException("Expected a 4D NRRD file holding a 3D tensor field, got " +
+                                      toString(header.dimension) + " dimensions",
+                                  IVW_CONTEXT_CUSTOM("nrrd::readTensors"));
+    }
+
+    // Locate the tensor axis, falling back to the first axis for files without kinds
+    size_t tensorAxis = 0;
+    std::optional<TensorKind> kind;
+    for (size_t axis = 0; axis < header.kinds.size() && !kind; ++axis) {
+        if ((kind = tensorKind(header.kinds[axis]))) tensorAxis = axis;
+    }
+    if (!kind) {
+        switch (header.sizes[0]) {
+            case 6:
+                kind = TensorKind::SymmetricMatrix;
+                break;
+            case 7:
+                kind = TensorKind::MaskedSymmetricMatrix;
+                break;
+            case 9:
+                kind = TensorKind::Matrix;
+                break;
+            case 10:
+                kind = TensorKind::MaskedMatrix;
+                break;
+            default:
+                throw DataReaderException("Could not find a tensor axis in " + filePath,
+                                          IVW_CONTEXT_CUSTOM("nrrd::readTensors"));
+        }
+    }
+
+    const auto numComponents = numberOfComponents(*kind);
+    if (header.sizes[tensorAxis] != numComponents) {
+        throw DataReaderException("Tensor axis of " + filePath + " has " +
+                                      toString(header.sizes[tensorAxis]) +
+                                      " components, expected " + toString(numComponents),
+                                  IVW_CONTEXT_CUSTOM("nrrd::readTensors"));
+    }
+
+    TensorVolume volume;
+    volume.kind = *kind;
+
+    // The three remaining axes span the grid. Samples along axes before the tensor axis are
+    // interleaved with the components, i.e. component c of sample v is located at
+    // (v / inner * numComponents + c) * inner + v % inner
+    size_t inner = 1;
+    glm::length_t spatial = 0;
+    for (size_t axis = 0; axis < 4; ++axis) {
+        if (axis == tensorAxis) continue;
+        const auto size = header.sizes[axis];
+        volume.dimensions[spatial] = size;
+        if (axis < tensorAxis) inner *= size;
+
+        // Per axis extent, from the space directions or spacings. Axes without geometry span
+        // the unit interval
+        const auto steps = static_cast<double>(std::max<size_t>(size, 2) - 1);
+        dvec3 direction(0.0);
+        if (axis < header.spaceDirections.size() && header.spaceDirections[axis]) {
+            direction = *header.spaceDirections[axis] * steps;
+        } else if (axis < header.spacings.size() && std::isfinite(header.spacings[axis])) {
+            direction[spatial] = header.spacings[axis] * steps;
+        } else {
+            direction[spatial] = 1.0;
+        }
+        volume.basis[spatial] = direction;
+        ++spatial;
+    }
+    volume.offset = header.spaceOrigin.value_or(dvec3(0.0));
+
+    const auto data = readData(header);
+    const auto numTensors = glm::compMul(volume.dimensions);
+    volume.tensors.resize(numTensors);
+    volume.confidence.resize(numTensors, 1.0f);
+
+    const auto masked = *kind == TensorKind::MaskedSymmetricMatrix ||
+                        *kind == TensorKind::MaskedMatrix;
+    const auto symmetric = *kind == TensorKind::SymmetricMatrix ||
+                           *kind == TensorKind::MaskedSymmetricMatrix;
+    const size_t first = masked ? 1 : 0;
+
+    dispatchScalar(header.format, data.data(), [&](const auto *scalars) {
+        for (size_t v = 0; v < numTensors; ++v) {
+            const auto base = (v / inner) * numComponents * inner + v % inner;
+            const auto component = [&](size_t c) {
+                return static_cast<double>(scalars[base + c * inner]);
+            };
+
+            dmat3 tensor;
+            if (symmetric) {
+                const auto xx = component(first + 0);
+                const auto xy = component(first + 1);
+                const auto xz = component(first + 2);
+                const auto yy = component(first + 3);
+                const auto yz = component(first + 4);
+                const auto zz = component(first + 5);
+                tensor = dmat3(xx, xy, xz, xy, yy, yz, xz, yz, zz);
+            } else {
+                // Components are given in row-major order
+                for (glm::length_t row = 0; row < 3; ++row) {
+                    for (glm::length_t col = 0; col < 3; ++col) {
+                        tensor[col][row] = component(first + 3 * row + col);
+                    }
+                }
+            }
+
+            if (masked) {
+                volume.confidence[v] = static_cast<float>(component(0));
+                if (volume.confidence[v] < 1.0f) tensor = dmat3(0.0);
+            }
+            volume.tensors[v] = tensor;
+        }
+    });
+
+    if (header.measurementFrame) {
+        const auto &frame = *header.measurementFrame;
+        const auto frameT = glm::transpose(frame);
+        for (auto &tensor : volume.tensors) tensor = frame * tensor * frameT;
+    }
+
+    return volume;
+}
+
+}  // namespace nrrd
+
+}  // namespace inviwo
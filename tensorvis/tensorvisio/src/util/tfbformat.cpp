@@ -0,0 +1,945 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/tensorvisio/util/tfbformat.h>
+#include <inviwo/tensorvisio/util/memorymappedfile.h>
+#include <inviwo/tensorvisbase/util/datareductions.h>
+#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/datastructures/datamapper.h>
+#include <inviwo/core/io/datareaderexception.h>
+#include <inviwo/core/util/exception.h>
+#include <inviwo/core/util/logcentral.h>
+#include <inviwo/core/util/settings/systemsettings.h>
+#include <inviwo/core/util/stringconversion.h>
+
+#include <algorithm>
+#include <array>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <limits>
+#include <mutex>
+#include <thread>
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <zlib.h>
+#include <warn/pop>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#endif
+
+namespace inviwo {
+
+namespace {
+const std::string versionString("TFBVersion:");
+
+size_t alignUp(const size_t value, const size_t alignment) {
+    return ((value + alignment - 1) / alignment) * alignment;
+}
+
+size_t scalarSize(const tfb::ScalarType type) {
+    switch (type) {
+        case tfb::ScalarType::UInt8:
+            return sizeof(glm::uint8);
+        case tfb::ScalarType::Float32:
+            return sizeof(float);
+        case tfb::ScalarType::Float64:
+        default:
+            return sizeof(double);
+    }
+}
+
+// Deflate compresses by at most this factor, which bounds the decoded size of a chunk
+constexpr size_t maxDeflateRatio = 1032;
+
+size_t maxDecodedSize(const size_t encodedSize) {
+    return encodedSize > std::numeric_limits<size_t>::max() / maxDeflateRatio
+               ? std::numeric_limits<size_t>::max()
+               : encodedSize * maxDeflateRatio;
+}
+
+// A stream holds at most a full tensor per element
+constexpr uint32_t maxNumberOfComponents = 9;
+
+size3_t numberOfBricks(const size3_t &dimensions, const size3_t &brickSize) {
+    return (dimensions + brickSize - size3_t(1)) / brickSize;
+}
+
+struct Brick {
+    size3_t origin;
+    size3_t dimensions;
+};
+
+Brick getBrick(const size3_t &dimensions, const size3_t &brickSize, const size_t index) {
+    const auto bricks = numberOfBricks(dimensions, brickSize);
+    const size3_t brick{index % bricks.x, (index / bricks.x) % bricks.y,
+                        index / (bricks.x * bricks.y)};
+    const auto origin = brick * brickSize;
+    return {origin, glm::min(brickSize, dimensions - origin)};
+}
+
+/*
+ * Calls copy(fieldIndex, brickIndex, count) for each row of consecutive elements in the brick.
+ */
+template <typename Copy>
+void forEachBrickRow(const size3_t &dimensions, const Brick &brick, Copy copy) {
+    for (size_t z = 0; z < brick.dimensions.z; ++z) {
+        for (size_t y = 0; y < brick.dimensions.y; ++y) {
+            const auto fieldIndex =
+                ((brick.origin.z + z) * dimensions.y + brick.origin.y + y) * dimensions.x +
+                brick.origin.x;
+            const auto brickIndex = (z * brick.dimensions.y + y) * brick.dimensions.x;
+            copy(fieldIndex, brickIndex, brick.dimensions.x);
+        }
+    }
+}
+
+/*
+ * Moves the completely written file at tmpPath over filePath. Fields that are still mapped from
+ * the old file keep their data. On POSIX the mapping keeps the old file alive. On Windows a mapped
+ * file cannot be overwritten, but it can be renamed since mappings share delete access, so it is
+ * moved aside and deleted, which only succeeds once it is no longer mapped.
+ */
+void replaceFile(const std::string &tmpPath, const std::string &filePath) {
+#ifdef _WIN32
+    const auto tmp = util::toWstring(tmpPath);
+    const auto target = util::toWstring(filePath);
+    if (MoveFileExW(tmp.c_str(), target.c_str(),
+                    MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH)) {
+        return;
+    }
+
+    const auto asidePath = filePath + "." + std::to_string(GetCurrentProcessId()) + "." +
+                           std::to_string(GetTickCount64()) + ".old";
+    const auto aside = util::toWstring(asidePath);
+    if (!MoveFileExW(target.c_str(), aside.c_str(), MOVEFILE_WRITE_THROUGH)) {
+        DeleteFileW(tmp.c_str());
+        throw FileException("Could not replace file: " + filePath + " (error " +
+                                std::to_string(GetLastError()) + ")",
+                            IVW_CONTEXT_CUSTOM("tfb::write"));
+    }
+    if (!MoveFileExW(tmp.c_str(), target.c_str(), MOVEFILE_WRITE_THROUGH)) {
+        const auto error = GetLastError();
+        MoveFileExW(aside.c_str(), target.c_str(), MOVEFILE_WRITE_THROUGH);
+        DeleteFileW(tmp.c_str());
+        throw FileException("Could not replace file: " + filePath + " (error " +
+                                std::to_string(error) + ")",
+                            IVW_CONTEXT_CUSTOM("tfb::write"));
+    }
+    if (!DeleteFileW(aside.c_str())) {
+        LogWarnCustom("tfb::write", "Could not delete " << asidePath
+                                                         << ", the previous version of the file "
+                                                            "is still in use");
+    }
+#else
+    if (std::rename(tmpPath.c_str(), filePath.c_str()) != 0) {
+        std::remove(tmpPath.c_str());
+        throw FileException("Could not replace file: " + filePath,
+                            IVW_CONTEXT_CUSTOM("tfb::write"));
+    }
+#endif
+}
+
+/*
+ * Groups the bytes of the scalars by significance, see tfb::Filter::ByteShuffle
+ */
+void shuffle(const unsigned char *src, const size_t size, const size_t scalarSize,
+             unsigned char *dst) {
+    const auto count = size / scalarSize;
+    for (size_t i = 0; i < count; ++i) {
+        for (size_t b = 0; b < scalarSize; ++b) {
+            dst[b * count + i] = src[i * scalarSize + b];
+        }
+    }
+}
+
+void unshuffle(const unsigned char *src, const size_t size, const size_t scalarSize,
+               unsigned char *dst) {
+    const auto count = size / scalarSize;
+    for (size_t i = 0; i < count; ++i) {
+        for (size_t b = 0; b < scalarSize; ++b) {
+            dst[i * scalarSize + b] = src[b * count + i];
+        }
+    }
+}
+
+/*
+ * Compresses data into encoded, returns false if the chunk does not get any smaller.
+ */
+bool compressChunk(const std::vector<unsigned char> &data, const size_t scalarSize,
+             const tfb::Filter filter, std::vector<unsigned char> &encoded) {
+    if (data.empty() || data.size() > std::numeric_limits<uLong>::max()) return false;
+
+    std::vector<unsigned char> shuffled;
+    const auto *src = &data;
+    if (filter == tfb::Filter::ByteShuffle) {
+        shuffled.resize(data.size());
+        shuffle(data.data(), data.size(), scalarSize, shuffled.data());
+        src = &shuffled;
+    }
+
+    auto size = compressBound(static_cast<uLong>(src->size()));
+    encoded.resize(size);
+    if (compress2(encoded.data(), &size, src->data(), static_cast<uLong>(src->size()),
+                  Z_DEFAULT_COMPRESSION) != Z_OK ||
+        size >= data.size()) {
+        return false;
+    }
+    encoded.resize(size);
+    return true;
+}
+
+void writeZeros(std::ostream &out, size_t count) {
+    static const std::array<char, 4096> zeros{};
+    while (count > 0) {
+        const auto n = std::min(count, zeros.size());
+        out.write(zeros.data(), n);
+        count -= n;
+    }
+}
+
+/*
+ * Writes chunks on a background thread so that encoding the next chunk overlaps with writing the
+ * previous one. At most capacity chunks are queued, which bounds the memory use.
+ */
+class ChunkWriter {
+public:
+    ChunkWriter(std::ostream &out, const size_t capacity) : out_(out), capacity_(capacity) {
+        thread_ = std::thread([this]() { run(); });
+    }
+    ChunkWriter(const ChunkWriter &) = delete;
+    ChunkWriter &operator=(const ChunkWriter &) = delete;
+    ~ChunkWriter() { finish(); }
+
+    /*
+     * Queues padding zero bytes followed by the data, blocks while the queue is full.
+     */
+    void push(const size_t padding, std::vector<unsigned char> data) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        condition_.wait(lock, [this]() { return queue_.size() < capacity_; });
+        queue_.emplace_back(padding, std::move(data));
+        condition_.notify_all();
+    }
+
+    void finish() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            done_ = true;
+        }
+        condition_.notify_all();
+        if (thread_.joinable()) thread_.join();
+    }
+
+private:
+    void run() {
+        while (true) {
+            std::pair<size_t, std::vector<unsigned char>> item;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                condition_.wait(lock, [this]() { return done_ || !queue_.empty(); });
+                if (queue_.empty()) return;
+                item = std::move(queue_.front());
+                queue_.pop_front();
+            }
+            condition_.notify_all();
+
+            writeZeros(out_, item.first);
+            out_.write(reinterpret_cast<const char *>(item.second.data()), item.second.size());
+        }
+    }
+
+    std::ostream &out_;
+    const size_t capacity_;
+    std::deque<std::pair<size_t, std::vector<unsigned char>>> queue_;
+    bool done_ = false;
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    std::thread thread_;
+};
+}  // namespace
+
+namespace tfb {
+
+void write(const TensorField3D &tensorField, const std::string &filePath,
+           const WriteSettings &settings) {
+    const auto dimensions = tensorField.getDimensions();
+    const auto brickSize = glm::clamp(settings.brickSize, size3_t(1), dimensions);
+    const auto numBricks = glm::compMul(numberOfBricks(dimensions, brickSize));
+
+    FileHeader header{};
+    const auto extents = tensorField.getExtents<double>();
+    const auto offset = tensorField.getOffset();
+    for (glm::length_t i = 0; i < 3; ++i) {
+        header.dimensions[i] = dimensions[i];
+        header.brickSize[i] = brickSize[i];
+        header.extents[i] = extents[i];
+        header.offset[i] = offset[i];
+        header.eigenValueRanges[i][0] = tensorField.dataMapEigenValues()[i].dataRange.x;
+        header.eigenValueRanges[i][1] = tensorField.dataMapEigenValues()[i].dataRange.y;
+        header.eigenVectorRanges[i][0] = tensorField.dataMapEigenVectors()[i].dataRange.x;
+        header.eigenVectorRanges[i][1] = tensorField.dataMapEigenVectors()[i].dataRange.y;
+    }
+
+    const auto scalarType = settings.floatPrecision ? ScalarType::Float32 : ScalarType::Float64;
+
+    // The source of every stream except for the tensors, which are accessed through the storage
+    std::vector<StreamInfo> streams{{tensorStreamId, 0, 9, scalarType}};
+    std::vector<const unsigned char *> sources{nullptr};
+
+    if (tensorField.hasMask()) {
+        streams.push_back({maskStreamId, 0, 1, ScalarType::UInt8});
+        sources.push_back(tensorField.getMask().data());
+    }
+
+    const auto isEigenData = [](const uint64_t id) {
+        return id == MajorEigenValues::id() || id == IntermediateEigenValues::id() ||
+               id == MinorEigenValues::id() || id == MajorEigenVectors::id() ||
+               id == IntermediateEigenVectors::id() || id == MinorEigenVectors::id();
+    };
+    // The snapshot keeps the metadata alive while the streams point into it
+    const auto metaDataItems = tensorField.metaData();
+    for (const auto &dataItem : metaDataItems) {
+        if (!settings.includeMetaData && !isEigenData(dataItem.first)) continue;
+
+        const auto &metaData = *dataItem.second;
+        if (metaData.getDataFormat()->getNumericType() != NumericType::Float ||
+            metaData.getDataFormat()->getPrecision() != 64) {
+            throw FileException("Metadata '" + metaData.getDisplayName() +
+                                    "' does not hold double data and cannot be written.",
+                                IVW_CONTEXT_CUSTOM("tfb::write"));
+        }
+        streams.push_back({dataItem.first, static_cast<uint64_t>(metaData.getTensorFeature()),
+                           static_cast<uint32_t>(metaData.getNumberOfComponents()), scalarType});
+        sources.push_back(static_cast<const unsigned char *>(metaData.getDataPtr()));
+    }
+    header.numStreams = streams.size();
+
+    // Write next to the target and replace it once done. Memory mapped readers of the old file
+    // keep seeing the old contents instead of a truncated file.
+    const auto tmpPath = filePath + ".tmp";
+    std::ofstream out(tmpPath, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!out) {
+        throw FileException("Could not open file for writing: " + tmpPath,
+                            IVW_CONTEXT_CUSTOM("tfb::write"));
+    }
+
+    const auto versionSize = versionString.size();
+    const size_t version = TFB_CURRENT_VERSION;
+    out.write(reinterpret_cast<const char *>(&versionSize), sizeof(size_t));
+    out.write(versionString.data(), versionSize);
+    out.write(reinterpret_cast<const char *>(&version), sizeof(size_t));
+    out.write(reinterpret_cast<const char *>(&header), sizeof(FileHeader));
+    out.write(reinterpret_cast<const char *>(streams.data()), streams.size() * sizeof(StreamInfo));
+
+    // The size of compressed chunks is only known once they are written, the chunk index is
+    // written last
+    const auto indexOffset = static_cast<size_t>(out.tellp());
+    std::vector<ChunkInfo> chunks(streams.size() * numBricks);
+    writeZeros(out, chunks.size() * sizeof(ChunkInfo));
+
+    const auto &tensors = tensorField.tensors();
+    auto position = indexOffset + chunks.size() * sizeof(ChunkInfo);
+    ChunkWriter writer(out, 2);
+    std::vector<unsigned char> buffer;
+    std::vector<unsigned char> encoded;
+    for (size_t s = 0; s < streams.size(); ++s) {
+        const auto elementSize = streams[s].numberOfComponents * scalarSize(streams[s].scalarType);
+        const auto isFloat = streams[s].scalarType == ScalarType::Float32;
+        for (size_t b = 0; b < numBricks; ++b) {
+            const auto brick = getBrick(dimensions, brickSize, b);
+            buffer.resize(glm::compMul(brick.dimensions) * elementSize);
+
+            if (streams[s].id == tensorStreamId) {
+                forEachBrickRow(dimensions, brick, [&](size_t src, size_t dst, size_t count) {
+                    for (size_t i = 0; i < count; ++i) {
+                        const auto tensor = tensors[src + i];
+                        if (isFloat) {
+                            std::transform(glm::value_ptr(tensor), glm::value_ptr(tensor) + 9,
+                                           reinterpret_cast<float *>(buffer.data()) + 9 * (dst + i),
+                                           [](double v) { return static_cast<float>(v); });
+                        } else {
+                            reinterpret_cast<dmat3 *>(buffer.data())[dst + i] = tensor;
+                        }
+                    }
+                });
+            } else if (isFloat) {
+                const auto components = streams[s].numberOfComponents;
+                const auto source = reinterpret_cast<const double *>(sources[s]);
+                forEachBrickRow(dimensions, brick, [&](size_t src, size_t dst, size_t count) {
+                    std::transform(source + src * components, source + (src + count) * components,
+                                   reinterpret_cast<float *>(buffer.data()) + dst * components,
+                                   [](double v) { return static_cast<float>(v); });
+                });
+            } else {
+                forEachBrickRow(dimensions, brick, [&](size_t src, size_t dst, size_t count) {
+                    std::memcpy(buffer.data() + dst * elementSize, sources[s] + src * elementSize,
+                                count * elementSize);
+                });
+            }
+
+            auto &chunk = chunks[s * numBricks + b];
+            auto *data = &buffer;
+            chunk = {0, buffer.size(), Encoding::Raw, Filter::None};
+            if (settings.compress) {
+                const auto filter = settings.shuffle && streams[s].scalarType != ScalarType::UInt8
+                                        ? Filter::ByteShuffle
+                                        : Filter::None;
+                if (compressChunk(buffer, scalarSize(streams[s].scalarType), filter, encoded)) {
+                    data = &encoded;
+                    chunk = {0, encoded.size(), Encoding::Deflate, filter};
+                }
+            }
+
+            chunk.offset = alignUp(position, chunkAlignment);
+            writer.push(chunk.offset - position, std::move(*data));
+            position = chunk.offset + chunk.size;
+
+            if (settings.progress) {
+                settings.progress(static_cast<float>(s * numBricks + b + 1) /
+                                  static_cast<float>(chunks.size()));
+            }
+        }
+    }
+    writer.finish();
+
+    out.seekp(indexOffset);
+    out.write(reinterpret_cast<const char *>(chunks.data()), chunks.size() * sizeof(ChunkInfo));
+
+    out.close();
+    if (!out) {
+        std::remove(tmpPath.c_str());
+        throw FileException("Failed to write file: " + tmpPath, IVW_CONTEXT_CUSTOM("tfb::write"));
+    }
+
+    replaceFile(tmpPath, filePath);
+}
+
+std::unique_ptr<MetaDataBase> createMetaData(const uint64_t id) {
+    switch (id) {
+        case MajorEigenVectors::id():
+            return std::make_unique<MajorEigenVectors>();
+        case IntermediateEigenVectors::id():
+            return std::make_unique<IntermediateEigenVectors>();
+        case MinorEigenVectors::id():
+            return std::make_unique<MinorEigenVectors>();
+        case MajorEigenValues::id():
+            return std::make_unique<MajorEigenValues>();
+        case IntermediateEigenValues::id():
+            return std::make_unique<IntermediateEigenValues>();
+        case MinorEigenValues::id():
+            return std::make_unique<MinorEigenValues>();
+        case I1::id():
+            return std::make_unique<I1>();
+        case I2::id():
+            return std::make_unique<I2>();
+        case I3::id():
+            return std::make_unique<I3>();
+        case J1::id():
+            return std::make_unique<J1>();
+        case J2::id():
+            return std::make_unique<J2>();
+        case J3::id():
+            return std::make_unique<J3>();
+        case LodeAngle::id():
+            return std::make_unique<LodeAngle>();
+        case Anisotropy::id():
+            return std::make_unique<Anisotropy>();
+        case LinearAnisotropy::id():
+            return std::make_unique<LinearAnisotropy>();
+        case PlanarAnisotropy::id():
+            return std::make_unique<PlanarAnisotropy>();
+        case SphericalAnisotropy::id():
+            return std::make_unique<SphericalAnisotropy>();
+        case Diffusivity::id():
+            return std::make_unique<Diffusivity>();
+        case ShearStress::id():
+            return std::make_unique<ShearStress>();
+        case PureShear::id():
+            return std::make_unique<PureShear>();
+        case ShapeFactor::id():
+            return std::make_unique<ShapeFactor>();
+        case IsotropicScaling::id():
+            return std::make_unique<IsotropicScaling>();
+        case Rotation::id():
+            return std::make_unique<Rotation>();
+        case FrobeniusNorm::id():
+            return std::make_unique<FrobeniusNorm>();
+        case HillYieldCriterion::id():
+            return std::make_unique<HillYieldCriterion>();
+        default:
+            return nullptr;
+    }
+}
+
+}  // namespace tfb
+
+TFBFile::TFBFile(const std::string &filePath) : filePath_(filePath) {
+    std::ifstream in(filePath, std::ios::in | std::ios::binary);
+    if (!in) {
+        throw FileException("Couldn't open file: " + filePath, IVW_CONTEXT);
+    }
+
+    size_t size = 0;
+    in.read(reinterpret_cast<char *>(&size), sizeof(size_t));
+    std::string versionStr(std::min(size, versionString.size() + 1), '\0');
+    in.read(&versionStr[0], versionStr.size());
+
+    if (!in || versionStr != versionString) {
+        throw DataReaderException("No valid tfb file: " + filePath, IVW_CONTEXT);
+    }
+
+    in.read(reinterpret_cast<char *>(&version_), sizeof(size_t));
+
+    if (version_ == tfb::streamVersion) {
+        readStreamFormat(in);
+    } else if (version_ == TFB_CURRENT_VERSION) {
+        const auto headerOffset = static_cast<size_t>(in.tellg());
+        in.close();
+        readChunkedFormat(headerOffset);
+    } else if (version_ < tfb::streamVersion) {
+        throw DataReaderException("Please update the tfb file. Current version is " +
+                                      toString(TFB_CURRENT_VERSION) + ", file has " +
+                                      toString(version_),
+                                  IVW_CONTEXT);
+    } else {
+        throw DataReaderException("Unsupported tfb version " + toString(version_), IVW_CONTEXT);
+    }
+}
+
+void TFBFile::readStreamFormat(std::istream &in) {
+    size_t dimensionality = 0;
+    size_t rank = 0;
+    glm::uint8 hasMetaData = 0;
+    in.read(reinterpret_cast<char *>(&dimensionality), sizeof(size_t));
+    in.read(reinterpret_cast<char *>(&rank), sizeof(size_t));
+    in.read(reinterpret_cast<char *>(&hasMetaData), sizeof(glm::uint8));
+
+    if (dimensionality != 3) {
+        throw DataReaderException("The loaded file is not a 3D tensor field. Try the 2D reader.",
+                                  IVW_CONTEXT);
+    }
+
+    in.read(reinterpret_cast<char *>(header_.dimensions), sizeof(uint64_t) * 3);
+    in.read(reinterpret_cast<char *>(header_.extents), sizeof(double) * 3);
+    in.read(reinterpret_cast<char *>(header_.offset), sizeof(double) * 3);
+    in.read(reinterpret_cast<char *>(header_.eigenValueRanges), sizeof(double) * 6);
+    in.read(reinterpret_cast<char *>(header_.eigenVectorRanges), sizeof(double) * 6);
+    std::copy(std::begin(header_.dimensions), std::end(header_.dimensions), header_.brickSize);
+
+    // The header is checked against the size of the file before anything is allocated
+    const auto dataStart = in.tellg();
+    in.seekg(0, std::ios::end);
+    const auto remaining = static_cast<size_t>(in.tellg() - dataStart);
+    in.seekg(dataStart);
+
+    size_t numElements = 1;
+    for (const auto dim : header_.dimensions) {
+        // Every element holds at least one tensor of 9 doubles
+        if (dim == 0 || dim > remaining / (9 * sizeof(double)) / numElements) {
+            numElements = 0;
+            break;
+        }
+        numElements *= dim;
+    }
+    if (!in || numElements == 0) {
+        throw DataReaderException("Invalid tfb header in " + filePath_, IVW_CONTEXT);
+    }
+
+    // The streams are kept in a single block of memory, laid out as a chunked file with a single
+    // brick so that both formats can be accessed in the same way
+    auto memory = std::make_shared<std::vector<unsigned char>>();
+    const auto readStream = [&](const tfb::StreamInfo &stream) {
+        const auto offset = alignUp(memory->size(), 64);
+        const auto size = numElements * getElementSize(stream);
+        memory->resize(offset + size);
+        in.read(reinterpret_cast<char *>(memory->data() + offset), size);
+        if (!in) {
+            throw DataReaderException("Dimensions do not match data size", IVW_CONTEXT);
+        }
+        streams_.push_back(stream);
+        chunks_.push_back({offset, size, tfb::Encoding::Raw, tfb::Filter::None});
+        return memory->data() + offset;
+    };
+
+    // The tensors are stored in row-major order
+    auto tensors = reinterpret_cast<dmat3 *>(readStream({tfb::tensorStreamId, 0, 9}));
+    std::transform(tensors, tensors + numElements, tensors,
+                   [](const dmat3 &tensor) { return glm::transpose(tensor); });
+
+    glm::uint8 hasMask = 0;
+    in.read(reinterpret_cast<char *>(&hasMask), sizeof(glm::uint8));
+    if (hasMask) {
+        readStream({tfb::maskStreamId, 0, 1, tfb::ScalarType::UInt8});
+    }
+
+    if (hasMetaData) {
+        size_t numMetaDataEntries = 0;
+        in.read(reinterpret_cast<char *>(&numMetaDataEntries), sizeof(size_t));
+
+        for (size_t i = 0; i < numMetaDataEntries; i++) {
+            uint64_t id = 0;
+            uint64_t feature = 0;
+            in.read(reinterpret_cast<char *>(&id), sizeof(uint64_t));
+            in.read(reinterpret_cast<char *>(&feature), sizeof(uint64_t));
+
+            // The size of the entries is not stored, so unknown entries cannot be skipped
+            const auto metaData = tfb::createMetaData(id);
+            if (!metaData) {
+                throw DataReaderException(
+                    "Unknown meta data entry. Revise tensor field import for missing meta data "
+                    "entry.",
+                    IVW_CONTEXT);
+            }
+            readStream({id, feature, static_cast<uint32_t>(metaData->getNumberOfComponents())});
+        }
+    }
+
+    std::string str;
+    size_t size = 0;
+    in.read(reinterpret_cast<char *>(&size), sizeof(size_t));
+    str.resize(std::min(size, size_t{16}));
+    in.read(&str[0], str.size());
+
+    if (str != "EOFreached") {
+        throw DataReaderException("EOF not reached", IVW_CONTEXT);
+    }
+
+    header_.numStreams = streams_.size();
+    data_ = memory->data();
+    size_ = memory->size();
+    memory_ = std::move(memory);
+}
+
+void TFBFile::readChunkedFormat(const size_t headerOffset) {
+    auto file = std::make_shared<MemoryMappedFile>(filePath_);
+    data_ = file->data();
+    size_ = file->size();
+    memory_ = std::move(file);
+
+    // Everything read from the file is checked against the size of the mapping before it is used
+    // to allocate or index anything, so corrupt files are rejected instead of exhausting memory
+    auto offset = std::min(headerOffset, size_);
+    const auto remaining = [&]() { return size_ - offset; };
+    const auto read = [&](void *dst, const size_t bytes) {
+        if (bytes > remaining()) {
+            throw DataReaderException("Truncated tfb file: " + filePath_, IVW_CONTEXT);
+        }
+        std::memcpy(dst, data_ + offset, bytes);
+        offset += bytes;
+    };
+    const auto invalid = [&](const std::string &what) {
+        return DataReaderException("Invalid " + what + " in " + filePath_, IVW_CONTEXT);
+    };
+
+    read(&header_, sizeof(tfb::FileHeader));
+
+    // Each element takes at least one byte once decoded, which bounds the number of elements
+    const auto maxElements = maxDecodedSize(size_);
+    size_t numElements = 1;
+    for (size_t i = 0; i < 3; ++i) {
+        const auto dim = header_.dimensions[i];
+        if (dim == 0 || dim > maxElements / numElements || header_.brickSize[i] == 0 ||
+            header_.brickSize[i] > dim) {
+            throw invalid("tfb header");
+        }
+        numElements *= dim;
+    }
+
+    if (header_.numStreams > remaining() / sizeof(tfb::StreamInfo)) throw invalid("tfb header");
+    streams_.resize(header_.numStreams);
+    read(streams_.data(), streams_.size() * sizeof(tfb::StreamInfo));
+    for (const auto &stream : streams_) {
+        if (stream.numberOfComponents == 0 || stream.numberOfComponents > maxNumberOfComponents ||
+            static_cast<uint32_t>(stream.scalarType) > 2) {
+            throw invalid("stream");
+        }
+    }
+
+    const auto numBricks = getNumberOfBricks();
+    if (!streams_.empty() &&
+        numBricks > remaining() / sizeof(tfb::ChunkInfo) / streams_.size()) {
+        throw invalid("chunk index");
+    }
+    chunks_.resize(streams_.size() * numBricks);
+    read(chunks_.data(), chunks_.size() * sizeof(tfb::ChunkInfo));
+
+    for (size_t s = 0; s < streams_.size(); ++s) {
+        const auto elementSize = getElementSize(streams_[s]);
+        for (size_t b = 0; b < numBricks; ++b) {
+            const auto &chunk = chunks_[s * numBricks + b];
+            const auto brickElements =
+                glm::compMul(getBrick(getDimensions(), getBrickSize(), b).dimensions);
+            if (chunk.offset > size_ || chunk.size > size_ - chunk.offset ||
+                (chunk.filter != tfb::Filter::None && chunk.filter != tfb::Filter::ByteShuffle)) {
+                throw invalid("chunk index");
+            }
+            switch (chunk.encoding) {
+                case tfb::Encoding::Raw:
+                    if (chunk.size % elementSize != 0 ||
+                        chunk.size / elementSize != brickElements) {
+                        throw invalid("chunk index");
+                    }
+                    break;
+                case tfb::Encoding::Deflate:
+                    if (brickElements > maxDecodedSize(chunk.size) / elementSize) {
+                        throw invalid("chunk index");
+                    }
+                    break;
+                default:
+                    throw invalid("chunk index");
+            }
+        }
+    }
+}
+
+size3_t TFBFile::getDimensions() const {
+    return size3_t(header_.dimensions[0], header_.dimensions[1], header_.dimensions[2]);
+}
+
+size3_t TFBFile::getBrickSize() const {
+    return size3_t(header_.brickSize[0], header_.brickSize[1], header_.brickSize[2]);
+}
+
+bool TFBFile::hasMask() const {
+    return std::any_of(streams_.begin(), streams_.end(), [](const tfb::StreamInfo &stream) {
+        return stream.id == tfb::maskStreamId;
+    });
+}
+
+std::vector<uint64_t> TFBFile::getMetaDataIds() const {
+    std::vector<uint64_t> ids;
+    for (const auto &stream : streams_) {
+        if (stream.id != tfb::tensorStreamId && stream.id != tfb::maskStreamId) {
+            ids.push_back(stream.id);
+        }
+    }
+    return ids;
+}
+
+size_t TFBFile::findStream(const uint64_t id) const {
+    const auto it = std::find_if(streams_.begin(), streams_.end(),
+                                 [id](const tfb::StreamInfo &stream) { return stream.id == id; });
+    if (it == streams_.end()) {
+        throw DataReaderException("Missing data stream in " + filePath_, IVW_CONTEXT);
+    }
+    return static_cast<size_t>(std::distance(streams_.begin(), it));
+}
+
+size_t TFBFile::getElementSize(const tfb::StreamInfo &stream) const {
+    return stream.numberOfComponents * scalarSize(stream.scalarType);
+}
+
+size_t TFBFile::getNumberOfBricks() const {
+    return glm::compMul(numberOfBricks(getDimensions(), getBrickSize()));
+}
+
+const unsigned char *TFBFile::getChunk(const size_t stream, const size_t brick) const {
+    return data_ + chunks_[stream * getNumberOfBricks() + brick].offset;
+}
+
+const unsigned char *TFBFile::decodeChunk(const size_t stream, const size_t brick,
+                                          std::vector<unsigned char> &buffer) const {
+    const auto &chunk = chunks_[stream * getNumberOfBricks() + brick];
+    if (chunk.encoding == tfb::Encoding::Raw) return getChunk(stream, brick);
+
+    const auto &info = streams_[stream];
+    const auto size = glm::compMul(getBrick(getDimensions(), getBrickSize(), brick).dimensions) *
+                      getElementSize(info);
+
+    std::vector<unsigned char> shuffled;
+    auto &decompressed = chunk.filter == tfb::Filter::ByteShuffle ? shuffled : buffer;
+    decompressed.resize(size);
+    auto decompressedSize = static_cast<uLongf>(size);
+    if (uncompress(decompressed.data(), &decompressedSize, getChunk(stream, brick),
+                   static_cast<uLong>(chunk.size)) != Z_OK ||
+        decompressedSize != size) {
+        throw DataReaderException("Corrupt chunk in " + filePath_, IVW_CONTEXT);
+    }
+
+    if (chunk.filter == tfb::Filter::ByteShuffle) {
+        buffer.resize(size);
+        unshuffle(shuffled.data(), size, scalarSize(info.scalarType), buffer.data());
+    }
+    return buffer.data();
+}
+
+void TFBFile::gather(const size_t stream, const size3_t &origin, const size3_t &size,
+                     void *dst) const {
+    const auto elementSize = getElementSize(streams_[stream]);
+    const auto dimensions = getDimensions();
+    const auto brickSize = getBrickSize();
+    const auto bricks = numberOfBricks(dimensions, brickSize);
+    const auto first = origin / brickSize;
+    const auto last = (origin + size - size3_t(1)) / brickSize;
+    auto out = static_cast<unsigned char *>(dst);
+
+    std::vector<size_t> overlapping;
+    for (size_t bz = first.z; bz <= last.z; ++bz) {
+        for (size_t by = first.y; by <= last.y; ++by) {
+            for (size_t bx = first.x; bx <= last.x; ++bx) {
+                overlapping.push_back((bz * bricks.y + by) * bricks.x + bx);
+            }
+        }
+    }
+
+    const auto copyBrick = [&](const size_t i) {
+        const auto index = overlapping[i];
+        const auto brick = getBrick(dimensions, brickSize, index);
+        std::vector<unsigned char> buffer;
+        const auto src = decodeChunk(stream, index, buffer);
+
+        // The part of the region covered by this brick
+        const auto lo = glm::max(origin, brick.origin);
+        const auto hi = glm::min(origin + size, brick.origin + brick.dimensions);
+        const auto count = (hi.x - lo.x) * elementSize;
+
+        for (size_t z = lo.z; z < hi.z; ++z) {
+            for (size_t y = lo.y; y < hi.y; ++y) {
+                const auto srcIndex =
+                    ((z - brick.origin.z) * brick.dimensions.y + (y - brick.origin.y)) *
+                        brick.dimensions.x +
+                    (lo.x - brick.origin.x);
+                const auto dstIndex =
+                    ((z - origin.z) * size.y + (y - origin.y)) * size.x + (lo.x - origin.x);
+                std::memcpy(out + dstIndex * elementSize, src + srcIndex * elementSize, count);
+            }
+        }
+    };
+
+    // Each brick covers a distinct part of the region, so they can be decoded independently
+    const auto settings = InviwoApplication::getPtr()->getSettingsByType<SystemSettings>();
+    const auto chunks =
+        std::min(overlapping.size(), static_cast<size_t>(settings->poolSize_.get()));
+    tensorutil::detail::forEachChunk(overlapping.size(), chunks,
+                                     [&](size_t, size_t begin, size_t end) {
+                                         for (size_t i = begin; i < end; ++i) copyBrick(i);
+                                     });
+}
+
+std::shared_ptr<TensorField3D> TFBFile::read(const TensorStorageMode mode) const {
+    return read(size3_t(0), getDimensions(), mode);
+}
+
+std::shared_ptr<TensorField3D> TFBFile::read(const size3_t &origin, const size3_t &size,
+                                             const TensorStorageMode mode) const {
+    const auto dimensions = getDimensions();
+    if (glm::compMul(size) == 0 || glm::any(glm::greaterThan(origin + size, dimensions))) {
+        throw Exception("Region is outside of the tensor field.", IVW_CONTEXT);
+    }
+
+    const auto numElements = glm::compMul(size);
+    const auto isWholeField = origin == size3_t(0) && size == dimensions;
+
+    const auto tensorStream = findStream(tfb::tensorStreamId);
+    const auto isFloat = streams_[tensorStream].scalarType == tfb::ScalarType::Float32;
+    TensorStorage3D tensors;
+    if (isChunked() && isWholeField && getNumberOfBricks() == 1 &&
+        mode == TensorStorageMode::Full && !isFloat &&
+        chunks_[tensorStream].encoding == tfb::Encoding::Raw) {
+        // Use the tensors in place, the storage keeps the mapping alive
+        const auto data = reinterpret_cast<const dmat3 *>(getChunk(tensorStream, 0));
+        tensors = TensorStorage3D(std::shared_ptr<const dmat3>(memory_, data), numElements);
+    } else if (isFloat) {
+        std::vector<float> data(numElements * 9);
+        gather(tensorStream, origin, size, data.data());
+        tensors = TensorStorage3D::fromStrided(data.data(), numElements, 9, mode);
+    } else {
+        std::vector<dmat3> data(numElements);
+        gather(tensorStream, origin, size, data.data());
+        tensors = TensorStorage3D(std::move(data), mode);
+    }
+
+    std::unordered_map<uint64_t, std::unique_ptr<MetaDataBase>> metaData;
+    for (size_t s = 0; s < streams_.size(); ++s) {
+        const auto &stream = streams_[s];
+        if (stream.id == tfb::tensorStreamId || stream.id == tfb::maskStreamId) continue;
+
+        auto entry = tfb::createMetaData(stream.id);
+        if (!entry || entry->getNumberOfComponents() != stream.numberOfComponents) {
+            LogWarnCustom("TFBFile", "Skipping unknown meta data entry in " << filePath_);
+            continue;
+        }
+        auto dst = static_cast<double *>(
+            entry->allocate(numElements, static_cast<TensorFeature>(stream.feature)));
+        if (stream.scalarType == tfb::ScalarType::Float32) {
+            std::vector<float> data(numElements * stream.numberOfComponents);
+            gather(s, origin, size, data.data());
+            std::copy(data.begin(), data.end(), dst);
+        } else {
+            gather(s, origin, size, dst);
+        }
+        metaData.insert(std::make_pair(stream.id, std::move(entry)));
+    }
+
+    const dvec3 extents(header_.extents[0], header_.extents[1], header_.extents[2]);
+    const dvec3 offset(header_.offset[0], header_.offset[1], header_.offset[2]);
+    const auto spacing = extents / dvec3(glm::max(dimensions - size3_t(1), size3_t(1)));
+    const auto regionExtents =
+        isWholeField ? extents : spacing * dvec3(glm::max(size - size3_t(1), size3_t(1)));
+
+    auto tensorField = std::make_shared<TensorField3D>(size, std::move(tensors),
+                                                       std::move(metaData), vec3(regionExtents));
+    tensorField->setOffset(vec3(offset + spacing * dvec3(origin)));
+
+    if (hasMask()) {
+        std::vector<glm::uint8> mask(numElements);
+        gather(findStream(tfb::maskStreamId), origin, size, mask.data());
+        tensorField->setMask(mask);
+    }
+
+    // The stored data ranges are only valid for the whole field
+    if (isWholeField) {
+        std::array<DataMapper, 3> eigenValues;
+        std::array<DataMapper, 3> eigenVectors;
+        for (size_t i = 0; i < 3; ++i) {
+            eigenValues[i].dataRange =
+                dvec2(header_.eigenValueRanges[i][0], header_.eigenValueRanges[i][1]);
+            eigenValues[i].valueRange = eigenValues[i].dataRange;
+            eigenVectors[i].dataRange =
+                dvec2(header_.eigenVectorRanges[i][0], header_.eigenVectorRanges[i][1]);
+            eigenVectors[i].valueRange = eigenVectors[i].dataRange;
+        }
+        tensorField->setDataMapEigenValues(eigenValues);
+        tensorField->setDataMapEigenVectors(eigenVectors);
+    }
+
+    return tensorField;
+}
+
+}  // namespace inviwo
@@ -0,0 +1,221 @@
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/tensorvisio/util/nrrdformat.h>
+#include <inviwo/core/io/datareaderexception.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+namespace inviwo {
+namespace {
+bool isLittleEndianHost() {
+    const uint16_t value = 1;
+    unsigned char first;
+    std::memcpy(&first, &value, 1);
+    return first == 1;
+}
+
+uint32_t crc32(const std::vector<unsigned char> &data) {
+    uint32_t crc = 0xFFFFFFFFu;
+    for (const auto byte : data) {
+        crc ^= byte;
+        for (int i = 0; i < 8; ++i) crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+    }
+    return ~crc;
+}
+
+void writeLE32(std::vector<unsigned char> &dst, const uint32_t value) {
+    for (int i = 0; i < 4; ++i) dst.push_back(static_cast<unsigned char>(value >> (8 * i)));
+}
+
+// Wraps the data in a gzip stream of uncompressed deflate blocks
+std::vector<unsigned char> gzipStored(const std::vector<unsigned char> &data) {
+    std::vector<unsigned char> gzip{0x1f, 0x8b, 8, 0, 0, 0, 0, 0, 0, 0xff};
+    size_t pos = 0;
+    do {
+        const auto size = std::min<size_t>(data.size() - pos, 0xFFFF);
+        const auto last = pos + size == data.size();
+        gzip.push_back(last ? 1 : 0);
+        gzip.push_back(static_cast<unsigned char>(size & 0xFF));
+        gzip.push_back(static_cast<unsigned char>(size >> 8));
+        gzip.push_back(static_cast<unsigned char>(~size & 0xFF));
+        gzip.push_back(static_cast<unsigned char>((~size >> 8) & 0xFF));
+        gzip.insert(gzip.end(), data.begin() + pos, data.begin() + pos + size);
+        pos += size;
+    } while (pos < data.size());
+    writeLE32(gzip, crc32(data));
+    writeLE32(gzip, static_cast<uint32_t>(data.size()));
+    return gzip;
+}
+
+template <typename T>
+std::vector<unsigned char> toBytes(const std::vector<T> &values) {
+    std::vector<unsigned char> bytes(values.size() * sizeof(T));
+    std::memcpy(bytes.data(), values.data(), bytes.size());
+    return bytes;
+}
+}  // namespace
+
+TEST(TensorVisIOTests, nrrdSwapBytes) {
+    std::vector<uint32_t> values{0x01020304u, 0xA0B0C0D0u, 0u};
+    nrrd::swapBytes(values.data(), values.size(), sizeof(uint32_t));
+    EXPECT_EQ(0x04030201u, values[0]);
+    EXPECT_EQ(0xD0C0B0A0u, values[1]);
+    EXPECT_EQ(0u, values[2]);
+}
+
+TEST(TensorVisIOTests, nrrdDetachedMaskedSymmetricForeignEndian) {
+    const size3_t dimensions(3, 2, 2);
+    const auto numTensors = glm::compMul(dimensions);
+
+    // confidence, xx, xy, xz, yy, yz, zz
+    std::vector<float> values;
+    for (size_t i = 0; i < numTensors; ++i) {
+        const auto v = static_cast<float>(i);
+        const float confidence = i == 1 ? 0.5f : 1.0f;
+        for (const auto c : {confidence, v, 1.0f, 2.0f, v + 1.0f, 3.0f, v + 2.0f}) {
+            values.push_back(c);
+        }
+    }
+    nrrd::swapBytes(values.data(), values.size(), sizeof(float));
+
+    const std::string headerPath = "nrrd-detached.nhdr";
+    const std::string rawPath = "nrrd-detached.raw";
+    {
+        std::ofstream raw(rawPath, std::ios::out | std::ios::binary);
+        raw << "skipped line\n";
+        raw.write(reinterpret_cast<const char *>(values.data()), values.size() * sizeof(float));
+
+        std::ofstream header(headerPath);
+        header << "NRRD0004\n"
+               << "# a comment\n"
+               << "type: float\n"
+               << "dimension: 4\n"
+               << "space: right-anterior-superior\n"
+               << "sizes: 7 3 2 2\n"
+               << "kinds: 3D-masked-symmetric-matrix space space space\n"
+               << "endian: " << (isLittleEndianHost() ? "big" : "little") << "\n"
+               << "encoding: raw\n"
+               << "space directions: none (0.5,0,0) (0,2,0) (0,0,1)\n"
+               << "space origin: (1,2,3)\n"
+               << "line skip: 1\n"
+               << "data file: " << rawPath << "\n"
+               << "modality:=DWMRI\n";
+    }
+
+    const auto volume = nrrd::readTensors(headerPath);
+    EXPECT_EQ(nrrd::TensorKind::MaskedSymmetricMatrix, volume.kind);
+    EXPECT_EQ(dimensions, volume.dimensions);
+    EXPECT_EQ(dvec3(1.0, 0.0, 0.0), volume.basis[0]);
+    EXPECT_EQ(dvec3(0.0, 2.0, 0.0), volume.basis[1]);
+    EXPECT_EQ(dvec3(1.0, 2.0, 3.0), volume.offset);
+
+    for (size_t i = 0; i < numTensors; ++i) {
+        const auto v = static_cast<double>(i);
+        const auto expected =
+            i == 1 ? dmat3(0.0) : dmat3(v, 1.0, 2.0, 1.0, v + 1.0, 3.0, 2.0, 3.0, v + 2.0);
+        EXPECT_EQ(expected, volume.tensors[i]);
+        EXPECT_EQ(i == 1 ? 0.5f : 1.0f, volume.confidence[i]);
+    }
+
+    std::remove(headerPath.c_str());
+    std::remove(rawPath.c_str());
+}
+
+TEST(TensorVisIOTests, nrrdAttachedGzipMatrixLastAxis) {
+    const size3_t dimensions(2, 3, 2);
+    const auto numTensors = glm::compMul(dimensions);
+
+    // Tensor axis last, i.e. one block of samples per component, components in row-major order
+    std::vector<double> values(9 * numTensors);
+    for (size_t c = 0; c < 9; ++c) {
+        for (size_t i = 0; i < numTensors; ++i) {
+            values[c * numTensors + i] = static_cast<double>(10 * i + c);
+        }
+    }
+
+    const std::string filePath = "nrrd-attached.nrrd";
+    {
+        std::ofstream file(filePath, std::ios::out | std::ios::binary);
+        file << "NRRD0004\n"
+             << "type: double\n"
+             << "dimension: 4\n"
+             << "sizes: 2 3 2 9\n"
+             << "kinds: space space space 3D-matrix\n"
+             << "endian: " << (isLittleEndianHost() ? "little" : "big") << "\n"
+             << "encoding: gzip\n"
+             << "spacings: 1 0.5 2 nan\n"
+             << "\n";
+        const auto compressed = gzipStored(toBytes(values));
+        file.write(reinterpret_cast<const char *>(compressed.data()), compressed.size());
+    }
+
+    const auto volume = nrrd::readTensors(filePath);
+    EXPECT_EQ(nrrd::TensorKind::Matrix, volume.kind);
+    EXPECT_EQ(dimensions, volume.dimensions);
+    EXPECT_EQ(dvec3(1.0, 0.0, 0.0), volume.basis[0]);
+    EXPECT_EQ(dvec3(0.0, 1.0, 0.0), volume.basis[1]);
+    EXPECT_EQ(dvec3(0.0, 0.0, 2.0), volume.basis[2]);
+
+    for (size_t i = 0; i < numTensors; ++i) {
+        const auto &tensor = volume.tensors[i];
+        for (glm::length_t row = 0; row < 3; ++row) {
+            for (glm::length_t col = 0; col < 3; ++col) {
+                EXPECT_EQ(static_cast<double>(10 * i + 3 * row + col), tensor[col][row]);
+            }
+        }
+        EXPECT_EQ(1.0f, volume.confidence[i]);
+    }
+
+    std::remove(filePath.c_str());
+}
+
+TEST(TensorVisIOTests, nrrdDataFilePattern) {
+    const std::string headerPath = "nrrd-pattern.nhdr";
+    {
+        std::ofstream header(headerPath);
+        header << "NRRD0004\n"
+               << "type: uchar\n"
+               << "dimension: 4\n"
+               << "sizes: 6 1 1 2\n"
+               << "encoding: raw\n"
+               << "data file: slice%02d.raw 9 10 1\n";
+    }
+
+    const auto header = nrrd::readHeader(headerPath);
+    ASSERT_EQ(2u, header.dataFiles.size());
+    EXPECT_EQ("slice09.raw", header.dataFiles[0].substr(header.dataFiles[0].size() - 11));
+    EXPECT_EQ("slice10.raw", header.dataFiles[1].substr(header.dataFiles[1].size() - 11));
+
+    std::remove(headerPath.c_str());
+}
+
+TEST(TensorVisIOTests, nrrdRejectsMalformedHeaders) {
+    const std::string filePath = "nrrd-malformed.nrrd";
+    for (const std::string fields :
+         {"sizes: 6 1 1 1\ndata file: slice%s.raw 1 2 1\n",
+          "sizes: 6 1 1 1\ndata file: slice%d%n.raw 1 2 1\n",
+          "sizes: 6 1 1 1\ndata file: slice%d.raw 1 x 1\n",
+          "sizes: 6 65536 65536 4294967296\n", "sizes: 6 1000 1000 1000\n"}) {
+        {
+            std::ofstream file(filePath, std::ios::out | std::ios::binary);
+            file << "NRRD0004\n"
+                 << "type: double\n"
+                 << "dimension: 4\n"
+                 << "endian: little\n"
+                 << "encoding: raw\n"
+                 << fields << "\n";
+            file.write("data", 4);
+        }
+        EXPECT_THROW(nrrd::readTensors(filePath), DataReaderException) << fields;
+    }
+
+    std::remove(filePath.c_str());
+}
+
+}  // namespace inviwo
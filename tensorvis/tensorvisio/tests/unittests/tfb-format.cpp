@@ -0,0 +1,232 @@
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/tensorvisio/util/tfbformat.h>
+#include <inviwo/core/util/indexmapper.h>
+
+#include <cstddef>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+
+namespace inviwo {
+namespace {
+std::shared_ptr<TensorField3D> createTensorField(const size3_t &dimensions) {
+    std::vector<dmat3> tensors(glm::compMul(dimensions));
+    std::vector<double> scalars(tensors.size());
+    std::vector<glm::uint8> mask(tensors.size());
+    for (size_t i = 0; i < tensors.size(); ++i) {
+        const auto v = static_cast<double>(i);
+        tensors[i] = dmat3(v, 1.0, 2.0, 1.0, v + 1.0, 3.0, 2.0, 3.0, v + 2.0);
+        scalars[i] = -v;
+        mask[i] = static_cast<glm::uint8>(i % 2);
+    }
+
+    auto tensorField = std::make_shared<TensorField3D>(dimensions, std::move(tensors), vec3(2.0f));
+    tensorField->setOffset(vec3(1.0f, 2.0f, 3.0f));
+    tensorField->setMask(mask);
+    tensorField->addMetaData<I1>(scalars, TensorFeature::I1);
+    return tensorField;
+}
+
+const double *metaDataPtr(const TensorField3D &tensorField, const uint64_t id) {
+    return static_cast<const double *>(tensorField.metaData().at(id)->getDataPtr());
+}
+}  // namespace
+
+TEST(TensorVisIOTests, tfbChunkedRoundTrip) {
+    const size3_t dimensions(5, 4, 3);
+    const auto tensorField = createTensorField(dimensions);
+    const std::string filePath = "tfb-chunked-round-trip.tfb";
+
+    tfb::WriteSettings settings;
+    settings.brickSize = size3_t(2);
+    tfb::write(*tensorField, filePath, settings);
+
+    {
+        TFBFile file(filePath);
+        EXPECT_TRUE(file.isChunked());
+        EXPECT_EQ(dimensions, file.getDimensions());
+        EXPECT_EQ(size3_t(2), file.getBrickSize());
+        EXPECT_TRUE(file.hasMask());
+
+        const auto loaded = file.read(TensorStorageMode::Symmetric);
+        EXPECT_EQ(dimensions, loaded->getDimensions());
+        EXPECT_EQ(tensorField->getOffset(), loaded->getOffset());
+        EXPECT_EQ(tensorField->getMask(), loaded->getMask());
+        for (size_t i = 0; i < glm::compMul(dimensions); ++i) {
+            EXPECT_EQ(tensorField->tensors()[i], loaded->tensors()[i]);
+            EXPECT_EQ(-static_cast<double>(i), metaDataPtr(*loaded, I1::id())[i]);
+        }
+    }
+
+    std::remove(filePath.c_str());
+}
+
+TEST(TensorVisIOTests, tfbRegionOnlyContainsRegion) {
+    const size3_t dimensions(5, 4, 3);
+    const auto tensorField = createTensorField(dimensions);
+    const std::string filePath = "tfb-region.tfb";
+
+    tfb::WriteSettings settings;
+    settings.brickSize = size3_t(2);
+    tfb::write(*tensorField, filePath, settings);
+
+    {
+        const size3_t origin(1, 1, 1);
+        const size3_t size(3, 2, 2);
+        const auto region = TFBFile(filePath).read(origin, size);
+
+        EXPECT_EQ(size, region->getDimensions());
+        const auto spacing = tensorField->getSpacing<double>();
+        for (glm::length_t i = 0; i < 3; ++i) {
+            EXPECT_NEAR(spacing[i], region->getSpacing<double>()[i], 1.0e-6);
+        }
+
+        const util::IndexMapper3D fieldIndex(dimensions);
+        const util::IndexMapper3D regionIndex(size);
+        for (size_t z = 0; z < size.z; ++z) {
+            for (size_t y = 0; y < size.y; ++y) {
+                for (size_t x = 0; x < size.x; ++x) {
+                    const auto i = regionIndex(x, y, z);
+                    const auto j = fieldIndex(origin + size3_t(x, y, z));
+                    EXPECT_EQ(tensorField->tensors()[j], region->tensors()[i]);
+                    EXPECT_EQ(tensorField->getMask()[j], region->getMask()[i]);
+                    EXPECT_EQ(metaDataPtr(*tensorField, I1::id())[j],
+                              metaDataPtr(*region, I1::id())[i]);
+                }
+            }
+        }
+
+        EXPECT_THROW(TFBFile(filePath).read(size3_t(4), size3_t(2)), Exception);
+    }
+
+    std::remove(filePath.c_str());
+}
+
+TEST(TensorVisIOTests, tfbSingleBrickIsMapped) {
+    const auto tensorField = createTensorField(size3_t(4));
+    const std::string filePath = "tfb-single-brick.tfb";
+
+    tfb::write(*tensorField, filePath);
+
+    {
+        const auto loaded = TFBFile(filePath).read();
+        EXPECT_TRUE(loaded->tensors().isShared());
+        EXPECT_EQ(tensorField->tensors().toMatrices(), loaded->tensors().toMatrices());
+    }
+
+    std::remove(filePath.c_str());
+}
+
+TEST(TensorVisIOTests, tfbCompressedRoundTrip) {
+    const size3_t dimensions(6, 5, 4);
+    const auto tensorField = createTensorField(dimensions);
+    const std::string filePath = "tfb-compressed.tfb";
+
+    tfb::WriteSettings settings;
+    settings.brickSize = size3_t(3);
+    settings.compress = true;
+    tfb::write(*tensorField, filePath, settings);
+
+    {
+        const auto loaded = TFBFile(filePath).read();
+        EXPECT_EQ(tensorField->tensors().toMatrices(), loaded->tensors().toMatrices());
+        EXPECT_EQ(tensorField->getMask(), loaded->getMask());
+    }
+
+    settings.floatPrecision = true;
+    tfb::write(*tensorField, filePath, settings);
+
+    {
+        const auto loaded = TFBFile(filePath).read(TensorStorageMode::SymmetricFloat);
+        // All values are small integers and thus exactly representable as float
+        EXPECT_EQ(tensorField->tensors().toMatrices(), loaded->tensors().toMatrices());
+        for (size_t i = 0; i < glm::compMul(dimensions); ++i) {
+            EXPECT_EQ(-static_cast<double>(i), metaDataPtr(*loaded, I1::id())[i]);
+        }
+    }
+
+    std::remove(filePath.c_str());
+}
+
+TEST(TensorVisIOTests, tfbRejectsCorruptIndex) {
+    const auto tensorField = createTensorField(size3_t(4));
+    const std::string filePath = "tfb-corrupt.tfb";
+
+    // The header follows the version string and the version number, the chunk index follows the
+    // header and the stream index
+    const auto headerOffset = 2 * sizeof(size_t) + std::string("TFBVersion:").size();
+    const auto corrupt = [&](const size_t offset, const uint64_t value) {
+        tfb::write(*tensorField, filePath);
+        std::fstream file(filePath, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(offset);
+        file.write(reinterpret_cast<const char *>(&value), sizeof(value));
+    };
+
+    tfb::FileHeader header;
+    tfb::write(*tensorField, filePath);
+    {
+        std::ifstream file(filePath, std::ios::in | std::ios::binary);
+        file.seekg(headerOffset);
+        file.read(reinterpret_cast<char *>(&header), sizeof(header));
+    }
+    const auto chunkIndexOffset =
+        headerOffset + sizeof(tfb::FileHeader) + header.numStreams * sizeof(tfb::StreamInfo);
+
+    // Must be rejected before allocating the stream or chunk index
+    corrupt(headerOffset + offsetof(tfb::FileHeader, numStreams), uint64_t{1} << 60);
+    EXPECT_THROW(TFBFile{filePath}, Exception);
+    corrupt(headerOffset + offsetof(tfb::FileHeader, dimensions), uint64_t{1} << 40);
+    EXPECT_THROW(TFBFile{filePath}, Exception);
+
+    // Offset of the first chunk pointing past the end of the file
+    corrupt(chunkIndexOffset + offsetof(tfb::ChunkInfo, offset),
+            std::numeric_limits<uint64_t>::max() - 4);
+    EXPECT_THROW(TFBFile{filePath}, Exception);
+
+    std::remove(filePath.c_str());
+}
+
+TEST(TensorVisIOTests, tfbReadsStreamFormat) {
+    const std::string filePath = "tfb-stream-format.tfb";
+    const dmat3 tensor(1.0, 4.0, 6.0, 2.0, 5.0, 7.0, 3.0, 8.0, 9.0);
+
+    {
+        std::ofstream out(filePath, std::ios::out | std::ios::binary);
+        const auto write = [&out](const auto &value) {
+            out.write(reinterpret_cast<const char *>(&value), sizeof(value));
+        };
+        const std::string versionStr("TFBVersion:");
+        write(versionStr.size());
+        out.write(versionStr.data(), versionStr.size());
+        write(tfb::streamVersion);
+        write(size_t{3});  // dimensionality
+        write(size_t{2});  // rank
+        write(glm::uint8{0});
+        write(size3_t(1));
+        write(dvec3(1.0));  // extents
+        write(dvec3(0.0));  // offset
+        for (int i = 0; i < 6; ++i) write(dvec2(0.0, 1.0));
+        // row-major
+        for (glm::length_t row = 0; row < 3; ++row) {
+            for (glm::length_t col = 0; col < 3; ++col) write(tensor[col][row]);
+        }
+        write(glm::uint8{0});
+        const std::string eof("EOFreached");
+        write(eof.size());
+        out.write(eof.data(), eof.size());
+    }
+
+    {
+        TFBFile file(filePath);
+        EXPECT_FALSE(file.isChunked());
+        EXPECT_EQ(tensor, file.read()->tensors()[0]);
+    }
+
+    std::remove(filePath.c_str());
+}
+
+}  // namespace inviwo